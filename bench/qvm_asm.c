@@ -0,0 +1,242 @@
+/*
+QMM2 - Q3 MultiMod 2
+Copyright 2025-2026
+https://github.com/thecybermind/qmm2/
+3-clause BSD license: https://opensource.org/license/bsd-3-clause
+
+Created By:
+    Kevin Masterson < k.m.masterson@gmail.com >
+
+*/
+
+#include <stdint.h>     // intptr_t and uint8_t
+#include <stdlib.h>     // malloc, realloc, and free
+#include <string.h>     // memcpy and memset
+#include "qvm_asm.h"
+
+static void* qvm_asm_append(qvm_asm* a, qvm_asm_buffer* buf, size_t size);
+
+
+void qvm_asm_init(qvm_asm* a) {
+    if (!a)
+        return;
+
+    memset(a, 0, sizeof(*a));
+}
+
+
+void qvm_asm_free(qvm_asm* a) {
+    if (!a)
+        return;
+
+    free(a->code.bytes);
+    free(a->data.bytes);
+    free(a->labels.bytes);
+    free(a->fixups.bytes);
+    qvm_asm_init(a);
+}
+
+
+int qvm_asm_pos(const qvm_asm* a) {
+    return a->instructioncount;
+}
+
+
+int qvm_asm_label(qvm_asm* a) {
+    int* label = (int*)qvm_asm_append(a, &a->labels, sizeof(int));
+    if (!label)
+        return -1;
+
+    *label = -1;
+    return (int)(a->labels.size / sizeof(int)) - 1;
+}
+
+
+void qvm_asm_bind(qvm_asm* a, int label) {
+    int* labels = (int*)a->labels.bytes;
+
+    // a label can only be bound once
+    if (label < 0 || (size_t)label >= a->labels.size / sizeof(int) || labels[label] != -1) {
+        a->failed = 1;
+        return;
+    }
+
+    labels[label] = a->instructioncount;
+}
+
+
+void qvm_asm_op(qvm_asm* a, qvm_opcode op, int param) {
+    if (op <= QVM_OP_UNDEF || op >= QVM_OP_NUM_OPS) {
+        a->failed = 1;
+        return;
+    }
+
+    switch (op) {
+    case QVM_OP_EQ:
+    case QVM_OP_NE:
+    case QVM_OP_LTI:
+    case QVM_OP_LEI:
+    case QVM_OP_GTI:
+    case QVM_OP_GEI:
+    case QVM_OP_LTU:
+    case QVM_OP_LEU:
+    case QVM_OP_GTU:
+    case QVM_OP_GEU:
+    case QVM_OP_EQF:
+    case QVM_OP_NEF:
+    case QVM_OP_LTF:
+    case QVM_OP_LEF:
+    case QVM_OP_GTF:
+    case QVM_OP_GEF:
+    case QVM_OP_ENTER:
+    case QVM_OP_LEAVE:
+    case QVM_OP_CONST:
+    case QVM_OP_LOCAL:
+    case QVM_OP_BLOCK_COPY: {
+        // 4-byte param (same encoding qvm_load expects)
+        uint8_t* p = (uint8_t*)qvm_asm_append(a, &a->code, 5);
+        if (!p)
+            return;
+        p[0] = (uint8_t)op;
+        memcpy(p + 1, &param, sizeof(param));
+        break;
+    }
+
+    case QVM_OP_ARG: {
+        // 1-byte param
+        uint8_t* p = (uint8_t*)qvm_asm_append(a, &a->code, 2);
+        if (!p)
+            return;
+        p[0] = (uint8_t)op;
+        p[1] = (uint8_t)param;
+        break;
+    }
+
+    default: {
+        // no param
+        uint8_t* p = (uint8_t*)qvm_asm_append(a, &a->code, 1);
+        if (!p)
+            return;
+        p[0] = (uint8_t)op;
+        break;
+    }
+    }
+
+    a->instructioncount++;
+}
+
+
+void qvm_asm_op_label(qvm_asm* a, qvm_opcode op, int label) {
+    if (label < 0 || (size_t)label >= a->labels.size / sizeof(int)) {
+        a->failed = 1;
+        return;
+    }
+
+    size_t size = a->code.size;
+    qvm_asm_op(a, op, 0);
+    // make sure the instruction was emitted with a 4-byte param
+    if (a->code.size != size + 5) {
+        a->failed = 1;
+        return;
+    }
+
+    qvm_asm_fixup* fixup = (qvm_asm_fixup*)qvm_asm_append(a, &a->fixups, sizeof(qvm_asm_fixup));
+    if (!fixup)
+        return;
+    fixup->offset = size + 1;
+    fixup->label = label;
+}
+
+
+int qvm_asm_data(qvm_asm* a, const void* data, size_t size) {
+    // data offsets would move if bss was already reserved before it
+    if (a->bsslen) {
+        a->failed = 1;
+        return 0;
+    }
+
+    int offset = (int)a->data.size;
+    size_t padded = (size + 3) & ~(size_t)3;
+    uint8_t* p = (uint8_t*)qvm_asm_append(a, &a->data, padded);
+    if (!p)
+        return 0;
+
+    memcpy(p, data, size);
+    memset(p + size, 0, padded - size);
+    return offset;
+}
+
+
+int qvm_asm_bss(qvm_asm* a, size_t size) {
+    int offset = (int)(a->data.size + a->bsslen);
+    a->bsslen += (uint32_t)((size + 3) & ~(size_t)3);
+    return offset;
+}
+
+
+uint8_t* qvm_asm_build(qvm_asm* a, size_t* filesize) {
+    if (a->failed || !a->instructioncount)
+        return NULL;
+
+    // fill in label references
+    const int* labels = (const int*)a->labels.bytes;
+    const qvm_asm_fixup* fixups = (const qvm_asm_fixup*)a->fixups.bytes;
+    for (size_t i = 0; i < a->fixups.size / sizeof(qvm_asm_fixup); i++) {
+        int target = labels[fixups[i].label];
+        if (target == -1)
+            return NULL;
+        memcpy(a->code.bytes + fixups[i].offset, &target, sizeof(target));
+    }
+
+    // q3asm pads the code segment to 4 bytes
+    size_t codelen = (a->code.size + 3) & ~(size_t)3;
+
+    qvm_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = QVM_MAGIC;
+    header.instructioncount = (uint32_t)a->instructioncount;
+    header.codeoffset = sizeof(header);
+    header.codelen = (uint32_t)codelen;
+    header.dataoffset = (uint32_t)(sizeof(header) + codelen);
+    header.datalen = (uint32_t)a->data.size;
+    header.litlen = 0;
+    header.bsslen = a->bsslen + QVM_PROGRAMSTACK_SIZE;
+
+    size_t size = sizeof(header) + codelen + a->data.size;
+    uint8_t* file = (uint8_t*)malloc(size);
+    if (!file)
+        return NULL;
+
+    memset(file, 0, size);
+    memcpy(file, &header, sizeof(header));
+    memcpy(file + header.codeoffset, a->code.bytes, a->code.size);
+    if (a->data.size)
+        memcpy(file + header.dataoffset, a->data.bytes, a->data.size);
+
+    *filesize = size;
+    return file;
+}
+
+
+// Grow a buffer by 'size' bytes and return a pointer to the new space, or NULL (and mark the builder failed)
+static void* qvm_asm_append(qvm_asm* a, qvm_asm_buffer* buf, size_t size) {
+    if (a->failed)
+        return NULL;
+
+    if (buf->size + size > buf->capacity) {
+        size_t capacity = buf->capacity ? buf->capacity : 256;
+        while (capacity < buf->size + size)
+            capacity *= 2;
+        uint8_t* bytes = (uint8_t*)realloc(buf->bytes, capacity);
+        if (!bytes) {
+            a->failed = 1;
+            return NULL;
+        }
+        buf->bytes = bytes;
+        buf->capacity = capacity;
+    }
+
+    void* p = buf->bytes + buf->size;
+    buf->size += size;
+    return p;
+}
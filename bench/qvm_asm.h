@@ -0,0 +1,143 @@
+/*
+QMM2 - Q3 MultiMod 2
+Copyright 2025-2026
+https://github.com/thecybermind/qmm2/
+3-clause BSD license: https://opensource.org/license/bsd-3-clause
+
+Created By:
+    Kevin Masterson < k.m.masterson@gmail.com >
+
+*/
+
+#ifndef QMM2_QVM_ASM_H
+#define QMM2_QVM_ASM_H
+
+#include <stdint.h>     // intptr_t and uint8_t
+#include <stddef.h>     // ptrdiff_t and size_t
+#include "qvm.h"
+
+// Minimal QVM bytecode builder. Instructions are appended one at a time and branch/call targets can be referenced by
+// label before they are bound. qvm_asm_build produces a complete .qvm file image (header, code, data, and bss length)
+// that can be passed straight to qvm_load. Execution starts at instruction 0, so the first function built is vmMain.
+
+// Growable byte buffer
+typedef struct {
+    size_t size;                // Number of bytes used
+    size_t capacity;            // Number of bytes allocated
+    uint8_t* bytes;             // Contents
+} qvm_asm_buffer;
+
+// A 4-byte instruction param to fill in with a label's instruction index once it is bound
+typedef struct {
+    size_t offset;              // Offset of param in code buffer
+    int label;                  // Label index
+} qvm_asm_fixup;
+
+// QVM builder state
+typedef struct {
+    qvm_asm_buffer code;        // Encoded instructions
+    qvm_asm_buffer data;        // Initialized data segment
+    qvm_asm_buffer labels;      // Instruction index for each label (int, -1 if not bound yet)
+    qvm_asm_buffer fixups;      // Params that reference labels (qvm_asm_fixup)
+    int instructioncount;       // Number of instructions emitted
+    uint32_t bsslen;            // Length of bss segment, not counting the program stack
+    int failed;                 // Set if anything went wrong (out of memory, bad label, data after bss)
+} qvm_asm;
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+
+/**
+* @brief Initialize a blank builder.
+*
+* @param a Pointer to builder
+*/
+void qvm_asm_init(qvm_asm* a);
+
+/**
+* @brief Free a builder's memory.
+*
+* @param a Pointer to builder
+*/
+void qvm_asm_free(qvm_asm* a);
+
+/**
+* @brief Get the index of the next instruction to be emitted.
+*
+* @param a Pointer to builder
+* @return Instruction index
+*/
+int qvm_asm_pos(const qvm_asm* a);
+
+/**
+* @brief Create a new unbound label.
+*
+* @param a Pointer to builder
+* @return Label index
+*/
+int qvm_asm_label(qvm_asm* a);
+
+/**
+* @brief Bind a label to the next instruction to be emitted.
+*
+* @param a Pointer to builder
+* @param label Label index from qvm_asm_label
+*/
+void qvm_asm_bind(qvm_asm* a, int label);
+
+/**
+* @brief Emit an instruction. The param is ignored for opcodes that don't have one, and truncated to a byte for
+* QVM_OP_ARG.
+*
+* @param a Pointer to builder
+* @param op Opcode
+* @param param Immediate
+*/
+void qvm_asm_op(qvm_asm* a, qvm_opcode op, int param);
+
+/**
+* @brief Emit an instruction whose 4-byte param is a label's instruction index (conditional jumps, or a QVM_OP_CONST
+* before QVM_OP_CALL/QVM_OP_JUMP).
+*
+* @param a Pointer to builder
+* @param op Opcode
+* @param label Label index from qvm_asm_label
+*/
+void qvm_asm_op_label(qvm_asm* a, qvm_opcode op, int label);
+
+/**
+* @brief Append initialized data to the data segment. All data must be added before any bss.
+*
+* @param a Pointer to builder
+* @param data Data to copy
+* @param size Size of data (padded to 4 bytes)
+* @return Offset of data in VM memory
+*/
+int qvm_asm_data(qvm_asm* a, const void* data, size_t size);
+
+/**
+* @brief Reserve zero-initialized space in the bss segment.
+*
+* @param a Pointer to builder
+* @param size Size of space (padded to 4 bytes)
+* @return Offset of space in VM memory
+*/
+int qvm_asm_bss(qvm_asm* a, size_t size);
+
+/**
+* @brief Build a .qvm file image. The bss segment is extended by QVM_PROGRAMSTACK_SIZE for the program stack, like
+* q3asm does.
+*
+* @param a Pointer to builder
+* @param filesize Receives size of file image
+* @return File image allocated with malloc, or NULL if the builder failed or a label was never bound
+*/
+uint8_t* qvm_asm_build(qvm_asm* a, size_t* filesize);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // QMM2_QVM_ASM_H
@@ -0,0 +1,535 @@
+/*
+QMM2 - Q3 MultiMod 2
+Copyright 2025-2026
+https://github.com/thecybermind/qmm2/
+3-clause BSD license: https://opensource.org/license/bsd-3-clause
+
+Created By:
+    Kevin Masterson < k.m.masterson@gmail.com >
+
+*/
+
+#define _GNU_SOURCE     // clock_gettime
+#include <stdint.h>     // intptr_t and uint8_t
+#include <stdarg.h>     // va_list
+#include <stdio.h>
+#include <stdlib.h>     // malloc, free, and atoi
+#include <string.h>     // memcpy, strcmp, and strlen
+#include <time.h>       // clock_gettime
+#include "qvm.h"
+#include "qvm_jit.h"
+#include "qvm_aot.h"
+#include "qvm_asm.h"
+
+// Standalone QVM benchmark suite. Each benchmark builds a small QVM with qvm_asm whose vmMain(n) runs a workload n
+// times and returns a checksum, then times repeated vmMain calls in each available execution mode. The number of VM
+// instructions per call is worked out from the built code, so the instruction rate is comparable between the
+// interpreter, the JIT, and translated code (a superinstruction counts as the instructions it replaced).
+
+// Minimum time to run each benchmark in each mode (milliseconds)
+#define BENCH_DEFAULT_TIME      250
+
+// Emit an instruction without a param
+#define OP(o)           qvm_asm_op(a, QVM_OP_##o, 0)
+// Emit an instruction with a param
+#define OPI(o, p)       qvm_asm_op(a, QVM_OP_##o, (p))
+// Emit an instruction whose param is a label
+#define OPL(o, l)       qvm_asm_op_label(a, QVM_OP_##o, (l))
+// Emit a QVM_OP_CONST with a float value
+#define OPF(f)          OPI(CONST, bench_float_bits(f))
+// Push the address of local slot/argument 'o' in a stack frame of size 'f'
+#define LOCAL(o)        OPI(LOCAL, (o))
+#define ARG(f, i)       OPI(LOCAL, (f) + 8 + 4 * (i))
+
+// Syscall handled by the stub syscall function
+#define BENCH_SYSCALL   0
+
+// A built benchmark program
+typedef struct {
+    uint8_t* file;              // .qvm file image
+    size_t filesize;            // Size of file image
+    int expected;               // Expected vmMain return value
+    int tolerance;              // Allowed difference from expected value (float results)
+    uint64_t instructions;      // Number of VM instructions run by a single vmMain call
+} bench_program;
+
+// A benchmark definition
+typedef struct {
+    const char* name;           // Name used to select benchmark on the command line
+    const char* desc;           // Description
+    int n;                      // Argument to vmMain
+    int (*build)(qvm_asm* a, int n, bench_program* prog);  // Emit code and fill in expected result and instruction count
+} bench_def;
+
+// An execution mode
+typedef enum {
+    BENCH_INTERP,
+    BENCH_JIT,
+    BENCH_AOT,
+    BENCH_NUM_MODES
+} bench_mode;
+
+static const char* bench_modename[BENCH_NUM_MODES] = { "interp", "jit", "aot" };
+
+static int bench_float_bits(float f);
+static int bench_calls(qvm_asm* a, int n, bench_program* prog);
+static int bench_intloop(qvm_asm* a, int n, bench_program* prog);
+static int bench_floatloop(qvm_asm* a, int n, bench_program* prog);
+static int bench_blockcopy(qvm_asm* a, int n, bench_program* prog);
+static int bench_syscall(qvm_asm* a, int n, bench_program* prog);
+static int bench_strscan(qvm_asm* a, int n, bench_program* prog);
+
+static bench_def bench_defs[] = {
+    { "calls",      "recursive fib(n), deep CALL/ENTER/LEAVE traffic",      20,     bench_calls },
+    { "intloop",    "integer hash loop over locals",                        100000, bench_intloop },
+    { "floatloop",  "float recurrence with int/float conversion",           100000, bench_floatloop },
+    { "blockcopy",  "64-byte struct and vec3 copies with BLOCK_COPY",       20000,  bench_blockcopy },
+    { "syscall",    "loop calling a stub syscall with 2 args",              20000,  bench_syscall },
+    { "strscan",    "scan a string for a character, byte by byte",          500,    bench_strscan },
+};
+
+// log_c is provided by the QMM logging system in the full build
+void log_c(int severity, const char* tag, const char* fmt, ...) {
+    // only show warnings and errors (QMM_LOG_WARNING and up)
+    if (severity < 4)
+        return;
+    va_list ap;
+    va_start(ap, fmt);
+    fprintf(stderr, "[%s] ", tag);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+}
+
+
+// Stub syscall handler: BENCH_SYSCALL returns the sum of its 2 args
+static int bench_syscall_handler(uint8_t* membase, int cmd, int* args) {
+    (void)membase;
+    if (cmd == BENCH_SYSCALL)
+        return args[0] + args[1];
+    return 0;
+}
+
+
+static uint64_t bench_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+
+// Load a program in the given mode. Returns 0 if the mode isn't available
+static int bench_load(qvm* vm, const bench_program* prog, bench_mode mode, const char* aotdir) {
+    if (!qvm_load(vm, prog->file, prog->filesize, bench_syscall_handler, 1, 0, NULL))
+        return 0;
+
+    if (mode == BENCH_JIT && !qvm_jit_compile(vm))
+        goto fail;
+    if (mode == BENCH_AOT && (!aotdir || !qvm_aot_load(vm, prog->file, prog->filesize, aotdir, "cc")))
+        goto fail;
+    return 1;
+
+fail:
+    qvm_unload(vm);
+    return 0;
+}
+
+
+// Run and time a benchmark in a mode. Returns 0 if the result was wrong
+static int bench_run(const bench_def* def, const bench_program* prog, bench_mode mode, const char* aotdir, uint64_t mintime) {
+    qvm vm;
+    qvm_init(&vm);
+
+    if (!bench_load(&vm, prog, mode, aotdir)) {
+        printf("%-10s %-7s %10s\n", def->name, bench_modename[mode], "unavailable");
+        return 1;
+    }
+
+    int arg = def->n;
+    // first call checks the result (and warms up caches)
+    int result = qvm_exec(&vm, 1, &arg);
+    int diff = result > prog->expected ? result - prog->expected : prog->expected - result;
+    if (vm.failed || diff > prog->tolerance) {
+        printf("%-10s %-7s %10s (got %d, expected %d)\n", def->name, bench_modename[mode], "FAILED", result, prog->expected);
+        qvm_unload(&vm);
+        return 0;
+    }
+
+    // run batches of calls until the minimum time is reached, doubling the batch size each time
+    uint64_t calls = 0;
+    uint64_t elapsed = 0;
+    for (uint64_t batch = 1; elapsed < mintime; batch *= 2) {
+        uint64_t start = bench_time();
+        for (uint64_t i = 0; i < batch; i++)
+            qvm_exec(&vm, 1, &arg);
+        elapsed += bench_time() - start;
+        calls += batch;
+    }
+
+    double nspercall = (double)elapsed / (double)calls;
+    double mips = (double)prog->instructions * (double)calls / (double)elapsed * 1000.0;
+    printf("%-10s %-7s %10llu %14.1f %12.1f\n", def->name, bench_modename[mode], (unsigned long long)calls, nspercall, mips);
+
+    qvm_unload(&vm);
+    return 1;
+}
+
+
+static void bench_usage(const char* argv0) {
+    printf("usage: %s [-t ms] [-m interp|jit|aot] [-a aotcachedir] [benchmark...]\n", argv0);
+    printf("  -t ms           minimum time to run each benchmark in each mode (default %d)\n", BENCH_DEFAULT_TIME);
+    printf("  -m mode         only run in the given mode (may be repeated)\n");
+    printf("  -a dir          directory to store translated modules in (aot mode is skipped without one)\n");
+    printf("benchmarks:\n");
+    for (size_t i = 0; i < sizeof(bench_defs) / sizeof(bench_defs[0]); i++)
+        printf("  %-15s %s (n=%d)\n", bench_defs[i].name, bench_defs[i].desc, bench_defs[i].n);
+}
+
+
+int main(int argc, char** argv) {
+    uint64_t mintime = BENCH_DEFAULT_TIME * 1000000ull;
+    const char* aotdir = NULL;
+    int modes[BENCH_NUM_MODES] = { 0 };
+    int anymode = 0;
+    const char** names = (const char**)malloc(argc * sizeof(const char*));
+    int numnames = 0;
+    if (!names)
+        return 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+            mintime = (uint64_t)atoi(argv[++i]) * 1000000ull;
+        }
+        else if (!strcmp(argv[i], "-a") && i + 1 < argc) {
+            aotdir = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-m") && i + 1 < argc) {
+            const char* mode = argv[++i];
+            int m;
+            for (m = 0; m < BENCH_NUM_MODES; m++) {
+                if (!strcmp(mode, bench_modename[m]))
+                    break;
+            }
+            if (m == BENCH_NUM_MODES) {
+                bench_usage(argv[0]);
+                free(names);
+                return 1;
+            }
+            modes[m] = 1;
+            anymode = 1;
+        }
+        else if (argv[i][0] == '-') {
+            bench_usage(argv[0]);
+            free(names);
+            return !strcmp(argv[i], "-h") ? 0 : 1;
+        }
+        else {
+            names[numnames++] = argv[i];
+        }
+    }
+    if (!anymode) {
+        for (int m = 0; m < BENCH_NUM_MODES; m++)
+            modes[m] = 1;
+    }
+
+    printf("%-10s %-7s %10s %14s %12s\n", "benchmark", "mode", "calls", "ns/call", "Minsn/s");
+
+    int ok = 1;
+    for (size_t i = 0; i < sizeof(bench_defs) / sizeof(bench_defs[0]); i++) {
+        const bench_def* def = &bench_defs[i];
+
+        // skip benchmarks not given on the command line
+        if (numnames) {
+            int found = 0;
+            for (int j = 0; j < numnames && !found; j++)
+                found = !strcmp(names[j], def->name);
+            if (!found)
+                continue;
+        }
+
+        qvm_asm a;
+        qvm_asm_init(&a);
+        bench_program prog;
+        memset(&prog, 0, sizeof(prog));
+        if (!def->build(&a, def->n, &prog) || !(prog.file = qvm_asm_build(&a, &prog.filesize))) {
+            printf("%-10s failed to build\n", def->name);
+            qvm_asm_free(&a);
+            ok = 0;
+            continue;
+        }
+        qvm_asm_free(&a);
+
+        for (int m = 0; m < BENCH_NUM_MODES; m++) {
+            if (modes[m] && !bench_run(def, &prog, (bench_mode)m, aotdir, mintime))
+                ok = 0;
+        }
+
+        free(prog.file);
+    }
+
+    free(names);
+    return ok ? 0 : 1;
+}
+
+
+static int bench_float_bits(float f) {
+    int i;
+    memcpy(&i, &f, sizeof(i));
+    return i;
+}
+
+
+// Loops below are all "do { body } while (++i < n)" with i in local slot 8. Emits the increment and branch
+static void bench_loop_end(qvm_asm* a, int top, int frame) {
+    LOCAL(8); LOCAL(8); OP(LOAD4); OPI(CONST, 1); OP(ADD); OP(STORE4);
+    LOCAL(8); OP(LOAD4); ARG(frame, 0); OP(LOAD4); OPL(LTI, top);
+}
+
+
+// vmMain(n) { return fib(n); }
+// fib(n) { if (n < 2) return n; return fib(n - 1) + fib(n - 2); }
+static int bench_calls(qvm_asm* a, int n, bench_program* prog) {
+    const int frame = 12;       // 1 outgoing arg
+    int fib = qvm_asm_label(a);
+    int rec = qvm_asm_label(a);
+
+    OPI(ENTER, frame);
+    ARG(frame, 0); OP(LOAD4); OPI(ARG, 8);
+    OPL(CONST, fib); OP(CALL);
+    OPI(LEAVE, frame);
+    int mainlen = qvm_asm_pos(a);
+
+    qvm_asm_bind(a, fib);
+    int fibstart = qvm_asm_pos(a);
+    OPI(ENTER, frame);
+    ARG(frame, 0); OP(LOAD4); OPI(CONST, 2); OPL(GEI, rec);
+    int testlen = qvm_asm_pos(a) - fibstart;
+    ARG(frame, 0); OP(LOAD4);
+    OPI(LEAVE, frame);
+    qvm_asm_bind(a, rec);
+    int baselen = qvm_asm_pos(a) - fibstart;
+    int recstart = qvm_asm_pos(a);
+    ARG(frame, 0); OP(LOAD4); OPI(CONST, 1); OP(SUB); OPI(ARG, 8);
+    OPL(CONST, fib); OP(CALL);
+    ARG(frame, 0); OP(LOAD4); OPI(CONST, 2); OP(SUB); OPI(ARG, 8);
+    OPL(CONST, fib); OP(CALL);
+    OP(ADD);
+    OPI(LEAVE, frame);
+    int reclen = testlen + qvm_asm_pos(a) - recstart;
+
+    // count calls that return n directly and calls that recurse
+    uint64_t* leaves = (uint64_t*)malloc((n + 2) * sizeof(uint64_t));
+    uint64_t* calls = (uint64_t*)malloc((n + 2) * sizeof(uint64_t));
+    int* fibs = (int*)malloc((n + 2) * sizeof(int));
+    if (!leaves || !calls || !fibs) {
+        free(leaves);
+        free(calls);
+        free(fibs);
+        return 0;
+    }
+    for (int i = 0; i <= n; i++) {
+        leaves[i] = i < 2 ? 1 : leaves[i - 1] + leaves[i - 2];
+        calls[i] = i < 2 ? 1 : 1 + calls[i - 1] + calls[i - 2];
+        fibs[i] = i < 2 ? i : fibs[i - 1] + fibs[i - 2];
+    }
+    prog->expected = fibs[n];
+    prog->instructions = (uint64_t)mainlen + leaves[n] * (uint64_t)baselen + (calls[n] - leaves[n]) * (uint64_t)reclen;
+    free(leaves);
+    free(calls);
+    free(fibs);
+    return 1;
+}
+
+
+// vmMain(n) { int i = 0, acc = 0; do { acc = acc * 31 ^ (i + (i >> 3)) + i % 7; } while (++i < n); return acc; }
+static int bench_intloop(qvm_asm* a, int n, bench_program* prog) {
+    const int frame = 16;       // i at 8, acc at 12
+    int top = qvm_asm_label(a);
+
+    OPI(ENTER, frame);
+    LOCAL(8); OPI(CONST, 0); OP(STORE4);
+    LOCAL(12); OPI(CONST, 0); OP(STORE4);
+    int prologue = qvm_asm_pos(a);
+    qvm_asm_bind(a, top);
+    LOCAL(12);
+    LOCAL(12); OP(LOAD4); OPI(CONST, 31); OP(MULI);
+    LOCAL(8); OP(LOAD4); LOCAL(8); OP(LOAD4); OPI(CONST, 3); OP(RSHI); OP(ADD);
+    LOCAL(8); OP(LOAD4); OPI(CONST, 7); OP(MODI); OP(ADD);
+    OP(BXOR);
+    OP(STORE4);
+    bench_loop_end(a, top, frame);
+    int body = qvm_asm_pos(a) - prologue;
+    LOCAL(12); OP(LOAD4);
+    OPI(LEAVE, frame);
+    int epilogue = qvm_asm_pos(a) - prologue - body;
+
+    unsigned int acc = 0;
+    int i = 0;
+    do {
+        acc = (acc * 31u) ^ (unsigned int)(i + (i >> 3) + i % 7);
+    } while (++i < n);
+    prog->expected = (int)acc;
+    prog->instructions = (uint64_t)prologue + (uint64_t)n * (uint64_t)body + (uint64_t)epilogue;
+    return 1;
+}
+
+
+// vmMain(n) { int i = 0; float x = 0, y = 0; do { x = x * 0.75f + (float)(i & 7); y += x / (x + 1.0f); } while (++i < n); return (int)y; }
+static int bench_floatloop(qvm_asm* a, int n, bench_program* prog) {
+    const int frame = 20;       // i at 8, x at 12, y at 16
+    int top = qvm_asm_label(a);
+
+    OPI(ENTER, frame);
+    LOCAL(8); OPI(CONST, 0); OP(STORE4);
+    LOCAL(12); OPF(0.0f); OP(STORE4);
+    LOCAL(16); OPF(0.0f); OP(STORE4);
+    int prologue = qvm_asm_pos(a);
+    qvm_asm_bind(a, top);
+    LOCAL(12);
+    LOCAL(12); OP(LOAD4); OPF(0.75f); OP(MULF);
+    LOCAL(8); OP(LOAD4); OPI(CONST, 7); OP(BAND); OP(CVIF);
+    OP(ADDF);
+    OP(STORE4);
+    LOCAL(16);
+    LOCAL(16); OP(LOAD4);
+    LOCAL(12); OP(LOAD4); LOCAL(12); OP(LOAD4); OPF(1.0f); OP(ADDF); OP(DIVF);
+    OP(ADDF);
+    OP(STORE4);
+    bench_loop_end(a, top, frame);
+    int body = qvm_asm_pos(a) - prologue;
+    LOCAL(16); OP(LOAD4); OP(CVFI);
+    OPI(LEAVE, frame);
+    int epilogue = qvm_asm_pos(a) - prologue - body;
+
+    float x = 0.0f, y = 0.0f;
+    int i = 0;
+    do {
+        x = x * 0.75f + (float)(i & 7);
+        y += x / (x + 1.0f);
+    } while (++i < n);
+    prog->expected = (int)y;
+    // rounding may differ slightly between modes (and the host) over a long sum
+    prog->tolerance = 1 + prog->expected / 1000;
+    prog->instructions = (uint64_t)prologue + (uint64_t)n * (uint64_t)body + (uint64_t)epilogue;
+    return 1;
+}
+
+
+// struct { int w[16]; } src, dst[16]; vec3_t v, vsrc;
+// vmMain(n) { int i = 0; do { src.w[0] = i; dst[i & 15] = src; v = vsrc; } while (++i < n); return dst[(n - 1) & 15].w[0]; }
+static int bench_blockcopy(qvm_asm* a, int n, bench_program* prog) {
+    const int frame = 12;       // i at 8
+    const float vinit[3] = { 1.0f, 2.0f, 3.0f };
+    int vsrc = qvm_asm_data(a, vinit, sizeof(vinit));
+    int src = qvm_asm_bss(a, 64);
+    int dst = qvm_asm_bss(a, 64 * 16);
+    int v = qvm_asm_bss(a, sizeof(vinit));
+    int top = qvm_asm_label(a);
+
+    OPI(ENTER, frame);
+    LOCAL(8); OPI(CONST, 0); OP(STORE4);
+    int prologue = qvm_asm_pos(a);
+    qvm_asm_bind(a, top);
+    OPI(CONST, src); LOCAL(8); OP(LOAD4); OP(STORE4);
+    OPI(CONST, dst); LOCAL(8); OP(LOAD4); OPI(CONST, 15); OP(BAND); OPI(CONST, 6); OP(LSH); OP(ADD);
+    OPI(CONST, src);
+    OPI(BLOCK_COPY, 64);
+    OPI(CONST, v); OPI(CONST, vsrc); OPI(BLOCK_COPY, sizeof(vinit));
+    bench_loop_end(a, top, frame);
+    int body = qvm_asm_pos(a) - prologue;
+    OPI(CONST, dst); ARG(frame, 0); OP(LOAD4); OPI(CONST, 1); OP(SUB); OPI(CONST, 15); OP(BAND); OPI(CONST, 6); OP(LSH); OP(ADD);
+    OP(LOAD4);
+    OPI(LEAVE, frame);
+    int epilogue = qvm_asm_pos(a) - prologue - body;
+
+    prog->expected = n - 1;
+    prog->instructions = (uint64_t)prologue + (uint64_t)n * (uint64_t)body + (uint64_t)epilogue;
+    return 1;
+}
+
+
+// vmMain(n) { int i = 0, acc = 0; do { acc += trap_Stub(i, 3); } while (++i < n); return acc; }
+static int bench_syscall(qvm_asm* a, int n, bench_program* prog) {
+    const int frame = 24;       // 2 outgoing args, i at 16, acc at 20
+    int top = qvm_asm_label(a);
+
+    OPI(ENTER, frame);
+    LOCAL(16); OPI(CONST, 0); OP(STORE4);
+    LOCAL(20); OPI(CONST, 0); OP(STORE4);
+    int prologue = qvm_asm_pos(a);
+    qvm_asm_bind(a, top);
+    LOCAL(20);
+    LOCAL(20); OP(LOAD4);
+    LOCAL(16); OP(LOAD4); OPI(ARG, 8);
+    OPI(CONST, 3); OPI(ARG, 12);
+    OPI(CONST, -BENCH_SYSCALL - 1); OP(CALL);
+    OP(ADD);
+    OP(STORE4);
+    // this frame has outgoing args, so i isn't in slot 8
+    LOCAL(16); LOCAL(16); OP(LOAD4); OPI(CONST, 1); OP(ADD); OP(STORE4);
+    LOCAL(16); OP(LOAD4); ARG(frame, 0); OP(LOAD4); OPL(LTI, top);
+    int body = qvm_asm_pos(a) - prologue;
+    LOCAL(20); OP(LOAD4);
+    OPI(LEAVE, frame);
+    int epilogue = qvm_asm_pos(a) - prologue - body;
+
+    unsigned int acc = 0;
+    int i = 0;
+    do {
+        acc += (unsigned int)(i + 3);
+    } while (++i < n);
+    prog->expected = (int)acc;
+    prog->instructions = (uint64_t)prologue + (uint64_t)n * (uint64_t)body + (uint64_t)epilogue;
+    return 1;
+}
+
+
+// vmMain(n) { int i = 0, count = 0; do { for (char* p = str; *p; p++) if (*p == 'e') count++; } while (++i < n); return count; }
+static int bench_strscan(qvm_asm* a, int n, bench_program* prog) {
+    const int frame = 20;       // i at 8, p at 12, count at 16
+    static const char text[] =
+        "Welcome to the arena! The level has been set up for free for all. Every frag counts, so keep "
+        "moving, check every corner, and remember where the armor and weapons respawn before the others do.";
+    int str = qvm_asm_data(a, text, sizeof(text));
+    int top = qvm_asm_label(a);
+    int scan = qvm_asm_label(a);
+    int skip = qvm_asm_label(a);
+    int next = qvm_asm_label(a);
+
+    OPI(ENTER, frame);
+    LOCAL(8); OPI(CONST, 0); OP(STORE4);
+    LOCAL(16); OPI(CONST, 0); OP(STORE4);
+    int prologue = qvm_asm_pos(a);
+    qvm_asm_bind(a, top);
+    LOCAL(12); OPI(CONST, str); OP(STORE4);
+    int setup = qvm_asm_pos(a) - prologue;
+    // *p == 0 ends the scan
+    qvm_asm_bind(a, scan);
+    int scanstart = qvm_asm_pos(a);
+    LOCAL(12); OP(LOAD4); OP(LOAD1); OPI(CONST, 0); OPL(EQ, next);
+    int endtest = qvm_asm_pos(a) - scanstart;
+    LOCAL(12); OP(LOAD4); OP(LOAD1); OPI(CONST, 'e'); OPL(NE, skip);
+    int counted = qvm_asm_pos(a);
+    LOCAL(16); LOCAL(16); OP(LOAD4); OPI(CONST, 1); OP(ADD); OP(STORE4);
+    int countlen = qvm_asm_pos(a) - counted;
+    qvm_asm_bind(a, skip);
+    LOCAL(12); LOCAL(12); OP(LOAD4); OPI(CONST, 1); OP(ADD); OP(STORE4);
+    OPL(CONST, scan); OP(JUMP);
+    int charlen = qvm_asm_pos(a) - scanstart - countlen;
+    qvm_asm_bind(a, next);
+    int nextstart = qvm_asm_pos(a);
+    bench_loop_end(a, top, frame);
+    int looplen = qvm_asm_pos(a) - nextstart;
+    int body = qvm_asm_pos(a) - prologue;
+    LOCAL(16); OP(LOAD4);
+    OPI(LEAVE, frame);
+    int epilogue = qvm_asm_pos(a) - prologue - body;
+
+    uint64_t len = strlen(text);
+    uint64_t es = 0;
+    for (const char* p = text; *p; p++)
+        es += *p == 'e';
+    uint64_t pass = (uint64_t)setup + len * (uint64_t)charlen + es * (uint64_t)countlen + (uint64_t)endtest + (uint64_t)looplen;
+    prog->expected = (int)(es * (uint64_t)n);
+    prog->instructions = (uint64_t)prologue + (uint64_t)n * pass + (uint64_t)epilogue;
+    return 1;
+}
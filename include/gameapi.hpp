@@ -18,6 +18,7 @@ Created By:
 #include <vector>
 #include "qmmapi.h"
 #include "util.hpp"
+#include "qvm.h"
 
 
 // ------------------------------------
@@ -102,7 +103,7 @@ enum {
 
 // List of all the mod messages/constants used by QMM. If you change this, update the GEN_GAME_QMM_MOD_MSGS macro.
 enum {
-    QMM_GAME_INIT, QMM_GAME_SHUTDOWN, QMM_GAME_CONSOLE_COMMAND,
+    QMM_GAME_INIT, QMM_GAME_SHUTDOWN, QMM_GAME_CONSOLE_COMMAND, QMM_GAME_RUN_FRAME,
 
     // Array size
     QMM_MOD_MSG_COUNT,
@@ -119,14 +120,33 @@ enum {
 // Output game-specific message values to match the QMM mod messages.
 #define GEN_GAME_QMM_MOD_MSGS() \
 	{ \
-		GAME_INIT, GAME_SHUTDOWN, GAME_CONSOLE_COMMAND, \
+		GAME_INIT, GAME_SHUTDOWN, GAME_CONSOLE_COMMAND, GAME_RUN_FRAME, \
 	}
 
+// How a QVM syscall's return value is passed back to the QVM
+enum QVMSyscallRet : uint8_t {
+    QVM_RET_VALUE,          // Engine return value
+    QVM_RET_ARG0,           // The QVM's own arg 0 (memcpy, strncpy, and memset return their real dest pointer)
+    QVM_RET_HUNK_STRING,    // Engine returns a string pointer, which is copied into the QVM hunk
+    QVM_RET_HUNK_ALLOC,     // Engine returns a block of (arg 0) bytes, which is allocated in the QVM hunk instead
+};
+
+// Argument descriptor for a single QVM syscall (see GEN_QVM_SYSCALL_TABLE)
+struct QVMSyscallDesc {
+    bool valid = false;                 // Syscall is supported (unsupported syscalls return 0)
+    uint8_t numargs = 0;                // Number of args
+    bool exactargs = true;              // numargs is the real arg count (false if the engine's args are not known)
+    QVMSyscallRet ret = QVM_RET_VALUE;  // How the return value is handled
+    uint32_t ptrargs = 0;               // Bit n is set if arg n is a pointer into the QVM data segment
+    qvm_intrinsic intrinsic = QVM_INTRINSIC_NONE;   // Native implementation the VM can run if no plugin hooks this syscall
+};
+
 // Pure virtual base class for game support.
 // Derived classes need to implement all functions except:
 // * DefaultQVMName - only need if the game supports QVMs. Default will return nullptr (this is how QMM determines QVM support).
 // * ModCvar - only need if the engine's cvar for determining mod is different from "fs_game"
-// * QVMSyscall - only need if the game supports QVMs. Default returns 0.
+// * QVMSyscalls - only need if the game supports QVMs. Default returns nullptr.
+// * SyscallArgcs/VMMainArgcs - only need if the arg counts are known. Default returns nullptr (every arg is passed on).
 // Derived classes also need to implement qmm_eng_msgs and qmm_mod_msgs (use GEN_GAME_QMM_ENG_MSGS() and GEN_GAME_QMM_MOD_MSGS() macros).
 struct GameSupport {
     /**
@@ -197,19 +217,72 @@ struct GameSupport {
     * @brief Game-specific code to call into the engine with given cmd and arguments.
     *
     * @param cmd Engine function
-    * @param ... Engine arguments
+    * @param args Engine arguments
+    * @param argc Number of entries in args (only these are passed on)
     * @return Engine function return value
     */
-    virtual intptr_t syscall(intptr_t cmd, ...) = 0;
+    virtual intptr_t syscall_args(intptr_t cmd, intptr_t* args, int argc) = 0;
 
     /**
     * @brief Game-specific code to call into the mod with given cmd and arguments.
     *
     * @param cmd Mod function
+    * @param args Mod arguments
+    * @param argc Number of entries in args (only these are passed on)
+    * @return Mod function return value
+    */
+    virtual intptr_t vmMain_args(intptr_t cmd, intptr_t* args, int argc) = 0;
+
+    /**
+    * @brief Call into the engine with given cmd and varargs (unpacks them and calls syscall_args).
+    *
+    * @param cmd Engine function
+    * @param ... Engine arguments
+    * @return Engine function return value
+    */
+    intptr_t syscall(intptr_t cmd, ...);
+
+    /**
+    * @brief Call into the mod with given cmd and varargs (unpacks them and calls vmMain_args).
+    *
+    * @param cmd Mod function
     * @param ... Mod arguments
     * @return Mod function return value
     */
-    virtual intptr_t vmMain(intptr_t cmd, ...) = 0;
+    intptr_t vmMain(intptr_t cmd, ...);
+
+    /**
+    * @brief Get the number of args an engine message takes, from the game's syscall arg count table (or its QVM
+    * syscall table if it doesn't have one).
+    *
+    * @param cmd Engine message
+    * @return Number of args, or QMM_MAX_SYSCALL_ARGS if the message is not in the table or its args are not known
+    */
+    int SyscallArgc(intptr_t cmd);
+
+    /**
+    * @brief Get the number of args a mod message takes, from the game's vmMain arg count table.
+    *
+    * @param cmd Mod message
+    * @return Number of args, or QMM_MAX_VMMAIN_ARGS if the message is not in the table or its args are not known
+    */
+    int VMMainArgc(intptr_t cmd);
+
+    /**
+    * @brief Get the number of args each engine message takes. Use GEN_SYSCALL_ARGC_TABLE to build it.
+    *
+    * @param count Receives the number of entries in the table
+    * @return Table of arg counts (-1 if not known) indexed by engine message, or nullptr if the game doesn't have one
+    */
+    virtual const int8_t* SyscallArgcs(int* count) { *count = 0; return nullptr; }
+
+    /**
+    * @brief Get the number of args each mod message takes. Use GEN_VMMAIN_ARGC_TABLE to build it.
+    *
+    * @param count Receives the number of entries in the table
+    * @return Table of arg counts (-1 if not known) indexed by mod message, or nullptr if the game doesn't have one
+    */
+    virtual const int8_t* VMMainArgcs(int* count) { *count = 0; return nullptr; }
 
     /**
     * @brief Get default filename for mod DLL.
@@ -254,16 +327,26 @@ struct GameSupport {
     virtual const char* GameCode() = 0;
 
     /**
-    * @brief Handler for syscalls out of the QVM.
+    * @brief Get argument descriptors for syscalls out of the QVM.
     * 
-    * This function should route the call to qmm_syscall while modifying pointer arguments using the VMPTR(x) macro.
+    * Mod::QVM_syscall uses this table to convert pointer arguments (adding the QVM data segment address) and route the
+    * call to plugins and the engine. Use GEN_QVM_SYSCALL_TABLE to build it.
     *
-    * @param membase Starting address of the QVM datasegment
-    * @param cmd Engine message
-    * @param args Engine arguments
-    * @return Engine function return value
+    * @param count Receives the number of entries in the table
+    * @return Table of descriptors indexed by engine message, or nullptr if the game doesn't support QVMs
+    */
+    virtual const QVMSyscallDesc* QVMSyscalls(int* count) { *count = 0; return nullptr; }
+
+    /**
+    * @brief Point import/export struct slots straight at the engine/mod functions for messages that no plugin hooks,
+    * and back at QMM's routing lambdas for messages that are hooked. Only possible if the engine and mod keep using
+    * QMM's structs after the entry point returns (instead of copying them). Use PASSTHROUGH_IMPORT and
+    * PASSTHROUGH_EXPORT to implement it.
+    *
+    * @param enabled false to route every slot through QMM
+    * @return Number of slots that bypass QMM
     */
-    virtual int QVMSyscall(uint8_t* membase, int cmd, int* args) { (void)membase; (void)cmd; (void)args; return 0; }
+    virtual int UpdatePassthroughs(bool enabled [[maybe_unused]]) { return 0; }
 };
 
 // Table of pointers to GameSupport objects
@@ -292,26 +375,118 @@ constexpr int QVM_MAX_VMMAIN_ARGS = 6;
 constexpr int QMM_MAX_VMMAIN_ARGS = 9;
 
 // Pull vmMain args from varargs
-#define QMM_GET_VMMAIN_ARGS()   intptr_t args[QMM_MAX_VMMAIN_ARGS] = {}; \
-                                va_list arglist; \
-                                va_start(arglist, cmd); \
-                                for (int i = 0; i < QMM_MAX_VMMAIN_ARGS; ++i) \
-                                    args[i] = va_arg(arglist, intptr_t); \
-                                va_end(arglist)
-// Generate list of all vmMain args for callsites
-#define QMM_PUT_VMMAIN_ARGS()	args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7], args[8]
+#define QMM_GET_VMMAIN_ARGS()   QMM_GET_VMMAIN_ARGS_N(QMM_MAX_VMMAIN_ARGS)
+// Pull only the first "n" vmMain args from varargs into args, and store the count in argc (the rest of args is not set)
+#define QMM_GET_VMMAIN_ARGS_N(n)    const int argc = (n); \
+                                    intptr_t args[QMM_MAX_VMMAIN_ARGS]; \
+                                    va_list arglist; \
+                                    va_start(arglist, cmd); \
+                                    for (int i = 0; i < argc; ++i) \
+                                        args[i] = va_arg(arglist, intptr_t); \
+                                    va_end(arglist)
 
 // Max amount of syscall args in any game
 constexpr int QMM_MAX_SYSCALL_ARGS = 18;
 // Pull syscall args from varargs
-#define QMM_GET_SYSCALL_ARGS()  intptr_t args[QMM_MAX_SYSCALL_ARGS] = {}; \
-                                va_list arglist; \
-                                va_start(arglist, cmd); \
-                                for (int i = 0; i < QMM_MAX_SYSCALL_ARGS; ++i) \
-                                    args[i] = va_arg(arglist, intptr_t); \
-                                va_end(arglist)
-// Generate list of all syscall args for callsites
-#define QMM_PUT_SYSCALL_ARGS()	args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7], args[8], args[9], args[10], args[11], args[12], args[13], args[14], args[15], args[16], args[17]
+#define QMM_GET_SYSCALL_ARGS()  QMM_GET_SYSCALL_ARGS_N(QMM_MAX_SYSCALL_ARGS)
+// Pull only the first "n" syscall args from varargs into args, and store the count in argc (the rest of args is not set)
+#define QMM_GET_SYSCALL_ARGS_N(n)   const int argc = (n); \
+                                    intptr_t args[QMM_MAX_SYSCALL_ARGS]; \
+                                    va_list arglist; \
+                                    va_start(arglist, cmd); \
+                                    for (int i = 0; i < argc; ++i) \
+                                        args[i] = va_arg(arglist, intptr_t); \
+                                    va_end(arglist)
+
+/**
+* @brief Call a vararg engine syscall or mod vmMain function with only the first argc args of an array.
+*
+* @param func Engine syscall or mod vmMain function
+* @param cmd First arg (the message for syscall/vmMain)
+* @param args Rest of the args
+* @param argc Number of entries in args to pass (0 to QMM_MAX_SYSCALL_ARGS)
+* @return Function return value
+*/
+intptr_t api_call_args(eng_syscall func, intptr_t cmd, const intptr_t* args, int argc);
+
+/**
+* @brief Call an import/export struct function (cast to eng_syscall or mod_vmMain) with only the first argc args of an
+* array.
+*
+* @param func Import/export struct function
+* @param args Args
+* @param argc Number of entries in args to pass
+* @return Function return value
+*/
+inline intptr_t api_call_args(eng_syscall func, const intptr_t* args, int argc) {
+    if (argc <= 0)
+        return func(0);
+    return api_call_args(func, args[0], args + 1, argc - 1);
+}
+
+// Entry in a game's list of engine or mod message arg counts. argc is -1 if the args are not known (every arg is
+// passed on)
+struct MsgArgcDef {
+    int cmd;
+    int argc;
+};
+
+// Table of arg counts indexed by message, built at compile time from a list of MsgArgcDef
+template <int N>
+struct MsgArgcTable {
+    static constexpr int count = N;
+    int8_t argc[N] = {};
+};
+
+// Get the number of entries needed for an arg count table (highest message + 1)
+template <size_t N>
+constexpr int msg_argc_count(const MsgArgcDef (&defs)[N]) {
+    int count = 0;
+    for (size_t i = 0; i < N; i++) {
+        if (defs[i].cmd >= count)
+            count = defs[i].cmd + 1;
+    }
+    return count;
+}
+
+// Build an arg count table from a list of MsgArgcDef. Messages that are not listed, and counts above maxargs (which
+// can't be passed on anyway), are not known. A message listed twice with different counts is not a constant
+// expression, so it fails to compile
+template <int Count, size_t N>
+constexpr MsgArgcTable<Count> msg_argc_table(const MsgArgcDef (&defs)[N], int maxargs) {
+    MsgArgcTable<Count> table;
+    for (int i = 0; i < Count; i++)
+        table.argc[i] = -1;
+    for (size_t i = 0; i < N; i++) {
+        if (defs[i].cmd < 0 || defs[i].argc < 0 || defs[i].argc > maxargs)
+            continue;
+        int8_t& argc = table.argc[defs[i].cmd];
+        if (argc >= 0 && argc != defs[i].argc)
+            throw "conflicting message arg counts";
+        argc = (int8_t)defs[i].argc;
+    }
+    return table;
+}
+
+// Generate syscall arg count table from a list of MsgArgcDef (used in game_XYZ.cpp)
+#define GEN_SYSCALL_ARGC_TABLE(defs) msg_argc_table<msg_argc_count(defs)>(defs, QMM_MAX_SYSCALL_ARGS)
+// Generate vmMain arg count table from a list of MsgArgcDef (used in game_XYZ.cpp)
+#define GEN_VMMAIN_ARGC_TABLE(defs) msg_argc_table<msg_argc_count(defs)>(defs, QMM_MAX_VMMAIN_ARGS)
+
+// Number of args a function pointer type takes (-1 if it takes varargs or isn't a plain function pointer)
+template <typename T>
+struct api_func_argc {
+    static constexpr int value = -1;
+};
+template <typename R, typename... A>
+struct api_func_argc<R(*)(A...)> {
+    static constexpr int value = (int)sizeof...(A);
+};
+
+// Generate MsgArgcDef for a game_import_t function, from its declaration
+#define GEN_IMPORT_ARGC(field, cmd) { cmd, api_func_argc<decltype(game_import_t:: field)>::value }
+// Generate MsgArgcDef for a game_export_t function, from its declaration
+#define GEN_EXPORT_ARGC(field, cmd) { cmd, api_func_argc<decltype(game_export_t:: field)>::value }
 
 // ----------------------------
 // ----- GetGameAPI stuff -----
@@ -321,7 +496,7 @@ constexpr int QMM_MAX_SYSCALL_ARGS = 18;
 #define FLOAT_CAST	horrible_cast<float>
 
 // Handle calls from QMM and plugins into the engine
-#define ROUTE_IMPORT(field, cmd)		case cmd: ret = ((eng_syscall)(orig_import. field))(QMM_PUT_SYSCALL_ARGS()); break
+#define ROUTE_IMPORT(field, cmd)		case cmd: ret = api_call_args((eng_syscall)(orig_import. field), args, argc); break
 // Handle accessing an engine-exported variable
 #define ROUTE_IMPORT_VAR(field, cmd)	case cmd: ret = (intptr_t)&(orig_import. field); break
 // Handle X specific arg type (for passing float args in the right registers), void return type
@@ -356,7 +531,7 @@ constexpr int QMM_MAX_SYSCALL_ARGS = 18;
 #define ROUTE_IMPORT_4_F(field, cmd, type0, type1, type2, type3) case cmd: fret = orig_import. field((type0)(args[0]), (type1)(args[1]), (type2)(args[2]), (type3)(args[3])); ret = *(int*)&fret; break
 
 // Handle calls from QMM and plugins into the mod
-#define ROUTE_EXPORT(field, cmd)		case cmd: ret = ((mod_vmMain)(orig_export-> field))(QMM_PUT_VMMAIN_ARGS()); break
+#define ROUTE_EXPORT(field, cmd)		case cmd: ret = api_call_args((mod_vmMain)(orig_export-> field), args, argc); break
 // Handle accessing a mod-exported variable
 #define ROUTE_EXPORT_VAR(field, cmd)	case cmd: ret = (intptr_t)&(orig_export-> field); break
 // Handle X specific arg type (for passing float args in the right registers), void return type
@@ -406,19 +581,93 @@ constexpr int QMM_MAX_SYSCALL_ARGS = 18;
 #define  GEN_EXPORT_8(field, cmd, typeret, type0, type1, type2, type3, type4, type5, type6, type7) +[](type0 arg0, type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6, type7 arg7) -> typeret { cgameinfo.is_from_QMM = true; return (typeret)::vmMain(cmd, arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7); }
 #define  GEN_EXPORT_9(field, cmd, typeret, type0, type1, type2, type3, type4, type5, type6, type7, type8) +[](type0 arg0, type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6, type7 arg7, type8 arg8) -> typeret { cgameinfo.is_from_QMM = true; return (typeret)::vmMain(cmd, arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8); }
 
+/**
+* @brief Point an import/export slot at the original function, or at QMM's routing lambda.
+*
+* @param slot Slot in qmm_import/qmm_export
+* @param orig Original engine/mod function (may be null)
+* @param routed QMM's routing lambda for this slot
+* @param passthrough true to bypass QMM for this slot
+* @return 1 if the slot now bypasses QMM, 0 otherwise
+*/
+inline int api_passthrough(void** slot, void* orig, void* routed, bool passthrough) {
+    passthrough = passthrough && orig;
+    *slot = passthrough ? orig : routed;
+    return passthrough;
+}
+
+// Point a qmm_import slot straight at the engine function if no plugin hooks it (needs routed_import, a copy of the
+// original qmm_import, and plugin.hpp)
+#define PASSTHROUGH_IMPORT(field, cmd)  count += api_passthrough((void**)&qmm_import. field, (void*)orig_import. field, (void*)routed_import. field, enabled && !plugins_hook_syscall(cmd))
+// Point a qmm_export slot straight at the mod function if no plugin hooks it (needs routed_export, a copy of the
+// original qmm_export, and plugin.hpp)
+#define PASSTHROUGH_EXPORT(field, cmd)  count += api_passthrough((void**)&qmm_export. field, orig_export ? (void*)orig_export-> field : nullptr, (void*)routed_export. field, enabled && !plugins_hook_vmmain(cmd))
+
 // ---------------------
 // ----- QVM stuff -----
 // ---------------------
 
-// These macros handle qvm syscall arguments in GAME_QVMSyscall functions in game_*.cpp
-
-// This gets the n'th argument value (evaluate to an intptr_t)
-#define VMARG(n)	(intptr_t)args[n]
+// Entry in a game's list of QVM syscalls. argtypes has a character for each arg: 'i' (int), 'f' (float), or 'p'
+// (pointer into the QVM data segment). Ints and floats are both passed through unchanged. If the args are not known,
+// argtypes is "?": QVMs call it like ( void ), but DLL mods still get every arg unpacked. Pure functions can also name
+// a qvm_intrinsic that does the same thing as the engine
+struct QVMSyscallDef {
+    int cmd;
+    const char* argtypes;
+    QVMSyscallRet ret = QVM_RET_VALUE;
+    qvm_intrinsic intrinsic = QVM_INTRINSIC_NONE;
+};
 
-// This adds the base VM address pointer to the n'th argument value (evaluate to a pointer)
-#define VMPTR(n)	(args[n] ? membase + args[n] : nullptr)
+// Table of QVM syscall descriptors indexed by engine message, built at compile time from a list of QVMSyscallDef
+template <int N>
+struct QVMSyscallTable {
+    static constexpr int count = N;
+    QVMSyscallDesc descs[N] = {};
+};
 
-// This subtracts the base VM address pointer from given pointer value (for returning a pointer from syscall, evaluate to an int)
-#define VMRET(ptr)	(int)(ptr ? (intptr_t)ptr - (intptr_t)membase : 0)
+// Get the number of entries needed for a QVM syscall table (highest engine message + 1)
+template <size_t N>
+constexpr int qvm_syscall_count(const QVMSyscallDef (&defs)[N]) {
+    int count = 0;
+    for (size_t i = 0; i < N; i++) {
+        if (defs[i].cmd >= count)
+            count = defs[i].cmd + 1;
+    }
+    return count;
+}
+
+// Build a QVM syscall table from a list of QVMSyscallDef. An invalid list (duplicate message, unknown arg type, too
+// many args) is not a constant expression, so it fails to compile
+template <int Count, size_t N>
+constexpr QVMSyscallTable<Count> qvm_syscall_table(const QVMSyscallDef (&defs)[N]) {
+    QVMSyscallTable<Count> table;
+    for (size_t i = 0; i < N; i++) {
+        QVMSyscallDesc& desc = table.descs[defs[i].cmd];
+        if (desc.valid)
+            throw "duplicate QVM syscall";
+        desc.valid = true;
+        desc.ret = defs[i].ret;
+        desc.intrinsic = defs[i].intrinsic;
+        if (defs[i].argtypes[0] == '?') {
+            if (defs[i].argtypes[1])
+                throw "invalid QVM syscall arg type";
+            desc.exactargs = false;
+            continue;
+        }
+        for (const char* type = defs[i].argtypes; *type; type++) {
+            if (desc.numargs >= QMM_MAX_SYSCALL_ARGS)
+                throw "too many QVM syscall args";
+            if (*type == 'p')
+                desc.ptrargs |= 1u << desc.numargs;
+            else if (*type != 'i' && *type != 'f')
+                throw "invalid QVM syscall arg type";
+            desc.numargs++;
+        }
+    }
+    return table;
+}
+
+// Generate QVM syscall table from a list of QVMSyscallDef (used in game_XYZ.cpp)
+#define GEN_QVM_SYSCALL_TABLE(defs) qvm_syscall_table<qvm_syscall_count(defs)>(defs)
 
 #endif // QMM2_GAMEAPI_HPP
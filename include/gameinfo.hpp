@@ -80,20 +80,35 @@ struct GameInfo {
     */
     bool LoadPlugin(std::string plugin_path);
 
+    /**
+    * @brief Let the game support code point import/export slots straight at the engine/mod for messages no plugin
+    * hooks.
+    */
+    void UpdatePassthroughs();
+
     /**
     * @brief Route syscall or vmMain calls to plugins and destination.
     *
     * @param is_syscall true if the call is for syscall, false for vmMain
     * @param cmd Function value to send
     * @param args Function arguments to send
+    * @param argc Number of entries in args
     * @return return value of call
     */
-    intptr_t Route(bool is_syscall, intptr_t cmd, intptr_t* args) const;
+    intptr_t Route(bool is_syscall, intptr_t cmd, intptr_t* args, int argc) const;
+
+    /**
+    * @brief Check if a Route call is in progress (plugin hooks are being called).
+    *
+    * @return true if a message is being routed, false otherwise
+    */
+    bool IsRouting() const;
 
     static intptr_t msg_G_PRINT;                // Value of G_PRINT for the detected game
     static intptr_t msg_GAME_INIT;              // Value of GAME_INIT for the detected game
     static intptr_t msg_GAME_CONSOLE_COMMAND;   // Value of GAME_CONSOLE_COMMAND for the detected game
     static intptr_t msg_GAME_SHUTDOWN;          // Value of GAME_SHUTDOWN for the detected game
+    static intptr_t msg_GAME_RUN_FRAME;         // Value of GAME_RUN_FRAME for the detected game
 };
 
 // Currently-loaded game & game engine info.
@@ -108,6 +108,18 @@ C_DLLEXPORT void* GetCGameAPI(void* import);
 */
 C_DLLEXPORT intptr_t vmMain(intptr_t cmd, ...);
 
+/**
+* @brief Handle and route a vmMain call with an already-built argument array to plugins and to the mod.
+*
+* This is the body of vmMain, after it has pulled the args this message takes out of varargs.
+*
+* @param cmd Mod function to perform
+* @param args Array of cmd-specific arguments
+* @param argc Number of entries in args
+* @return Return value of mod call
+*/
+intptr_t qmm_vmMain_args(intptr_t cmd, intptr_t* args, int argc);
+
 /**
 * @brief Entry point: mod->qmm
 *
@@ -124,6 +136,19 @@ C_DLLEXPORT intptr_t vmMain(intptr_t cmd, ...);
 */
 intptr_t qmm_syscall(intptr_t cmd, ...);
 
+/**
+* @brief Route a syscall with an already-built argument array to plugins and to the engine.
+*
+* This is the body of qmm_syscall, used directly by callers that already have the arguments in an array (like QVM
+* syscalls) to skip repacking them through varargs.
+*
+* @param cmd Engine function to perform
+* @param args Array of cmd-specific arguments
+* @param argc Number of entries in args
+* @return Return value of engine call
+*/
+intptr_t qmm_syscall_args(intptr_t cmd, intptr_t* args, int argc);
+
 /**
 * @brief Fill "buf" with a given argument.
 *
@@ -13,6 +13,7 @@ Created By:
 #define QMM2_MOD_HPP
 
 #include <string>
+#include <map>
 #include "gameapi.hpp"
 #include "qvm.h"
 
@@ -22,6 +23,11 @@ struct Mod {
     void* dll = nullptr;			// OS DLL handle
     std::string path;				// Mod file path
     APIType api = QMM_API_ERROR;	// API the mod DLL was loaded with
+    std::map<int, std::string> qvmsymbols;	// QVM function names by instruction index, from the mod's .map file
+    const QVMSyscallDesc* qvmsyscalls = nullptr;	// Game's QVM syscall descriptors, indexed by engine message
+    int numqvmsyscalls = 0;			// Number of QVM syscall descriptors
+    std::map<int, qvm_snap> qvmsnapshots;	// QVM memory snapshots taken by plugins, by snapshot ID
+    int nextqvmsnapshot = 1;		// Next QVM snapshot ID to hand out
 
     Mod();
     ~Mod();
@@ -43,6 +49,42 @@ struct Mod {
     * @brief Unload mod file
     */
     void Unload();
+
+    /**
+    * @brief Get the name of a QVM function
+    *
+    * @param instruction Instruction index of the function's QVM_OP_ENTER
+    * @return Function name from the mod's .map file, or "func_<instruction>" if unknown
+    */
+    std::string QVMFunctionName(int instruction);
+
+    /**
+    * @brief Let the QVM run its own native implementations of pure syscalls (like memcpy and sin) that no plugin hooks,
+    * and clear them for syscalls that a plugin does hook. Call again whenever the set of hooked syscalls changes
+    */
+    void UpdateQVMIntrinsics();
+
+    /**
+    * @brief Take a snapshot of QVM memory (see qvm_snapshot). Snapshots are freed when the mod is unloaded
+    *
+    * @return Snapshot ID, or 0 if the mod is not a QVM, is running, or the snapshot failed
+    */
+    int QVMSnapshot();
+
+    /**
+    * @brief Restore QVM memory from a snapshot (see qvm_restore)
+    *
+    * @param id Snapshot ID from QVMSnapshot
+    * @return true if restore was successful, false otherwise
+    */
+    bool QVMRestore(int id);
+
+    /**
+    * @brief Free a QVM snapshot
+    *
+    * @param id Snapshot ID from QVMSnapshot
+    */
+    void QVMSnapshotFree(int id);
 private:
     // Entry point into QVM mods. Passed to GameSupport::Entry
     static intptr_t QVM_vmMain(intptr_t cmd, ...);
@@ -16,6 +16,7 @@ Created By:
 #include <map>
 #include <string>
 #include "qmmapi.h"
+#include "stats.hpp"
 
 // A QMM plugin
 struct Plugin {
@@ -31,6 +32,8 @@ struct Plugin {
     using plugin_pluginmessage = void (*)(plugin_id from_plid, const char* message, void* buf, intptr_t buflen, int is_broadcast);
     // QMM_QVMHandler signature
     using plugin_qvmhandler = int (*)(int cmd, int* args);
+    // QMM_vmMain_Batch signature
+    using plugin_batch = void (*)(const plugin_batch_event* events, intptr_t numevents);
 
     void* dll = nullptr;                                // Plugin DLL handle
     std::string path;                                   // Plugin path
@@ -43,7 +46,14 @@ struct Plugin {
     plugin_callback QMM_syscall_Post = nullptr;         // QMM_syscall_Post function pointer
     plugin_pluginmessage QMM_PluginMessage = nullptr;   // QMM_PluginMessage function pointer (optional)
     plugin_qvmhandler QMM_QVMHandler = nullptr;         // QMM_QVMHandler function pointer (optional)
+    plugin_batch QMM_vmMain_Batch = nullptr;            // QMM_vmMain_Batch function pointer (optional)
     plugin_info* plugininfo = nullptr;                  // Plugin-provided info
+    std::vector<uint8_t> syscall_hooks;                 // QMM_HOOK_* flags for each syscall message (if subscribed)
+    std::vector<uint8_t> vmmain_hooks;                  // QMM_HOOK_* flags for each vmMain message (if subscribed)
+    bool syscall_subscribed = false;                    // Only call syscall hooks for messages in syscall_hooks
+    bool vmmain_subscribed = false;                     // Only call vmMain hooks for messages in vmmain_hooks
+    std::vector<plugin_batch_event> batch_events;       // vmMain messages waiting for the next QMM_vmMain_Batch call
+    StatsTable stats;                                   // Routing statistics for this plugin's hooks
 
     Plugin();
     ~Plugin();
@@ -90,6 +100,61 @@ extern plugin_globals g_plugin_globals;
 // List of QMM plugins
 extern std::vector<Plugin> g_plugins;
 
+/**
+* @brief Check if any loaded plugin would see an engine syscall routed through QMM
+*
+* @param cmd Engine message
+* @return true if a plugin's QMM_syscall or QMM_syscall_Post would be called for this message
+*/
+bool plugins_hook_syscall(intptr_t cmd);
+
+/**
+* @brief Check if any loaded plugin would see a mod vmMain message routed through QMM
+*
+* @param cmd Mod message
+* @return true if a plugin's QMM_vmMain or QMM_vmMain_Post would be called for this message
+*/
+bool plugins_hook_vmmain(intptr_t cmd);
+
+/**
+* @brief Rebuild the per-message hook lists if plugins were added or removed or a plugin changed its subscriptions.
+* Must not be called while iterating over a list returned by plugins_hooks.
+*
+*/
+void plugins_update_hooks();
+
+/**
+* @brief Get the plugins whose hooks should be called for a message, in load order
+*
+* @param is_syscall true for syscall hooks, false for vmMain hooks
+* @param cmd Message
+* @param post true for post-hooks, false for pre-hooks
+* @return List of plugins
+*/
+const std::vector<Plugin*>& plugins_hooks(bool is_syscall, intptr_t cmd, bool post);
+
+/**
+* @brief Buffer a routed vmMain message for plugins that subscribed to it with QMM_HOOK_BATCH
+*
+* @param cmd Mod message
+* @param args Mod arguments
+* @param argc Number of entries in args
+* @param ret Final return value of the call
+*/
+void plugins_batch_add(intptr_t cmd, const intptr_t* args, int argc, intptr_t ret);
+
+/**
+* @brief Pass each plugin's buffered vmMain messages to its QMM_vmMain_Batch function
+*
+*/
+void plugins_batch_deliver();
+
+// Highest message a plugin can subscribe to (plugins that haven't subscribed still see every message)
+constexpr intptr_t QMM_MAX_HOOK_CMD = 4095;
+
+// Most vmMain messages buffered for a plugin before they are delivered without waiting for the end of the frame
+constexpr size_t QMM_MAX_BATCH_EVENTS = 4096;
+
 constexpr int QMM_QVM_FUNC_STARTING_ID = 10000;
 // This holds pseudo-syscall IDs. They are registered to a given plugin, and when the QVM interpreter executes the
 // syscall ID, the plugin's QMM_QVMHandler function is called.
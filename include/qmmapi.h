@@ -42,7 +42,7 @@ typedef void* (*mod_GetGameAPI)(void*, void*);
 // major interface version increases with change to the signature of QMM_Query, QMM_Attach, QMM_Detach, plugin_func, or plugin_info
 #define QMM_PIFV_MAJOR  4
 // minor interface version increases with trailing addition to plugin_func or plugin_info structs
-#define QMM_PIFV_MINOR  3
+#define QMM_PIFV_MINOR  6
 // 2:0
 // - removed canpause, loadcmd, unloadcmd from plugininfo_t
 // - renamed old pause/cmd args to QMM_ functions (iscmd, etc) to "reserved"
@@ -73,6 +73,13 @@ typedef void* (*mod_GetGameAPI)(void*, void*);
 // - added QMM_MODDIR
 // 4:4
 // - swapped order of severity and text in QMM_WRITEQMMLOG and also made it vararg. string construction is ignored if log won't write
+// - added QMM_QVM_SNAPSHOT, QMM_QVM_RESTORE, and QMM_QVM_SNAPSHOT_FREE
+// 4:5
+// - added QMM_SUBSCRIBE_SYSCALL and QMM_SUBSCRIBE_VMMAIN. once a plugin subscribes to any syscall (or vmMain) message,
+//   its syscall (or vmMain) hooks are only called for the messages it subscribed to
+// 4:6
+// - added QMM_HOOK_BATCH and optional QMM_vmMain_Batch callback function to receive subscribed vmMain messages in one
+//   call per frame
 
 // holds plugin info to pass back to QMM
 typedef struct {
@@ -120,6 +127,21 @@ typedef enum {
 #define QMM_RET_OVERRIDE(ret)	QMM_RETURN(QMM_OVERRIDE, (ret))         // this plugin has overridden the return value, and return "ret"
 #define QMM_RET_SUPERCEDE(ret)	QMM_RETURN(QMM_SUPERCEDE, (ret))        // this plugin has overridden the return value AND wants the original function to not be called, and return "ret"
 
+// hook flags for QMM_SUBSCRIBE_SYSCALL and QMM_SUBSCRIBE_VMMAIN
+#define QMM_HOOK_PRE    1   // call QMM_syscall/QMM_vmMain for this message
+#define QMM_HOOK_POST   2   // call QMM_syscall_Post/QMM_vmMain_Post for this message
+#define QMM_HOOK_BATCH  4   // add this vmMain message to the next QMM_vmMain_Batch call (requires QMM_vmMain_Batch)
+
+// number of arguments stored in a plugin_batch_event
+#define QMM_BATCH_ARGS  4
+
+// a vmMain message buffered for QMM_vmMain_Batch. pointer arguments are not valid after the original call
+typedef struct {
+    intptr_t cmd;                       // vmMain message
+    intptr_t args[QMM_BATCH_ARGS];      // first QMM_BATCH_ARGS arguments (e.g. clientNum)
+    intptr_t ret;                       // final return value passed back to the engine
+} plugin_batch_event;
+
 // prototype struct for QMM plugin util funcs
 typedef struct {
     void (*pfnWriteQMMLog)(plugin_id plid, int severity, const char* fmt, ...);                               // write to the QMM log
@@ -145,6 +167,10 @@ typedef struct {
     const char* (*pfnArgv2)(plugin_id plid, intptr_t argn);                                                   // same as pfnArgv except returns value
     const char* (*pfnGetConfigString2)(plugin_id plid, intptr_t index);                                       // same as pfnGetConfigString except returns value
     const char* (*pfnModDir)(plugin_id plid);                                                                 // return loaded mod directory
+    int (*pfnQVMSnapshot)(plugin_id plid);                                                                    // take a snapshot of QVM mod memory, returns snapshot ID (0 if unsuccessful)
+    int (*pfnQVMRestore)(plugin_id plid, int snapid);                                                         // restore QVM mod memory from a snapshot (0 if unsuccessful)
+    void (*pfnQVMSnapshotFree)(plugin_id plid, int snapid);                                                   // free a QVM snapshot
+    int (*pfnSubscribe)(plugin_id plid, int is_syscall, intptr_t cmd, int hooks);                             // set which hooks (QMM_HOOK_*) are called for a message (0 if unsuccessful)
 } plugin_funcs;
 
 // macros for QMM plugin util funcs
@@ -171,6 +197,11 @@ typedef struct {
 #define QMM_ARGV2(argn)                         (g_pluginfuncs->pfnArgv2)(PLID, argn)                           // same as QMM_ARGV except returns value
 #define QMM_GETCONFIGSTRING2(index)             (g_pluginfuncs->pfnGetConfigString2)(PLID, index)               // same as QMM_GETCONFIGSTRING except returns value
 #define QMM_MODDIR(index)                       (g_pluginfuncs->pfnModDir)(PLID)                                // return loaded mod directory
+#define QMM_QVM_SNAPSHOT()                      (g_pluginfuncs->pfnQVMSnapshot)(PLID)                           // take a snapshot of QVM mod memory, returns snapshot ID (0 if unsuccessful)
+#define QMM_QVM_RESTORE(snapid)                 (g_pluginfuncs->pfnQVMRestore)(PLID, snapid)                    // restore QVM mod memory from a snapshot (0 if unsuccessful)
+#define QMM_QVM_SNAPSHOT_FREE(snapid)           (g_pluginfuncs->pfnQVMSnapshotFree)(PLID, snapid)               // free a QVM snapshot
+#define QMM_SUBSCRIBE_SYSCALL(cmd, hooks)       (g_pluginfuncs->pfnSubscribe)(PLID, 1, cmd, hooks)              // set which hooks (QMM_HOOK_*) are called for a syscall message (0 if unsuccessful)
+#define QMM_SUBSCRIBE_VMMAIN(cmd, hooks)        (g_pluginfuncs->pfnSubscribe)(PLID, 0, cmd, hooks)              // set which hooks (QMM_HOOK_*) are called for a vmMain message (0 if unsuccessful)
 
 // struct of vars for QMM plugin utils
 typedef struct {
@@ -220,6 +251,7 @@ C_DLLEXPORT intptr_t QMM_syscall(intptr_t cmd, intptr_t* args);
 C_DLLEXPORT intptr_t QMM_syscall_Post(intptr_t cmd, intptr_t* args);
 C_DLLEXPORT void QMM_PluginMessage(plugin_id from_plid, const char* message, void* buf, intptr_t buflen, int is_broadcast);
 C_DLLEXPORT int QMM_QVMHandler(int func, int* args);
+C_DLLEXPORT void QMM_vmMain_Batch(const plugin_batch_event* events, intptr_t numevents);
 
 // Some helpful macros assuming you've stored entity/client info in G_LOCATE_GAME_DATA
 #define ENT_FROM_NUM(index)     ((gentity_t*)((unsigned char*)g_gents + g_gentsize * (index)))                  // get a gentity_t* by entity number (check g_gents for NULL first)
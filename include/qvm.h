@@ -15,22 +15,66 @@ Created By:
 #include <stdint.h>     // intptr_t and uint8_t
 #include <stddef.h>     // ptrdiff_t and size_t
 
+// The guarded allocator needs a 64-bit address space (to reserve guard regions) and POSIX signals
+#if !defined(_WIN32) && UINTPTR_MAX > 0xFFFFFFFFu
+#define QVM_GUARDED_SUPPORTED
+#include <setjmp.h>     // sigjmp_buf
+#endif
+
+// Snapshots can keep their copy of VM memory in a memfd and map it copy-on-write over the VM's memory (with an allocator
+// that has QVM_ALLOC_MAPPED). Otherwise they are plain copies
+#if defined(__linux__)
+#define QVM_SNAPSHOT_COW
+#endif
+
+// VM memory can be backed by huge pages (hugetlbfs or transparent huge pages) to cut TLB misses
+#if defined(__linux__)
+#define QVM_HUGEPAGE_SUPPORTED
+#endif
+
+// Decoded code can be saved to a cache file and mapped back in with mmap on later loads (see qvm_load_ex)
+#if !defined(_WIN32)
+#define QVM_CACHE_SUPPORTED
+#endif
+
 // Magic number is stored in file as 44 14 72 12
 #define QVM_MAGIC                       0x12721444
 
 // Magic number is stored in file as 45 14 72 12
-// QVM version 2: ioQuake3 added a new version of QVM with jump targets for JIT optimization.
-// There is no difference if interpreted, and extra header field can be ignored.
+// QVM version 2: ioQuake3 added a new version of QVM with a table of jump targets (see qvm_header_v2). It is used to
+// only allow QVM_OP_JUMP to known jump targets, and to tell the verifier which instructions can be jumped to.
 #define QVM_MAGIC_VER2                  0x12721445
 
 // Amount of operands the opstack can hold (same amount used by Q3 engine)
 #define QVM_OPSTACK_SIZE                1024
 // Max size of program stack (this is set by q3asm for ALL QVM-compatible games) (64KiB)
 #define QVM_PROGRAMSTACK_SIZE           0x10000
+// Size of inaccessible guard regions on each side of the data segment with the guarded allocator (4 GiB). Any 32-bit
+// data offset (plus a 4-byte access) from the data segment either lands inside it or in a guard region and faults
+#define QVM_GUARD_SIZE                  0x100000000ull
+// Pass as stack_size to qvm_load_ex() to size the program stack from call graph analysis
+#define QVM_STACK_AUTO                  ((size_t)-1)
 // Default size of temporary hunk segment (ioRTCW defaults to 2 MiB) (1MiB)
 #define QVM_HUNK_SIZE                   0x100000
-// Alignment of hunk in bytes
+// Number of syscall arguments saved in each flight recorder entry
+#define QVM_TRACE_ARGS                  5
+// Magic number of a crash dump file from qvm_dump() ("QVMD")
+#define QVM_DUMP_MAGIC                  0x444D5651
+// Version of the crash dump file format
+#define QVM_DUMP_VERSION                1
+// Size of a huge page, and the alignment and size granularity of the huge page allocator (2 MiB)
+#define QVM_HUGEPAGE_SIZE               0x200000
+// Alignment of hunk in bytes (also the size of a hunk allocator granule)
 #define QVM_HUNK_ALIGNMENT              8
+// Version of the decoded code cache file format. Part of the cache key, so changing the decoder, verifier, or fusion
+// invalidates cached files
+#define QVM_CACHE_VERSION               3
+
+// Use direct-threaded (computed goto) dispatch in the interpreter if the compiler supports labels-as-values.
+// Define QVM_NO_COMPUTED_GOTO to build the portable switch-based dispatch loop instead.
+#if !defined(QVM_NO_COMPUTED_GOTO) && defined(__GNUC__)
+#define QVM_COMPUTED_GOTO
+#endif
 
 // Round "var" up to next power of 2: https://stackoverflow.com/a/1322548/809900
 #define QVM_NEXT_POW_2(var) var--; var |= var >> 1; var |= var >> 2; var |= var >> 4; var |= var >> 8; var |= var >> 16; var++
@@ -45,9 +89,36 @@ Created By:
 // Push "v" to opstack
 #define QVM_PUSH(v) --opstack; opstack[0] = (v)
 
+// Verify program stack and opstack pointers are inside their blocks
+// using > to allow starting at 1 past the end of block
+#define QVM_CHECK_STACKS() \
+    if (programstack <= stacklow || programstack > stackhigh) goto programstack_overflow; \
+    if (opstack <= opstacklow || opstack > opstackhigh) goto opstack_overflow
+
+// Can execution continue at instruction index "i" without per-instruction stack checks? True if the instruction's
+// function passed load-time verification and the opstack has room for everything the function can push or pop from i.
+// Always false while profiling, since instructions are counted with the per-instruction stack checks
+#define QVM_VERIFIED(i) \
+    (!prof && verifyinfo[i].depth >= 0 && opstack + verifyinfo[i].depth <= opstackhigh && opstack - verifyinfo[i].room > opstacklow)
+
+#ifdef QVM_COMPUTED_GOTO
+// Label for an opcode's handler in the interpreter
+#define QVM_CASE(o) qvm_handler_##o
+// Finish the current instruction: verify stacks (if needed) and jump straight to the next instruction's handler
+#define QVM_NEXT() do { if (checked) { QVM_CHECK_STACKS(); profcount++; } param = opptr->param; goto *dispatch[opptr++ - codesegment]; } while (0)
+#else
+// Label for an opcode's handler in the interpreter
+#define QVM_CASE(o) case QVM_OP_##o
+// Finish the current instruction
+#define QVM_NEXT() break
+#endif
+
 // Move instruction pointer to a given index, masked to code segment
 #define QVM_JUMP(x) opptr = codesegment + ((x) & codemask)
 
+// Is instruction index "i" set in a jump target bitmap?
+#define QVM_JUMPTARGET(bitmap, i) (((bitmap)[(i) >> 3] >> ((i) & 7)) & 1)
+
 // Conditional branches
 
 // Conditional branch to param; compare top 2 opstack operands as signed integers
@@ -56,6 +127,8 @@ Created By:
 #define QVM_JUMP_UIF(o) if (*(unsigned int*)&opstack[1] o *(unsigned int*)&opstack[0]) { QVM_JUMP(param); } QVM_POPN(2)
 // Conditional branch to param; compare top 2 opstack operands as floats
 #define QVM_JUMP_FIF(o) if (*(float*)&opstack[1] o *(float*)&opstack[0]) { QVM_JUMP(param); } QVM_POPN(2)
+// Conditional branch to next instruction's param; compare opstack[0] and param as signed integers (fused QVM_OP_CONST)
+#define QVM_CONST_JUMP_SIF(o) if (opstack[0] o param) { QVM_JUMP(opptr->param); } else { opptr++; } QVM_POP()
 
 // Math operations
 
@@ -73,6 +146,25 @@ Created By:
 // Type of pointer to function that receives syscalls (engine traps) out of VM
 typedef int (*qvm_syscall)(uint8_t* membase, int cmd, int* args);
 
+// Native implementations of pure syscalls that the VM can run itself instead of calling qvm_syscall (see
+// qvm_set_intrinsic). Pointer args are VM data segment offsets, and floats are passed and returned as their bits
+typedef enum {
+    QVM_INTRINSIC_NONE,             // Not an intrinsic, call qvm_syscall
+    QVM_INTRINSIC_MEMSET,           // (void* dest, int c, size_t count), returns dest
+    QVM_INTRINSIC_MEMCPY,           // (void* dest, const void* src, size_t count), returns dest
+    QVM_INTRINSIC_STRNCPY,          // (char* dest, const char* src, size_t count), returns dest
+    QVM_INTRINSIC_SIN,              // (float x)
+    QVM_INTRINSIC_COS,              // (float x)
+    QVM_INTRINSIC_SQRT,             // (float x)
+    QVM_INTRINSIC_ATAN2,            // (float y, float x)
+    QVM_INTRINSIC_FLOOR,            // (float x)
+    QVM_INTRINSIC_CEIL,             // (float x)
+    QVM_INTRINSIC_MATRIXMULTIPLY,   // (float in1[3][3], float in2[3][3], float out[3][3])
+    QVM_INTRINSIC_ANGLEVECTORS,     // (const vec3_t angles, vec3_t forward, vec3_t right, vec3_t up), outputs can be NULL
+
+    QVM_INTRINSIC_NUM,              // Number of intrinsics
+} qvm_intrinsic;
+
 // QVM instructions
 typedef enum {
     QVM_OP_UNDEF,       // Undefined (error)
@@ -148,6 +240,89 @@ typedef struct {
     int param;                  // Immediate
 } qvm_op;
 
+// Load-time verifier results for a single instruction
+typedef struct {
+    int16_t depth;              // Opstack depth before this instruction, relative to function entry (-1 if unverified)
+    int16_t room;               // Max number of values the function can push past depth
+} qvm_verifyinfo;
+
+// Opstack for a single execution. Re-entrant executions (started from a syscall) each use the next segment
+typedef struct qvm_opstack_segment {
+    struct qvm_opstack_segment* prev;   // Segment of the outer execution
+    struct qvm_opstack_segment* next;   // Segment of the next re-entrant execution, once allocated
+    int* opstack;                       // Opstack pointer saved while this segment's execution is in a syscall
+    int data[QVM_OPSTACK_SIZE + 2];     // Opstack values (+2 for some extra space to "harmlessly" read 2 values if empty)
+} qvm_opstack_segment;
+
+// Profiler counters for a single function in a single call stack
+typedef struct {
+    int func;                   // Instruction index of the function's QVM_OP_ENTER (-1 for the root node)
+    int parent;                 // Node of the calling function (-1 for the root node)
+    int child;                  // First node of a function called from this one (-1 if none)
+    int sibling;                // Next node with the same parent (-1 if none)
+    uint64_t calls;             // Number of calls
+    uint64_t instructions;      // Number of instructions run in this function (a superinstruction counts once)
+    uint64_t time;              // Nanoseconds spent in this function (including syscalls), not counting VM functions it called
+} qvm_prof_node;
+
+// Function-level profiler data, from qvm_prof_start(). Nodes form a tree of every call stack seen while profiling
+typedef struct {
+    qvm_prof_node* nodes;       // Call stack nodes. Node 0 is the root, outside of any VM function
+    size_t numnodes;            // Number of nodes in use
+    size_t maxnodes;            // Number of nodes allocated
+    int node;                   // Node of the running function
+    uint64_t lasttime;          // Time of the last function entry or exit, in nanoseconds
+    int active;                 // Executions are being profiled
+} qvm_prof;
+
+// Kind of flight recorder event
+typedef enum {
+    QVM_TRACE_CALL,             // Entered the VM function whose QVM_OP_ENTER is at instruction
+    QVM_TRACE_RETURN,           // Returned from a VM function to instruction
+    QVM_TRACE_JUMP,             // Jumped to instruction with QVM_OP_JUMP
+    QVM_TRACE_SYSCALL,          // Called syscall cmd from the QVM_OP_CALL at instruction (-1 if not known)
+} qvm_trace_type;
+
+// A single flight recorder event
+typedef struct {
+    int type;                   // qvm_trace_type
+    int instruction;            // Instruction index (see qvm_trace_type)
+    int cmd;                    // Syscall number (-target - 1), for QVM_TRACE_SYSCALL
+    int args[QVM_TRACE_ARGS];   // First syscall arguments, for QVM_TRACE_SYSCALL (0 past the top of the program stack)
+} qvm_trace_entry;
+
+// Flight recorder, from qvm_trace_start(). A ring buffer of the most recent calls, returns, jumps, and syscalls
+typedef struct {
+    qvm_trace_entry* entries;   // Ring buffer, the newest entry is entries[(count - 1) & mask]
+    size_t mask;                // Number of entries - 1 (always a power of 2)
+    uint64_t count;             // Number of events recorded since qvm_trace_start()
+} qvm_trace;
+
+// Header of a crash dump file from qvm_dump(). These sections follow the header in order, with no padding:
+// - opstack: int[opstackcount], top first
+// - outer execution opstacks: outercount times, a uint32_t count and then int[count], innermost execution first
+// - flight recorder: qvm_trace_entry[tracecount], oldest first
+// - code segment: qvm_op[codeseglen / sizeof(qvm_op)]
+// - data segment: dataseglen bytes
+typedef struct {
+    uint32_t magic;             // QVM_DUMP_MAGIC
+    uint32_t version;           // QVM_DUMP_VERSION
+    uint32_t headersize;        // sizeof(qvm_dump_header)
+    uint32_t vmmagic;           // Magic number from QVM
+    int64_t time;               // Time of dump, in seconds since the Unix epoch
+    int32_t instruction;        // Instruction index of the current instruction (-1 if unknown)
+    uint32_t instructioncount;  // Number of instructions
+    uint32_t codeseglen;        // Size of code segment
+    uint32_t dataseglen;        // Size of data segment
+    uint32_t stackptr;          // Offset of program stack pointer in data segment
+    uint32_t stackhigh;         // Offset of highest address of program stack in data segment
+    uint32_t opstackcount;      // Number of values on the opstack
+    uint32_t outercount;        // Number of outer executions with saved opstacks
+    uint32_t tracecount;        // Number of flight recorder entries
+    uint32_t reserved;          // 0
+    uint64_t tracetotal;        // Number of events recorded (more than tracecount if older ones were overwritten)
+} qvm_dump_header;
+
 // QVM file header
 typedef struct {
     uint32_t magic;             // Magic number
@@ -158,49 +333,135 @@ typedef struct {
     uint32_t datalen;           // Length of data segment
     uint32_t litlen;            // Length of lit segment
     uint32_t bsslen;            // Length of bss segment
-    // uint32_t jtrglen;        // Length of jump target table in version 2, only used by ioQuake3 for JIT optimization
 } qvm_header;
 
+// QVM version 2 file header. The jump target table is stored right after the lit segment, and holds the instruction
+// index of every code address q3asm put in the data segment (the entries of switch jump tables)
+typedef struct {
+    qvm_header base;            // Version 1 header
+    uint32_t jtrglen;           // Length of jump target table in bytes (4 bytes per entry)
+} qvm_header_v2;
+
+// Allocator flag: allocations are surrounded by QVM_GUARD_SIZE guard regions, and faults in them are caught by
+// qvm_guard_handler. The data segment is not rounded up to a power of 2 and data accesses are not masked
+#define QVM_ALLOC_GUARDED               1
+// Allocator flag: allocations are page-aligned private mappings (made with mmap) that the VM may replace in place with
+// mmap(MAP_FIXED), which lets snapshots be restored copy-on-write instead of copied back
+#define QVM_ALLOC_MAPPED                2
+// Allocator flag: allocations try to use huge pages (see qvm_hugepage_bytes)
+#define QVM_ALLOC_HUGEPAGE              4
+
 // Allocator type for custom allocation
 typedef struct {
     void* (*alloc)(ptrdiff_t size, void* ctx);              // Function to allocate 'size' bytes, given 'ctx' context pointer
     void  (*free)(void* ptr, ptrdiff_t size, void* ctx);    // Function to free 'size' bytes existing at 'ptr', given 'ctx' context pointer
     void* ctx;                                              // Context pointer
+    int flags;                                              // QVM_ALLOC_* flags
 } qvm_alloc;
 
 // Default VM allocator (uses malloc/free)
 extern qvm_alloc qvm_allocator_default;
 
-// All the info for a single QVM object
+#ifdef QVM_SNAPSHOT_COW
+// Mapped VM allocator (uses mmap, see QVM_ALLOC_MAPPED)
+extern qvm_alloc qvm_allocator_mapped;
+#endif
+
+#ifdef QVM_HUGEPAGE_SUPPORTED
+// Huge page VM allocator. Tries explicit huge pages (MAP_HUGETLB) first, then a huge page aligned mapping with
+// madvise(MADV_HUGEPAGE) for transparent huge pages, which quietly uses normal pages if the kernel has none to give
+extern qvm_alloc qvm_allocator_hugepage;
+#endif
+
+#ifdef QVM_GUARDED_SUPPORTED
+// Guarded VM allocator (uses mmap with guard regions, see QVM_ALLOC_GUARDED)
+extern qvm_alloc qvm_allocator_guarded;
+
+// Catches faults in a guarded VM's guard regions while code is running. Used internally by qvm_exec_ex/qvm_jit_exec
+typedef struct qvm_guard {
+    struct qvm_guard* prev;     // Next outer guard on this thread
+    const struct qvm* vm;       // VM being run
+    sigjmp_buf env;             // Where to jump to on a fault
+    void* faultaddr;            // Faulting address
+    void* faultpc;              // Faulting instruction address (if known)
+} qvm_guard;
+#endif
+
+// Saved VM memory and stack/hunk pointers, from qvm_snapshot()
+typedef struct {
+    uint8_t* memory;            // Copy of VM memory (NULL if it is held in fd instead)
+    int fd;                     // memfd holding a copy of VM memory for copy-on-write restores (-1 if not used)
+    size_t memorysize;          // Size of VM memory
+    ptrdiff_t stackptr;         // Offset of program stack pointer in data segment
+    struct qvm_hunk* hunk;      // Copy of hunk allocator state
+} qvm_snap;
+
+// Hunk allocator statistics, from qvm_hunk_stats()
 typedef struct {
+    size_t size;                // Usable size of hunk
+    size_t live;                // Bytes in allocated blocks (after rounding up to QVM_HUNK_ALIGNMENT)
+    size_t peak;                // Highest value of live since the VM was loaded
+    size_t free;                // Bytes in free blocks
+    size_t largestfree;         // Size of the largest free block
+    size_t fragmented;          // Free bytes outside of the largest free block
+    size_t allocs;              // Number of allocated blocks
+} qvm_hunkstats;
+
+// All the info for a single QVM object
+typedef struct qvm {
     uint32_t magic;                 // Magic number from QVM
 
     qvm_syscall syscall;            // Function that will handle syscalls and adjust pointer arguments
 
-    uint8_t* memory;                // Main block of memory
+    uint8_t* memory;                // Main block of memory (the data segment), from the allocator
     size_t memorysize;              // Size of memory block
 
     qvm_op* codesegment;            // Start of code segment, each op is 8 bytes (4 op, 4 param)
+    const void** dispatch;          // Pre-decoded handler address for each op in code segment (computed goto only)
+    qvm_verifyinfo* verifyinfo;     // Verifier results for each op in code segment
+    uint8_t* jumptargets;           // Bitmap of allowed QVM_OP_JUMP targets (version 2 jump targets and constant jumps), or NULL if not a version 2 QVM
+    size_t numjumptargets;          // Number of entries in the version 2 jump target table
+    uint8_t* fusedops;              // Interpreter opcode for each op in code segment, after superinstruction fusion
     uint8_t* datasegment;           // Start of data segment, partially filled on load
 
     size_t instructioncount;        // Number of instructions, from QVM header
     size_t codeseglen;              // Size of code segment in memory
     size_t dataseglen;              // Size of entire data segment in memory
+    size_t datamask;                // Mask applied to data segment offsets (all 1s if data accesses are not masked)
 
     size_t stacksize;               // Size of program stack in bss segment
+    size_t stackneeded;             // Program stack needed by the deepest call path from vmMain, found when loading
+    int stackrecursive;             // Recursive calls are reachable from vmMain, so stackneeded only covers non-recursive paths
+    int stackindirectcycle;         // A call cycle may close through a function pointer call, so stackneeded may be too small
+    int stackanalyzed;              // Stack analysis finished, so stackneeded, stackrecursive, and stackindirectcycle are valid
     int* stacklow;                  // Pointer to lowest address of program stack
     int* stackhigh;                 // Pointer to highest address of program stack
 
     size_t hunksize;                // Size of the hunk
     int hunklow;                    // Offset of lowest address of hunk
     int hunkhigh;                   // Offset of highest address of hunk
+    struct qvm_hunk* hunk;          // Hunk allocator state (kept outside of VM memory so VM code can't corrupt it)
 
     int* stackptr;                  // Pointer to current location in program stack
-    int hunkptr;                    // Offset of current location in hunk
+
+    qvm_opstack_segment* opstacks;  // First opstack segment (allocated on first execution)
+    qvm_opstack_segment* opstackseg; // Opstack segment of the innermost running execution
 
     size_t filesize;                // .qvm file size
     qvm_alloc* allocator;           // Allocator
     int verify_data;                // Verify data access is inside the memory block
+
+    struct qvm_jit* jit;            // Native code from qvm_jit_compile(), or NULL to use the interpreter
+    int execdepth;                  // Number of active (possibly re-entrant) executions
+    int failed;                     // Set when an execution fails, so outer executions abort too
+    qvm_prof* prof;                 // Profiler data from qvm_prof_start(), or NULL if never started
+    struct qvm_aot* aot;            // Native module from qvm_aot_load(), or NULL if not translated
+    uint8_t* intrinsics;            // qvm_intrinsic for each syscall number (-target - 1), or NULL if none are set
+    size_t numintrinsics;           // Number of entries in intrinsics
+    void* cachemap;                 // Mapped cache file that codesegment, verifyinfo, and fusedops point into, or NULL
+    size_t cachemapsize;            // Size of cachemap
+    qvm_trace* trace;               // Flight recorder from qvm_trace_start(), or NULL if not recording
+    char* dumpdir;                  // Directory for crash dumps from qvm_set_dumpdir(), or NULL for the current directory
 } qvm;
 
 #ifdef __cplusplus
@@ -229,6 +490,32 @@ void qvm_init(qvm* vm);
 */
 int qvm_load(qvm* vm, const uint8_t* filemem, size_t filesize, qvm_syscall qvmsyscall, int verify_data, size_t hunk_size, qvm_alloc* allocator);
 
+/**
+* @brief Create and initialize a new VM from a QVM file, using a cache of decoded code.
+*
+* The decoded code segment, verifier results, and superinstruction table only depend on the file contents, so they are
+* saved in cachedir as "qvm_<key>.qvmc", where key is a hash of the .qvm file and QVM_CACHE_VERSION. If the cache file
+* exists, it is mapped read-only with mmap and used in place of decoding the file. Otherwise, the file is decoded as
+* usual and the cache file is written. A missing, stale, or unwritable cache file never makes the load fail.
+*
+* The program stack normally keeps the QVM_PROGRAMSTACK_SIZE that q3asm reserves. Loading always finds how much stack
+* the deepest call path from vmMain needs (stackneeded), and warns if it doesn't fit. With QVM_STACK_AUTO, the stack is
+* sized to fit two of those paths (for a re-entrant vmMain call). The stack is only made smaller than
+* QVM_PROGRAMSTACK_SIZE if the analysis finished and found no recursion, direct or possibly through function pointers.
+*
+* @param vm Pointer to QVM object to store VM information
+* @param filemem Buffer with QVM file contents
+* @param filesize Size of the filemem buffer
+* @param qvmsyscall Function to be called for engine traps
+* @param verify_data Should data segment reads and writes be validated?
+* @param hunk_size Size of hunk in VM data segment
+* @param stack_size Size of program stack (0 for QVM_PROGRAMSTACK_SIZE, or QVM_STACK_AUTO)
+* @param allocator Pointer to a qvm_alloc object which contains custom alloc/free function pointers (pass NULL for default)
+* @param cachedir Directory to store cache files in (must exist), or NULL to not use a cache
+* @return 1 if success, 0 if failure
+*/
+int qvm_load_ex(qvm* vm, const uint8_t* filemem, size_t filesize, qvm_syscall qvmsyscall, int verify_data, size_t hunk_size, size_t stack_size, qvm_alloc* allocator, const char* cachedir);
+
 /**
 * @brief Begin execution in a VM at the start of the code segment.
 *
@@ -260,19 +547,19 @@ void qvm_unload(qvm* vm);
 /**
 * @brief Allocate memory in a VM's hunk.
 * 
+* The hunk uses a two-level segregated fit allocator, so allocating and freeing take constant time.
+* 
 * @param vm Pointer to QVM object to allocate memory in
 * @param size Size of block to allocate
-* @param init Initial data to copy into allocation
-* @return VM-based pointer to allocated block
+* @param init Initial data to copy into allocation (block is zeroed if NULL)
+* @return VM-based pointer to allocated block, or 0 if failed
 */
 int qvm_hunk_alloc(qvm* vm, size_t size, const void* init);
 
 /**
 * @brief Free memory in a VM's hunk.
 * 
-* Since the hunk is stack allocated, you can only truly free a block if it was the most recently allocated block.
-* 
-* This function silently fails if the provided block is not the most recent.
+* Blocks can be freed in any order, and free neighboring blocks are merged.
 * 
 * @param vm Pointer to QVM object to allocate memory in
 * @param ptr VM-based pointer to allocated block
@@ -282,7 +569,107 @@ int qvm_hunk_alloc(qvm* vm, size_t size, const void* init);
 void qvm_hunk_free(qvm* vm, int ptr, size_t size, void* out);
 
 /**
-* @brief Dump VM memory/stacks.
+* @brief Get a VM's hunk usage and fragmentation.
+*
+* @param vm Pointer to QVM object
+* @param stats Pointer to stats object to fill in (all 0 if the VM is not loaded)
+*/
+void qvm_hunk_stats(const qvm* vm, qvm_hunkstats* stats);
+
+/**
+* @brief Save a VM's memory, program stack pointer, and hunk pointer.
+*
+* If the VM's allocator has QVM_ALLOC_MAPPED (and QVM_SNAPSHOT_COW is supported), VM memory is copied into a memfd once
+* and then mapped privately over the VM's memory, so the running VM shares pages with the snapshot until it writes to
+* them, and qvm_restore() only has to map the memfd again. Otherwise (or if mapping over VM memory fails) the snapshot
+* is a plain copy.
+*
+* Only VM memory is saved: engine state (like linked entities) and plugin state are not.
+*
+* @param vm Pointer to loaded QVM object (not running)
+* @param snap Pointer to snapshot object to fill in (free with qvm_snapshot_free)
+* @return 1 if success, 0 if the VM is not loaded, is running, or allocation failed
+*/
+int qvm_snapshot(qvm* vm, qvm_snap* snap);
+
+/**
+* @brief Restore a VM's memory, program stack pointer, and hunk pointer from a snapshot. The memory stays at the same
+* address, so pointers into it (including ones held by the engine) remain valid.
+*
+* @param vm Pointer to loaded QVM object (not running) with the same memory size as when the snapshot was taken
+* @param snap Pointer to snapshot object from qvm_snapshot()
+* @return 1 if success, 0 if failure
+*/
+int qvm_restore(qvm* vm, const qvm_snap* snap);
+
+/**
+* @brief Free a snapshot.
+*
+* @param snap Pointer to snapshot object from qvm_snapshot()
+*/
+void qvm_snapshot_free(qvm_snap* snap);
+
+/**
+* @brief Get how much of a VM's memory is backed by huge pages.
+*
+* On Linux, this reads the VM memory's mapping from /proc/self/smaps, so it reflects what the kernel actually provided
+* (transparent huge pages can be split or never assigned).
+*
+* @param vm Pointer to loaded QVM object
+* @return Number of bytes of VM memory in huge pages (0 if none, or if not supported)
+*/
+size_t qvm_hugepage_bytes(const qvm* vm);
+
+/**
+* @brief Set (or clear with QVM_INTRINSIC_NONE) the native implementation of a syscall.
+*
+* Calls to the syscall are then handled inside the VM without calling qvm_syscall. If a pointer arg (or the memory it
+* covers) is outside the data segment, or a count is negative, the call goes to qvm_syscall as usual.
+*
+* @param vm Pointer to loaded QVM object
+* @param cmd Syscall number (-target - 1)
+* @param intrinsic Intrinsic to run for the syscall
+* @return 1 if success, 0 if failure
+*/
+int qvm_set_intrinsic(qvm* vm, int cmd, qvm_intrinsic intrinsic);
+
+/**
+* @brief Run the intrinsic set for a syscall, if there is one. Used internally before calling qvm_syscall.
+*
+* @param vm Pointer to QVM object
+* @param cmd Syscall number (-target - 1)
+* @param args Syscall arguments
+* @param ret Receives the return value
+* @return 1 if the syscall was handled, 0 if it needs to go to qvm_syscall
+*/
+int qvm_intrinsic_call(qvm* vm, int cmd, int* args, int* ret);
+
+/**
+* @brief Record a syscall in the VM's flight recorder, if it has one. Used by the interpreter, JIT, and native modules.
+*
+* @param vm Pointer to QVM object
+* @param instruction Instruction index of the QVM_OP_CALL (-1 if not known)
+* @param cmd Syscall number (-target - 1)
+* @param args Syscall arguments
+*/
+void qvm_trace_syscall(qvm* vm, int instruction, int cmd, const int* args);
+
+/**
+* @brief Set the directory that qvm_dump() writes crash dumps to. Cleared when the VM is unloaded.
+*
+* @param vm Pointer to loaded QVM object
+* @param dir Directory to write crash dumps in (must exist, and is copied), or NULL or "" for the current directory
+* @return 1 if success, 0 if failure
+*/
+int qvm_set_dumpdir(qvm* vm, const char* dir);
+
+/**
+* @brief Dump VM memory/stacks to a crash dump file.
+*
+* The dump is a single binary file (see qvm_dump_header) named "qvm_dump_<date>-<time>.qvmd" in the directory from
+* qvm_set_dumpdir() (or the current directory if none was set), with a number added to the name if that file already
+* exists. It is written in one go (with writev where available) and can be rendered with the qvmdump tool. If writing
+* fails, the partly written file is deleted.
 * 
 * @param vm Pointer to QVM object
 * @param opstack Current opstack pointer
@@ -291,6 +678,78 @@ void qvm_hunk_free(qvm* vm, int ptr, size_t size, void* out);
 */
 void qvm_dump(qvm* vm, int* opstack, int* opstackhigh, qvm_op* instruction);
 
+/**
+* @brief Start recording a VM's recent calls, returns, jumps, and syscalls, discarding any previous recording. The
+* recording is included in crash dumps from qvm_dump().
+*
+* Calls, returns, and jumps are only recorded by the interpreter. Syscalls are recorded by all execution modes.
+*
+* @param vm Pointer to loaded QVM object
+* @param entries Number of events to keep (rounded up to a power of 2)
+* @return 1 if recording started, 0 if the VM is not loaded, is running, or allocation failed
+*/
+int qvm_trace_start(qvm* vm, size_t entries);
+
+/**
+* @brief Stop recording and free the flight recorder.
+*
+* @param vm Pointer to QVM object
+*/
+void qvm_trace_stop(qvm* vm);
+
+/**
+* @brief Start profiling a VM, discarding any previous profiler data.
+*
+* While profiling, executions always use the interpreter with per-instruction stack checks (even if the VM has been
+* JIT compiled), and instructions and time are counted for each function in each call stack in vm->prof.
+*
+* @param vm Pointer to QVM object
+* @return 1 if profiling started, 0 if the VM is not loaded, is running, or allocation failed
+*/
+int qvm_prof_start(qvm* vm);
+
+/**
+* @brief Stop profiling a VM. Profiler data is kept until the next qvm_prof_start() or the VM is unloaded.
+*
+* @param vm Pointer to QVM object
+*/
+void qvm_prof_stop(qvm* vm);
+
+#ifdef QVM_GUARDED_SUPPORTED
+/**
+* @brief Start catching faults in a guarded VM's guard regions on this thread. Used internally.
+*
+* sigsetjmp(guard->env, 0) must be called first (the fault handler doesn't block SIGSEGV, so the signal mask doesn't
+* need to be saved). If a fault happens, the guard is removed and execution jumps back to sigsetjmp with faultaddr (and
+* faultpc, if known) filled in.
+*
+* @param guard Pointer to guard object
+* @param vm Pointer to QVM object being run
+*/
+void qvm_guard_push(qvm_guard* guard, const qvm* vm);
+
+/**
+* @brief Stop catching faults with a guard. Does nothing if the guard was already removed.
+*
+* @param guard Pointer to guard object
+*/
+void qvm_guard_pop(qvm_guard* guard);
+
+/**
+* @brief Stop catching faults on this thread while a syscall runs engine code. Used internally.
+*
+* @return Guard to pass to qvm_guard_resume() after the syscall
+*/
+qvm_guard* qvm_guard_suspend(void);
+
+/**
+* @brief Resume catching faults after a syscall. Used internally.
+*
+* @param guard Guard returned by qvm_guard_suspend()
+*/
+void qvm_guard_resume(qvm_guard* guard);
+#endif
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
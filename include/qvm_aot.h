@@ -0,0 +1,89 @@
+/*
+QMM2 - Q3 MultiMod 2
+Copyright 2025-2026
+https://github.com/thecybermind/qmm2/
+3-clause BSD license: https://opensource.org/license/bsd-3-clause
+
+Created By:
+    Kevin Masterson < k.m.masterson@gmail.com >
+
+*/
+
+#ifndef QMM2_QVM_AOT_H
+#define QMM2_QVM_AOT_H
+
+#include <stdint.h>     // intptr_t and uint8_t
+#include <stddef.h>     // ptrdiff_t and size_t
+#include "qvm.h"
+
+// Translated modules are built by running the system C compiler and loaded with dlopen, so this is only available on
+// Linux
+#if defined(__linux__)
+#define QVM_AOT_SUPPORTED
+#endif
+
+// Version of the generated C code. Part of the cache key, so changing the translator invalidates cached modules
+#define QVM_AOT_VERSION                 2
+
+// Maximum number of nested VM function calls in translated code (each one uses native stack space)
+#define QVM_AOT_MAX_CALL_DEPTH          0x4000
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+
+/**
+* @brief Load a native module translated from a VM's code segment, translating and compiling it first if needed.
+*
+* Modules are cached in cachedir as "qvm_<key>.so", where key is a hash of the .qvm file, the VM's data mask, and
+* QVM_AOT_VERSION. If there is no cached module, the VM is translated into C ("qvm_<key>.c") and compiled with the given
+* compiler command. If loading succeeds, qvm_exec/qvm_exec_ex will run the module instead of the interpreter or JIT.
+* If it fails (unsupported platform, no compiler, a function that didn't pass verification, a module with the wrong
+* key), the VM is left untouched.
+*
+* @param vm Pointer to loaded QVM object
+* @param filemem Pointer to QVM file contents the VM was loaded from
+* @param filesize Size of QVM file contents
+* @param cachedir Directory to store translated and compiled modules in (must exist)
+* @param compiler C compiler command (like "cc" or "gcc")
+* @return 1 if success, 0 if failure
+*/
+int qvm_aot_load(qvm* vm, const uint8_t* filemem, size_t filesize, const char* cachedir, const char* compiler);
+
+/**
+* @brief Unload a VM's native module, returning it to the interpreter.
+*
+* @param vm Pointer to QVM object
+*/
+void qvm_aot_free(qvm* vm);
+
+/**
+* @brief Get the path of a VM's native module.
+*
+* @param vm Pointer to QVM object
+* @return Path of native module, or NULL if the VM doesn't have one loaded
+*/
+const char* qvm_aot_path(const qvm* vm);
+
+/**
+* @brief Run a VM function in the native module. Used internally by qvm_exec_ex.
+*
+* The entry stack frame must already be set up on the program stack. The return value is pushed onto the opstack. On
+* error, this logs a message and stores the index of the failing instruction in errinstr. Translated code keeps the
+* opstack in native registers, so the opstack is left empty on error.
+*
+* @param vm Pointer to QVM object with a native module
+* @param instruction Instruction to begin execution at (a QVM_OP_ENTER)
+* @param programstack Pointer to program stack pointer, updated on return
+* @param opstack Pointer to opstack pointer, updated on return
+* @param errinstr Receives the index of the failing instruction on error
+* @return 1 if success, 0 if failure
+*/
+int qvm_aot_exec(qvm* vm, size_t instruction, int** programstack, int** opstack, size_t* errinstr);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // QMM2_QVM_AOT_H
@@ -0,0 +1,80 @@
+/*
+QMM2 - Q3 MultiMod 2
+Copyright 2025-2026
+https://github.com/thecybermind/qmm2/
+3-clause BSD license: https://opensource.org/license/bsd-3-clause
+
+Created By:
+    Kevin Masterson < k.m.masterson@gmail.com >
+
+*/
+
+#ifndef QMM2_QVM_JIT_H
+#define QMM2_QVM_JIT_H
+
+#include <stdint.h>     // intptr_t and uint8_t
+#include <stddef.h>     // ptrdiff_t and size_t
+#include "qvm.h"
+
+// The JIT generates x86-64 code for the System V ABI, so it is only available on 64-bit Linux
+#if defined(__linux__) && defined(__x86_64__)
+#define QVM_JIT_SUPPORTED
+#endif
+
+// Maximum number of nested VM function calls in JIT code (each one uses native stack space)
+#define QVM_JIT_MAX_CALL_DEPTH          0x10000
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+
+/**
+* @brief Compile a loaded VM's code segment into native code.
+*
+* If compilation succeeds, qvm_exec/qvm_exec_ex will run the native code instead of the interpreter. If it fails
+* (unsupported platform, out of memory, code that can't be translated), the VM is left untouched and continues to
+* use the interpreter.
+*
+* @param vm Pointer to loaded QVM object
+* @return 1 if success, 0 if failure
+*/
+int qvm_jit_compile(qvm* vm);
+
+/**
+* @brief Free a VM's native code, returning it to the interpreter.
+*
+* @param vm Pointer to QVM object
+*/
+void qvm_jit_free(qvm* vm);
+
+/**
+* @brief Get the size of a VM's native code.
+*
+* @param vm Pointer to QVM object
+* @return Size of native code in bytes, or 0 if the VM is not compiled
+*/
+size_t qvm_jit_codesize(const qvm* vm);
+
+/**
+* @brief Run native code for a VM function. Used internally by qvm_exec_ex.
+*
+* The entry stack frame must already be set up on the program stack. On error, this logs a message and stores the
+* index of the failing instruction in errinstr.
+*
+* @param vm Pointer to compiled QVM object
+* @param instruction Instruction to begin execution at (a QVM_OP_ENTER)
+* @param programstack Pointer to program stack pointer, updated on return
+* @param opstack Pointer to opstack pointer, updated on return
+* @param opstacklow Lowest address of opstack for bounds checking
+* @param opstackhigh Highest address of opstack for bounds checking
+* @param errinstr Receives the index of the failing instruction on error
+* @return 1 if success, 0 if failure
+*/
+int qvm_jit_exec(qvm* vm, size_t instruction, int** programstack, int** opstack, int* opstacklow, int* opstackhigh, size_t* errinstr);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // QMM2_QVM_JIT_H
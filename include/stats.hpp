@@ -0,0 +1,95 @@
+/*
+QMM2 - Q3 MultiMod 2
+Copyright 2025-2026
+https://github.com/thecybermind/qmm2/
+3-clause BSD license: https://opensource.org/license/bsd-3-clause
+
+Created By:
+    Kevin Masterson < k.m.masterson@gmail.com >
+
+*/
+
+#ifndef QMM2_STATS_HPP
+#define QMM2_STATS_HPP
+
+#include <cstdint>  // intptr_t and uint64_t
+#include <map>
+#include <vector>
+#include "qmmapi.h"
+
+// Parts of a routed call that are timed separately
+enum StatsPhase {
+    STATS_PRE,              // Plugins' pre-hooks
+    STATS_REAL,             // Real engine/mod function
+    STATS_POST,             // Plugins' post-hooks
+
+    STATS_NUM_PHASES,
+};
+
+// Counters for one phase
+struct StatsCounter {
+    uint64_t calls = 0;         // Number of calls
+    uint64_t time = 0;          // Total nanoseconds
+    uint64_t maxtime = 0;       // Longest call in nanoseconds
+    uint64_t overrides = 0;     // Calls with a result of QMM_OVERRIDE
+    uint64_t supercedes = 0;    // Calls with a result of QMM_SUPERCEDE
+};
+
+// Counters for each phase of a message
+struct StatsEntry {
+    StatsCounter phases[STATS_NUM_PHASES];
+    uint64_t maxtime = 0;       // Longest whole routed call (all phases) in nanoseconds, only for the totals
+};
+
+// Highest message kept in a StatsTable's arrays. Negative or higher messages are kept in a map instead
+constexpr intptr_t QMM_STATS_MAX_CMD = 4095;
+
+// Routing statistics for one set of calls: a single plugin's hooks (each Plugin has one), or the totals of every plugin
+// (and the real call) for each message
+struct StatsTable {
+    std::vector<StatsEntry> cmds[2];                // Entries for vmMain ([0]) and syscall ([1]) messages, by message
+    std::map<intptr_t, StatsEntry> othercmds[2];    // Entries for messages outside of cmds
+};
+
+// Routing statistics are being collected. Checked by GameInfo::Route before doing any timing
+extern bool g_stats_active;
+
+// Collected routing statistics totals (each plugin's own are in Plugin::stats)
+extern StatsTable g_stats;
+
+/**
+* @brief Get a timestamp for routing statistics.
+*
+* @return Monotonic time in nanoseconds
+*/
+uint64_t stats_time();
+
+/**
+* @brief Add a call to the routing statistics.
+*
+* @param table Plugin's statistics, or g_stats for the totals for a message
+* @param is_syscall true for a syscall message, false for a vmMain message
+* @param cmd Message
+* @param phase Which part of the routed call this was
+* @param time Nanoseconds the call took
+* @param result Plugin result (highest result for totals, QMM_UNUSED for the real call)
+*/
+void stats_add(StatsTable& table, bool is_syscall, intptr_t cmd, StatsPhase phase, uint64_t time, plugin_res result);
+
+/**
+* @brief Add the time of a whole routed call (all phases) to the totals for a message.
+*
+* @param is_syscall true for a syscall message, false for a vmMain message
+* @param cmd Message
+* @param time Nanoseconds the routed call took
+*/
+void stats_add_call(bool is_syscall, intptr_t cmd, uint64_t time);
+
+/**
+* @brief Remove all routing statistics from a table.
+*
+* @param table Plugin's statistics, or g_stats
+*/
+void stats_clear(StatsTable& table);
+
+#endif // QMM2_STATS_HPP
@@ -261,6 +261,22 @@ T util_max(T a, T b) {
 }
 
 
+/**
+* @brief Returns whichever value is lesser - a typical "min" function.
+*
+* This was created to avoid any overlap with a "min" function from stdlib or game SDKs.
+*
+* @param T any type
+* @param a an object of type T
+* @param b an object of type T
+* @return whichever of a or b compares lesser
+*/
+template<typename T>
+T util_min(T a, T b) {
+    return (a < b ? a : b);
+}
+
+
 template <class OutputClass, class InputClass>
 union horrible_union {
     OutputClass out;
@@ -32,8 +32,8 @@ struct COD11MP_GameSupport : public GameSupport {
     virtual int QMMEngMsg(int msg) { return qmm_eng_msgs[msg]; }
     virtual int QMMModMsg(int msg) { return qmm_mod_msgs[msg]; }
 
-    virtual intptr_t syscall(intptr_t, ...);
-    virtual intptr_t vmMain(intptr_t, ...);
+    virtual intptr_t syscall_args(intptr_t, intptr_t*, int);
+    virtual intptr_t vmMain_args(intptr_t, intptr_t*, int);
 
     virtual const char* DefaultDLLName() { return "game" MP_DLL MOD_DLL; }
     virtual const char* DefaultModDir() { return "Main"; }
@@ -62,9 +62,7 @@ bool COD11MP_GameSupport::AutoDetect(APIType) {
 
 // wrapper syscall function that calls actual engine func in orig_syscall
 // this is how QMM and plugins will call into the engine
-intptr_t COD11MP_GameSupport::syscall(intptr_t cmd, ...) {
-    QMM_GET_SYSCALL_ARGS();
-
+intptr_t COD11MP_GameSupport::syscall_args(intptr_t cmd, intptr_t* args, int argc) {
     if (cmd != G_PRINT)
         QMMLOG(QMM_LOG_TRACE, "QMM") << "COD11MP_GameSupport::syscall(" << EngMsgName(cmd) << "(" << cmd << ")) called\n";
 
@@ -92,7 +90,7 @@ intptr_t COD11MP_GameSupport::syscall(intptr_t cmd, ...) {
 
     default:
         // all normal engine functions go to syscall
-        ret = orig_syscall(cmd, QMM_PUT_SYSCALL_ARGS());
+        ret = api_call_args(orig_syscall, cmd, args, argc);
     }
 
     // do anything that needs to be done after function call here
@@ -106,9 +104,7 @@ intptr_t COD11MP_GameSupport::syscall(intptr_t cmd, ...) {
 
 // wrapper vmMain function that calls actual mod func in orig_vmMain
 // this is how QMM and plugins will call into the mod
-intptr_t COD11MP_GameSupport::vmMain(intptr_t cmd, ...) {
-    QMM_GET_VMMAIN_ARGS();
-
+intptr_t COD11MP_GameSupport::vmMain_args(intptr_t cmd, intptr_t* args, int argc) {
     QMMLOG(QMM_LOG_TRACE, "QMM") << "COD11MP_GameSupport::vmMain(" << ModMsgName(cmd) << "(" << cmd << ")) called\n";
 
     if (!orig_vmMain)
@@ -118,7 +114,7 @@ intptr_t COD11MP_GameSupport::vmMain(intptr_t cmd, ...) {
     intptr_t ret = 0;
 
     // all normal mod functions go to vmMain
-    ret = orig_vmMain(cmd, QMM_PUT_VMMAIN_ARGS());
+    ret = api_call_args(orig_vmMain, cmd, args, argc);
 
     QMMLOG(QMM_LOG_TRACE, "QMM") << "COD11MP_GameSupport::vmMain(" << ModMsgName(cmd) << "(" << cmd << ")) returning " << ret << "\n";
 
@@ -33,8 +33,8 @@ struct CODMP_GameSupport : public GameSupport {
     virtual int QMMEngMsg(int msg) { return qmm_eng_msgs[msg]; }
     virtual int QMMModMsg(int msg) { return qmm_mod_msgs[msg]; }
 
-    virtual intptr_t syscall(intptr_t, ...);
-    virtual intptr_t vmMain(intptr_t, ...);
+    virtual intptr_t syscall_args(intptr_t, intptr_t*, int);
+    virtual intptr_t vmMain_args(intptr_t, intptr_t*, int);
 
     virtual const char* DefaultDLLName() { return "game" MP_DLL MOD_DLL; }
     virtual const char* DefaultModDir() { return "Main"; }
@@ -51,7 +51,7 @@ private:
     const int qmm_eng_msgs[QMM_ENGINE_MSG_COUNT] = GEN_GAME_QMM_ENG_MSGS();
     // GAME_GET_APIVERSION gets called first, which is when QMM has to perform mod/plugin loading, but we
     // don't want to make plugins have to use separate code to handle the actual GAME_INIT message
-    const int qmm_mod_msgs[QMM_MOD_MSG_COUNT] = { GAME_GET_APIVERSION, GAME_SHUTDOWN, GAME_CONSOLE_COMMAND, };
+    const int qmm_mod_msgs[QMM_MOD_MSG_COUNT] = { GAME_GET_APIVERSION, GAME_SHUTDOWN, GAME_CONSOLE_COMMAND, GAME_RUN_FRAME, };
 };
 
 GEN_GAME_OBJ(CODMP);
@@ -74,9 +74,7 @@ bool CODMP_GameSupport::AutoDetect(APIType engineapi) {
 
 // wrapper syscall function that calls actual engine func in orig_syscall
 // this is how QMM and plugins will call into the engine
-intptr_t CODMP_GameSupport::syscall(intptr_t cmd, ...) {
-    QMM_GET_SYSCALL_ARGS();
-
+intptr_t CODMP_GameSupport::syscall_args(intptr_t cmd, intptr_t* args, int argc) {
     if (cmd != G_PRINT)
         QMMLOG(QMM_LOG_TRACE, "QMM") << "CODMP_GameSupport::syscall(" << EngMsgName(cmd) << "(" << cmd << ")) called\n";
 
@@ -104,7 +102,7 @@ intptr_t CODMP_GameSupport::syscall(intptr_t cmd, ...) {
 
     default:
         // all normal engine functions go to syscall
-        ret = orig_syscall(cmd, QMM_PUT_SYSCALL_ARGS());
+        ret = api_call_args(orig_syscall, cmd, args, argc);
     }
 
     // do anything that needs to be done after function call here
@@ -118,9 +116,7 @@ intptr_t CODMP_GameSupport::syscall(intptr_t cmd, ...) {
 
 // wrapper vmMain function that calls actual mod func in orig_vmMain
 // this is how QMM and plugins will call into the mod
-intptr_t CODMP_GameSupport::vmMain(intptr_t cmd, ...) {
-    QMM_GET_VMMAIN_ARGS();
-
+intptr_t CODMP_GameSupport::vmMain_args(intptr_t cmd, intptr_t* args, int argc) {
     QMMLOG(QMM_LOG_TRACE, "QMM") << "CODMP_GameSupport::vmMain(" << ModMsgName(cmd) << "(" << cmd << ")) called\n";
 
     if (!orig_vmMain)
@@ -130,7 +126,7 @@ intptr_t CODMP_GameSupport::vmMain(intptr_t cmd, ...) {
     intptr_t ret = 0;
 
     // all normal mod functions go to vmMain
-    ret = orig_vmMain(cmd, QMM_PUT_VMMAIN_ARGS());
+    ret = api_call_args(orig_vmMain, cmd, args, argc);
 
     QMMLOG(QMM_LOG_TRACE, "QMM") << "CODMP_GameSupport::vmMain(" << ModMsgName(cmd) << "(" << cmd << ")) returning " << ret << "\n";
 
@@ -19,6 +19,7 @@ Created By:
 #include "game_jamp.h"
 #include "gameinfo.hpp"
 #include "main.hpp"
+#include "plugin.hpp"
 #include "util.hpp"
 
 struct JAMP_GameSupport : public GameSupport {
@@ -28,11 +29,14 @@ struct JAMP_GameSupport : public GameSupport {
     virtual void* Entry(void* arg0, void* arg1, APIType engine_api);
     virtual bool ModLoad(void* entry, APIType mod_api);
     virtual void ModUnload();
+    virtual int UpdatePassthroughs(bool enabled);
     virtual int QMMEngMsg(int msg) { return qmm_eng_msgs[msg]; }
     virtual int QMMModMsg(int msg) { return qmm_mod_msgs[msg]; }
 
-    virtual intptr_t syscall(intptr_t, ...);
-    virtual intptr_t vmMain(intptr_t, ...);
+    virtual intptr_t syscall_args(intptr_t, intptr_t*, int);
+    virtual intptr_t vmMain_args(intptr_t, intptr_t*, int);
+    virtual const int8_t* SyscallArgcs(int* count);
+    virtual const int8_t* VMMainArgcs(int* count);
 
     virtual const char* DefaultDLLName() { return "jampgame" MOD_DLL; }
     virtual const char* DefaultModDir() { return "base"; }
@@ -65,6 +69,10 @@ private:
 
     // struct with lambdas that call QMM's vmMain function. this is given to the game engine
     static game_export_t qmm_export;
+
+    // copies of qmm_import and qmm_export before any slots are changed by UpdatePassthroughs
+    static const game_import_t routed_import;
+    static const game_export_t routed_export;
 };
 
 GEN_GAME_OBJ(JAMP);
@@ -96,9 +104,7 @@ bool JAMP_GameSupport::AutoDetect(APIType engineapi) {
 
 // wrapper syscall function that calls actual engine func from orig_import or orig_syscall
 // this is how QMM and plugins will call into the engine
-intptr_t JAMP_GameSupport::syscall(intptr_t cmd, ...) {
-    QMM_GET_SYSCALL_ARGS();
-
+intptr_t JAMP_GameSupport::syscall_args(intptr_t cmd, intptr_t* args, int argc) {
     if (cmd != G_PRINT)
         QMMLOG(QMM_LOG_TRACE, "QMM") << "JAMP_GameSupport::syscall(" << EngMsgName(cmd) << "(" << cmd << ")) called\n";
 
@@ -129,7 +135,7 @@ intptr_t JAMP_GameSupport::syscall(intptr_t cmd, ...) {
 
         default:
             // all normal engine functions go to syscall
-            ret = orig_syscall(cmd, QMM_PUT_SYSCALL_ARGS());
+            ret = api_call_args(orig_syscall, cmd, args, argc);
         }
     }
     // if QMM was loaded with the OpenJK "new" API
@@ -479,9 +485,7 @@ intptr_t JAMP_GameSupport::syscall(intptr_t cmd, ...) {
 
 // wrapper vmMain function that calls actual mod func from orig_export
 // this is how QMM and plugins will call into the mod
-intptr_t JAMP_GameSupport::vmMain(intptr_t cmd, ...) {
-    QMM_GET_VMMAIN_ARGS();
-
+intptr_t JAMP_GameSupport::vmMain_args(intptr_t cmd, intptr_t* args, int argc) {
     QMMLOG(QMM_LOG_TRACE, "QMM") << "JAMP_GameSupport::vmMain(" << ModMsgName(cmd) << "(" << cmd << ")) called\n";
 
     // store return value since we do some stuff after the function call is over
@@ -490,7 +494,7 @@ intptr_t JAMP_GameSupport::vmMain(intptr_t cmd, ...) {
     // if the loaded JAMP mod uses the official JAMP or OpenJK "legacy" API
     if (orig_vmMain) {
         // all normal mod functions go to vmMain
-        ret = orig_vmMain(cmd, QMM_PUT_VMMAIN_ARGS());
+        ret = api_call_args(orig_vmMain, cmd, args, argc);
     }
     // if the loaded JAMP mod uses the OpenJK "new" API
     else if (orig_export) {
@@ -601,6 +605,367 @@ bool JAMP_GameSupport::ModLoad(void* entry, APIType modapi) {
 void JAMP_GameSupport::ModUnload() {
     orig_export = nullptr;
     orig_vmMain = nullptr;
+    // the engine may still call exports after the mod is unloaded, so stop bypassing QMM
+    qmm_import = routed_import;
+    qmm_export = routed_export;
+}
+
+
+int JAMP_GameSupport::UpdatePassthroughs(bool enabled) {
+    int count = 0;
+
+    // only the OpenJK "new" API uses the structs. OpenJK keeps the pointers to both structs, so the slots can be
+    // changed at any time. orig_import is empty if QMM was loaded with the legacy API, so those slots stay routed
+    PASSTHROUGH_IMPORT(Print, G_PRINT);
+    PASSTHROUGH_IMPORT(Error, G_ERROR);
+    PASSTHROUGH_IMPORT(Milliseconds, G_MILLISECONDS);
+    PASSTHROUGH_IMPORT(PrecisionTimerStart, G_PRECISIONTIMER_START);
+    PASSTHROUGH_IMPORT(PrecisionTimerEnd, G_PRECISIONTIMER_END);
+    PASSTHROUGH_IMPORT(SV_RegisterSharedMemory, G_SET_SHARED_BUFFER);
+    PASSTHROUGH_IMPORT(RealTime, G_REAL_TIME);
+    PASSTHROUGH_IMPORT(TrueMalloc, G_TRUEMALLOC);
+    PASSTHROUGH_IMPORT(TrueFree, G_TRUEFREE);
+    PASSTHROUGH_IMPORT(SnapVector, G_SNAPVECTOR);
+    PASSTHROUGH_IMPORT(Cvar_Register, G_CVAR_REGISTER);
+    PASSTHROUGH_IMPORT(Cvar_Set, G_CVAR_SET);
+    PASSTHROUGH_IMPORT(Cvar_Update, G_CVAR_UPDATE);
+    PASSTHROUGH_IMPORT(Cvar_VariableIntegerValue, G_CVAR_VARIABLE_INTEGER_VALUE);
+    PASSTHROUGH_IMPORT(Cvar_VariableStringBuffer, G_CVAR_VARIABLE_STRING_BUFFER);
+    PASSTHROUGH_IMPORT(Argc, G_ARGC);
+    PASSTHROUGH_IMPORT(Argv, G_ARGV);
+    PASSTHROUGH_IMPORT(FS_Close, G_FS_FCLOSE_FILE);
+    PASSTHROUGH_IMPORT(FS_GetFileList, G_FS_GETFILELIST);
+    PASSTHROUGH_IMPORT(FS_Open, G_FS_FOPEN_FILE);
+    PASSTHROUGH_IMPORT(FS_Read, G_FS_READ);
+    PASSTHROUGH_IMPORT(FS_Write, G_FS_WRITE);
+    PASSTHROUGH_IMPORT(AdjustAreaPortalState, G_ADJUST_AREA_PORTAL_STATE);
+    PASSTHROUGH_IMPORT(AreasConnected, G_AREAS_CONNECTED);
+    PASSTHROUGH_IMPORT(DebugPolygonCreate, G_DEBUG_POLYGON_CREATE);
+    PASSTHROUGH_IMPORT(DebugPolygonDelete, G_DEBUG_POLYGON_DELETE);
+    PASSTHROUGH_IMPORT(DropClient, G_DROP_CLIENT);
+    PASSTHROUGH_IMPORT(EntitiesInBox, G_ENTITIES_IN_BOX);
+    PASSTHROUGH_IMPORT(EntityContact, G_ENTITY_CONTACT);
+    PASSTHROUGH_IMPORT(GetConfigstring, G_GET_CONFIGSTRING);
+    PASSTHROUGH_IMPORT(GetEntityToken, G_GET_ENTITY_TOKEN);
+    PASSTHROUGH_IMPORT(GetServerinfo, G_GET_SERVERINFO);
+    PASSTHROUGH_IMPORT(GetUsercmd, G_GET_USERCMD);
+    PASSTHROUGH_IMPORT(GetUserinfo, G_GET_USERINFO);
+    PASSTHROUGH_IMPORT(InPVS, G_IN_PVS);
+    PASSTHROUGH_IMPORT(InPVSIgnorePortals, G_IN_PVS_IGNORE_PORTALS);
+    PASSTHROUGH_IMPORT(LinkEntity, G_LINKENTITY);
+    PASSTHROUGH_IMPORT(LocateGameData, G_LOCATE_GAME_DATA);
+    PASSTHROUGH_IMPORT(PointContents, G_POINT_CONTENTS);
+    PASSTHROUGH_IMPORT(SendConsoleCommand, G_SEND_CONSOLE_COMMAND);
+    PASSTHROUGH_IMPORT(SendServerCommand, G_SEND_SERVER_COMMAND);
+    PASSTHROUGH_IMPORT(SetBrushModel, G_SET_BRUSH_MODEL);
+    PASSTHROUGH_IMPORT(SetConfigstring, G_SET_CONFIGSTRING);
+    PASSTHROUGH_IMPORT(SetServerCull, G_SET_SERVER_CULL);
+    PASSTHROUGH_IMPORT(SetUserinfo, G_SET_USERINFO);
+    PASSTHROUGH_IMPORT(SiegePersSet, G_SIEGEPERSSET);
+    PASSTHROUGH_IMPORT(SiegePersGet, G_SIEGEPERSGET);
+    PASSTHROUGH_IMPORT(Trace, G_TRACE);
+    PASSTHROUGH_IMPORT(UnlinkEntity, G_UNLINKENTITY);
+    PASSTHROUGH_IMPORT(ROFF_Clean, G_ROFF_CLEAN);
+    PASSTHROUGH_IMPORT(ROFF_UpdateEntities, G_ROFF_UPDATE_ENTITIES);
+    PASSTHROUGH_IMPORT(ROFF_Cache, G_ROFF_CACHE);
+    PASSTHROUGH_IMPORT(ROFF_Play, G_ROFF_PLAY);
+    PASSTHROUGH_IMPORT(ROFF_Purge_Ent, G_ROFF_PURGE_ENT);
+    PASSTHROUGH_IMPORT(ICARUS_RunScript, G_ICARUS_RUNSCRIPT);
+    PASSTHROUGH_IMPORT(ICARUS_RegisterScript, G_ICARUS_REGISTERSCRIPT);
+    PASSTHROUGH_IMPORT(ICARUS_Init, G_ICARUS_INIT);
+    PASSTHROUGH_IMPORT(ICARUS_ValidEnt, G_ICARUS_VALIDENT);
+    PASSTHROUGH_IMPORT(ICARUS_IsInitialized, G_ICARUS_ISINITIALIZED);
+    PASSTHROUGH_IMPORT(ICARUS_MaintainTaskManager, G_ICARUS_MAINTAINTASKMANAGER);
+    PASSTHROUGH_IMPORT(ICARUS_IsRunning, G_ICARUS_ISRUNNING);
+    PASSTHROUGH_IMPORT(ICARUS_TaskIDPending, G_ICARUS_TASKIDPENDING);
+    PASSTHROUGH_IMPORT(ICARUS_InitEnt, G_ICARUS_INITENT);
+    PASSTHROUGH_IMPORT(ICARUS_FreeEnt, G_ICARUS_FREEENT);
+    PASSTHROUGH_IMPORT(ICARUS_AssociateEnt, G_ICARUS_ASSOCIATEENT);
+    PASSTHROUGH_IMPORT(ICARUS_Shutdown, G_ICARUS_SHUTDOWN);
+    PASSTHROUGH_IMPORT(ICARUS_TaskIDSet, G_ICARUS_TASKIDSET);
+    PASSTHROUGH_IMPORT(ICARUS_TaskIDComplete, G_ICARUS_TASKIDCOMPLETE);
+    PASSTHROUGH_IMPORT(ICARUS_SetVar, G_ICARUS_SETVAR);
+    PASSTHROUGH_IMPORT(ICARUS_VariableDeclared, G_ICARUS_VARIABLEDECLARED);
+    PASSTHROUGH_IMPORT(ICARUS_GetFloatVariable, G_ICARUS_GETFLOATVARIABLE);
+    PASSTHROUGH_IMPORT(ICARUS_GetStringVariable, G_ICARUS_GETSTRINGVARIABLE);
+    PASSTHROUGH_IMPORT(ICARUS_GetVectorVariable, G_ICARUS_GETVECTORVARIABLE);
+    PASSTHROUGH_IMPORT(Nav_Init, G_NAV_INIT);
+    PASSTHROUGH_IMPORT(Nav_Free, G_NAV_FREE);
+    PASSTHROUGH_IMPORT(Nav_Load, G_NAV_LOAD);
+    PASSTHROUGH_IMPORT(Nav_Save, G_NAV_SAVE);
+    PASSTHROUGH_IMPORT(Nav_AddRawPoint, G_NAV_ADDRAWPOINT);
+    PASSTHROUGH_IMPORT(Nav_CalculatePaths, G_NAV_CALCULATEPATHS);
+    PASSTHROUGH_IMPORT(Nav_HardConnect, G_NAV_HARDCONNECT);
+    PASSTHROUGH_IMPORT(Nav_ShowNodes, G_NAV_SHOWNODES);
+    PASSTHROUGH_IMPORT(Nav_ShowEdges, G_NAV_SHOWEDGES);
+    PASSTHROUGH_IMPORT(Nav_ShowPath, G_NAV_SHOWPATH);
+    PASSTHROUGH_IMPORT(Nav_GetNearestNode, G_NAV_GETNEARESTNODE);
+    PASSTHROUGH_IMPORT(Nav_GetBestNode, G_NAV_GETBESTNODE);
+    PASSTHROUGH_IMPORT(Nav_GetNodePosition, G_NAV_GETNODEPOSITION);
+    PASSTHROUGH_IMPORT(Nav_GetNodeNumEdges, G_NAV_GETNODENUMEDGES);
+    PASSTHROUGH_IMPORT(Nav_GetNodeEdge, G_NAV_GETNODEEDGE);
+    PASSTHROUGH_IMPORT(Nav_GetNumNodes, G_NAV_GETNUMNODES);
+    PASSTHROUGH_IMPORT(Nav_Connected, G_NAV_CONNECTED);
+    PASSTHROUGH_IMPORT(Nav_GetPathCost, G_NAV_GETPATHCOST);
+    PASSTHROUGH_IMPORT(Nav_GetEdgeCost, G_NAV_GETEDGECOST);
+    PASSTHROUGH_IMPORT(Nav_GetProjectedNode, G_NAV_GETPROJECTEDNODE);
+    PASSTHROUGH_IMPORT(Nav_CheckFailedNodes, G_NAV_CHECKFAILEDNODES);
+    PASSTHROUGH_IMPORT(Nav_AddFailedNode, G_NAV_ADDFAILEDNODE);
+    PASSTHROUGH_IMPORT(Nav_NodeFailed, G_NAV_NODEFAILED);
+    PASSTHROUGH_IMPORT(Nav_NodesAreNeighbors, G_NAV_NODESARENEIGHBORS);
+    PASSTHROUGH_IMPORT(Nav_ClearFailedEdge, G_NAV_CLEARFAILEDEDGE);
+    PASSTHROUGH_IMPORT(Nav_ClearAllFailedEdges, G_NAV_CLEARALLFAILEDEDGES);
+    PASSTHROUGH_IMPORT(Nav_EdgeFailed, G_NAV_EDGEFAILED);
+    PASSTHROUGH_IMPORT(Nav_AddFailedEdge, G_NAV_ADDFAILEDEDGE);
+    PASSTHROUGH_IMPORT(Nav_CheckFailedEdge, G_NAV_CHECKFAILEDEDGE);
+    PASSTHROUGH_IMPORT(Nav_CheckAllFailedEdges, G_NAV_CHECKALLFAILEDEDGES);
+    PASSTHROUGH_IMPORT(Nav_RouteBlocked, G_NAV_ROUTEBLOCKED);
+    PASSTHROUGH_IMPORT(Nav_GetBestNodeAltRoute, G_NAV_GETBESTNODEALTROUTE);
+    PASSTHROUGH_IMPORT(Nav_GetBestNodeAltRoute2, G_NAV_GETBESTNODEALT2);
+    PASSTHROUGH_IMPORT(Nav_GetBestPathBetweenEnts, G_NAV_GETBESTPATHBETWEENENTS);
+    PASSTHROUGH_IMPORT(Nav_GetNodeRadius, G_NAV_GETNODERADIUS);
+    PASSTHROUGH_IMPORT(Nav_CheckBlockedEdges, G_NAV_CHECKBLOCKEDEDGES);
+    PASSTHROUGH_IMPORT(Nav_ClearCheckedNodes, G_NAV_CLEARCHECKEDNODES);
+    PASSTHROUGH_IMPORT(Nav_CheckedNode, G_NAV_CHECKEDNODE);
+    PASSTHROUGH_IMPORT(Nav_SetCheckedNode, G_NAV_SETCHECKEDNODE);
+    PASSTHROUGH_IMPORT(Nav_FlagAllNodes, G_NAV_FLAGALLNODES);
+    PASSTHROUGH_IMPORT(Nav_GetPathsCalculated, G_NAV_GETPATHSCALCULATED);
+    PASSTHROUGH_IMPORT(Nav_SetPathsCalculated, G_NAV_SETPATHSCALCULATED);
+    PASSTHROUGH_IMPORT(BotAllocateClient, G_BOT_ALLOCATE_CLIENT);
+    PASSTHROUGH_IMPORT(BotFreeClient, G_BOT_FREE_CLIENT);
+    PASSTHROUGH_IMPORT(BotLoadCharacter, BOTLIB_AI_LOAD_CHARACTER);
+    PASSTHROUGH_IMPORT(BotFreeCharacter, BOTLIB_AI_FREE_CHARACTER);
+    PASSTHROUGH_IMPORT(Characteristic_Float, BOTLIB_AI_CHARACTERISTIC_FLOAT);
+    PASSTHROUGH_IMPORT(Characteristic_BFloat, BOTLIB_AI_CHARACTERISTIC_BFLOAT);
+    PASSTHROUGH_IMPORT(Characteristic_Integer, BOTLIB_AI_CHARACTERISTIC_INTEGER);
+    PASSTHROUGH_IMPORT(Characteristic_BInteger, BOTLIB_AI_CHARACTERISTIC_BINTEGER);
+    PASSTHROUGH_IMPORT(Characteristic_String, BOTLIB_AI_CHARACTERISTIC_STRING);
+    PASSTHROUGH_IMPORT(BotAllocChatState, BOTLIB_AI_ALLOC_CHAT_STATE);
+    PASSTHROUGH_IMPORT(BotFreeChatState, BOTLIB_AI_FREE_CHAT_STATE);
+    PASSTHROUGH_IMPORT(BotQueueConsoleMessage, BOTLIB_AI_QUEUE_CONSOLE_MESSAGE);
+    PASSTHROUGH_IMPORT(BotRemoveConsoleMessage, BOTLIB_AI_REMOVE_CONSOLE_MESSAGE);
+    PASSTHROUGH_IMPORT(BotNextConsoleMessage, BOTLIB_AI_NEXT_CONSOLE_MESSAGE);
+    PASSTHROUGH_IMPORT(BotNumConsoleMessages, BOTLIB_AI_NUM_CONSOLE_MESSAGE);
+    PASSTHROUGH_IMPORT(BotInitialChat, BOTLIB_AI_INITIAL_CHAT);
+    PASSTHROUGH_IMPORT(BotReplyChat, BOTLIB_AI_REPLY_CHAT);
+    PASSTHROUGH_IMPORT(BotChatLength, BOTLIB_AI_CHAT_LENGTH);
+    PASSTHROUGH_IMPORT(BotEnterChat, BOTLIB_AI_ENTER_CHAT);
+    PASSTHROUGH_IMPORT(StringContains, BOTLIB_AI_STRING_CONTAINS);
+    PASSTHROUGH_IMPORT(BotFindMatch, BOTLIB_AI_FIND_MATCH);
+    PASSTHROUGH_IMPORT(BotMatchVariable, BOTLIB_AI_MATCH_VARIABLE);
+    PASSTHROUGH_IMPORT(UnifyWhiteSpaces, BOTLIB_AI_UNIFY_WHITE_SPACES);
+    PASSTHROUGH_IMPORT(BotReplaceSynonyms, BOTLIB_AI_REPLACE_SYNONYMS);
+    PASSTHROUGH_IMPORT(BotLoadChatFile, BOTLIB_AI_LOAD_CHAT_FILE);
+    PASSTHROUGH_IMPORT(BotSetChatGender, BOTLIB_AI_SET_CHAT_GENDER);
+    PASSTHROUGH_IMPORT(BotSetChatName, BOTLIB_AI_SET_CHAT_NAME);
+    PASSTHROUGH_IMPORT(BotResetGoalState, BOTLIB_AI_RESET_GOAL_STATE);
+    PASSTHROUGH_IMPORT(BotResetAvoidGoals, BOTLIB_AI_RESET_AVOID_GOALS);
+    PASSTHROUGH_IMPORT(BotPushGoal, BOTLIB_AI_PUSH_GOAL);
+    PASSTHROUGH_IMPORT(BotPopGoal, BOTLIB_AI_POP_GOAL);
+    PASSTHROUGH_IMPORT(BotEmptyGoalStack, BOTLIB_AI_EMPTY_GOAL_STACK);
+    PASSTHROUGH_IMPORT(BotDumpAvoidGoals, BOTLIB_AI_DUMP_AVOID_GOALS);
+    PASSTHROUGH_IMPORT(BotDumpGoalStack, BOTLIB_AI_DUMP_GOAL_STACK);
+    PASSTHROUGH_IMPORT(BotGoalName, BOTLIB_AI_GOAL_NAME);
+    PASSTHROUGH_IMPORT(BotGetTopGoal, BOTLIB_AI_GET_TOP_GOAL);
+    PASSTHROUGH_IMPORT(BotGetSecondGoal, BOTLIB_AI_GET_SECOND_GOAL);
+    PASSTHROUGH_IMPORT(BotChooseLTGItem, BOTLIB_AI_CHOOSE_LTG_ITEM);
+    PASSTHROUGH_IMPORT(BotChooseNBGItem, BOTLIB_AI_CHOOSE_NBG_ITEM);
+    PASSTHROUGH_IMPORT(BotTouchingGoal, BOTLIB_AI_TOUCHING_GOAL);
+    PASSTHROUGH_IMPORT(BotItemGoalInVisButNotVisible, BOTLIB_AI_ITEM_GOAL_IN_VIS_BUT_NOT_VISIBLE);
+    PASSTHROUGH_IMPORT(BotGetLevelItemGoal, BOTLIB_AI_GET_LEVEL_ITEM_GOAL);
+    PASSTHROUGH_IMPORT(BotAvoidGoalTime, BOTLIB_AI_AVOID_GOAL_TIME);
+    PASSTHROUGH_IMPORT(BotInitLevelItems, BOTLIB_AI_INIT_LEVEL_ITEMS);
+    PASSTHROUGH_IMPORT(BotUpdateEntityItems, BOTLIB_AI_UPDATE_ENTITY_ITEMS);
+    PASSTHROUGH_IMPORT(BotLoadItemWeights, BOTLIB_AI_LOAD_ITEM_WEIGHTS);
+    PASSTHROUGH_IMPORT(BotFreeItemWeights, BOTLIB_AI_FREE_ITEM_WEIGHTS);
+    PASSTHROUGH_IMPORT(BotSaveGoalFuzzyLogic, BOTLIB_AI_SAVE_GOAL_FUZZY_LOGIC);
+    PASSTHROUGH_IMPORT(BotAllocGoalState, BOTLIB_AI_ALLOC_GOAL_STATE);
+    PASSTHROUGH_IMPORT(BotFreeGoalState, BOTLIB_AI_FREE_GOAL_STATE);
+    PASSTHROUGH_IMPORT(BotResetMoveState, BOTLIB_AI_RESET_MOVE_STATE);
+    PASSTHROUGH_IMPORT(BotMoveToGoal, BOTLIB_AI_MOVE_TO_GOAL);
+    PASSTHROUGH_IMPORT(BotMoveInDirection, BOTLIB_AI_MOVE_IN_DIRECTION);
+    PASSTHROUGH_IMPORT(BotResetAvoidReach, BOTLIB_AI_RESET_AVOID_REACH);
+    PASSTHROUGH_IMPORT(BotResetLastAvoidReach, BOTLIB_AI_RESET_LAST_AVOID_REACH);
+    PASSTHROUGH_IMPORT(BotReachabilityArea, BOTLIB_AI_REACHABILITY_AREA);
+    PASSTHROUGH_IMPORT(BotMovementViewTarget, BOTLIB_AI_MOVEMENT_VIEW_TARGET);
+    PASSTHROUGH_IMPORT(BotAllocMoveState, BOTLIB_AI_ALLOC_MOVE_STATE);
+    PASSTHROUGH_IMPORT(BotFreeMoveState, BOTLIB_AI_FREE_MOVE_STATE);
+    PASSTHROUGH_IMPORT(BotInitMoveState, BOTLIB_AI_INIT_MOVE_STATE);
+    PASSTHROUGH_IMPORT(BotChooseBestFightWeapon, BOTLIB_AI_CHOOSE_BEST_FIGHT_WEAPON);
+    PASSTHROUGH_IMPORT(BotGetWeaponInfo, BOTLIB_AI_GET_WEAPON_INFO);
+    PASSTHROUGH_IMPORT(BotLoadWeaponWeights, BOTLIB_AI_LOAD_WEAPON_WEIGHTS);
+    PASSTHROUGH_IMPORT(BotAllocWeaponState, BOTLIB_AI_ALLOC_WEAPON_STATE);
+    PASSTHROUGH_IMPORT(BotFreeWeaponState, BOTLIB_AI_FREE_WEAPON_STATE);
+    PASSTHROUGH_IMPORT(BotResetWeaponState, BOTLIB_AI_RESET_WEAPON_STATE);
+    PASSTHROUGH_IMPORT(GeneticParentsAndChildSelection, BOTLIB_AI_GENETIC_PARENTS_AND_CHILD_SELECTION);
+    PASSTHROUGH_IMPORT(BotInterbreedGoalFuzzyLogic, BOTLIB_AI_INTERBREED_GOAL_FUZZY_LOGIC);
+    PASSTHROUGH_IMPORT(BotMutateGoalFuzzyLogic, BOTLIB_AI_MUTATE_GOAL_FUZZY_LOGIC);
+    PASSTHROUGH_IMPORT(BotGetNextCampSpotGoal, BOTLIB_AI_GET_NEXT_CAMP_SPOT_GOAL);
+    PASSTHROUGH_IMPORT(BotGetMapLocationGoal, BOTLIB_AI_GET_MAP_LOCATION_GOAL);
+    PASSTHROUGH_IMPORT(BotNumInitialChats, BOTLIB_AI_NUM_INITIAL_CHATS);
+    PASSTHROUGH_IMPORT(BotGetChatMessage, BOTLIB_AI_GET_CHAT_MESSAGE);
+    PASSTHROUGH_IMPORT(BotRemoveFromAvoidGoals, BOTLIB_AI_REMOVE_FROM_AVOID_GOALS);
+    PASSTHROUGH_IMPORT(BotPredictVisiblePosition, BOTLIB_AI_PREDICT_VISIBLE_POSITION);
+    PASSTHROUGH_IMPORT(BotSetAvoidGoalTime, BOTLIB_AI_SET_AVOID_GOAL_TIME);
+    PASSTHROUGH_IMPORT(BotAddAvoidSpot, BOTLIB_AI_ADD_AVOID_SPOT);
+    PASSTHROUGH_IMPORT(BotLibSetup, BOTLIB_SETUP);
+    PASSTHROUGH_IMPORT(BotLibShutdown, BOTLIB_SHUTDOWN);
+    PASSTHROUGH_IMPORT(BotLibVarSet, BOTLIB_LIBVAR_SET);
+    PASSTHROUGH_IMPORT(BotLibVarGet, BOTLIB_LIBVAR_GET);
+    PASSTHROUGH_IMPORT(BotLibDefine, BOTLIB_PC_ADD_GLOBAL_DEFINE);
+    PASSTHROUGH_IMPORT(BotLibStartFrame, BOTLIB_START_FRAME);
+    PASSTHROUGH_IMPORT(BotLibLoadMap, BOTLIB_LOAD_MAP);
+    PASSTHROUGH_IMPORT(BotLibUpdateEntity, BOTLIB_UPDATENTITY);
+    PASSTHROUGH_IMPORT(BotLibTest, BOTLIB_TEST);
+    PASSTHROUGH_IMPORT(BotGetSnapshotEntity, BOTLIB_GET_SNAPSHOT_ENTITY);
+    PASSTHROUGH_IMPORT(BotGetServerCommand, BOTLIB_GET_CONSOLE_MESSAGE);
+    PASSTHROUGH_IMPORT(BotUserCommand, BOTLIB_USER_COMMAND);
+    PASSTHROUGH_IMPORT(BotUpdateWaypoints, G_BOT_UPDATEWAYPOINTS);
+    PASSTHROUGH_IMPORT(BotCalculatePaths, G_BOT_CALCULATEPATHS);
+    PASSTHROUGH_IMPORT(AAS_EnableRoutingArea, BOTLIB_AAS_ENABLE_ROUTING_AREA);
+    PASSTHROUGH_IMPORT(AAS_BBoxAreas, BOTLIB_AAS_BBOX_AREAS);
+    PASSTHROUGH_IMPORT(AAS_AreaInfo, BOTLIB_AAS_AREA_INFO);
+    PASSTHROUGH_IMPORT(AAS_EntityInfo, BOTLIB_AAS_ENTITY_INFO);
+    PASSTHROUGH_IMPORT(AAS_Initialized, BOTLIB_AAS_INITIALIZED);
+    PASSTHROUGH_IMPORT(AAS_PresenceTypeBoundingBox, BOTLIB_AAS_PRESENCE_TYPE_BOUNDING_BOX);
+    PASSTHROUGH_IMPORT(AAS_Time, BOTLIB_AAS_TIME);
+    PASSTHROUGH_IMPORT(AAS_PointAreaNum, BOTLIB_AAS_POINT_AREA_NUM);
+    PASSTHROUGH_IMPORT(AAS_TraceAreas, BOTLIB_AAS_TRACE_AREAS);
+    PASSTHROUGH_IMPORT(AAS_PointContents, BOTLIB_AAS_POINT_CONTENTS);
+    PASSTHROUGH_IMPORT(AAS_NextBSPEntity, BOTLIB_AAS_NEXT_BSP_ENTITY);
+    PASSTHROUGH_IMPORT(AAS_ValueForBSPEpairKey, BOTLIB_AAS_VALUE_FOR_BSP_EPAIR_KEY);
+    PASSTHROUGH_IMPORT(AAS_VectorForBSPEpairKey, BOTLIB_AAS_VECTOR_FOR_BSP_EPAIR_KEY);
+    PASSTHROUGH_IMPORT(AAS_FloatForBSPEpairKey, BOTLIB_AAS_FLOAT_FOR_BSP_EPAIR_KEY);
+    PASSTHROUGH_IMPORT(AAS_IntForBSPEpairKey, BOTLIB_AAS_INT_FOR_BSP_EPAIR_KEY);
+    PASSTHROUGH_IMPORT(AAS_AreaReachability, BOTLIB_AAS_AREA_REACHABILITY);
+    PASSTHROUGH_IMPORT(AAS_AreaTravelTimeToGoalArea, BOTLIB_AAS_AREA_TRAVEL_TIME_TO_GOAL_AREA);
+    PASSTHROUGH_IMPORT(AAS_Swimming, BOTLIB_AAS_SWIMMING);
+    PASSTHROUGH_IMPORT(AAS_PredictClientMovement, BOTLIB_AAS_PREDICT_CLIENT_MOVEMENT);
+    PASSTHROUGH_IMPORT(AAS_AlternativeRouteGoals, BOTLIB_AAS_ALTERNATIVE_ROUTE_GOAL);
+    PASSTHROUGH_IMPORT(AAS_PredictRoute, BOTLIB_AAS_PREDICT_ROUTE);
+    PASSTHROUGH_IMPORT(AAS_PointReachabilityAreaIndex, BOTLIB_AAS_POINT_REACHABILITY_AREA_INDEX);
+    PASSTHROUGH_IMPORT(EA_Say, BOTLIB_EA_SAY);
+    PASSTHROUGH_IMPORT(EA_SayTeam, BOTLIB_EA_SAY_TEAM);
+    PASSTHROUGH_IMPORT(EA_Command, BOTLIB_EA_COMMAND);
+    PASSTHROUGH_IMPORT(EA_Action, BOTLIB_EA_ACTION);
+    PASSTHROUGH_IMPORT(EA_Gesture, BOTLIB_EA_GESTURE);
+    PASSTHROUGH_IMPORT(EA_Talk, BOTLIB_EA_TALK);
+    PASSTHROUGH_IMPORT(EA_Attack, BOTLIB_EA_ATTACK);
+    PASSTHROUGH_IMPORT(EA_Alt_Attack, BOTLIB_EA_ALT_ATTACK);
+    PASSTHROUGH_IMPORT(EA_ForcePower, BOTLIB_EA_FORCEPOWER);
+    PASSTHROUGH_IMPORT(EA_Use, BOTLIB_EA_USE);
+    PASSTHROUGH_IMPORT(EA_Respawn, BOTLIB_EA_RESPAWN);
+    PASSTHROUGH_IMPORT(EA_Crouch, BOTLIB_EA_CROUCH);
+    PASSTHROUGH_IMPORT(EA_MoveUp, BOTLIB_EA_MOVE_UP);
+    PASSTHROUGH_IMPORT(EA_MoveDown, BOTLIB_EA_MOVE_DOWN);
+    PASSTHROUGH_IMPORT(EA_MoveForward, BOTLIB_EA_MOVE_FORWARD);
+    PASSTHROUGH_IMPORT(EA_MoveBack, BOTLIB_EA_MOVE_BACK);
+    PASSTHROUGH_IMPORT(EA_MoveLeft, BOTLIB_EA_MOVE_LEFT);
+    PASSTHROUGH_IMPORT(EA_MoveRight, BOTLIB_EA_MOVE_RIGHT);
+    PASSTHROUGH_IMPORT(EA_SelectWeapon, BOTLIB_EA_SELECT_WEAPON);
+    PASSTHROUGH_IMPORT(EA_Jump, BOTLIB_EA_JUMP);
+    PASSTHROUGH_IMPORT(EA_DelayedJump, BOTLIB_EA_DELAYED_JUMP);
+    PASSTHROUGH_IMPORT(EA_Move, BOTLIB_EA_MOVE);
+    PASSTHROUGH_IMPORT(EA_View, BOTLIB_EA_VIEW);
+    PASSTHROUGH_IMPORT(EA_EndRegular, BOTLIB_EA_END_REGULAR);
+    PASSTHROUGH_IMPORT(EA_GetInput, BOTLIB_EA_GET_INPUT);
+    PASSTHROUGH_IMPORT(EA_ResetInput, BOTLIB_EA_RESET_INPUT);
+    PASSTHROUGH_IMPORT(PC_LoadSource, BOTLIB_PC_LOAD_SOURCE);
+    PASSTHROUGH_IMPORT(PC_FreeSource, BOTLIB_PC_FREE_SOURCE);
+    PASSTHROUGH_IMPORT(PC_ReadToken, BOTLIB_PC_READ_TOKEN);
+    PASSTHROUGH_IMPORT(PC_SourceFileAndLine, BOTLIB_PC_SOURCE_FILE_AND_LINE);
+    PASSTHROUGH_IMPORT(R_RegisterSkin, G_R_REGISTERSKIN);
+    PASSTHROUGH_IMPORT(SetActiveSubBSP, G_SET_ACTIVE_SUBBSP);
+    PASSTHROUGH_IMPORT(CM_RegisterTerrain, G_CM_REGISTER_TERRAIN);
+    PASSTHROUGH_IMPORT(RMG_Init, G_RMG_INIT);
+    PASSTHROUGH_IMPORT(G2API_ListModelBones, G_G2_LISTBONES);
+    PASSTHROUGH_IMPORT(G2API_ListModelSurfaces, G_G2_LISTSURFACES);
+    PASSTHROUGH_IMPORT(G2API_HaveWeGhoul2Models, G_G2_HAVEWEGHOULMODELS);
+    PASSTHROUGH_IMPORT(G2API_SetGhoul2ModelIndexes, G_G2_SETMODELS);
+    PASSTHROUGH_IMPORT(G2API_GetBoltMatrix, G_G2_GETBOLT);
+    PASSTHROUGH_IMPORT(G2API_GetBoltMatrix_NoReconstruct, G_G2_GETBOLT_NOREC);
+    PASSTHROUGH_IMPORT(G2API_GetBoltMatrix_NoRecNoRot, G_G2_GETBOLT_NOREC_NOROT);
+    PASSTHROUGH_IMPORT(G2API_InitGhoul2Model, G_G2_INITGHOUL2MODEL);
+    PASSTHROUGH_IMPORT(G2API_SetSkin, G_G2_SETSKIN);
+    PASSTHROUGH_IMPORT(G2API_Ghoul2Size, G_G2_SIZE);
+    PASSTHROUGH_IMPORT(G2API_AddBolt, G_G2_ADDBOLT);
+    PASSTHROUGH_IMPORT(G2API_SetBoltInfo, G_G2_SETBOLTINFO);
+    PASSTHROUGH_IMPORT(G2API_SetBoneAngles, G_G2_ANGLEOVERRIDE);
+    PASSTHROUGH_IMPORT(G2API_SetBoneAnim, G_G2_PLAYANIM);
+    PASSTHROUGH_IMPORT(G2API_GetBoneAnim, G_G2_GETBONEANIM);
+    PASSTHROUGH_IMPORT(G2API_GetGLAName, G_G2_GETGLANAME);
+    PASSTHROUGH_IMPORT(G2API_CopyGhoul2Instance, G_G2_COPYGHOUL2INSTANCE);
+    PASSTHROUGH_IMPORT(G2API_CopySpecificGhoul2Model, G_G2_COPYSPECIFICGHOUL2MODEL);
+    PASSTHROUGH_IMPORT(G2API_DuplicateGhoul2Instance, G_G2_DUPLICATEGHOUL2INSTANCE);
+    PASSTHROUGH_IMPORT(G2API_HasGhoul2ModelOnIndex, G_G2_HASGHOUL2MODELONINDEX);
+    PASSTHROUGH_IMPORT(G2API_RemoveGhoul2Model, G_G2_REMOVEGHOUL2MODEL);
+    PASSTHROUGH_IMPORT(G2API_RemoveGhoul2Models, G_G2_REMOVEGHOUL2MODELS);
+    PASSTHROUGH_IMPORT(G2API_CleanGhoul2Models, G_G2_CLEANMODELS);
+    PASSTHROUGH_IMPORT(G2API_CollisionDetect, G_G2_COLLISIONDETECT);
+    PASSTHROUGH_IMPORT(G2API_CollisionDetectCache, G_G2_COLLISIONDETECTCACHE);
+    PASSTHROUGH_IMPORT(G2API_SetRootSurface, G_G2_SETROOTSURFACE);
+    PASSTHROUGH_IMPORT(G2API_SetSurfaceOnOff, G_G2_SETSURFACEONOFF);
+    PASSTHROUGH_IMPORT(G2API_SetNewOrigin, G_G2_SETNEWORIGIN);
+    PASSTHROUGH_IMPORT(G2API_DoesBoneExist, G_G2_DOESBONEEXIST);
+    PASSTHROUGH_IMPORT(G2API_GetSurfaceRenderStatus, G_G2_GETSURFACERENDERSTATUS);
+    PASSTHROUGH_IMPORT(G2API_AbsurdSmoothing, G_G2_ABSURDSMOOTHING);
+    PASSTHROUGH_IMPORT(G2API_SetRagDoll, G_G2_SETRAGDOLL);
+    PASSTHROUGH_IMPORT(G2API_AnimateG2Models, G_G2_ANIMATEG2MODELS);
+    PASSTHROUGH_IMPORT(G2API_RagPCJConstraint, G_G2_RAGPCJCONSTRAINT);
+    PASSTHROUGH_IMPORT(G2API_RagPCJGradientSpeed, G_G2_RAGPCJGRADIENTSPEED);
+    PASSTHROUGH_IMPORT(G2API_RagEffectorGoal, G_G2_RAGEFFECTORGOAL);
+    PASSTHROUGH_IMPORT(G2API_GetRagBonePos, G_G2_GETRAGBONEPOS);
+    PASSTHROUGH_IMPORT(G2API_RagEffectorKick, G_G2_RAGEFFECTORKICK);
+    PASSTHROUGH_IMPORT(G2API_RagForceSolve, G_G2_RAGFORCESOLVE);
+    PASSTHROUGH_IMPORT(G2API_SetBoneIKState, G_G2_SETBONEIKSTATE);
+    PASSTHROUGH_IMPORT(G2API_IKMove, G_G2_IKMOVE);
+    PASSTHROUGH_IMPORT(G2API_RemoveBone, G_G2_REMOVEBONE);
+    PASSTHROUGH_IMPORT(G2API_AttachInstanceToEntNum, G_G2_ATTACHINSTANCETOENTNUM);
+    PASSTHROUGH_IMPORT(G2API_ClearAttachedInstance, G_G2_CLEARATTACHEDINSTANCE);
+    PASSTHROUGH_IMPORT(G2API_CleanEntAttachments, G_G2_CLEANENTATTACHMENTS);
+    PASSTHROUGH_IMPORT(G2API_OverrideServer, G_G2_OVERRIDESERVER);
+    PASSTHROUGH_IMPORT(G2API_GetSurfaceName, G_G2_GETSURFACENAME);
+
+    // QMM handles GAME_INIT, GAME_SHUTDOWN, and GAME_CONSOLE_COMMAND itself, so those always go through QMM
+    PASSTHROUGH_EXPORT(ClientConnect, GAME_CLIENT_CONNECT);
+    PASSTHROUGH_EXPORT(ClientBegin, GAME_CLIENT_BEGIN);
+    PASSTHROUGH_EXPORT(ClientUserinfoChanged, GAME_CLIENT_USERINFO_CHANGED);
+    PASSTHROUGH_EXPORT(ClientDisconnect, GAME_CLIENT_DISCONNECT);
+    PASSTHROUGH_EXPORT(ClientCommand, GAME_CLIENT_COMMAND);
+    PASSTHROUGH_EXPORT(ClientThink, GAME_CLIENT_THINK);
+    PASSTHROUGH_EXPORT(RunFrame, GAME_RUN_FRAME);
+    PASSTHROUGH_EXPORT(BotAIStartFrame, BOTAI_START_FRAME);
+    PASSTHROUGH_EXPORT(ROFF_NotetrackCallback, GAME_ROFF_NOTETRACK_CALLBACK);
+    PASSTHROUGH_EXPORT(SpawnRMGEntity, GAME_SPAWN_RMG_ENTITY);
+    PASSTHROUGH_EXPORT(ICARUS_PlaySound, GAME_ICARUS_PLAYSOUND);
+    PASSTHROUGH_EXPORT(ICARUS_Set, GAME_ICARUS_SET);
+    PASSTHROUGH_EXPORT(ICARUS_Lerp2Pos, GAME_ICARUS_LERP2POS);
+    PASSTHROUGH_EXPORT(ICARUS_Lerp2Origin, GAME_ICARUS_LERP2ORIGIN);
+    PASSTHROUGH_EXPORT(ICARUS_Lerp2Angles, GAME_ICARUS_LERP2ANGLES);
+    PASSTHROUGH_EXPORT(ICARUS_GetTag, GAME_ICARUS_GETTAG);
+    PASSTHROUGH_EXPORT(ICARUS_Lerp2Start, GAME_ICARUS_LERP2START);
+    PASSTHROUGH_EXPORT(ICARUS_Lerp2End, GAME_ICARUS_LERP2END);
+    PASSTHROUGH_EXPORT(ICARUS_Use, GAME_ICARUS_USE);
+    PASSTHROUGH_EXPORT(ICARUS_Kill, GAME_ICARUS_KILL);
+    PASSTHROUGH_EXPORT(ICARUS_Remove, GAME_ICARUS_REMOVE);
+    PASSTHROUGH_EXPORT(ICARUS_Play, GAME_ICARUS_PLAY);
+    PASSTHROUGH_EXPORT(ICARUS_GetFloat, GAME_ICARUS_GETFLOAT);
+    PASSTHROUGH_EXPORT(ICARUS_GetVector, GAME_ICARUS_GETVECTOR);
+    PASSTHROUGH_EXPORT(ICARUS_GetString, GAME_ICARUS_GETSTRING);
+    PASSTHROUGH_EXPORT(ICARUS_SoundIndex, GAME_ICARUS_SOUNDINDEX);
+    PASSTHROUGH_EXPORT(ICARUS_GetSetIDForString, GAME_ICARUS_GETSETIDFORSTRING);
+    PASSTHROUGH_EXPORT(NAV_ClearPathToPoint, GAME_NAV_CLEARPATHTOPOINT);
+    PASSTHROUGH_EXPORT(NPC_ClearLOS2, GAME_NAV_CLEARLOS);
+    PASSTHROUGH_EXPORT(NAVNEW_ClearPathBetweenPoints, GAME_NAV_CLEARPATHBETWEENPOINTS);
+    PASSTHROUGH_EXPORT(NAV_CheckNodeFailedForEnt, GAME_NAV_CHECKNODEFAILEDFORENT);
+    PASSTHROUGH_EXPORT(NAV_EntIsUnlockedDoor, GAME_NAV_ENTISUNLOCKEDDOOR);
+    PASSTHROUGH_EXPORT(NAV_EntIsDoor, GAME_NAV_ENTISDOOR);
+    PASSTHROUGH_EXPORT(NAV_EntIsBreakable, GAME_NAV_ENTISBREAKABLE);
+    PASSTHROUGH_EXPORT(NAV_EntIsRemovableUsable, GAME_NAV_ENTISREMOVABLEUSABLE);
+    PASSTHROUGH_EXPORT(NAV_FindCombatPointWaypoints, GAME_NAV_FINDCOMBATPOINTWAYPOINTS);
+    PASSTHROUGH_EXPORT(BG_GetItemIndexByTag, GAME_GETITEMINDEXBYTAG);
+
+    return count;
 }
 
 
@@ -1358,3 +1723,393 @@ game_export_t JAMP_GameSupport::qmm_export = {
         GEN_EXPORT(NAV_FindCombatPointWaypoints, GAME_NAV_FINDCOMBATPOINTWAYPOINTS),
         GEN_EXPORT(BG_GetItemIndexByTag, GAME_GETITEMINDEXBYTAG),
 };
+
+
+const game_import_t JAMP_GameSupport::routed_import = JAMP_GameSupport::qmm_import;
+
+
+const game_export_t JAMP_GameSupport::routed_export = JAMP_GameSupport::qmm_export;
+
+
+// number of args each engine message takes, read from the game_import_t declarations
+static constexpr MsgArgcDef syscall_argc_defs[] = {
+    GEN_IMPORT_ARGC(Print, G_PRINT),
+    GEN_IMPORT_ARGC(Error, G_ERROR),
+    GEN_IMPORT_ARGC(Milliseconds, G_MILLISECONDS),
+    GEN_IMPORT_ARGC(PrecisionTimerStart, G_PRECISIONTIMER_START),
+    GEN_IMPORT_ARGC(PrecisionTimerEnd, G_PRECISIONTIMER_END),
+    GEN_IMPORT_ARGC(SV_RegisterSharedMemory, G_SET_SHARED_BUFFER),
+    GEN_IMPORT_ARGC(RealTime, G_REAL_TIME),
+    GEN_IMPORT_ARGC(TrueMalloc, G_TRUEMALLOC),
+    GEN_IMPORT_ARGC(TrueFree, G_TRUEFREE),
+    GEN_IMPORT_ARGC(SnapVector, G_SNAPVECTOR),
+    GEN_IMPORT_ARGC(Cvar_Register, G_CVAR_REGISTER),
+    GEN_IMPORT_ARGC(Cvar_Set, G_CVAR_SET),
+    GEN_IMPORT_ARGC(Cvar_Update, G_CVAR_UPDATE),
+    GEN_IMPORT_ARGC(Cvar_VariableIntegerValue, G_CVAR_VARIABLE_INTEGER_VALUE),
+    GEN_IMPORT_ARGC(Cvar_VariableStringBuffer, G_CVAR_VARIABLE_STRING_BUFFER),
+    GEN_IMPORT_ARGC(Argc, G_ARGC),
+    GEN_IMPORT_ARGC(Argv, G_ARGV),
+    GEN_IMPORT_ARGC(FS_Close, G_FS_FCLOSE_FILE),
+    GEN_IMPORT_ARGC(FS_GetFileList, G_FS_GETFILELIST),
+    GEN_IMPORT_ARGC(FS_Open, G_FS_FOPEN_FILE),
+    GEN_IMPORT_ARGC(FS_Read, G_FS_READ),
+    GEN_IMPORT_ARGC(FS_Write, G_FS_WRITE),
+    GEN_IMPORT_ARGC(AdjustAreaPortalState, G_ADJUST_AREA_PORTAL_STATE),
+    GEN_IMPORT_ARGC(AreasConnected, G_AREAS_CONNECTED),
+    GEN_IMPORT_ARGC(DebugPolygonCreate, G_DEBUG_POLYGON_CREATE),
+    GEN_IMPORT_ARGC(DebugPolygonDelete, G_DEBUG_POLYGON_DELETE),
+    GEN_IMPORT_ARGC(DropClient, G_DROP_CLIENT),
+    GEN_IMPORT_ARGC(EntitiesInBox, G_ENTITIES_IN_BOX),
+    GEN_IMPORT_ARGC(EntityContact, G_ENTITY_CONTACT),
+    GEN_IMPORT_ARGC(GetConfigstring, G_GET_CONFIGSTRING),
+    GEN_IMPORT_ARGC(GetEntityToken, G_GET_ENTITY_TOKEN),
+    GEN_IMPORT_ARGC(GetServerinfo, G_GET_SERVERINFO),
+    GEN_IMPORT_ARGC(GetUsercmd, G_GET_USERCMD),
+    GEN_IMPORT_ARGC(GetUserinfo, G_GET_USERINFO),
+    GEN_IMPORT_ARGC(InPVS, G_IN_PVS),
+    GEN_IMPORT_ARGC(InPVSIgnorePortals, G_IN_PVS_IGNORE_PORTALS),
+    GEN_IMPORT_ARGC(LinkEntity, G_LINKENTITY),
+    GEN_IMPORT_ARGC(LocateGameData, G_LOCATE_GAME_DATA),
+    GEN_IMPORT_ARGC(PointContents, G_POINT_CONTENTS),
+    GEN_IMPORT_ARGC(SendConsoleCommand, G_SEND_CONSOLE_COMMAND),
+    GEN_IMPORT_ARGC(SendServerCommand, G_SEND_SERVER_COMMAND),
+    GEN_IMPORT_ARGC(SetBrushModel, G_SET_BRUSH_MODEL),
+    GEN_IMPORT_ARGC(SetConfigstring, G_SET_CONFIGSTRING),
+    GEN_IMPORT_ARGC(SetServerCull, G_SET_SERVER_CULL),
+    GEN_IMPORT_ARGC(SetUserinfo, G_SET_USERINFO),
+    GEN_IMPORT_ARGC(SiegePersSet, G_SIEGEPERSSET),
+    GEN_IMPORT_ARGC(SiegePersGet, G_SIEGEPERSGET),
+    GEN_IMPORT_ARGC(Trace, G_TRACE),
+    GEN_IMPORT_ARGC(UnlinkEntity, G_UNLINKENTITY),
+    GEN_IMPORT_ARGC(ROFF_Clean, G_ROFF_CLEAN),
+    GEN_IMPORT_ARGC(ROFF_UpdateEntities, G_ROFF_UPDATE_ENTITIES),
+    GEN_IMPORT_ARGC(ROFF_Cache, G_ROFF_CACHE),
+    GEN_IMPORT_ARGC(ROFF_Play, G_ROFF_PLAY),
+    GEN_IMPORT_ARGC(ROFF_Purge_Ent, G_ROFF_PURGE_ENT),
+    GEN_IMPORT_ARGC(ICARUS_RunScript, G_ICARUS_RUNSCRIPT),
+    GEN_IMPORT_ARGC(ICARUS_RegisterScript, G_ICARUS_REGISTERSCRIPT),
+    GEN_IMPORT_ARGC(ICARUS_Init, G_ICARUS_INIT),
+    GEN_IMPORT_ARGC(ICARUS_ValidEnt, G_ICARUS_VALIDENT),
+    GEN_IMPORT_ARGC(ICARUS_IsInitialized, G_ICARUS_ISINITIALIZED),
+    GEN_IMPORT_ARGC(ICARUS_MaintainTaskManager, G_ICARUS_MAINTAINTASKMANAGER),
+    GEN_IMPORT_ARGC(ICARUS_IsRunning, G_ICARUS_ISRUNNING),
+    GEN_IMPORT_ARGC(ICARUS_TaskIDPending, G_ICARUS_TASKIDPENDING),
+    GEN_IMPORT_ARGC(ICARUS_InitEnt, G_ICARUS_INITENT),
+    GEN_IMPORT_ARGC(ICARUS_FreeEnt, G_ICARUS_FREEENT),
+    GEN_IMPORT_ARGC(ICARUS_AssociateEnt, G_ICARUS_ASSOCIATEENT),
+    GEN_IMPORT_ARGC(ICARUS_Shutdown, G_ICARUS_SHUTDOWN),
+    GEN_IMPORT_ARGC(ICARUS_TaskIDSet, G_ICARUS_TASKIDSET),
+    GEN_IMPORT_ARGC(ICARUS_TaskIDComplete, G_ICARUS_TASKIDCOMPLETE),
+    GEN_IMPORT_ARGC(ICARUS_SetVar, G_ICARUS_SETVAR),
+    GEN_IMPORT_ARGC(ICARUS_VariableDeclared, G_ICARUS_VARIABLEDECLARED),
+    GEN_IMPORT_ARGC(ICARUS_GetFloatVariable, G_ICARUS_GETFLOATVARIABLE),
+    GEN_IMPORT_ARGC(ICARUS_GetStringVariable, G_ICARUS_GETSTRINGVARIABLE),
+    GEN_IMPORT_ARGC(ICARUS_GetVectorVariable, G_ICARUS_GETVECTORVARIABLE),
+    GEN_IMPORT_ARGC(Nav_Init, G_NAV_INIT),
+    GEN_IMPORT_ARGC(Nav_Free, G_NAV_FREE),
+    GEN_IMPORT_ARGC(Nav_Load, G_NAV_LOAD),
+    GEN_IMPORT_ARGC(Nav_Save, G_NAV_SAVE),
+    GEN_IMPORT_ARGC(Nav_AddRawPoint, G_NAV_ADDRAWPOINT),
+    GEN_IMPORT_ARGC(Nav_CalculatePaths, G_NAV_CALCULATEPATHS),
+    GEN_IMPORT_ARGC(Nav_HardConnect, G_NAV_HARDCONNECT),
+    GEN_IMPORT_ARGC(Nav_ShowNodes, G_NAV_SHOWNODES),
+    GEN_IMPORT_ARGC(Nav_ShowEdges, G_NAV_SHOWEDGES),
+    GEN_IMPORT_ARGC(Nav_ShowPath, G_NAV_SHOWPATH),
+    GEN_IMPORT_ARGC(Nav_GetNearestNode, G_NAV_GETNEARESTNODE),
+    GEN_IMPORT_ARGC(Nav_GetBestNode, G_NAV_GETBESTNODE),
+    GEN_IMPORT_ARGC(Nav_GetNodePosition, G_NAV_GETNODEPOSITION),
+    GEN_IMPORT_ARGC(Nav_GetNodeNumEdges, G_NAV_GETNODENUMEDGES),
+    GEN_IMPORT_ARGC(Nav_GetNodeEdge, G_NAV_GETNODEEDGE),
+    GEN_IMPORT_ARGC(Nav_GetNumNodes, G_NAV_GETNUMNODES),
+    GEN_IMPORT_ARGC(Nav_Connected, G_NAV_CONNECTED),
+    GEN_IMPORT_ARGC(Nav_GetPathCost, G_NAV_GETPATHCOST),
+    GEN_IMPORT_ARGC(Nav_GetEdgeCost, G_NAV_GETEDGECOST),
+    GEN_IMPORT_ARGC(Nav_GetProjectedNode, G_NAV_GETPROJECTEDNODE),
+    GEN_IMPORT_ARGC(Nav_CheckFailedNodes, G_NAV_CHECKFAILEDNODES),
+    GEN_IMPORT_ARGC(Nav_AddFailedNode, G_NAV_ADDFAILEDNODE),
+    GEN_IMPORT_ARGC(Nav_NodeFailed, G_NAV_NODEFAILED),
+    GEN_IMPORT_ARGC(Nav_NodesAreNeighbors, G_NAV_NODESARENEIGHBORS),
+    GEN_IMPORT_ARGC(Nav_ClearFailedEdge, G_NAV_CLEARFAILEDEDGE),
+    GEN_IMPORT_ARGC(Nav_ClearAllFailedEdges, G_NAV_CLEARALLFAILEDEDGES),
+    GEN_IMPORT_ARGC(Nav_EdgeFailed, G_NAV_EDGEFAILED),
+    GEN_IMPORT_ARGC(Nav_AddFailedEdge, G_NAV_ADDFAILEDEDGE),
+    GEN_IMPORT_ARGC(Nav_CheckFailedEdge, G_NAV_CHECKFAILEDEDGE),
+    GEN_IMPORT_ARGC(Nav_CheckAllFailedEdges, G_NAV_CHECKALLFAILEDEDGES),
+    GEN_IMPORT_ARGC(Nav_RouteBlocked, G_NAV_ROUTEBLOCKED),
+    GEN_IMPORT_ARGC(Nav_GetBestNodeAltRoute, G_NAV_GETBESTNODEALTROUTE),
+    GEN_IMPORT_ARGC(Nav_GetBestNodeAltRoute2, G_NAV_GETBESTNODEALT2),
+    GEN_IMPORT_ARGC(Nav_GetBestPathBetweenEnts, G_NAV_GETBESTPATHBETWEENENTS),
+    GEN_IMPORT_ARGC(Nav_GetNodeRadius, G_NAV_GETNODERADIUS),
+    GEN_IMPORT_ARGC(Nav_CheckBlockedEdges, G_NAV_CHECKBLOCKEDEDGES),
+    GEN_IMPORT_ARGC(Nav_ClearCheckedNodes, G_NAV_CLEARCHECKEDNODES),
+    GEN_IMPORT_ARGC(Nav_CheckedNode, G_NAV_CHECKEDNODE),
+    GEN_IMPORT_ARGC(Nav_SetCheckedNode, G_NAV_SETCHECKEDNODE),
+    GEN_IMPORT_ARGC(Nav_FlagAllNodes, G_NAV_FLAGALLNODES),
+    GEN_IMPORT_ARGC(Nav_GetPathsCalculated, G_NAV_GETPATHSCALCULATED),
+    GEN_IMPORT_ARGC(Nav_SetPathsCalculated, G_NAV_SETPATHSCALCULATED),
+    GEN_IMPORT_ARGC(BotAllocateClient, G_BOT_ALLOCATE_CLIENT),
+    GEN_IMPORT_ARGC(BotFreeClient, G_BOT_FREE_CLIENT),
+    GEN_IMPORT_ARGC(BotLoadCharacter, BOTLIB_AI_LOAD_CHARACTER),
+    GEN_IMPORT_ARGC(BotFreeCharacter, BOTLIB_AI_FREE_CHARACTER),
+    GEN_IMPORT_ARGC(Characteristic_Float, BOTLIB_AI_CHARACTERISTIC_FLOAT),
+    GEN_IMPORT_ARGC(Characteristic_BFloat, BOTLIB_AI_CHARACTERISTIC_BFLOAT),
+    GEN_IMPORT_ARGC(Characteristic_Integer, BOTLIB_AI_CHARACTERISTIC_INTEGER),
+    GEN_IMPORT_ARGC(Characteristic_BInteger, BOTLIB_AI_CHARACTERISTIC_BINTEGER),
+    GEN_IMPORT_ARGC(Characteristic_String, BOTLIB_AI_CHARACTERISTIC_STRING),
+    GEN_IMPORT_ARGC(BotAllocChatState, BOTLIB_AI_ALLOC_CHAT_STATE),
+    GEN_IMPORT_ARGC(BotFreeChatState, BOTLIB_AI_FREE_CHAT_STATE),
+    GEN_IMPORT_ARGC(BotQueueConsoleMessage, BOTLIB_AI_QUEUE_CONSOLE_MESSAGE),
+    GEN_IMPORT_ARGC(BotRemoveConsoleMessage, BOTLIB_AI_REMOVE_CONSOLE_MESSAGE),
+    GEN_IMPORT_ARGC(BotNextConsoleMessage, BOTLIB_AI_NEXT_CONSOLE_MESSAGE),
+    GEN_IMPORT_ARGC(BotNumConsoleMessages, BOTLIB_AI_NUM_CONSOLE_MESSAGE),
+    GEN_IMPORT_ARGC(BotInitialChat, BOTLIB_AI_INITIAL_CHAT),
+    GEN_IMPORT_ARGC(BotReplyChat, BOTLIB_AI_REPLY_CHAT),
+    GEN_IMPORT_ARGC(BotChatLength, BOTLIB_AI_CHAT_LENGTH),
+    GEN_IMPORT_ARGC(BotEnterChat, BOTLIB_AI_ENTER_CHAT),
+    GEN_IMPORT_ARGC(StringContains, BOTLIB_AI_STRING_CONTAINS),
+    GEN_IMPORT_ARGC(BotFindMatch, BOTLIB_AI_FIND_MATCH),
+    GEN_IMPORT_ARGC(BotMatchVariable, BOTLIB_AI_MATCH_VARIABLE),
+    GEN_IMPORT_ARGC(UnifyWhiteSpaces, BOTLIB_AI_UNIFY_WHITE_SPACES),
+    GEN_IMPORT_ARGC(BotReplaceSynonyms, BOTLIB_AI_REPLACE_SYNONYMS),
+    GEN_IMPORT_ARGC(BotLoadChatFile, BOTLIB_AI_LOAD_CHAT_FILE),
+    GEN_IMPORT_ARGC(BotSetChatGender, BOTLIB_AI_SET_CHAT_GENDER),
+    GEN_IMPORT_ARGC(BotSetChatName, BOTLIB_AI_SET_CHAT_NAME),
+    GEN_IMPORT_ARGC(BotResetGoalState, BOTLIB_AI_RESET_GOAL_STATE),
+    GEN_IMPORT_ARGC(BotResetAvoidGoals, BOTLIB_AI_RESET_AVOID_GOALS),
+    GEN_IMPORT_ARGC(BotPushGoal, BOTLIB_AI_PUSH_GOAL),
+    GEN_IMPORT_ARGC(BotPopGoal, BOTLIB_AI_POP_GOAL),
+    GEN_IMPORT_ARGC(BotEmptyGoalStack, BOTLIB_AI_EMPTY_GOAL_STACK),
+    GEN_IMPORT_ARGC(BotDumpAvoidGoals, BOTLIB_AI_DUMP_AVOID_GOALS),
+    GEN_IMPORT_ARGC(BotDumpGoalStack, BOTLIB_AI_DUMP_GOAL_STACK),
+    GEN_IMPORT_ARGC(BotGoalName, BOTLIB_AI_GOAL_NAME),
+    GEN_IMPORT_ARGC(BotGetTopGoal, BOTLIB_AI_GET_TOP_GOAL),
+    GEN_IMPORT_ARGC(BotGetSecondGoal, BOTLIB_AI_GET_SECOND_GOAL),
+    GEN_IMPORT_ARGC(BotChooseLTGItem, BOTLIB_AI_CHOOSE_LTG_ITEM),
+    GEN_IMPORT_ARGC(BotChooseNBGItem, BOTLIB_AI_CHOOSE_NBG_ITEM),
+    GEN_IMPORT_ARGC(BotTouchingGoal, BOTLIB_AI_TOUCHING_GOAL),
+    GEN_IMPORT_ARGC(BotItemGoalInVisButNotVisible, BOTLIB_AI_ITEM_GOAL_IN_VIS_BUT_NOT_VISIBLE),
+    GEN_IMPORT_ARGC(BotGetLevelItemGoal, BOTLIB_AI_GET_LEVEL_ITEM_GOAL),
+    GEN_IMPORT_ARGC(BotAvoidGoalTime, BOTLIB_AI_AVOID_GOAL_TIME),
+    GEN_IMPORT_ARGC(BotInitLevelItems, BOTLIB_AI_INIT_LEVEL_ITEMS),
+    GEN_IMPORT_ARGC(BotUpdateEntityItems, BOTLIB_AI_UPDATE_ENTITY_ITEMS),
+    GEN_IMPORT_ARGC(BotLoadItemWeights, BOTLIB_AI_LOAD_ITEM_WEIGHTS),
+    GEN_IMPORT_ARGC(BotFreeItemWeights, BOTLIB_AI_FREE_ITEM_WEIGHTS),
+    GEN_IMPORT_ARGC(BotSaveGoalFuzzyLogic, BOTLIB_AI_SAVE_GOAL_FUZZY_LOGIC),
+    GEN_IMPORT_ARGC(BotAllocGoalState, BOTLIB_AI_ALLOC_GOAL_STATE),
+    GEN_IMPORT_ARGC(BotFreeGoalState, BOTLIB_AI_FREE_GOAL_STATE),
+    GEN_IMPORT_ARGC(BotResetMoveState, BOTLIB_AI_RESET_MOVE_STATE),
+    GEN_IMPORT_ARGC(BotMoveToGoal, BOTLIB_AI_MOVE_TO_GOAL),
+    GEN_IMPORT_ARGC(BotMoveInDirection, BOTLIB_AI_MOVE_IN_DIRECTION),
+    GEN_IMPORT_ARGC(BotResetAvoidReach, BOTLIB_AI_RESET_AVOID_REACH),
+    GEN_IMPORT_ARGC(BotResetLastAvoidReach, BOTLIB_AI_RESET_LAST_AVOID_REACH),
+    GEN_IMPORT_ARGC(BotReachabilityArea, BOTLIB_AI_REACHABILITY_AREA),
+    GEN_IMPORT_ARGC(BotMovementViewTarget, BOTLIB_AI_MOVEMENT_VIEW_TARGET),
+    GEN_IMPORT_ARGC(BotAllocMoveState, BOTLIB_AI_ALLOC_MOVE_STATE),
+    GEN_IMPORT_ARGC(BotFreeMoveState, BOTLIB_AI_FREE_MOVE_STATE),
+    GEN_IMPORT_ARGC(BotInitMoveState, BOTLIB_AI_INIT_MOVE_STATE),
+    GEN_IMPORT_ARGC(BotChooseBestFightWeapon, BOTLIB_AI_CHOOSE_BEST_FIGHT_WEAPON),
+    GEN_IMPORT_ARGC(BotGetWeaponInfo, BOTLIB_AI_GET_WEAPON_INFO),
+    GEN_IMPORT_ARGC(BotLoadWeaponWeights, BOTLIB_AI_LOAD_WEAPON_WEIGHTS),
+    GEN_IMPORT_ARGC(BotAllocWeaponState, BOTLIB_AI_ALLOC_WEAPON_STATE),
+    GEN_IMPORT_ARGC(BotFreeWeaponState, BOTLIB_AI_FREE_WEAPON_STATE),
+    GEN_IMPORT_ARGC(BotResetWeaponState, BOTLIB_AI_RESET_WEAPON_STATE),
+    GEN_IMPORT_ARGC(GeneticParentsAndChildSelection, BOTLIB_AI_GENETIC_PARENTS_AND_CHILD_SELECTION),
+    GEN_IMPORT_ARGC(BotInterbreedGoalFuzzyLogic, BOTLIB_AI_INTERBREED_GOAL_FUZZY_LOGIC),
+    GEN_IMPORT_ARGC(BotMutateGoalFuzzyLogic, BOTLIB_AI_MUTATE_GOAL_FUZZY_LOGIC),
+    GEN_IMPORT_ARGC(BotGetNextCampSpotGoal, BOTLIB_AI_GET_NEXT_CAMP_SPOT_GOAL),
+    GEN_IMPORT_ARGC(BotGetMapLocationGoal, BOTLIB_AI_GET_MAP_LOCATION_GOAL),
+    GEN_IMPORT_ARGC(BotNumInitialChats, BOTLIB_AI_NUM_INITIAL_CHATS),
+    GEN_IMPORT_ARGC(BotGetChatMessage, BOTLIB_AI_GET_CHAT_MESSAGE),
+    GEN_IMPORT_ARGC(BotRemoveFromAvoidGoals, BOTLIB_AI_REMOVE_FROM_AVOID_GOALS),
+    GEN_IMPORT_ARGC(BotPredictVisiblePosition, BOTLIB_AI_PREDICT_VISIBLE_POSITION),
+    GEN_IMPORT_ARGC(BotSetAvoidGoalTime, BOTLIB_AI_SET_AVOID_GOAL_TIME),
+    GEN_IMPORT_ARGC(BotAddAvoidSpot, BOTLIB_AI_ADD_AVOID_SPOT),
+    GEN_IMPORT_ARGC(BotLibSetup, BOTLIB_SETUP),
+    GEN_IMPORT_ARGC(BotLibShutdown, BOTLIB_SHUTDOWN),
+    GEN_IMPORT_ARGC(BotLibVarSet, BOTLIB_LIBVAR_SET),
+    GEN_IMPORT_ARGC(BotLibVarGet, BOTLIB_LIBVAR_GET),
+    GEN_IMPORT_ARGC(BotLibDefine, BOTLIB_PC_ADD_GLOBAL_DEFINE),
+    GEN_IMPORT_ARGC(BotLibStartFrame, BOTLIB_START_FRAME),
+    GEN_IMPORT_ARGC(BotLibLoadMap, BOTLIB_LOAD_MAP),
+    GEN_IMPORT_ARGC(BotLibUpdateEntity, BOTLIB_UPDATENTITY),
+    GEN_IMPORT_ARGC(BotLibTest, BOTLIB_TEST),
+    GEN_IMPORT_ARGC(BotGetSnapshotEntity, BOTLIB_GET_SNAPSHOT_ENTITY),
+    GEN_IMPORT_ARGC(BotGetServerCommand, BOTLIB_GET_CONSOLE_MESSAGE),
+    GEN_IMPORT_ARGC(BotUserCommand, BOTLIB_USER_COMMAND),
+    GEN_IMPORT_ARGC(BotUpdateWaypoints, G_BOT_UPDATEWAYPOINTS),
+    GEN_IMPORT_ARGC(BotCalculatePaths, G_BOT_CALCULATEPATHS),
+    GEN_IMPORT_ARGC(AAS_EnableRoutingArea, BOTLIB_AAS_ENABLE_ROUTING_AREA),
+    GEN_IMPORT_ARGC(AAS_BBoxAreas, BOTLIB_AAS_BBOX_AREAS),
+    GEN_IMPORT_ARGC(AAS_AreaInfo, BOTLIB_AAS_AREA_INFO),
+    GEN_IMPORT_ARGC(AAS_EntityInfo, BOTLIB_AAS_ENTITY_INFO),
+    GEN_IMPORT_ARGC(AAS_Initialized, BOTLIB_AAS_INITIALIZED),
+    GEN_IMPORT_ARGC(AAS_PresenceTypeBoundingBox, BOTLIB_AAS_PRESENCE_TYPE_BOUNDING_BOX),
+    GEN_IMPORT_ARGC(AAS_Time, BOTLIB_AAS_TIME),
+    GEN_IMPORT_ARGC(AAS_PointAreaNum, BOTLIB_AAS_POINT_AREA_NUM),
+    GEN_IMPORT_ARGC(AAS_TraceAreas, BOTLIB_AAS_TRACE_AREAS),
+    GEN_IMPORT_ARGC(AAS_PointContents, BOTLIB_AAS_POINT_CONTENTS),
+    GEN_IMPORT_ARGC(AAS_NextBSPEntity, BOTLIB_AAS_NEXT_BSP_ENTITY),
+    GEN_IMPORT_ARGC(AAS_ValueForBSPEpairKey, BOTLIB_AAS_VALUE_FOR_BSP_EPAIR_KEY),
+    GEN_IMPORT_ARGC(AAS_VectorForBSPEpairKey, BOTLIB_AAS_VECTOR_FOR_BSP_EPAIR_KEY),
+    GEN_IMPORT_ARGC(AAS_FloatForBSPEpairKey, BOTLIB_AAS_FLOAT_FOR_BSP_EPAIR_KEY),
+    GEN_IMPORT_ARGC(AAS_IntForBSPEpairKey, BOTLIB_AAS_INT_FOR_BSP_EPAIR_KEY),
+    GEN_IMPORT_ARGC(AAS_AreaReachability, BOTLIB_AAS_AREA_REACHABILITY),
+    GEN_IMPORT_ARGC(AAS_AreaTravelTimeToGoalArea, BOTLIB_AAS_AREA_TRAVEL_TIME_TO_GOAL_AREA),
+    GEN_IMPORT_ARGC(AAS_Swimming, BOTLIB_AAS_SWIMMING),
+    GEN_IMPORT_ARGC(AAS_PredictClientMovement, BOTLIB_AAS_PREDICT_CLIENT_MOVEMENT),
+    GEN_IMPORT_ARGC(AAS_AlternativeRouteGoals, BOTLIB_AAS_ALTERNATIVE_ROUTE_GOAL),
+    GEN_IMPORT_ARGC(AAS_PredictRoute, BOTLIB_AAS_PREDICT_ROUTE),
+    GEN_IMPORT_ARGC(AAS_PointReachabilityAreaIndex, BOTLIB_AAS_POINT_REACHABILITY_AREA_INDEX),
+    GEN_IMPORT_ARGC(EA_Say, BOTLIB_EA_SAY),
+    GEN_IMPORT_ARGC(EA_SayTeam, BOTLIB_EA_SAY_TEAM),
+    GEN_IMPORT_ARGC(EA_Command, BOTLIB_EA_COMMAND),
+    GEN_IMPORT_ARGC(EA_Action, BOTLIB_EA_ACTION),
+    GEN_IMPORT_ARGC(EA_Gesture, BOTLIB_EA_GESTURE),
+    GEN_IMPORT_ARGC(EA_Talk, BOTLIB_EA_TALK),
+    GEN_IMPORT_ARGC(EA_Attack, BOTLIB_EA_ATTACK),
+    GEN_IMPORT_ARGC(EA_Alt_Attack, BOTLIB_EA_ALT_ATTACK),
+    GEN_IMPORT_ARGC(EA_ForcePower, BOTLIB_EA_FORCEPOWER),
+    GEN_IMPORT_ARGC(EA_Use, BOTLIB_EA_USE),
+    GEN_IMPORT_ARGC(EA_Respawn, BOTLIB_EA_RESPAWN),
+    GEN_IMPORT_ARGC(EA_Crouch, BOTLIB_EA_CROUCH),
+    GEN_IMPORT_ARGC(EA_MoveUp, BOTLIB_EA_MOVE_UP),
+    GEN_IMPORT_ARGC(EA_MoveDown, BOTLIB_EA_MOVE_DOWN),
+    GEN_IMPORT_ARGC(EA_MoveForward, BOTLIB_EA_MOVE_FORWARD),
+    GEN_IMPORT_ARGC(EA_MoveBack, BOTLIB_EA_MOVE_BACK),
+    GEN_IMPORT_ARGC(EA_MoveLeft, BOTLIB_EA_MOVE_LEFT),
+    GEN_IMPORT_ARGC(EA_MoveRight, BOTLIB_EA_MOVE_RIGHT),
+    GEN_IMPORT_ARGC(EA_SelectWeapon, BOTLIB_EA_SELECT_WEAPON),
+    GEN_IMPORT_ARGC(EA_Jump, BOTLIB_EA_JUMP),
+    GEN_IMPORT_ARGC(EA_DelayedJump, BOTLIB_EA_DELAYED_JUMP),
+    GEN_IMPORT_ARGC(EA_Move, BOTLIB_EA_MOVE),
+    GEN_IMPORT_ARGC(EA_View, BOTLIB_EA_VIEW),
+    GEN_IMPORT_ARGC(EA_EndRegular, BOTLIB_EA_END_REGULAR),
+    GEN_IMPORT_ARGC(EA_GetInput, BOTLIB_EA_GET_INPUT),
+    GEN_IMPORT_ARGC(EA_ResetInput, BOTLIB_EA_RESET_INPUT),
+    GEN_IMPORT_ARGC(PC_LoadSource, BOTLIB_PC_LOAD_SOURCE),
+    GEN_IMPORT_ARGC(PC_FreeSource, BOTLIB_PC_FREE_SOURCE),
+    GEN_IMPORT_ARGC(PC_ReadToken, BOTLIB_PC_READ_TOKEN),
+    GEN_IMPORT_ARGC(PC_SourceFileAndLine, BOTLIB_PC_SOURCE_FILE_AND_LINE),
+    GEN_IMPORT_ARGC(R_RegisterSkin, G_R_REGISTERSKIN),
+    GEN_IMPORT_ARGC(SetActiveSubBSP, G_SET_ACTIVE_SUBBSP),
+    GEN_IMPORT_ARGC(CM_RegisterTerrain, G_CM_REGISTER_TERRAIN),
+    GEN_IMPORT_ARGC(RMG_Init, G_RMG_INIT),
+    GEN_IMPORT_ARGC(G2API_ListModelBones, G_G2_LISTBONES),
+    GEN_IMPORT_ARGC(G2API_ListModelSurfaces, G_G2_LISTSURFACES),
+    GEN_IMPORT_ARGC(G2API_HaveWeGhoul2Models, G_G2_HAVEWEGHOULMODELS),
+    GEN_IMPORT_ARGC(G2API_SetGhoul2ModelIndexes, G_G2_SETMODELS),
+    GEN_IMPORT_ARGC(G2API_GetBoltMatrix, G_G2_GETBOLT),
+    GEN_IMPORT_ARGC(G2API_GetBoltMatrix_NoReconstruct, G_G2_GETBOLT_NOREC),
+    GEN_IMPORT_ARGC(G2API_GetBoltMatrix_NoRecNoRot, G_G2_GETBOLT_NOREC_NOROT),
+    GEN_IMPORT_ARGC(G2API_InitGhoul2Model, G_G2_INITGHOUL2MODEL),
+    GEN_IMPORT_ARGC(G2API_SetSkin, G_G2_SETSKIN),
+    GEN_IMPORT_ARGC(G2API_Ghoul2Size, G_G2_SIZE),
+    GEN_IMPORT_ARGC(G2API_AddBolt, G_G2_ADDBOLT),
+    GEN_IMPORT_ARGC(G2API_SetBoltInfo, G_G2_SETBOLTINFO),
+    GEN_IMPORT_ARGC(G2API_SetBoneAngles, G_G2_ANGLEOVERRIDE),
+    GEN_IMPORT_ARGC(G2API_SetBoneAnim, G_G2_PLAYANIM),
+    GEN_IMPORT_ARGC(G2API_GetBoneAnim, G_G2_GETBONEANIM),
+    GEN_IMPORT_ARGC(G2API_GetGLAName, G_G2_GETGLANAME),
+    GEN_IMPORT_ARGC(G2API_CopyGhoul2Instance, G_G2_COPYGHOUL2INSTANCE),
+    GEN_IMPORT_ARGC(G2API_CopySpecificGhoul2Model, G_G2_COPYSPECIFICGHOUL2MODEL),
+    GEN_IMPORT_ARGC(G2API_DuplicateGhoul2Instance, G_G2_DUPLICATEGHOUL2INSTANCE),
+    GEN_IMPORT_ARGC(G2API_HasGhoul2ModelOnIndex, G_G2_HASGHOUL2MODELONINDEX),
+    GEN_IMPORT_ARGC(G2API_RemoveGhoul2Model, G_G2_REMOVEGHOUL2MODEL),
+    GEN_IMPORT_ARGC(G2API_RemoveGhoul2Models, G_G2_REMOVEGHOUL2MODELS),
+    GEN_IMPORT_ARGC(G2API_CleanGhoul2Models, G_G2_CLEANMODELS),
+    GEN_IMPORT_ARGC(G2API_CollisionDetect, G_G2_COLLISIONDETECT),
+    GEN_IMPORT_ARGC(G2API_CollisionDetectCache, G_G2_COLLISIONDETECTCACHE),
+    GEN_IMPORT_ARGC(G2API_SetRootSurface, G_G2_SETROOTSURFACE),
+    GEN_IMPORT_ARGC(G2API_SetSurfaceOnOff, G_G2_SETSURFACEONOFF),
+    GEN_IMPORT_ARGC(G2API_SetNewOrigin, G_G2_SETNEWORIGIN),
+    GEN_IMPORT_ARGC(G2API_DoesBoneExist, G_G2_DOESBONEEXIST),
+    GEN_IMPORT_ARGC(G2API_GetSurfaceRenderStatus, G_G2_GETSURFACERENDERSTATUS),
+    GEN_IMPORT_ARGC(G2API_AbsurdSmoothing, G_G2_ABSURDSMOOTHING),
+    GEN_IMPORT_ARGC(G2API_SetRagDoll, G_G2_SETRAGDOLL),
+    GEN_IMPORT_ARGC(G2API_AnimateG2Models, G_G2_ANIMATEG2MODELS),
+    GEN_IMPORT_ARGC(G2API_RagPCJConstraint, G_G2_RAGPCJCONSTRAINT),
+    GEN_IMPORT_ARGC(G2API_RagPCJGradientSpeed, G_G2_RAGPCJGRADIENTSPEED),
+    GEN_IMPORT_ARGC(G2API_RagEffectorGoal, G_G2_RAGEFFECTORGOAL),
+    GEN_IMPORT_ARGC(G2API_GetRagBonePos, G_G2_GETRAGBONEPOS),
+    GEN_IMPORT_ARGC(G2API_RagEffectorKick, G_G2_RAGEFFECTORKICK),
+    GEN_IMPORT_ARGC(G2API_RagForceSolve, G_G2_RAGFORCESOLVE),
+    GEN_IMPORT_ARGC(G2API_SetBoneIKState, G_G2_SETBONEIKSTATE),
+    GEN_IMPORT_ARGC(G2API_IKMove, G_G2_IKMOVE),
+    GEN_IMPORT_ARGC(G2API_RemoveBone, G_G2_REMOVEBONE),
+    GEN_IMPORT_ARGC(G2API_AttachInstanceToEntNum, G_G2_ATTACHINSTANCETOENTNUM),
+    GEN_IMPORT_ARGC(G2API_ClearAttachedInstance, G_G2_CLEARATTACHEDINSTANCE),
+    GEN_IMPORT_ARGC(G2API_CleanEntAttachments, G_G2_CLEANENTATTACHMENTS),
+    GEN_IMPORT_ARGC(G2API_OverrideServer, G_G2_OVERRIDESERVER),
+    GEN_IMPORT_ARGC(G2API_GetSurfaceName, G_G2_GETSURFACENAME),
+};
+
+static constexpr auto syscall_argcs = GEN_SYSCALL_ARGC_TABLE(syscall_argc_defs);
+
+
+// number of args each mod message takes, read from the game_export_t declarations
+static constexpr MsgArgcDef vmmain_argc_defs[] = {
+    GEN_EXPORT_ARGC(InitGame, GAME_INIT),
+    GEN_EXPORT_ARGC(ShutdownGame, GAME_SHUTDOWN),
+    GEN_EXPORT_ARGC(ClientConnect, GAME_CLIENT_CONNECT),
+    GEN_EXPORT_ARGC(ClientBegin, GAME_CLIENT_BEGIN),
+    GEN_EXPORT_ARGC(ClientUserinfoChanged, GAME_CLIENT_USERINFO_CHANGED),
+    GEN_EXPORT_ARGC(ClientDisconnect, GAME_CLIENT_DISCONNECT),
+    GEN_EXPORT_ARGC(ClientCommand, GAME_CLIENT_COMMAND),
+    GEN_EXPORT_ARGC(ClientThink, GAME_CLIENT_THINK),
+    GEN_EXPORT_ARGC(RunFrame, GAME_RUN_FRAME),
+    GEN_EXPORT_ARGC(ConsoleCommand, GAME_CONSOLE_COMMAND),
+    GEN_EXPORT_ARGC(BotAIStartFrame, BOTAI_START_FRAME),
+    GEN_EXPORT_ARGC(ROFF_NotetrackCallback, GAME_ROFF_NOTETRACK_CALLBACK),
+    GEN_EXPORT_ARGC(SpawnRMGEntity, GAME_SPAWN_RMG_ENTITY),
+    GEN_EXPORT_ARGC(ICARUS_PlaySound, GAME_ICARUS_PLAYSOUND),
+    GEN_EXPORT_ARGC(ICARUS_Set, GAME_ICARUS_SET),
+    GEN_EXPORT_ARGC(ICARUS_Lerp2Pos, GAME_ICARUS_LERP2POS),
+    GEN_EXPORT_ARGC(ICARUS_Lerp2Origin, GAME_ICARUS_LERP2ORIGIN),
+    GEN_EXPORT_ARGC(ICARUS_Lerp2Angles, GAME_ICARUS_LERP2ANGLES),
+    GEN_EXPORT_ARGC(ICARUS_GetTag, GAME_ICARUS_GETTAG),
+    GEN_EXPORT_ARGC(ICARUS_Lerp2Start, GAME_ICARUS_LERP2START),
+    GEN_EXPORT_ARGC(ICARUS_Lerp2End, GAME_ICARUS_LERP2END),
+    GEN_EXPORT_ARGC(ICARUS_Use, GAME_ICARUS_USE),
+    GEN_EXPORT_ARGC(ICARUS_Kill, GAME_ICARUS_KILL),
+    GEN_EXPORT_ARGC(ICARUS_Remove, GAME_ICARUS_REMOVE),
+    GEN_EXPORT_ARGC(ICARUS_Play, GAME_ICARUS_PLAY),
+    GEN_EXPORT_ARGC(ICARUS_GetFloat, GAME_ICARUS_GETFLOAT),
+    GEN_EXPORT_ARGC(ICARUS_GetVector, GAME_ICARUS_GETVECTOR),
+    GEN_EXPORT_ARGC(ICARUS_GetString, GAME_ICARUS_GETSTRING),
+    GEN_EXPORT_ARGC(ICARUS_SoundIndex, GAME_ICARUS_SOUNDINDEX),
+    GEN_EXPORT_ARGC(ICARUS_GetSetIDForString, GAME_ICARUS_GETSETIDFORSTRING),
+    GEN_EXPORT_ARGC(NAV_ClearPathToPoint, GAME_NAV_CLEARPATHTOPOINT),
+    GEN_EXPORT_ARGC(NPC_ClearLOS2, GAME_NAV_CLEARLOS),
+    GEN_EXPORT_ARGC(NAVNEW_ClearPathBetweenPoints, GAME_NAV_CLEARPATHBETWEENPOINTS),
+    GEN_EXPORT_ARGC(NAV_CheckNodeFailedForEnt, GAME_NAV_CHECKNODEFAILEDFORENT),
+    GEN_EXPORT_ARGC(NAV_EntIsUnlockedDoor, GAME_NAV_ENTISUNLOCKEDDOOR),
+    GEN_EXPORT_ARGC(NAV_EntIsDoor, GAME_NAV_ENTISDOOR),
+    GEN_EXPORT_ARGC(NAV_EntIsBreakable, GAME_NAV_ENTISBREAKABLE),
+    GEN_EXPORT_ARGC(NAV_EntIsRemovableUsable, GAME_NAV_ENTISREMOVABLEUSABLE),
+    GEN_EXPORT_ARGC(NAV_FindCombatPointWaypoints, GAME_NAV_FINDCOMBATPOINTWAYPOINTS),
+    GEN_EXPORT_ARGC(BG_GetItemIndexByTag, GAME_GETITEMINDEXBYTAG),
+};
+
+static constexpr auto vmmain_argcs = GEN_VMMAIN_ARGC_TABLE(vmmain_argc_defs);
+
+
+// the tables only describe the OpenJK "new" API, so the "legacy" API gets every arg passed on
+const int8_t* JAMP_GameSupport::SyscallArgcs(int* count) {
+    if (orig_syscall) {
+        *count = 0;
+        return nullptr;
+    }
+    *count = syscall_argcs.count;
+    return syscall_argcs.argc;
+}
+
+
+const int8_t* JAMP_GameSupport::VMMainArgcs(int* count) {
+    if (orig_vmMain) {
+        *count = 0;
+        return nullptr;
+    }
+    *count = vmmain_argcs.count;
+    return vmmain_argcs.argc;
+}
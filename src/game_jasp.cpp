@@ -33,8 +33,10 @@ struct JASP_GameSupport : public GameSupport {
     virtual int QMMEngMsg(int msg) { return qmm_eng_msgs[msg]; }
     virtual int QMMModMsg(int msg) { return qmm_mod_msgs[msg]; }
 
-    virtual intptr_t syscall(intptr_t, ...);
-    virtual intptr_t vmMain(intptr_t, ...);
+    virtual intptr_t syscall_args(intptr_t, intptr_t*, int);
+    virtual intptr_t vmMain_args(intptr_t, intptr_t*, int);
+    virtual const int8_t* SyscallArgcs(int* count);
+    virtual const int8_t* VMMainArgcs(int* count);
 
     virtual const char* DefaultDLLName() { return "jagame" MOD_DLL; }
     virtual const char* DefaultModDir() { return "."; }
@@ -87,9 +89,7 @@ bool JASP_GameSupport::AutoDetect(APIType engineapi) {
 
 // wrapper syscall function that calls actual engine func from orig_import
 // this is how QMM and plugins will call into the engine
-intptr_t JASP_GameSupport::syscall(intptr_t cmd, ...) {
-    QMM_GET_SYSCALL_ARGS();
-
+intptr_t JASP_GameSupport::syscall_args(intptr_t cmd, intptr_t* args, int argc) {
     if (cmd != G_PRINT)
         QMMLOG(QMM_LOG_TRACE, "QMM") << "JASP_GameSupport::syscall(" << EngMsgName(cmd) << "(" << cmd << ")) called\n";
 
@@ -330,9 +330,7 @@ intptr_t JASP_GameSupport::syscall(intptr_t cmd, ...) {
 
 // wrapper vmMain function that calls actual mod func from orig_export
 // this is how QMM and plugins will call into the mod
-intptr_t JASP_GameSupport::vmMain(intptr_t cmd, ...) {
-    QMM_GET_VMMAIN_ARGS();
-
+intptr_t JASP_GameSupport::vmMain_args(intptr_t cmd, intptr_t* args, int argc) {
     QMMLOG(QMM_LOG_TRACE, "QMM") << "JASP_GameSupport::vmMain(" << ModMsgName(cmd) << "(" << cmd << ")) called\n";
 
     if (!orig_export)
@@ -794,3 +792,174 @@ game_export_t JASP_GameSupport::qmm_export = {
     0,			// gentitySize
     0,			// num_entities
 };
+
+
+// number of args each engine message takes, read from the game_import_t declarations
+static constexpr MsgArgcDef syscall_argc_defs[] = {
+    GEN_IMPORT_ARGC(Printf, G_PRINTF),
+    GEN_IMPORT_ARGC(WriteCam, G_WRITECAM),
+    GEN_IMPORT_ARGC(FlushCamFile, G_FLUSHCAMFILE),
+    GEN_IMPORT_ARGC(Error, G_ERROR),
+    GEN_IMPORT_ARGC(Milliseconds, G_MILLISECONDS),
+    GEN_IMPORT_ARGC(cvar, G_CVAR),
+    GEN_IMPORT_ARGC(cvar_set, G_CVAR_SET),
+    GEN_IMPORT_ARGC(Cvar_VariableIntegerValue, G_CVAR_VARIABLE_INTEGER_VALUE),
+    GEN_IMPORT_ARGC(Cvar_VariableStringBuffer, G_CVAR_VARIABLE_STRING_BUFFER),
+    GEN_IMPORT_ARGC(argc, G_ARGC),
+    GEN_IMPORT_ARGC(argv, G_ARGV),
+    GEN_IMPORT_ARGC(FS_FOpenFile, G_FS_FOPEN_FILE),
+    GEN_IMPORT_ARGC(FS_Read, G_FS_READ),
+    GEN_IMPORT_ARGC(FS_Write, G_FS_WRITE),
+    GEN_IMPORT_ARGC(FS_FCloseFile, G_FS_FCLOSE_FILE),
+    GEN_IMPORT_ARGC(FS_ReadFile, G_FS_READFILE),
+    GEN_IMPORT_ARGC(FS_FreeFile, G_FS_FREEFILE),
+    GEN_IMPORT_ARGC(FS_GetFileList, G_FS_GETFILELIST),
+    GEN_IMPORT_ARGC(AppendToSaveGame, G_APPENDTOSAVEGAME),
+    GEN_IMPORT_ARGC(ReadFromSaveGame, G_READFROMSAVEGAME),
+    GEN_IMPORT_ARGC(ReadFromSaveGameOptional, G_READFROMSAVEGAMEOPTIONAL),
+    GEN_IMPORT_ARGC(SendConsoleCommand, G_SEND_CONSOLE_COMMAND),
+    GEN_IMPORT_ARGC(DropClient, G_DROP_CLIENT),
+    GEN_IMPORT_ARGC(SendServerCommand, G_SEND_SERVER_COMMAND),
+    GEN_IMPORT_ARGC(SetConfigstring, G_SET_CONFIGSTRING),
+    GEN_IMPORT_ARGC(GetConfigstring, G_GET_CONFIGSTRING),
+    GEN_IMPORT_ARGC(GetUserinfo, G_GET_USERINFO),
+    GEN_IMPORT_ARGC(SetUserinfo, G_SET_USERINFO),
+    GEN_IMPORT_ARGC(GetServerinfo, G_GET_SERVERINFO),
+    GEN_IMPORT_ARGC(SetBrushModel, G_SET_BRUSH_MODEL),
+    GEN_IMPORT_ARGC(trace, G_TRACE),
+    GEN_IMPORT_ARGC(pointcontents, G_POINT_CONTENTS),
+    GEN_IMPORT_ARGC(totalMapContents, G_TOTALMAPCONTENTS),
+    GEN_IMPORT_ARGC(inPVS, G_IN_PVS),
+    GEN_IMPORT_ARGC(inPVSIgnorePortals, G_IN_PVS_IGNOREPORTALS),
+    GEN_IMPORT_ARGC(AdjustAreaPortalState, G_ADJUSTAREAPORTALSTATE),
+    GEN_IMPORT_ARGC(AreasConnected, G_AREAS_CONNECTED),
+    GEN_IMPORT_ARGC(linkentity, G_LINKENTITY),
+    GEN_IMPORT_ARGC(unlinkentity, G_UNLINKENTITY),
+    GEN_IMPORT_ARGC(EntitiesInBox, G_ENTITIES_IN_BOX),
+    GEN_IMPORT_ARGC(EntityContact, G_ENTITY_CONTACT),
+    GEN_IMPORT_ARGC(Malloc, G_MALLOC),
+    GEN_IMPORT_ARGC(Free, G_FREE),
+    GEN_IMPORT_ARGC(bIsFromZone, G_BISFROMZONE),
+    GEN_IMPORT_ARGC(G2API_PrecacheGhoul2Model, G_G2API_PRECACHEGHOUL2MODEL),
+    GEN_IMPORT_ARGC(G2API_InitGhoul2Model, G_G2API_INITGHOUL2MODEL),
+    GEN_IMPORT_ARGC(G2API_SetSkin, G_G2API_SETSKIN),
+    GEN_IMPORT_ARGC(G2API_SetBoneAnim, G_G2API_SETBONEANIM),
+    GEN_IMPORT_ARGC(G2API_SetBoneAngles, G_G2API_SETBONEANGLES),
+    GEN_IMPORT_ARGC(G2API_SetBoneAnglesIndex, G_G2API_SETBONEANGLESINDEX),
+    GEN_IMPORT_ARGC(G2API_SetBoneAnglesMatrix, G_G2API_SETBONEANGLESMATRIX),
+    GEN_IMPORT_ARGC(G2API_CopyGhoul2Instance, G_G2API_COPYGHOUL2INSTANCE),
+    GEN_IMPORT_ARGC(G2API_SetBoneAnimIndex, G_G2API_SETBONEANIMINDEX),
+    GEN_IMPORT_ARGC(G2API_SetLodBias, G_G2API_SETLODBIAS),
+    GEN_IMPORT_ARGC(G2API_SetShader, G_G2API_SETSHADER),
+    GEN_IMPORT_ARGC(G2API_RemoveGhoul2Model, G_G2API_REMOVEGHOUL2MODEL),
+    GEN_IMPORT_ARGC(G2API_SetSurfaceOnOff, G_G2API_SETSURFACEONOFF),
+    GEN_IMPORT_ARGC(G2API_SetRootSurface, G_G2API_SETROOTSURFACE),
+    GEN_IMPORT_ARGC(G2API_RemoveSurface, G_G2API_REMOVESURFACE),
+    GEN_IMPORT_ARGC(G2API_AddSurface, G_G2API_ADDSURFACE),
+    GEN_IMPORT_ARGC(G2API_GetBoneAnim, G_G2API_GETBONEANIM),
+    GEN_IMPORT_ARGC(G2API_GetBoneAnimIndex, G_G2API_GETBONEANIMINDEX),
+    GEN_IMPORT_ARGC(G2API_GetAnimRange, G_G2API_GETANIMRANGE),
+    GEN_IMPORT_ARGC(G2API_GetAnimRangeIndex, G_G2API_GETANIMRANGEINDEX),
+    GEN_IMPORT_ARGC(G2API_PauseBoneAnim, G_G2API_PAUSEBONEANIM),
+    GEN_IMPORT_ARGC(G2API_PauseBoneAnimIndex, G_G2API_PAUSEBONEANIMINDEX),
+    GEN_IMPORT_ARGC(G2API_IsPaused, G_G2API_ISPAUSED),
+    GEN_IMPORT_ARGC(G2API_StopBoneAnim, G_G2API_STOPBONEANIM),
+    GEN_IMPORT_ARGC(G2API_StopBoneAngles, G_G2API_STOPBONEANGLES),
+    GEN_IMPORT_ARGC(G2API_RemoveBone, G_G2API_REMOVEBONE),
+    GEN_IMPORT_ARGC(G2API_RemoveBolt, G_G2API_REMOVEBOLT),
+    GEN_IMPORT_ARGC(G2API_AddBolt, G_G2API_ADDBOLT),
+    GEN_IMPORT_ARGC(G2API_AddBoltSurfNum, G_G2API_ADDBOLTSURFNUM),
+    GEN_IMPORT_ARGC(G2API_AttachG2Model, G_G2API_ATTACHG2MODEL),
+    GEN_IMPORT_ARGC(G2API_DetachG2Model, G_G2API_DETACHG2MODEL),
+    GEN_IMPORT_ARGC(G2API_AttachEnt, G_G2API_ATTACHENT),
+    GEN_IMPORT_ARGC(G2API_DetachEnt, G_G2API_DETACHENT),
+    GEN_IMPORT_ARGC(G2API_GetBoltMatrix, G_G2API_GETBOLTMATRIX),
+    GEN_IMPORT_ARGC(G2API_ListSurfaces, G_G2API_LISTSURFACES),
+    GEN_IMPORT_ARGC(G2API_ListBones, G_G2API_LISTBONES),
+    GEN_IMPORT_ARGC(G2API_HaveWeGhoul2Models, G_G2API_HAVEWEGHOUL2MODELS),
+    GEN_IMPORT_ARGC(G2API_SetGhoul2ModelFlags, G_G2API_SETGHOUL2MODELFLAGS),
+    GEN_IMPORT_ARGC(G2API_GetGhoul2ModelFlags, G_G2API_GETGHOUL2MODELFLAGS),
+    GEN_IMPORT_ARGC(G2API_GetAnimFileName, G_G2API_GETANIMFILENAME),
+    GEN_IMPORT_ARGC(G2API_CollisionDetect, G_G2API_COLLISIONDETECT),
+    GEN_IMPORT_ARGC(G2API_GiveMeVectorFromMatrix, G_G2API_GIVEMEVECTORFROMMATRIX),
+    GEN_IMPORT_ARGC(G2API_CleanGhoul2Models, G_G2API_CLEANGHOUL2MODELS),
+    GEN_IMPORT_ARGC(TheGhoul2InfoArray, G_THEGHOUL2INFOARRAY),
+    GEN_IMPORT_ARGC(G2API_GetParentSurface, G_G2API_GETPARENTSURFACE),
+    GEN_IMPORT_ARGC(G2API_GetSurfaceIndex, G_G2API_GETSURFACEINDEX),
+    GEN_IMPORT_ARGC(G2API_GetSurfaceName, G_G2API_GETSURFACENAME),
+    GEN_IMPORT_ARGC(G2API_GetGLAName, G_G2API_GETGLANAME),
+    GEN_IMPORT_ARGC(G2API_SetNewOrigin, G_G2API_SETNEWORIGIN),
+    GEN_IMPORT_ARGC(G2API_GetBoneIndex, G_G2API_GETBONEINDEX),
+    GEN_IMPORT_ARGC(G2API_StopBoneAnglesIndex, G_G2API_STOPBONEANGLESINDEX),
+    GEN_IMPORT_ARGC(G2API_StopBoneAnimIndex, G_G2API_STOPBONEANIMINDEX),
+    GEN_IMPORT_ARGC(G2API_SetBoneAnglesMatrixIndex, G_G2API_SETBONEANGLESMATRIXINDEX),
+    GEN_IMPORT_ARGC(G2API_SetAnimIndex, G_G2API_SETANIMINDEX),
+    GEN_IMPORT_ARGC(G2API_GetAnimIndex, G_G2API_GETANIMINDEX),
+    GEN_IMPORT_ARGC(G2API_SaveGhoul2Models, G_G2API_SAVEGHOUL2MODELS),
+    GEN_IMPORT_ARGC(G2API_LoadGhoul2Models, G_G2API_LOADGHOUL2MODELS),
+    GEN_IMPORT_ARGC(G2API_LoadSaveCodeDestructGhoul2Info, G_G2API_LOADSAVECODEDESTRUCTGHOUL2INFO),
+    GEN_IMPORT_ARGC(G2API_GetAnimFileNameIndex, G_G2API_GETANIMFILENAMEINDEX),
+    GEN_IMPORT_ARGC(G2API_GetAnimFileInternalNameIndex, G_G2API_GETANIMFILEINTERNALNAMEINDEX),
+    GEN_IMPORT_ARGC(G2API_GetSurfaceRenderStatus, G_G2API_GETSURFACERENDERSTATUS),
+    GEN_IMPORT_ARGC(G2API_SetRagDoll, G_G2API_SETRAGDOLL),
+    GEN_IMPORT_ARGC(G2API_AnimateG2Models, G_G2API_ANIMATEG2MODELS),
+    GEN_IMPORT_ARGC(G2API_RagPCJConstraint, G_G2API_RAGPCJCONSTRAINT),
+    GEN_IMPORT_ARGC(G2API_RagPCJGradientSpeed, G_G2API_RAGPCJGRADIENTSPEED),
+    GEN_IMPORT_ARGC(G2API_RagEffectorGoal, G_G2API_RAGEFFECTORGOAL),
+    GEN_IMPORT_ARGC(G2API_GetRagBonePos, G_G2API_GETRAGBONEPOS),
+    GEN_IMPORT_ARGC(G2API_RagEffectorKick, G_G2API_RAGEFFECTORKICK),
+    GEN_IMPORT_ARGC(G2API_RagForceSolve, G_G2API_RAGFORCESOLVE),
+    GEN_IMPORT_ARGC(G2API_SetBoneIKState, G_G2API_SETBONEIKSTATE),
+    GEN_IMPORT_ARGC(G2API_IKMove, G_G2API_IKMOVE),
+    GEN_IMPORT_ARGC(G2API_AddSkinGore, G_G2API_ADDSKINGORE),
+    GEN_IMPORT_ARGC(G2API_ClearSkinGore, G_G2API_CLEARSKINGORE),
+    GEN_IMPORT_ARGC(RMG_Init, G_RMG_INIT),
+    GEN_IMPORT_ARGC(CM_RegisterTerrain, G_CM_REGISTERTERRAIN),
+    GEN_IMPORT_ARGC(SetActiveSubBSP, G_SET_ACTIVE_SUBBSP),
+    GEN_IMPORT_ARGC(RE_RegisterSkin, G_RE_REGISTERSKIN),
+    GEN_IMPORT_ARGC(RE_GetAnimationCFG, G_RE_GETANIMATIONCFG),
+    GEN_IMPORT_ARGC(WE_GetWindVector, G_WE_GETWINDVECTOR),
+    GEN_IMPORT_ARGC(WE_GetWindGusting, G_WE_GETWINDGUSTING),
+    GEN_IMPORT_ARGC(WE_IsOutside, G_WE_ISOUTSIDE),
+    GEN_IMPORT_ARGC(WE_IsOutsideCausingPain, G_WE_ISOUTSIDECAUSINGPAIN),
+    GEN_IMPORT_ARGC(WE_GetChanceOfSaberFizz, G_WE_GETCHANCEOFSABERFIZZ),
+    GEN_IMPORT_ARGC(WE_IsShaking, G_WE_ISSHAKING),
+    GEN_IMPORT_ARGC(WE_AddWeatherZone, G_WE_ADDWEATHERZONE),
+    GEN_IMPORT_ARGC(WE_SetTempGlobalFogColor, G_WE_SETTEMPGLOBALFOGCOLOR),
+};
+
+static constexpr auto syscall_argcs = GEN_SYSCALL_ARGC_TABLE(syscall_argc_defs);
+
+
+// number of args each mod message takes, read from the game_export_t declarations
+static constexpr MsgArgcDef vmmain_argc_defs[] = {
+    GEN_EXPORT_ARGC(Init, GAME_INIT),
+    GEN_EXPORT_ARGC(Shutdown, GAME_SHUTDOWN),
+    GEN_EXPORT_ARGC(WriteLevel, GAME_WRITE_LEVEL),
+    GEN_EXPORT_ARGC(ReadLevel, GAME_READ_LEVEL),
+    GEN_EXPORT_ARGC(GameAllowedToSaveHere, GAME_GAMEALLOWEDTOSAVEHERE),
+    GEN_EXPORT_ARGC(ClientConnect, GAME_CLIENT_CONNECT),
+    GEN_EXPORT_ARGC(ClientBegin, GAME_CLIENT_BEGIN),
+    GEN_EXPORT_ARGC(ClientUserinfoChanged, GAME_CLIENT_USERINFO_CHANGED),
+    GEN_EXPORT_ARGC(ClientDisconnect, GAME_CLIENT_DISCONNECT),
+    GEN_EXPORT_ARGC(ClientCommand, GAME_CLIENT_COMMAND),
+    GEN_EXPORT_ARGC(ClientThink, GAME_CLIENT_THINK),
+    GEN_EXPORT_ARGC(RunFrame, GAME_RUN_FRAME),
+    GEN_EXPORT_ARGC(ConnectNavs, GAME_CONNECTNAVS),
+    GEN_EXPORT_ARGC(ConsoleCommand, GAME_CONSOLE_COMMAND),
+    GEN_EXPORT_ARGC(GameSpawnRMGEntity, GAME_SPAWN_RMG_ENTITY),
+};
+
+static constexpr auto vmmain_argcs = GEN_VMMAIN_ARGC_TABLE(vmmain_argc_defs);
+
+
+const int8_t* JASP_GameSupport::SyscallArgcs(int* count) {
+    *count = syscall_argcs.count;
+    return syscall_argcs.argc;
+}
+
+
+const int8_t* JASP_GameSupport::VMMainArgcs(int* count) {
+    *count = vmmain_argcs.count;
+    return vmmain_argcs.argc;
+}
@@ -33,8 +33,8 @@ struct JK2MP_GameSupport : public GameSupport {
     virtual int QMMEngMsg(int msg) { return qmm_eng_msgs[msg]; }
     virtual int QMMModMsg(int msg) { return qmm_mod_msgs[msg]; }
 
-    virtual intptr_t syscall(intptr_t, ...);
-    virtual intptr_t vmMain(intptr_t, ...);
+    virtual intptr_t syscall_args(intptr_t, intptr_t*, int);
+    virtual intptr_t vmMain_args(intptr_t, intptr_t*, int);
 
     virtual const char* DefaultDLLName() { return "jk2mpgame" MOD_DLL; }
     virtual const char* DefaultQVMName() { return "vm/jk2mpgame.qvm"; }
@@ -42,7 +42,8 @@ struct JK2MP_GameSupport : public GameSupport {
     virtual const char* GameName() { return "Jedi Knight 2: Jedi Outcast (MP)"; }
     virtual const char* GameCode() { return "JK2MP"; }
 
-    virtual int QVMSyscall(uint8_t* membase, int cmd, int* args);
+    virtual const QVMSyscallDesc* QVMSyscalls(int* count);
+    virtual const int8_t* VMMainArgcs(int* count);
 
 private:
     // a copy of the original syscall from the engine
@@ -75,9 +76,7 @@ bool JK2MP_GameSupport::AutoDetect(APIType engineapi) {
 
 // wrapper syscall function that calls actual engine func in orig_syscall
 // this is how QMM and plugins will call into the engine
-intptr_t JK2MP_GameSupport::syscall(intptr_t cmd, ...) {
-    QMM_GET_SYSCALL_ARGS();
-
+intptr_t JK2MP_GameSupport::syscall_args(intptr_t cmd, intptr_t* args, int argc) {
     if (cmd != G_PRINT)
         QMMLOG(QMM_LOG_TRACE, "QMM") << "JK2MP_GameSupport::syscall(" << EngMsgName(cmd) << "(" << cmd << ")) called\n";
 
@@ -105,7 +104,7 @@ intptr_t JK2MP_GameSupport::syscall(intptr_t cmd, ...) {
 
     default:
         // all normal engine functions go to syscall
-        ret = orig_syscall(cmd, QMM_PUT_SYSCALL_ARGS());
+        ret = api_call_args(orig_syscall, cmd, args, argc);
     }
 
     // do anything that needs to be done after function call here
@@ -119,9 +118,7 @@ intptr_t JK2MP_GameSupport::syscall(intptr_t cmd, ...) {
 
 // wrapper vmMain function that calls actual mod func in orig_vmMain
 // this is how QMM and plugins will call into the mod
-intptr_t JK2MP_GameSupport::vmMain(intptr_t cmd, ...) {
-    QMM_GET_VMMAIN_ARGS();
-
+intptr_t JK2MP_GameSupport::vmMain_args(intptr_t cmd, intptr_t* args, int argc) {
     QMMLOG(QMM_LOG_TRACE, "QMM") << "JK2MP_GameSupport::vmMain(" << ModMsgName(cmd) << "(" << cmd << ")) called\n";
 
     if (!orig_vmMain)
@@ -142,7 +139,7 @@ intptr_t JK2MP_GameSupport::vmMain(intptr_t cmd, ...) {
     }
 
     // all normal mod functions go to vmMain
-    ret = orig_vmMain(cmd, QMM_PUT_VMMAIN_ARGS());
+    ret = api_call_args(orig_vmMain, cmd, args, argc);
 
     // the return value for GAME_CLIENT_CONNECT is a char* so we have to modify the pointer value for QVMs
     // the char* is a string to print if the client should not be allowed to connect, so only change if it's not NULL
@@ -442,340 +439,273 @@ const char* JK2MP_GameSupport::ModMsgName(intptr_t cmd) {
 }
 
 
-/* Entry point: qvm mod->qmm
-   This is the syscall function called by a QVM mod as a way to pass info to or get info from the engine.
-   It modifies pointer arguments (if they are not NULL, the QVM data segment base address is added), and
-   then the call is passed to the normal syscall() function that DLL mods call.
+/* Syscalls from a qvm mod
+   This is the list of syscalls a QVM mod can make to pass info to or get info from the engine, and the type of each
+   argument. Mod::QVM_syscall uses it to modify pointer arguments (if they are not NULL, the QVM data segment base
+   address is added), and then the call is routed just like a syscall from a DLL mod.
 */
 // vec3_t are arrays, so convert them as pointers
 // do NOT convert the "ghoul" void pointers, treat them as plain ints
-// for double pointers (gentity_t**, vec3_t*, void**), convert them once with vmptr()
-int JK2MP_GameSupport::QVMSyscall(uint8_t* membase, int cmd, int* args) {
-    QMMLOG(QMM_LOG_TRACE, "QMM") << "JK2MP_GameSupport::QVMSyscall(" << EngMsgName(cmd) << "(" << cmd << ")) called\n";
+// for double pointers (gentity_t**, vec3_t*, void**), convert them once as 'p'
+static constexpr QVMSyscallDef qvm_syscall_defs[] = {
+    { G_MILLISECONDS, "" },	// (void)
+    { G_ARGC, "" },	// (void)
+    { G_BOT_ALLOCATE_CLIENT, "" },	// (void)
+    { BOTLIB_SETUP, "" },	// (void)
+    { BOTLIB_SHUTDOWN, "" },	// (void)
+    { BOTLIB_AAS_INITIALIZED, "" },	// (void)
+    { BOTLIB_AAS_TIME, "" },	// (void)
+    { BOTLIB_AI_ALLOC_CHAT_STATE, "" },	// (void)
+    { BOTLIB_AI_INIT_LEVEL_ITEMS, "" },	// (void)
+    { BOTLIB_AI_UPDATE_ENTITY_ITEMS, "" },	// (void)
+    { BOTLIB_AI_ALLOC_MOVE_STATE, "" },	// (void)
+    { BOTLIB_AI_ALLOC_WEAPON_STATE, "" },	// (void)
+    { G_ROFF_CLEAN, "" },	// (void)
+    { G_ROFF_UPDATE_ENTITIES, "" },	// (void)
+    { G_PRINT, "p" },	// (const char* string);
+    { G_ERROR, "p" },	// (const char* string);
+    { G_CVAR_UPDATE, "p" },	// (vmCvar_t* vmCvar);
+    { G_CVAR_VARIABLE_INTEGER_VALUE, "p" },	// (const char* var_name);
+    { G_LINKENTITY, "p" },	// (gentity_t* ent);
+    { G_UNLINKENTITY, "p" },	// (gentity_t* ent);
+    { G_REAL_TIME, "p" },	// (qtime_t* qtime)
+    { G_SNAPVECTOR, "p" },	// (float* v)
+    { BOTLIB_PC_ADD_GLOBAL_DEFINE, "p" },	// (char* string)
+    { BOTLIB_LOAD_MAP, "p" },	// (const char* mapname)
+    { BOTLIB_AAS_POINT_AREA_NUM, "p" },	// (vec3_t point)
+    { BOTLIB_AAS_POINT_REACHABILITY_AREA_INDEX, "p" },	// (vec3_t point)
+    { BOTLIB_AAS_POINT_CONTENTS, "p" },	// (vec3_t point)
+    { BOTLIB_AAS_SWIMMING, "p" },	// (vec3_t origin)
+    { BOTLIB_AI_UNIFY_WHITE_SPACES, "p" },	// (char* string)
+    { BOTLIB_PC_LOAD_SOURCE, "p" },	// (const char*)
+    { G_G2_CLEANMODELS, "p" },	// (void** ghoul2Ptr)
+    { G_ROFF_CACHE, "p" },	// (char* file)
+    { SP_REGISTER_SERVER_CMD, "p" },	// (const char* package)
+    { G_FS_FCLOSE_FILE, "i" },	// (fileHandle_t f);
+    { G_BOT_FREE_CLIENT, "i" },	// (int clientNum);
+    { G_DEBUG_POLYGON_DELETE, "i" },	// (int id)
+    { BOTLIB_START_FRAME, "f" },	// (float time)
+    { BOTLIB_AAS_NEXT_BSP_ENTITY, "i" },	// (int ent)
+    { BOTLIB_AAS_AREA_REACHABILITY, "i" },	// (int areanum)
+    { BOTLIB_EA_GESTURE, "i" },	// (int client)
+    { BOTLIB_EA_TALK, "i" },	// (int client)
+    { BOTLIB_EA_ATTACK, "i" },	// (int client)
+    { BOTLIB_EA_USE, "i" },	// (int client)
+    { BOTLIB_EA_RESPAWN, "i" },	// (int client)
+    { BOTLIB_EA_CROUCH, "i" },	// (int client)
+    { BOTLIB_EA_MOVE_UP, "i" },	// (int client)
+    { BOTLIB_EA_MOVE_DOWN, "i" },	// (int client)
+    { BOTLIB_EA_MOVE_FORWARD, "i" },	// (int client)
+    { BOTLIB_EA_MOVE_BACK, "i" },	// (int client)
+    { BOTLIB_EA_MOVE_LEFT, "i" },	// (int client)
+    { BOTLIB_EA_MOVE_RIGHT, "i" },	// (int client)
+    { BOTLIB_EA_JUMP, "i" },	// (int client)
+    { BOTLIB_EA_DELAYED_JUMP, "i" },	// (int client)
+    { BOTLIB_EA_RESET_INPUT, "i" },	// (int client)
+    { BOTLIB_AI_FREE_CHARACTER, "i" },	// (int character)
+    { BOTLIB_AI_FREE_CHAT_STATE, "i" },	// (int handle)
+    { BOTLIB_AI_CHAT_LENGTH, "i" },	// (int chatstate)
+    { BOTLIB_AI_NUM_CONSOLE_MESSAGE, "i" },	// (int chatstate)
+    { BOTLIB_AI_RESET_GOAL_STATE, "i" },	// (int goalstate)
+    { BOTLIB_AI_RESET_AVOID_GOALS, "i" },	// (int goalstate)
+    { BOTLIB_AI_POP_GOAL, "i" },	// (int goalstate)
+    { BOTLIB_AI_EMPTY_GOAL_STACK, "i" },	// (int goalstate)
+    { BOTLIB_AI_DUMP_AVOID_GOALS, "i" },	// (int goalstate)
+    { BOTLIB_AI_DUMP_GOAL_STACK, "i" },	// (int goalstate)
+    { BOTLIB_AI_FREE_ITEM_WEIGHTS, "i" },	// (int goalstate)
+    { BOTLIB_AI_ALLOC_GOAL_STATE, "i" },	// (int state)
+    { BOTLIB_AI_FREE_GOAL_STATE, "i" },	// (int handle)
+    { BOTLIB_AI_RESET_MOVE_STATE, "i" },	// (int movestate)
+    { BOTLIB_AI_RESET_AVOID_REACH, "i" },	// (int movestate)
+    { BOTLIB_AI_RESET_LAST_AVOID_REACH, "i" },	// (int movestate)
+    { BOTLIB_AI_FREE_MOVE_STATE, "i" },	// (int handle)
+    { BOTLIB_AI_FREE_WEAPON_STATE, "i" },	// (int)
+    { BOTLIB_AI_RESET_WEAPON_STATE, "i" },	// (int)
+    { BOTLIB_PC_FREE_SOURCE, "i" },	// (int)
+    { G_SIN, "f", QVM_RET_VALUE, QVM_INTRINSIC_SIN },	// (double)
+    { G_COS, "f", QVM_RET_VALUE, QVM_INTRINSIC_COS },	// (double)
+    { G_SQRT, "f", QVM_RET_VALUE, QVM_INTRINSIC_SQRT },	// (double)
+    { G_FLOOR, "f", QVM_RET_VALUE, QVM_INTRINSIC_FLOOR },	// (double)
+    { G_CEIL, "f", QVM_RET_VALUE, QVM_INTRINSIC_CEIL },	// (double)
+    { G_ACOS, "f" },	// (double x)
+    { G_ASIN, "f" },	// not used, but probably (double x)
+    { BOTLIB_EA_ALT_ATTACK, "i" },	// (int client)
+    { BOTLIB_EA_FORCEPOWER, "i" },	// (int client)
+    { G_G2_LISTSURFACES, "i" },	// (void* ghoulInfo)
+    { G_G2_HAVEWEGHOULMODELS, "i" },	// (void* ghoul2)
+    { G_ROFF_PURGE_ENT, "i" },	// (int entID)
+    { G_CVAR_SET, "pp" },	// (const char* var_name, const char* value);
+    { G_SET_BRUSH_MODEL, "pp" },	// (gentity_t* ent, const char* name);
+    { G_IN_PVS, "pp" },	// (const vec3_t p1, const vec3_t p2);
+    { G_IN_PVS_IGNORE_PORTALS, "pp" },	// (const vec3_t p1, const vec3_t p2);
+    { BOTLIB_LIBVAR_SET, "pp" },	// (char* var_name, char* value)
+    { BOTLIB_AI_TOUCHING_GOAL, "pp" },	// (vec3_t origin, void /*struct bot_goal_s*/* goal)
+    { BOTLIB_AI_GET_MAP_LOCATION_GOAL, "pp" },	// (char* name, void /*struct bot_goal_s*/* goal)
+    { G_PERPENDICULARVECTOR, "pp" },	// (vec3_t dst, const vec3_t src)
+    { G_AREAS_CONNECTED, "ii" },	// (int area1, int area2);
+    { BOTLIB_GET_SNAPSHOT_ENTITY, "ii" },	// (int clientNum, int sequence)
+    { BOTLIB_AAS_ENABLE_ROUTING_AREA, "ii" },	// (int areanum, int enable)
+    { BOTLIB_EA_ACTION, "ii" },	// (int client, int action)
+    { BOTLIB_EA_SELECT_WEAPON, "ii" },	// (int client, int weapon)
+    { BOTLIB_EA_END_REGULAR, "if" },	// (int client, float thinktime)
+    { BOTLIB_AI_CHARACTERISTIC_FLOAT, "ii" },	// (int character, int index)
+    { BOTLIB_AI_CHARACTERISTIC_INTEGER, "ii" },	// (int character, int index)
+    { BOTLIB_AI_REMOVE_CONSOLE_MESSAGE, "ii" },	// (int chatstate, int handle)
+    { BOTLIB_AI_SET_CHAT_GENDER, "ii" },	// (int chatstate, int gender)
+    { BOTLIB_AI_REMOVE_FROM_AVOID_GOALS, "ii" },	// (int goalstate, int number)
+    { BOTLIB_AI_AVOID_GOAL_TIME, "ii" },	// (int goalstate, int number)
+    { BOTLIB_AI_MUTATE_GOAL_FUZZY_LOGIC, "if" },	// (int goalstate, float range)
+    { G_ATAN2, "ff", QVM_RET_VALUE, QVM_INTRINSIC_ATAN2 },	// (double, double)
+    { G_G2_LISTBONES, "ii" },	// (void* ghoulInfo, int frame)
+    { G_G2_HASGHOUL2MODELONINDEX, "ii" },	// (void* ghoulInfo, int modelIndex)
+    { G_G2_REMOVEGHOUL2MODEL, "ii" },	// (void* ghoulInfo, int modelIndex)
+    { G_SEND_CONSOLE_COMMAND, "ip" },	// (int exec_when, const char* text)
+    { G_DROP_CLIENT, "ip" },	// (int clientNum, const char* reason);
+    { G_SEND_SERVER_COMMAND, "ip" },	// (int clientNum, const char* fmt);
+    { G_SET_CONFIGSTRING, "ip" },	// (int num, const char* string);
+    { G_SET_USERINFO, "ip" },	// (int num, const char* buffer);
+    { G_GET_USERCMD, "ip" },	// (int clientNum, usercmd_t* cmd)
+    { BOTLIB_UPDATENTITY, "ip" },	// (int ent, void /*struct bot_updateentity_s*/* bue)
+    { BOTLIB_USER_COMMAND, "ip" },	// (int clientNum, usercmd_t* ucmd)
+    { BOTLIB_AAS_ENTITY_INFO, "ip" },	// (int entnum, void /*struct aas_entityinfo_s*/* info)
+    { BOTLIB_AAS_AREA_INFO, "ip" },	// (int areanum, void /*struct aas_areainfo_s*/* info)
+    { BOTLIB_EA_SAY, "ip" },	// (int client, char* str)
+    { BOTLIB_EA_SAY_TEAM, "ip" },	// (int client, char* str)
+    { BOTLIB_EA_COMMAND, "ip" },	// (int client, char* command)
+    { BOTLIB_EA_VIEW, "ip" },	// (int client, vec3_t viewangles)
+    { BOTLIB_AI_NEXT_CONSOLE_MESSAGE, "ip" },	// (int chatstate, void /*struct bot_consolemessage_s*/* cm)
+    { BOTLIB_AI_NUM_INITIAL_CHATS, "ip" },	// (int chatstate, char* type)
+    { BOTLIB_AI_PUSH_GOAL, "ip" },	// (int goalstate, void* goal)
+    { BOTLIB_AI_GET_TOP_GOAL, "ip" },	// (int goalstate, void /*struct bot_goal_s*/* goal)
+    { BOTLIB_AI_GET_SECOND_GOAL, "ip" },	// (int goalstate, void /*struct bot_goal_s*/* goal)
+    { BOTLIB_AI_GET_NEXT_CAMP_SPOT_GOAL, "ip" },	// (int num, void /*struct bot_goal_s*/* goal)
+    { BOTLIB_AI_LOAD_ITEM_WEIGHTS, "ip" },	// (int, char*)
+    { BOTLIB_AI_SAVE_GOAL_FUZZY_LOGIC, "ip" },	// (int, char*)
+    { BOTLIB_AI_INIT_MOVE_STATE, "ip" },	// (int handle, void* initmove)
+    { BOTLIB_AI_CHOOSE_BEST_FIGHT_WEAPON, "ip" },	// (int weaponstate, int* inventory)
+    { BOTLIB_AI_LOAD_WEAPON_WEIGHTS, "ip" },	// (int, char*)
+    { BOTLIB_PC_READ_TOKEN, "ip" },	// (int, void*)
+    { G_G2_DUPLICATEGHOUL2INSTANCE, "ip" },	// (void* ghoul2From, void** ghoul2To)
+    { G_GET_SERVERINFO, "pi" },	// (char* buffer, int bufferSize);
+    { G_POINT_CONTENTS, "pi" },	// (const vec3_t point, int passEntityNum);
+    { G_ADJUST_AREA_PORTAL_STATE, "pi" },	// (gentity_t* ent, qboolean open);
+    { G_GET_ENTITY_TOKEN, "pi" },	// (char* buffer, int bufferSize)
+    { BOTLIB_AI_LOAD_CHARACTER, "pf" },	// (char* charfile, float skill)
+    { BOTLIB_AI_REPLACE_SYNONYMS, "pi" },	// (char* string, unsigned long int context)
+    { BOTLIB_AI_REACHABILITY_AREA, "pi" },	// (vec3_t origin, int testground)
+    { G_TESTPRINTINT, "pi" },	// (char*, int)
+    { G_TESTPRINTFLOAT, "pf" },	// (char*, float)
+    { G_ARGV, "ipi" },	// (int n, char* buffer, int bufferLength);
+    { G_GET_CONFIGSTRING, "ipi" },	// (int num, char* buffer, int bufferSize);
+    { G_GET_USERINFO, "ipi" },	// (int num, char* buffer, int bufferSize);
+    { BOTLIB_GET_CONSOLE_MESSAGE, "ipi" },	// (int clientNum, char* message, int size)
+    { BOTLIB_EA_MOVE, "ipf" },	// (int client, vec3_t dir, float speed)
+    { BOTLIB_AI_GET_CHAT_MESSAGE, "ipi" },	// (int chatstate, char* buf, int size)
+    { BOTLIB_AI_SET_CHAT_NAME, "ipi" },	// (int chatstate, char* name, int client)
+    { BOTLIB_AI_GOAL_NAME, "ipi" },	// (int number, char* name, int size)
+    { G_CVAR_VARIABLE_STRING_BUFFER, "ppi" },	// (const char* var_name, char* buffer, int bufsize);
+    { G_FS_FOPEN_FILE, "ppi" },	// (const char* qpath, fileHandle_t* file, fsMode_t mode);
+    { BOTLIB_LIBVAR_GET, "ppi" },	// (char* var_name, char* value, int size)
+    { BOTLIB_AI_STRING_CONTAINS, "ppi" },	// (char* str1, char* str2, int casesensitive)
+    { BOTLIB_AI_FIND_MATCH, "ppi" },	// (char* str, void /*struct bot_match_s*/* match, unsigned long int context)
+    { SP_GETSTRINGTEXTSTRING, "ppi" },	// (const char* text, char* buffer, int bufferLength)
+    { G_MEMCPY, "ppi", QVM_RET_ARG0, QVM_INTRINSIC_MEMCPY },	// (void* dest, const void* src, size_t count)
+    { G_STRNCPY, "ppi", QVM_RET_ARG0, QVM_INTRINSIC_STRNCPY },	// (char* strDest, const char* strSource, size_t count)
+    { G_FS_READ, "pii" },	// (void* buffer, int len, fileHandle_t f);
+    { G_FS_WRITE, "pii" },	// (const void* buffer, int len, fileHandle_t f);
+    { G_MEMSET, "pii", QVM_RET_ARG0, QVM_INTRINSIC_MEMSET },	// (void* dest, int c, size_t count)
+    { G_ENTITY_CONTACT, "ppp" },	// (const vec3_t mins, const vec3_t maxs, const gentity_t* ent);
+    { G_MATRIXMULTIPLY, "ppp", QVM_RET_VALUE, QVM_INTRINSIC_MATRIXMULTIPLY },	// (float in1[3][3], float in2[3][3], float out[3][3])
+    { G_ENTITY_CONTACTCAPSULE, "ppp" },	// (const vec3_t mins, const vec3_t maxs, const gentity_t* ent);
+    { BOTLIB_AI_ENTER_CHAT, "iii" },	// (int chatstate, int client, int sendto)
+    { BOTLIB_AI_SET_AVOID_GOAL_TIME, "iif" },	// (int goalstate, int number, float avoidtime)
+    { BOTLIB_AI_INTERBREED_GOAL_FUZZY_LOGIC, "iii" },	// (int, int, int)
+    { G_G2_SETBOLTINFO, "iii" },	// (void* ghoul2, int modelIndex, int boltInfo)
+    { G_G2_COPYGHOUL2INSTANCE, "iii" },	// (void* ghoul2From, void* ghoul2To, int modelIndex)
+    { G_ROFF_PLAY, "iii" },	// (int entID, int roffID, qboolean doTranslation)
+    { G_DEBUG_POLYGON_CREATE, "iip" },	// (int color, int numPoints, vec3_t* points)
+    { BOTLIB_EA_GET_INPUT, "ifp" },	// (int client, float thinktime, void /*struct bot_input_s*/* input)
+    { BOTLIB_AI_QUEUE_CONSOLE_MESSAGE, "iip" },	// (int chatstate, int type, char* message)
+    { BOTLIB_AI_GET_WEAPON_INFO, "iip" },	// (int weaponstate, int weapon, void /*struct weaponinfo_s*/* weaponinfo)
+    { G_G2_ADDBOLT, "iip" },	// (void* ghoul2, int modelIndex, const char* boneName)
+    { G_G2_GETGLANAME, "iip" },	// (void* ghoul2, int modelIndex, char* fillBuf)
+    { BOTLIB_AAS_PRESENCE_TYPE_BOUNDING_BOX, "ipp" },	// (int presencetype, vec3_t mins, vec3_t maxs)
+    { BOTLIB_AAS_VECTOR_FOR_BSP_EPAIR_KEY, "ipp" },	// (int ent, char* key, vec3_t v)
+    { BOTLIB_AAS_FLOAT_FOR_BSP_EPAIR_KEY, "ipp" },	// (int ent, char* key, float* value)
+    { BOTLIB_AAS_INT_FOR_BSP_EPAIR_KEY, "ipp" },	// (int ent, char* key, int* value)
+    { BOTLIB_AI_LOAD_CHAT_FILE, "ipp" },	// (int chatstate, char* chatfile, char* chatname)
+    { BOTLIB_AI_GET_LEVEL_ITEM_GOAL, "ipp" },	// (int index, char* classname, void /*struct bot_goal_s*/* goal)
+    { BOTLIB_PC_SOURCE_FILE_AND_LINE, "ipp" },	// (int handle, char* filename, int* line)
+    { G_G2_SETMODELS, "ipp" },	// (void* ghoul2, qhandle_t* modelList, qhandle_t* skinList)
+    { G_CVAR_REGISTER, "pppi" },	// (vmCvar_t* vmCvar, const char* varName, const char* defaultValue, int flags);
+    { G_ENTITIES_IN_BOX, "pppi" },	// (const vec3_t mins, const vec3_t maxs, gentity_t** list, int maxcount);
+    { G_FS_GETFILELIST, "pppi" },	// (const char* path, const char* extension, char* listbuf, int bufsize) {
+    { BOTLIB_AAS_BBOX_AREAS, "pppi" },	// (vec3_t absmins, vec3_t absmaxs, int* areas, int maxareas)
+    { BOTLIB_TEST, "ippp" },	// (int parm0, char* parm1, vec3_t parm2, vec3_t parm3)
+    { BOTLIB_AI_ITEM_GOAL_IN_VIS_BUT_NOT_VISIBLE, "ippp" },	// (int viewer, vec3_t eye, vec3_t viewangles, void /*struct bot_goal_s*/* goal)
+    { BOTLIB_AAS_VALUE_FOR_BSP_EPAIR_KEY, "ippi" },	// (int ent, char* key, char* value, int size)
+    { BOTLIB_AI_CHOOSE_LTG_ITEM, "ippi" },	// (int goalstate, vec3_t origin, int* inventory, int travelflags)
+    { G_ANGLEVECTORS, "pppp", QVM_RET_VALUE, QVM_INTRINSIC_ANGLEVECTORS },	// (const vec3_t angles, vec3_t forward, vec3_t right, vec3_t up)
+    { BOTLIB_AAS_AREA_TRAVEL_TIME_TO_GOAL_AREA, "ipii" },	// (int areanum, vec3_t origin, int goalareanum, int travelflags)
+    { BOTLIB_AI_ADD_AVOID_SPOT, "ipfi" },	// (int movestate, vec3_t origin, float radius, int type)
+    { BOTLIB_AI_MOVE_IN_DIRECTION, "ipfi" },	// (int movestate, vec3_t dir, float speed, int type)
+    { BOTLIB_AI_CHARACTERISTIC_BFLOAT, "iiff" },	// (int character, int index, float min, float max)
+    { BOTLIB_AI_CHARACTERISTIC_BINTEGER, "iiii" },	// (int character, int index, int min, int max)
+    { G_G2_COPYSPECIFICGHOUL2MODEL, "iiii" },	// (void* ghoul2From, int modelFrom, void* ghoul2To, int modelTo)
+    { BOTLIB_AI_MATCH_VARIABLE, "pipi" },	// (void /*struct bot_match_s*/* match, int variable, char* buf, int size)
+    { BOTLIB_AI_MOVE_TO_GOAL, "pipi" },	// (void /*struct bot_moveresult_s*/* result, int movestate, void /*struct bot_goal_s*/* goal, int travelflags)
+    { BOTLIB_AI_CHARACTERISTIC_STRING, "iipi" },	// (int character, int index, char* buf, int size)
+    { G_LOCATE_GAME_DATA, "piipi" },	// (gentity_t* gEnts, int numGEntities, int sizeofGEntity_t, playerState_t* clients, int sizeofGameClient);
+    { BOTLIB_AAS_TRACE_AREAS, "ppppi" },	// (vec3_t start, vec3_t end, int* areas, vec3_t* points, int maxareas)
+    { BOTLIB_AI_MOVEMENT_VIEW_TARGET, "ipifp" },	// (int movestate, void /*struct bot_goal_s*/* goal, int travelflags, float lookahead, vec3_t tvmarget)
+    { BOTLIB_AI_PREDICT_VISIBLE_POSITION, "pipip" },	// (vec3_t origin, int areanum, void /*struct bot_goal_s*/* goal, int travelflags, vec3_t tvmarget)
+    { BOTLIB_AI_GENETIC_PARENTS_AND_CHILD_SELECTION, "ipppp" },	// (int numranks, float* ranks, int* parent1, int* parent2, int* child)
+    { G_TRACECAPSULE, "pppppii" },	// (trace_t* results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask);
+    { BOTLIB_AI_CHOOSE_NBG_ITEM, "ippipf" },	// (int goalstate, vec3_t origin, int* inventory, int travelflags, void /*struct bot_goal_s*/* ltg, float maxtime)
+    { G_TRACE, "pppppii" },	// (trace_t* results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask);
+    { G_G2_INITGHOUL2MODEL, "ppiiiii" },	// (void** ghoul2Ptr, const char* fileName, int modelIndex, qhandle_t customSkin, qhandle_t customShader, int modelFlags, int lodBias)
+    { BOTLIB_AAS_ALTERNATIVE_ROUTE_GOAL, "pipiipii" },	// (vec3_t start, int startareanum, vec3_t goal, int goalareanum, int travelflags, void /*struct aas_altroutegoal_s*/*altroutegoals, int maxaltroutegoals, int type)
+    { G_G2_GETBOLT, "iiipppipp" },	// (void* ghoul2, const int modelIndex, const int boltIndex, mdxaBone_t* matrix, const vec3_t angles, const vec3_t position, const int frameNum, qhandle_t* modelList, vec3_t scale)
+    { G_G2_GETBOLT_NOREC, "iiipppipp" },	// (void* ghoul2, const int modelIndex, const int boltIndex, mdxaBone_t* matrix, const vec3_t angles, const vec3_t position, const int frameNum, qhandle_t* modelList, vec3_t scale)
+    { G_G2_GETBOLT_NOREC_NOROT, "iiipppipp" },	// (void* ghoul2, const int modelIndex, const int boltIndex, mdxaBone_t* matrix, const vec3_t angles, const vec3_t position, const int frameNum, qhandle_t* modelList, vec3_t scale)
+    { G_G2_PLAYANIM, "iipiiifipi" },	// (void* ghoul2, const int modelIndex, const char* boneName, const int startFrame, const int endFrame, const int flags, const float animSpeed, const int currentTime, const float setFrame , const int blendTime)
+    { BOTLIB_AI_INITIAL_CHAT, "ipipppppppp" },	// (int chatstate, char* type, int mcontext, char* var0, char* var1, char* var2, char* var3, char* var4, char* var5, char* var6, char* var7)
+    { G_G2_ANGLEOVERRIDE, "iippiiiipii" },	// (void* ghoul2, int modelIndex, const char* boneName, const vec3_t angles, const int flags, const int up, const int right, const int forward, qhandle_t* modelList, int blendTime , int currentTime)
+    { BOTLIB_AAS_PREDICT_ROUTE, "pipiiiiiiiii" },	// (void /*struct aas_predictroute_s*/*route, int areanum, vec3_t origin, int goalareanum, int travelflags, int maxareas, int maxtime, int stopevent, int stopcontents, int stoptfl, int stopareanum)
+    { BOTLIB_AI_REPLY_CHAT, "ipiipppppppp" },	// (int chatstate, char* message, int mcontext, int vcontext, char* var0, char* var1, char* var2, char* var3, char* var4, char* var5, char* var6, char* var7)
+    { G_G2_COLLISIONDETECT, "pippiipppiif" },	// (CollisionRecord_t* collRecMap, void* ghoul2, const vec3_t angles, const vec3_t position,int frameNumber, int entNum, vec3_t rayStart, vec3_t rayEnd, vec3_t scale, int traceFlags, int useLod, float fRadius)
+    { BOTLIB_AAS_PREDICT_CLIENT_MOVEMENT, "pipiippiifiii" },	// (void /*struct aas_clientmove_s*/* move, int entnum, vec3_t origin, int presencetype, int onground, vec3_t velocity, vec3_t cmdmove, int cmdframes, int maxframes, float frametime, int stopevent, int stopareanum, int visualize)
+};
 
-    int ret = 0;
+static constexpr auto qvm_syscalls = GEN_QVM_SYSCALL_TABLE(qvm_syscall_defs);
 
-    switch (cmd) {
-    case G_MILLISECONDS:			// (void)
-    case G_ARGC:				// (void)
-    case G_BOT_ALLOCATE_CLIENT:		// (void)
-    case BOTLIB_SETUP:			// (void)
-    case BOTLIB_SHUTDOWN:			// (void)
-    case BOTLIB_AAS_INITIALIZED:		// (void)
-    case BOTLIB_AAS_TIME:			// (void)
-    case BOTLIB_AI_ALLOC_CHAT_STATE:	// (void)
-    case BOTLIB_AI_INIT_LEVEL_ITEMS:	// (void)
-    case BOTLIB_AI_UPDATE_ENTITY_ITEMS:	// (void)
-    case BOTLIB_AI_ALLOC_MOVE_STATE:	// (void)
-    case BOTLIB_AI_ALLOC_WEAPON_STATE:	// (void)
-    case G_ROFF_CLEAN:			// (void)
-    case G_ROFF_UPDATE_ENTITIES:		// (void)
-        ret = qmm_syscall(cmd);
-        break;
-    case G_PRINT:				// (const char* string);
-    case G_ERROR:				// (const char* string);
-    case G_CVAR_UPDATE:			// (vmCvar_t* vmCvar);
-    case G_CVAR_VARIABLE_INTEGER_VALUE:	// (const char* var_name);
-    case G_LINKENTITY:			// (gentity_t* ent);
-    case G_UNLINKENTITY:			// (gentity_t* ent);
-    case G_REAL_TIME:			// (qtime_t* qtime)
-    case G_SNAPVECTOR:			// (float* v)
-    case BOTLIB_PC_ADD_GLOBAL_DEFINE:	// (char* string)
-    case BOTLIB_LOAD_MAP:			// (const char* mapname)
-    case BOTLIB_AAS_POINT_AREA_NUM:		// (vec3_t point)
-    case BOTLIB_AAS_POINT_REACHABILITY_AREA_INDEX:	// (vec3_t point)
-    case BOTLIB_AAS_POINT_CONTENTS:		// (vec3_t point)
-    case BOTLIB_AAS_SWIMMING:		// (vec3_t origin)
-    case BOTLIB_AI_UNIFY_WHITE_SPACES:	// (char* string)
-    case BOTLIB_PC_LOAD_SOURCE:		// (const char*)
-    case G_G2_CLEANMODELS:			// (void** ghoul2Ptr)
-    case G_ROFF_CACHE:			// (char* file) 
-    case SP_REGISTER_SERVER_CMD:		// (const char* package)
-        ret = qmm_syscall(cmd, VMPTR(0));
-        break;
-    case G_FS_FCLOSE_FILE:			// (fileHandle_t f);
-    case G_BOT_FREE_CLIENT:			// (int clientNum);
-    case G_DEBUG_POLYGON_DELETE:		// (int id)
-    case BOTLIB_START_FRAME:		// (float time)
-    case BOTLIB_AAS_NEXT_BSP_ENTITY:	// (int ent)
-    case BOTLIB_AAS_AREA_REACHABILITY:	// (int areanum)
-    case BOTLIB_EA_GESTURE:			// (int client)
-    case BOTLIB_EA_TALK:			// (int client)
-    case BOTLIB_EA_ATTACK:			// (int client)
-    case BOTLIB_EA_USE:			// (int client)
-    case BOTLIB_EA_RESPAWN:			// (int client)
-    case BOTLIB_EA_CROUCH:			// (int client)
-    case BOTLIB_EA_MOVE_UP:			// (int client)
-    case BOTLIB_EA_MOVE_DOWN:		// (int client)
-    case BOTLIB_EA_MOVE_FORWARD:		// (int client)
-    case BOTLIB_EA_MOVE_BACK:		// (int client)
-    case BOTLIB_EA_MOVE_LEFT:		// (int client)
-    case BOTLIB_EA_MOVE_RIGHT:		// (int client)
-    case BOTLIB_EA_JUMP:			// (int client)
-    case BOTLIB_EA_DELAYED_JUMP:		// (int client)
-    case BOTLIB_EA_RESET_INPUT:		// (int client)
-    case BOTLIB_AI_FREE_CHARACTER:		// (int character)
-    case BOTLIB_AI_FREE_CHAT_STATE:		// (int handle)
-    case BOTLIB_AI_CHAT_LENGTH:		// (int chatstate)
-    case BOTLIB_AI_NUM_CONSOLE_MESSAGE:	// (int chatstate)
-    case BOTLIB_AI_RESET_GOAL_STATE:	// (int goalstate)
-    case BOTLIB_AI_RESET_AVOID_GOALS:	// (int goalstate)
-    case BOTLIB_AI_POP_GOAL:		// (int goalstate)
-    case BOTLIB_AI_EMPTY_GOAL_STACK:	// (int goalstate)
-    case BOTLIB_AI_DUMP_AVOID_GOALS:	// (int goalstate)
-    case BOTLIB_AI_DUMP_GOAL_STACK:		// (int goalstate)
-    case BOTLIB_AI_FREE_ITEM_WEIGHTS:	// (int goalstate)
-    case BOTLIB_AI_ALLOC_GOAL_STATE:	// (int state)
-    case BOTLIB_AI_FREE_GOAL_STATE:		// (int handle)
-    case BOTLIB_AI_RESET_MOVE_STATE:	// (int movestate)
-    case BOTLIB_AI_RESET_AVOID_REACH:	// (int movestate)
-    case BOTLIB_AI_RESET_LAST_AVOID_REACH:	// (int movestate)
-    case BOTLIB_AI_FREE_MOVE_STATE:		// (int handle)
-    case BOTLIB_AI_FREE_WEAPON_STATE:	// (int)
-    case BOTLIB_AI_RESET_WEAPON_STATE:	// (int)
-    case BOTLIB_PC_FREE_SOURCE:		// (int)
-    case G_SIN:				// (double)
-    case G_COS:				// (double)
-    case G_SQRT:				// (double)
-    case G_FLOOR:				// (double)
-    case G_CEIL:				// (double)
-    case G_ACOS:				// (double x)
-    case G_ASIN:				// not used, but probably (double x)
-    case BOTLIB_EA_ALT_ATTACK:		// (int client)
-    case BOTLIB_EA_FORCEPOWER:		// (int client)
-    case G_G2_LISTSURFACES:			// (void* ghoulInfo)
-    case G_G2_HAVEWEGHOULMODELS:		// (void* ghoul2)
-    case G_ROFF_PURGE_ENT:			// (int entID) 
-        ret = qmm_syscall(cmd, VMARG(0));
-        break;
-    case G_CVAR_SET:			// (const char* var_name, const char* value);
-    case G_SET_BRUSH_MODEL:			// (gentity_t* ent, const char* name);
-    case G_IN_PVS:				// (const vec3_t p1, const vec3_t p2);
-    case G_IN_PVS_IGNORE_PORTALS:		// (const vec3_t p1, const vec3_t p2);
-    case BOTLIB_LIBVAR_SET:			// (char* var_name, char* value)
-    case BOTLIB_AI_TOUCHING_GOAL:		// (vec3_t origin, void /*struct bot_goal_s*/* goal)
-    case BOTLIB_AI_GET_MAP_LOCATION_GOAL:	// (char* name, void /*struct bot_goal_s*/* goal)
-    case G_PERPENDICULARVECTOR:		// (vec3_t dst, const vec3_t src)
-        ret = qmm_syscall(cmd, VMPTR(0), VMPTR(1));
-        break;
-    case G_AREAS_CONNECTED:			// (int area1, int area2);
-    case BOTLIB_GET_SNAPSHOT_ENTITY:	// (int clientNum, int sequence)
-    case BOTLIB_AAS_ENABLE_ROUTING_AREA:	// (int areanum, int enable)
-    case BOTLIB_EA_ACTION:			// (int client, int action)
-    case BOTLIB_EA_SELECT_WEAPON:		// (int client, int weapon)
-    case BOTLIB_EA_END_REGULAR:		// (int client, float thinktime)
-    case BOTLIB_AI_CHARACTERISTIC_FLOAT:	// (int character, int index)
-    case BOTLIB_AI_CHARACTERISTIC_INTEGER:	// (int character, int index)
-    case BOTLIB_AI_REMOVE_CONSOLE_MESSAGE:	// (int chatstate, int handle)
-    case BOTLIB_AI_SET_CHAT_GENDER:		// (int chatstate, int gender)
-    case BOTLIB_AI_REMOVE_FROM_AVOID_GOALS:	// (int goalstate, int number)
-    case BOTLIB_AI_AVOID_GOAL_TIME:		// (int goalstate, int number)
-    case BOTLIB_AI_MUTATE_GOAL_FUZZY_LOGIC: // (int goalstate, float range)
-    case G_ATAN2:				// (double, double)
-    case G_G2_LISTBONES:			// (void* ghoulInfo, int frame)
-    case G_G2_HASGHOUL2MODELONINDEX:	// (void* ghoulInfo, int modelIndex)
-    case G_G2_REMOVEGHOUL2MODEL:		// (void* ghoulInfo, int modelIndex)
-        ret = qmm_syscall(cmd, VMARG(0), VMARG(1));
-        break;
-    case G_SEND_CONSOLE_COMMAND:		// (int exec_when, const char* text)
-    case G_DROP_CLIENT:			// (int clientNum, const char* reason);
-    case G_SEND_SERVER_COMMAND:		// (int clientNum, const char* fmt);
-    case G_SET_CONFIGSTRING:		// (int num, const char* string);
-    case G_SET_USERINFO:			// (int num, const char* buffer);
-    case G_GET_USERCMD:			// (int clientNum, usercmd_t* cmd)
-    case BOTLIB_UPDATENTITY:		// (int ent, void /*struct bot_updateentity_s*/* bue)
-    case BOTLIB_USER_COMMAND:		// (int clientNum, usercmd_t* ucmd)
-    case BOTLIB_AAS_ENTITY_INFO:		// (int entnum, void /*struct aas_entityinfo_s*/* info)
-    case BOTLIB_AAS_AREA_INFO:		// (int areanum, void /*struct aas_areainfo_s*/* info)
-    case BOTLIB_EA_SAY:			// (int client, char* str)
-    case BOTLIB_EA_SAY_TEAM:		// (int client, char* str)
-    case BOTLIB_EA_COMMAND:			// (int client, char* command)
-    case BOTLIB_EA_VIEW:			// (int client, vec3_t viewangles)
-    case BOTLIB_AI_NEXT_CONSOLE_MESSAGE:	// (int chatstate, void /*struct bot_consolemessage_s*/* cm)
-    case BOTLIB_AI_NUM_INITIAL_CHATS:	// (int chatstate, char* type)
-    case BOTLIB_AI_PUSH_GOAL:		// (int goalstate, void* goal)
-    case BOTLIB_AI_GET_TOP_GOAL:		// (int goalstate, void /*struct bot_goal_s*/* goal)
-    case BOTLIB_AI_GET_SECOND_GOAL:		// (int goalstate, void /*struct bot_goal_s*/* goal)
-    case BOTLIB_AI_GET_NEXT_CAMP_SPOT_GOAL:	// (int num, void /*struct bot_goal_s*/* goal)
-    case BOTLIB_AI_LOAD_ITEM_WEIGHTS:	// (int, char*)
-    case BOTLIB_AI_SAVE_GOAL_FUZZY_LOGIC:	// (int, char*)
-    case BOTLIB_AI_INIT_MOVE_STATE:		// (int handle, void* initmove)
-    case BOTLIB_AI_CHOOSE_BEST_FIGHT_WEAPON:	// (int weaponstate, int* inventory)
-    case BOTLIB_AI_LOAD_WEAPON_WEIGHTS:	// (int, char*)
-    case BOTLIB_PC_READ_TOKEN:		// (int, void*)
-    case G_G2_DUPLICATEGHOUL2INSTANCE:	// (void* ghoul2From, void** ghoul2To)
-        ret = qmm_syscall(cmd, VMARG(0), VMPTR(1));
-        break;
-    case G_GET_SERVERINFO:			// (char* buffer, int bufferSize);
-    case G_POINT_CONTENTS:			// (const vec3_t point, int passEntityNum);
-    case G_ADJUST_AREA_PORTAL_STATE:	// (gentity_t* ent, qboolean open);
-    case G_GET_ENTITY_TOKEN:		// (char* buffer, int bufferSize)
-    case BOTLIB_AI_LOAD_CHARACTER:		// (char* charfile, float skill)
-    case BOTLIB_AI_REPLACE_SYNONYMS:	// (char* string, unsigned long int context)
-    case BOTLIB_AI_REACHABILITY_AREA:	// (vec3_t origin, int testground)
-    case G_TESTPRINTINT:			// (char*, int)
-    case G_TESTPRINTFLOAT:			// (char*, float)
-        ret = qmm_syscall(cmd, VMPTR(0), VMARG(1));
-        break;
-    case G_ARGV:				// (int n, char* buffer, int bufferLength);
-    case G_GET_CONFIGSTRING:		// (int num, char* buffer, int bufferSize);
-    case G_GET_USERINFO:			// (int num, char* buffer, int bufferSize);
-    case BOTLIB_GET_CONSOLE_MESSAGE:	// (int clientNum, char* message, int size)
-    case BOTLIB_EA_MOVE:			// (int client, vec3_t dir, float speed)
-    case BOTLIB_AI_GET_CHAT_MESSAGE:	// (int chatstate, char* buf, int size)
-    case BOTLIB_AI_SET_CHAT_NAME:		// (int chatstate, char* name, int client)
-    case BOTLIB_AI_GOAL_NAME:		// (int number, char* name, int size)
-        ret = qmm_syscall(cmd, VMARG(0), VMPTR(1), VMARG(2));
-        break;
-    case G_CVAR_VARIABLE_STRING_BUFFER:	// (const char* var_name, char* buffer, int bufsize);
-    case G_FS_FOPEN_FILE:			// (const char* qpath, fileHandle_t* file, fsMode_t mode);
-    case BOTLIB_LIBVAR_GET:			// (char* var_name, char* value, int size)
-    case BOTLIB_AI_STRING_CONTAINS:		// (char* str1, char* str2, int casesensitive)
-    case BOTLIB_AI_FIND_MATCH:		// (char* str, void /*struct bot_match_s*/* match, unsigned long int context)
-    case SP_GETSTRINGTEXTSTRING:		// (const char* text, char* buffer, int bufferLength)
-        ret = qmm_syscall(cmd, VMPTR(0), VMPTR(1), VMARG(2));
-        break;
-    case G_MEMCPY:				// (void* dest, const void* src, size_t count)
-    case G_STRNCPY:				// (char* strDest, const char* strSource, size_t count)
-        qmm_syscall(cmd, VMPTR(0), VMPTR(1), VMARG(2));
-        ret = args[0];
-        break;
-    case G_FS_READ:				// (void* buffer, int len, fileHandle_t f);
-    case G_FS_WRITE:			// (const void* buffer, int len, fileHandle_t f);
-        ret = qmm_syscall(cmd, VMPTR(0), VMARG(1), VMARG(2));
-        break;
-    case G_MEMSET:				// (void* dest, int c, size_t count)
-        qmm_syscall(cmd, VMPTR(0), VMARG(1), VMARG(2));
-        ret = args[0];
-        break;
-    case G_ENTITY_CONTACT:			// (const vec3_t mins, const vec3_t maxs, const gentity_t* ent);
-    case G_MATRIXMULTIPLY:			// (float in1[3][3], float in2[3][3], float out[3][3])
-        ret = qmm_syscall(cmd, VMPTR(0), VMPTR(1), VMPTR(2));
-        break;
-    case G_ENTITY_CONTACTCAPSULE:		// (const vec3_t mins, const vec3_t maxs, const gentity_t* ent);
-    case BOTLIB_AI_ENTER_CHAT:		// (int chatstate, int client, int sendto)
-    case BOTLIB_AI_SET_AVOID_GOAL_TIME:	// (int goalstate, int number, float avoidtime)
-    case BOTLIB_AI_INTERBREED_GOAL_FUZZY_LOGIC:	// (int, int, int)
-    case G_G2_SETBOLTINFO:			// (void* ghoul2, int modelIndex, int boltInfo)
-    case G_G2_COPYGHOUL2INSTANCE:		// (void* ghoul2From, void* ghoul2To, int modelIndex)
-    case G_ROFF_PLAY:			// (int entID, int roffID, qboolean doTranslation) 
-        ret = qmm_syscall(cmd, VMARG(0), VMARG(1), VMARG(2));
-        break;
-    case G_DEBUG_POLYGON_CREATE:		// (int color, int numPoints, vec3_t* points)
-    case BOTLIB_EA_GET_INPUT:		// (int client, float thinktime, void /*struct bot_input_s*/* input)
-    case BOTLIB_AI_QUEUE_CONSOLE_MESSAGE:	// (int chatstate, int type, char* message)
-    case BOTLIB_AI_GET_WEAPON_INFO:		// (int weaponstate, int weapon, void /*struct weaponinfo_s*/* weaponinfo)
-    case G_G2_ADDBOLT:			// (void* ghoul2, int modelIndex, const char* boneName)
-    case G_G2_GETGLANAME:			// (void* ghoul2, int modelIndex, char* fillBuf)
-        ret = qmm_syscall(cmd, VMARG(0), VMARG(1), VMPTR(2));
-        break;
-    case BOTLIB_AAS_PRESENCE_TYPE_BOUNDING_BOX:	// (int presencetype, vec3_t mins, vec3_t maxs)
-    case BOTLIB_AAS_VECTOR_FOR_BSP_EPAIR_KEY:	// (int ent, char* key, vec3_t v)
-    case BOTLIB_AAS_FLOAT_FOR_BSP_EPAIR_KEY:	// (int ent, char* key, float* value)
-    case BOTLIB_AAS_INT_FOR_BSP_EPAIR_KEY:	// (int ent, char* key, int* value)
-    case BOTLIB_AI_LOAD_CHAT_FILE:		// (int chatstate, char* chatfile, char* chatname)
-    case BOTLIB_AI_GET_LEVEL_ITEM_GOAL:	// (int index, char* classname, void /*struct bot_goal_s*/* goal)
-    case BOTLIB_PC_SOURCE_FILE_AND_LINE:	// (int handle, char* filename, int* line)
-    case G_G2_SETMODELS:			// (void* ghoul2, qhandle_t* modelList, qhandle_t* skinList)
-        ret = qmm_syscall(cmd, VMARG(0), VMPTR(1), VMPTR(2));
-        break;
-    case G_CVAR_REGISTER:			// (vmCvar_t* vmCvar, const char* varName, const char* defaultValue, int flags);
-    case G_ENTITIES_IN_BOX:			// (const vec3_t mins, const vec3_t maxs, gentity_t** list, int maxcount);
-    case G_FS_GETFILELIST:			// (const char* path, const char* extension, char* listbuf, int bufsize) {
-    case BOTLIB_AAS_BBOX_AREAS:		// (vec3_t absmins, vec3_t absmaxs, int* areas, int maxareas)
-        ret = qmm_syscall(cmd, VMPTR(0), VMPTR(1), VMPTR(2), VMARG(3));
-        break;
-    case BOTLIB_TEST:			// (int parm0, char* parm1, vec3_t parm2, vec3_t parm3)
-    case BOTLIB_AI_ITEM_GOAL_IN_VIS_BUT_NOT_VISIBLE:	// (int viewer, vec3_t eye, vec3_t viewangles, void /*struct bot_goal_s*/* goal)
-        ret = qmm_syscall(cmd, VMARG(0), VMPTR(1), VMPTR(2), VMPTR(3));
-        break;
-    case BOTLIB_AAS_VALUE_FOR_BSP_EPAIR_KEY:	// (int ent, char* key, char* value, int size)
-    case BOTLIB_AI_CHOOSE_LTG_ITEM:		// (int goalstate, vec3_t origin, int* inventory, int travelflags)
-        ret = qmm_syscall(cmd, VMARG(0), VMPTR(1), VMPTR(2), VMARG(3));
-        break;
-    case G_ANGLEVECTORS:			// (const vec3_t angles, vec3_t forward, vec3_t right, vec3_t up)
-        ret = qmm_syscall(cmd, VMPTR(0), VMPTR(1), VMPTR(2), VMPTR(3));
-        break;
-    case BOTLIB_AAS_AREA_TRAVEL_TIME_TO_GOAL_AREA:	// (int areanum, vec3_t origin, int goalareanum, int travelflags)
-    case BOTLIB_AI_ADD_AVOID_SPOT:		// (int movestate, vec3_t origin, float radius, int type)
-    case BOTLIB_AI_MOVE_IN_DIRECTION:	// (int movestate, vec3_t dir, float speed, int type)
-        ret = qmm_syscall(cmd, VMARG(0), VMPTR(1), VMARG(2), VMARG(3));
-        break;
-    case BOTLIB_AI_CHARACTERISTIC_BFLOAT:	// (int character, int index, float min, float max)
-    case BOTLIB_AI_CHARACTERISTIC_BINTEGER:	// (int character, int index, int min, int max)
-    case G_G2_COPYSPECIFICGHOUL2MODEL:	// (void* ghoul2From, int modelFrom, void* ghoul2To, int modelTo)
-        ret = qmm_syscall(cmd, VMARG(0), VMARG(1), VMARG(2), VMARG(3));
-        break;
-    case BOTLIB_AI_MATCH_VARIABLE:		// (void /*struct bot_match_s*/* match, int variable, char* buf, int size)
-    case BOTLIB_AI_MOVE_TO_GOAL:		// (void /*struct bot_moveresult_s*/* result, int movestate, void /*struct bot_goal_s*/* goal, int travelflags)
-        ret = qmm_syscall(cmd, VMPTR(0), VMARG(1), VMPTR(2), VMARG(3));
-        break;
-    case BOTLIB_AI_CHARACTERISTIC_STRING:	// (int character, int index, char* buf, int size)
-        ret = qmm_syscall(cmd, VMARG(0), VMARG(1), VMPTR(2), VMARG(3));
-        break;
-    case G_LOCATE_GAME_DATA:		// (gentity_t* gEnts, int numGEntities, int sizeofGEntity_t, playerState_t* clients, int sizeofGameClient);
-        ret = qmm_syscall(cmd, VMPTR(0), VMARG(1), VMARG(2), VMPTR(3), VMARG(4));
-        break;
-    case BOTLIB_AAS_TRACE_AREAS:		// (vec3_t start, vec3_t end, int* areas, vec3_t* points, int maxareas)
-        ret = qmm_syscall(cmd, VMPTR(0), VMPTR(1), VMPTR(2), VMPTR(3), VMARG(4));
-        break;
-    case BOTLIB_AI_MOVEMENT_VIEW_TARGET:	// (int movestate, void /*struct bot_goal_s*/* goal, int travelflags, float lookahead, vec3_t tvmarget)
-        ret = qmm_syscall(cmd, VMARG(0), VMPTR(1), VMARG(2), VMARG(3), VMPTR(4));
-        break;
-    case BOTLIB_AI_PREDICT_VISIBLE_POSITION:	// (vec3_t origin, int areanum, void /*struct bot_goal_s*/* goal, int travelflags, vec3_t tvmarget)
-        ret = qmm_syscall(cmd, VMPTR(0), VMARG(1), VMPTR(2), VMARG(3), VMPTR(4));
-        break;
-    case BOTLIB_AI_GENETIC_PARENTS_AND_CHILD_SELECTION:	// (int numranks, float* ranks, int* parent1, int* parent2, int* child)
-        ret = qmm_syscall(cmd, VMARG(0), VMPTR(1), VMPTR(2), VMPTR(3), VMPTR(4));
-        break;
-    case G_TRACECAPSULE:			// (trace_t* results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask);
-        ret = qmm_syscall(cmd, VMARG(0), VMARG(1), VMARG(2), VMARG(3), VMARG(4), VMARG(5));
-        break;
-    case BOTLIB_AI_CHOOSE_NBG_ITEM:		// (int goalstate, vec3_t origin, int* inventory, int travelflags, void /*struct bot_goal_s*/* ltg, float maxtime)
-        ret = qmm_syscall(cmd, VMARG(0), VMPTR(1), VMPTR(2), VMARG(3), VMPTR(4), VMARG(5));
-        break;
-    case G_TRACE:				// (trace_t* results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask);
-        ret = qmm_syscall(cmd, VMPTR(0), VMPTR(1), VMPTR(2), VMPTR(3), VMPTR(4), VMARG(5), VMARG(6));
-        break;
-    case G_G2_INITGHOUL2MODEL:		// (void** ghoul2Ptr, const char* fileName, int modelIndex, qhandle_t customSkin, qhandle_t customShader, int modelFlags, int lodBias)
-        ret = qmm_syscall(cmd, VMPTR(0), VMPTR(1), VMARG(2), VMARG(3), VMARG(4), VMARG(5), VMARG(6));
-        break;
-    case BOTLIB_AAS_ALTERNATIVE_ROUTE_GOAL:	// (vec3_t start, int startareanum, vec3_t goal, int goalareanum, int travelflags, void /*struct aas_altroutegoal_s*/*altroutegoals, int maxaltroutegoals, int type)
-        ret = qmm_syscall(cmd, VMPTR(0), VMARG(1), VMPTR(2), VMARG(3), VMARG(4), VMPTR(5), VMARG(6), VMARG(7));
-        break;
-    case G_G2_GETBOLT:			// (void* ghoul2, const int modelIndex, const int boltIndex, mdxaBone_t* matrix, const vec3_t angles, const vec3_t position, const int frameNum, qhandle_t* modelList, vec3_t scale)
-    case G_G2_GETBOLT_NOREC:		// (void* ghoul2, const int modelIndex, const int boltIndex, mdxaBone_t* matrix, const vec3_t angles, const vec3_t position, const int frameNum, qhandle_t* modelList, vec3_t scale)
-    case G_G2_GETBOLT_NOREC_NOROT:		// (void* ghoul2, const int modelIndex, const int boltIndex, mdxaBone_t* matrix, const vec3_t angles, const vec3_t position, const int frameNum, qhandle_t* modelList, vec3_t scale)
-        ret = qmm_syscall(cmd, VMARG(0), VMARG(1), VMARG(2), VMPTR(3), VMPTR(4), VMPTR(5), VMARG(6), VMPTR(7), VMPTR(8));
-        break;
-    case G_G2_PLAYANIM:			// (void* ghoul2, const int modelIndex, const char* boneName, const int startFrame, const int endFrame, const int flags, const float animSpeed, const int currentTime, const float setFrame , const int blendTime)
-        ret = qmm_syscall(cmd, VMARG(0), VMARG(1), VMPTR(2), VMARG(3), VMARG(4), VMARG(5), VMARG(6), VMARG(7), VMPTR(8), VMARG(9));
-        break;
-    case BOTLIB_AI_INITIAL_CHAT:		// (int chatstate, char* type, int mcontext, char* var0, char* var1, char* var2, char* var3, char* var4, char* var5, char* var6, char* var7)
-        ret = qmm_syscall(cmd, VMARG(0), VMPTR(1), VMARG(2), VMPTR(3), VMPTR(4), VMPTR(5), VMPTR(6), VMPTR(7), VMPTR(8), VMPTR(9), VMPTR(10));
-        break;
-    case G_G2_ANGLEOVERRIDE:		// (void* ghoul2, int modelIndex, const char* boneName, const vec3_t angles, const int flags, const int up, const int right, const int forward, qhandle_t* modelList, int blendTime , int currentTime)
-        ret = qmm_syscall(cmd, VMARG(0), VMARG(1), VMPTR(2), VMPTR(3), VMARG(4), VMARG(5), VMARG(6), VMARG(7), VMPTR(8), VMARG(9), VMARG(10));
-        break;
-    case BOTLIB_AAS_PREDICT_ROUTE:		// (void /*struct aas_predictroute_s*/*route, int areanum, vec3_t origin, int goalareanum, int travelflags, int maxareas, int maxtime, int stopevent, int stopcontents, int stoptfl, int stopareanum)
-        ret = qmm_syscall(cmd, VMPTR(0), VMARG(1), VMPTR(2), VMARG(3), VMARG(4), VMARG(5), VMARG(6), VMARG(7), VMARG(8), VMARG(9), VMARG(10), VMARG(11));
-        break;
-    case BOTLIB_AI_REPLY_CHAT:		// (int chatstate, char* message, int mcontext, int vcontext, char* var0, char* var1, char* var2, char* var3, char* var4, char* var5, char* var6, char* var7)
-        ret = qmm_syscall(cmd, VMARG(0), VMPTR(1), VMARG(2), VMARG(3), VMPTR(4), VMPTR(5), VMPTR(6), VMPTR(7), VMPTR(8), VMPTR(9), VMPTR(10), VMPTR(11));
-        break;
-    case G_G2_COLLISIONDETECT:		// (CollisionRecord_t* collRecMap, void* ghoul2, const vec3_t angles, const vec3_t position,int frameNumber, int entNum, vec3_t rayStart, vec3_t rayEnd, vec3_t scale, int traceFlags, int useLod, float fRadius)
-        ret = qmm_syscall(cmd, VMPTR(0), VMARG(1), VMPTR(2), VMPTR(3), VMARG(4), VMARG(5), VMPTR(6), VMPTR(7), VMPTR(8), VMARG(9), VMARG(10), VMARG(11));
-        break;
-    case BOTLIB_AAS_PREDICT_CLIENT_MOVEMENT:	// (void /*struct aas_clientmove_s*/* move, int entnum, vec3_t origin, int presencetype, int onground, vec3_t velocity, vec3_t cmdmove, int cmdframes, int maxframes, float frametime, int stopevent, int stopareanum, int visualize)
-        ret = qmm_syscall(cmd, VMPTR(0), VMARG(1), VMPTR(2), VMARG(3), VMARG(4), VMPTR(5), VMPTR(6), VMARG(7), VMARG(8), VMARG(9), VMARG(10), VMARG(11), VMARG(12));
-        break;
 
-    default:
-        ret = 0;
-    }
+const QVMSyscallDesc* JK2MP_GameSupport::QVMSyscalls(int* count) {
+    *count = qvm_syscalls.count;
+    return qvm_syscalls.descs;
+}
+
 
-    QMMLOG(QMM_LOG_TRACE, "QMM") << "JK2MP_GameSupport::QVMSyscall(" << EngMsgName(cmd) << "(" << cmd << ")) returning " << ret << "\n";
+// number of args each mod message takes
+static constexpr MsgArgcDef vmmain_argc_defs[] = {
+    { GAME_INIT, 3 },	// (int levelTime, int randomSeed, int restart)
+    { GAME_SHUTDOWN, 1 },	// (int restart)
+    { GAME_CLIENT_CONNECT, 3 },	// (int clientNum, qboolean firstTime, qboolean isBot)
+    { GAME_CLIENT_BEGIN, 1 },	// (int clientNum)
+    { GAME_CLIENT_USERINFO_CHANGED, 1 },	// (int clientNum)
+    { GAME_CLIENT_DISCONNECT, 1 },	// (int clientNum)
+    { GAME_CLIENT_COMMAND, 1 },	// (int clientNum)
+    { GAME_CLIENT_THINK, 1 },	// (int clientNum)
+    { GAME_RUN_FRAME, 1 },	// (int levelTime)
+    { GAME_CONSOLE_COMMAND, 0 },	// (void)
+    { BOTAI_START_FRAME, 1 },	// (int time)
+    { GAME_ROFF_NOTETRACK_CALLBACK, 2 },	// (int entID, const char* notetrack)
+};
 
+static constexpr auto vmmain_argcs = GEN_VMMAIN_ARGC_TABLE(vmmain_argc_defs);
 
-    return ret;
+
+const int8_t* JK2MP_GameSupport::VMMainArgcs(int* count) {
+    *count = vmmain_argcs.count;
+    return vmmain_argcs.argc;
 }
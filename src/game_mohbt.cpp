@@ -41,8 +41,10 @@ struct MOHBT_GameSupport : public GameSupport {
     virtual int QMMEngMsg(int msg) { return qmm_eng_msgs[msg]; }
     virtual int QMMModMsg(int msg) { return qmm_mod_msgs[msg]; }
 
-    virtual intptr_t syscall(intptr_t, ...);
-    virtual intptr_t vmMain(intptr_t, ...);
+    virtual intptr_t syscall_args(intptr_t, intptr_t*, int);
+    virtual intptr_t vmMain_args(intptr_t, intptr_t*, int);
+    virtual const int8_t* SyscallArgcs(int* count);
+    virtual const int8_t* VMMainArgcs(int* count);
 
     virtual const char* DefaultDLLName() { return "game" MOD_DLL; }
     virtual const char* DefaultModDir() { return "maintt"; }
@@ -94,9 +96,7 @@ bool MOHBT_GameSupport::AutoDetect(APIType engineapi) {
 
 // wrapper syscall function that calls actual engine func from orig_import
 // this is how QMM and plugins will call into the engine
-intptr_t MOHBT_GameSupport::syscall(intptr_t cmd, ...) {
-    QMM_GET_SYSCALL_ARGS();
-
+intptr_t MOHBT_GameSupport::syscall_args(intptr_t cmd, intptr_t* args, int argc) {
     if (cmd != G_PRINT)
         QMMLOG(QMM_LOG_TRACE, "QMM") << "MOHBT_GameSupport::syscall(" << EngMsgName(cmd) << "(" << cmd << ")) called\n";
 
@@ -464,9 +464,7 @@ intptr_t MOHBT_GameSupport::syscall(intptr_t cmd, ...) {
 
 // wrapper vmMain function that calls actual mod func from orig_export
 // this is how QMM and plugins will call into the mod
-intptr_t MOHBT_GameSupport::vmMain(intptr_t cmd, ...) {
-    QMM_GET_VMMAIN_ARGS();
-
+intptr_t MOHBT_GameSupport::vmMain_args(intptr_t cmd, intptr_t* args, int argc) {
     QMMLOG(QMM_LOG_TRACE, "QMM") << "MOHBT_GameSupport::vmMain(" << ModMsgName(cmd) << "(" << cmd << ")) called\n";
 
     if (!orig_export)
@@ -1086,3 +1084,234 @@ game_export_t MOHBT_GameSupport::qmm_export = {
 };
 
 #endif // QMM_ARCH_32
+
+
+// number of args each engine message takes, read from the game_import_t declarations
+static constexpr MsgArgcDef syscall_argc_defs[] = {
+    GEN_IMPORT_ARGC(Printf, G_PRINTF),
+    GEN_IMPORT_ARGC(DPrintf, G_DPRINTF),
+    GEN_IMPORT_ARGC(DPrintf2, G_DPRINTF2),
+    GEN_IMPORT_ARGC(DebugPrintf, G_DEBUGPRINTF),
+    GEN_IMPORT_ARGC(Error, G_ERROR),
+    GEN_IMPORT_ARGC(Milliseconds, G_MILLISECONDS),
+    GEN_IMPORT_ARGC(LV_ConvertString, G_LV_CONVERTSTRING),
+    GEN_IMPORT_ARGC(CL_LV_ConvertString, G_CL_LV_CONVERTSTRING),
+    GEN_IMPORT_ARGC(Malloc, G_MALLOC),
+    GEN_IMPORT_ARGC(Free, G_FREE),
+    GEN_IMPORT_ARGC(Cvar_Get, G_CVAR_GET),
+    GEN_IMPORT_ARGC(cvar_set, G_CVAR_SET),
+    GEN_IMPORT_ARGC(cvar_set2, G_CVAR_SET2),
+    GEN_IMPORT_ARGC(NextCvar, G_NEXTCVAR),
+    GEN_IMPORT_ARGC(Argc, G_ARGC),
+    GEN_IMPORT_ARGC(Argv, G_ARGV),
+    GEN_IMPORT_ARGC(Args, G_ARGS),
+    GEN_IMPORT_ARGC(AddCommand, G_ADDCOMMAND),
+    GEN_IMPORT_ARGC(FS_ReadFile, G_FS_READFILE),
+    GEN_IMPORT_ARGC(FS_FreeFile, G_FS_FREEFILE),
+    GEN_IMPORT_ARGC(FS_WriteFile, G_FS_WRITEFILE),
+    GEN_IMPORT_ARGC(FS_FOpenFileWrite, G_FS_FOPEN_FILE_WRITE),
+    GEN_IMPORT_ARGC(FS_FOpenFileAppend, G_FS_FOPEN_FILE_APPEND),
+    GEN_IMPORT_ARGC(FS_FOpenFile, G_FS_UNKNOWN),
+    GEN_IMPORT_ARGC(FS_PrepFileWrite, G_FS_PREPFILEWRITE),
+    GEN_IMPORT_ARGC(FS_Write, G_FS_WRITE),
+    GEN_IMPORT_ARGC(FS_Read, G_FS_READ),
+    GEN_IMPORT_ARGC(FS_FCloseFile, G_FS_FCLOSE_FILE),
+    GEN_IMPORT_ARGC(FS_Tell, G_FS_TELL),
+    GEN_IMPORT_ARGC(FS_Seek, G_FS_SEEK),
+    GEN_IMPORT_ARGC(FS_Flush, G_FS_FLUSH),
+    GEN_IMPORT_ARGC(FS_FileNewer, G_FS_FILENEWER),
+    GEN_IMPORT_ARGC(FS_CanonicalFilename, G_FS_CANONICALFILENAME),
+    GEN_IMPORT_ARGC(FS_ListFiles, G_FS_LISTFILES),
+    GEN_IMPORT_ARGC(FS_FreeFileList, G_FS_FREEFILELIST),
+    GEN_IMPORT_ARGC(GetArchiveFileName, G_GETARCHIVEFILENAME),
+    GEN_IMPORT_ARGC(SendConsoleCommand, G_SEND_CONSOLE_COMMAND),
+    GEN_IMPORT_ARGC(ExecuteConsoleCommand, G_EXECUTE_CONSOLE_COMMAND),
+    GEN_IMPORT_ARGC(DebugGraph, G_DEBUGGRAPH),
+    GEN_IMPORT_ARGC(SendServerCommand, G_SEND_SERVER_COMMAND),
+    GEN_IMPORT_ARGC(DropClient, G_DROP_CLIENT),
+    GEN_IMPORT_ARGC(MSG_WriteBits, G_MSG_WRITEBITS),
+    GEN_IMPORT_ARGC(MSG_WriteChar, G_MSG_WRITECHAR),
+    GEN_IMPORT_ARGC(MSG_WriteByte, G_MSG_WRITEBYTE),
+    GEN_IMPORT_ARGC(MSG_WriteSVC, G_MSG_WRITESVC),
+    GEN_IMPORT_ARGC(MSG_WriteShort, G_MSG_WRITESHORT),
+    GEN_IMPORT_ARGC(MSG_WriteLong, G_MSG_WRITELONG),
+    GEN_IMPORT_ARGC(MSG_WriteFloat, G_MSG_WRITEFLOAT),
+    GEN_IMPORT_ARGC(MSG_WriteString, G_MSG_WRITESTRING),
+    GEN_IMPORT_ARGC(MSG_WriteAngle8, G_MSG_WRITEANGLE8),
+    GEN_IMPORT_ARGC(MSG_WriteAngle16, G_MSG_WRITEANGLE16),
+    GEN_IMPORT_ARGC(MSG_WriteCoord, G_MSG_WRITECOORD),
+    GEN_IMPORT_ARGC(MSG_WriteDir, G_MSG_WRITEDIR),
+    GEN_IMPORT_ARGC(MSG_StartCGM, G_MSG_STARTCGM),
+    GEN_IMPORT_ARGC(MSG_EndCGM, G_MSG_ENDCGM),
+    GEN_IMPORT_ARGC(MSG_SetClient, G_MSG_SETCLIENT),
+    GEN_IMPORT_ARGC(SetBroadcastVisible, G_SETBROADCASTVISIBLE),
+    GEN_IMPORT_ARGC(SetBroadcastHearable, G_SETBROADCASTHEARABLE),
+    GEN_IMPORT_ARGC(SetBroadcastAll, G_SETBROADCASTALL),
+    GEN_IMPORT_ARGC(setConfigstring, G_SET_CONFIGSTRING),
+    GEN_IMPORT_ARGC(getConfigstring, G_GET_CONFIGSTRING),
+    GEN_IMPORT_ARGC(SetUserinfo, G_SET_USERINFO),
+    GEN_IMPORT_ARGC(GetUserinfo, G_GET_USERINFO),
+    GEN_IMPORT_ARGC(SetBrushModel, G_SET_BRUSH_MODEL),
+    GEN_IMPORT_ARGC(ModelBoundsFromName, G_MODELBOUNDSFROMNAME),
+    GEN_IMPORT_ARGC(SightTraceEntity, G_SIGHTTRACEENTITY),
+    GEN_IMPORT_ARGC(SightTrace, G_SIGHTTRACE),
+    GEN_IMPORT_ARGC(trace, G_TRACE),
+    GEN_IMPORT_ARGC(CM_VisualObfuscation, G_CM_VISUALOBFUSCATION),
+    GEN_IMPORT_ARGC(GetShader, G_GETSHADER),
+    GEN_IMPORT_ARGC(pointcontents, G_POINT_CONTENTS),
+    GEN_IMPORT_ARGC(PointBrushnum, G_POINTBRUSHNUM),
+    GEN_IMPORT_ARGC(AdjustAreaPortalState, G_ADJUSTAREAPORTALSTATE),
+    GEN_IMPORT_ARGC(AreaForPoint, G_AREAFORPOINT),
+    GEN_IMPORT_ARGC(AreasConnected, G_AREAS_CONNECTED),
+    GEN_IMPORT_ARGC(InPVS, G_IN_PVS),
+    GEN_IMPORT_ARGC(linkentity, G_LINKENTITY),
+    GEN_IMPORT_ARGC(unlinkentity, G_UNLINKENTITY),
+    GEN_IMPORT_ARGC(AreaEntities, G_AREAENTITIES),
+    GEN_IMPORT_ARGC(ClipToEntity, G_CLIPTOENTITY),
+    GEN_IMPORT_ARGC(HitEntity, G_HITENTITY),
+    GEN_IMPORT_ARGC(imageindex, G_IMAGEINDEX),
+    GEN_IMPORT_ARGC(itemindex, G_ITEMINDEX),
+    GEN_IMPORT_ARGC(soundindex, G_SOUNDINDEX),
+    GEN_IMPORT_ARGC(TIKI_RegisterModel, G_TIKI_REGISTERMODEL),
+    GEN_IMPORT_ARGC(modeltiki, G_MODELTIKI),
+    GEN_IMPORT_ARGC(modeltikianim, G_MODELTIKIANIM),
+    GEN_IMPORT_ARGC(SetLightStyle, G_SETLIGHTSTYLE),
+    GEN_IMPORT_ARGC(GameDir, G_GAMEDIR),
+    GEN_IMPORT_ARGC(setmodel, G_SETMODEL),
+    GEN_IMPORT_ARGC(clearmodel, G_CLEARMODEL),
+    GEN_IMPORT_ARGC(TIKI_NumAnims, G_TIKI_NUMANIMS),
+    GEN_IMPORT_ARGC(TIKI_NumSurfaces, G_TIKI_NUMSURFACES),
+    GEN_IMPORT_ARGC(TIKI_NumTags, G_TIKI_NUMTAGS),
+    GEN_IMPORT_ARGC(TIKI_CalculateBounds, G_TIKI_CALCULATEBOUNDS),
+    GEN_IMPORT_ARGC(TIKI_GetSkeletor, G_TIKI_GETSKELETOR),
+    GEN_IMPORT_ARGC(Anim_NameForNum, G_ANIM_NAMEFORNUM),
+    GEN_IMPORT_ARGC(Anim_NumForName, G_ANIM_NUMFORNAME),
+    GEN_IMPORT_ARGC(Anim_Random, G_ANIM_RANDOM),
+    GEN_IMPORT_ARGC(Anim_NumFrames, G_ANIM_NUMFRAMES),
+    GEN_IMPORT_ARGC(Anim_Time, G_ANIM_TIME),
+    GEN_IMPORT_ARGC(Anim_Frametime, G_ANIM_FRAMETIME),
+    GEN_IMPORT_ARGC(Anim_CrossTime, G_ANIM_CROSSTIME),
+    GEN_IMPORT_ARGC(Anim_Delta, G_ANIM_DELTA),
+    GEN_IMPORT_ARGC(Anim_AngularDelta, G_ANIM_ANGULARDELTA),
+    GEN_IMPORT_ARGC(Anim_HasDelta, G_ANIM_HASDELTA),
+    GEN_IMPORT_ARGC(Anim_DeltaOverTime, G_ANIM_DELTAOVERTIME),
+    GEN_IMPORT_ARGC(Anim_AngularDeltaOverTime, G_ANIM_ANGULARDELTAOVERTIME),
+    GEN_IMPORT_ARGC(Anim_Flags, G_ANIM_FLAGS),
+    GEN_IMPORT_ARGC(Anim_FlagsSkel, G_ANIM_FLAGSSKEL),
+    GEN_IMPORT_ARGC(Anim_HasCommands, G_ANIM_HASCOMMANDS),
+    GEN_IMPORT_ARGC(NumHeadModels, G_NUMHEADMODELS),
+    GEN_IMPORT_ARGC(GetHeadModel, G_GETHEADMODEL),
+    GEN_IMPORT_ARGC(NumHeadSkins, G_NUMHEADSKINS),
+    GEN_IMPORT_ARGC(GetHeadSkin, G_GETHEADSKIN),
+    GEN_IMPORT_ARGC(Frame_Commands, G_FRAME_COMMANDS),
+    GEN_IMPORT_ARGC(Surface_NameToNum, G_SURFACE_NAMETONUM),
+    GEN_IMPORT_ARGC(Surface_NumToName, G_SURFACE_NUMTONAME),
+    GEN_IMPORT_ARGC(Tag_NumForName, G_TAG_NUMFORNAME),
+    GEN_IMPORT_ARGC(Tag_NameForNum, G_TAG_NAMEFORNUM),
+    GEN_IMPORT_ARGC(TIKI_OrientationInternal, G_TIKI_ORIENTATIONINTERNAL),
+    GEN_IMPORT_ARGC(TIKI_TransformInternal, G_TIKI_TRANSFORMINTERNAL),
+    GEN_IMPORT_ARGC(TIKI_IsOnGroundInternal, G_TIKI_ISONGROUNDINTERNAL),
+    GEN_IMPORT_ARGC(TIKI_SetPoseInternal, G_TIKI_SETPOSEINTERNAL),
+    GEN_IMPORT_ARGC(CM_GetHitLocationInfo, G_CM_GETHITLOCATIONINFO),
+    GEN_IMPORT_ARGC(CM_GetHitLocationInfoSecondary, G_CM_GETHITLOCATIONINFOSECONDARY),
+    GEN_IMPORT_ARGC(Alias_Add, G_ALIAS_ADD),
+    GEN_IMPORT_ARGC(Alias_FindRandom, G_ALIAS_FINDRANDOM),
+    GEN_IMPORT_ARGC(Alias_Dump, G_ALIAS_DUMP),
+    GEN_IMPORT_ARGC(Alias_Clear, G_ALIAS_CLEAR),
+    GEN_IMPORT_ARGC(Alias_UpdateDialog, G_ALIAS_UPDATEDIALOG),
+    GEN_IMPORT_ARGC(TIKI_NameForNum, G_TIKI_NAMEFORNUM),
+    GEN_IMPORT_ARGC(GlobalAlias_Add, G_GLOBALALIAS_ADD),
+    GEN_IMPORT_ARGC(GlobalAlias_FindRandom, G_GLOBALALIAS_FINDRANDOM),
+    GEN_IMPORT_ARGC(GlobalAlias_Dump, G_GLOBALALIAS_DUMP),
+    GEN_IMPORT_ARGC(GlobalAlias_Clear, G_GLOBALALIAS_CLEAR),
+    GEN_IMPORT_ARGC(centerprintf, G_CENTERPRINTF),
+    GEN_IMPORT_ARGC(locationprintf, G_LOCATIONPRINTF),
+    GEN_IMPORT_ARGC(Sound, G_SOUND),
+    GEN_IMPORT_ARGC(StopSound, G_STOPSOUND),
+    GEN_IMPORT_ARGC(SoundLength, G_SOUNDLENGTH),
+    GEN_IMPORT_ARGC(SoundAmplitudes, G_SOUNDAMPLITUDES),
+    GEN_IMPORT_ARGC(S_IsSoundPlaying, G_S_ISSOUNDPLAYING),
+    GEN_IMPORT_ARGC(CalcCRC, G_CALCCRC),
+    GEN_IMPORT_ARGC(LocateGameData, G_LOCATE_GAME_DATA),
+    GEN_IMPORT_ARGC(SetFarPlane, G_SETFARPLANE),
+    GEN_IMPORT_ARGC(SetSkyPortal, G_SETSKYPORTAL),
+    GEN_IMPORT_ARGC(Popmenu, G_POPMENU),
+    GEN_IMPORT_ARGC(Showmenu, G_SHOWMENU),
+    GEN_IMPORT_ARGC(Hidemenu, G_HIDEMENU),
+    GEN_IMPORT_ARGC(Pushmenu, G_PUSHMENU),
+    GEN_IMPORT_ARGC(HideMouseCursor, G_HIDEMOUSECURSOR),
+    GEN_IMPORT_ARGC(ShowMouseCursor, G_SHOWMOUSECURSOR),
+    GEN_IMPORT_ARGC(MapTime, G_MAPTIME),
+    GEN_IMPORT_ARGC(LoadResource, G_LOADRESOURCE),
+    GEN_IMPORT_ARGC(ClearResource, G_CLEARRESOURCE),
+    GEN_IMPORT_ARGC(Key_StringToKeynum, G_KEY_STRINGTOKEYNUM),
+    GEN_IMPORT_ARGC(Key_KeynumToBindString, G_KEY_KEYNUMTOBINDSTRING),
+    GEN_IMPORT_ARGC(Key_GetKeysForCommand, G_KEY_GETKEYSFORCOMMAND),
+    GEN_IMPORT_ARGC(ArchiveLevel, G_ARCHIVELEVEL),
+    GEN_IMPORT_ARGC(AddSvsTimeFixup, G_ADDSVSTIMEFIXUP),
+    GEN_IMPORT_ARGC(HudDrawShader, G_HUDDRAWSHADER),
+    GEN_IMPORT_ARGC(HudDrawAlign, G_HUDDRAWALIGN),
+    GEN_IMPORT_ARGC(HudDrawRect, G_HUDDRAWRECT),
+    GEN_IMPORT_ARGC(HudDrawVirtualSize, G_HUDDRAWVIRTUALSIZE),
+    GEN_IMPORT_ARGC(HudDrawColor, G_HUDDRAWCOLOR),
+    GEN_IMPORT_ARGC(HudDrawAlpha, G_HUDDRAWALPHA),
+    GEN_IMPORT_ARGC(HudDrawString, G_HUDDRAWSTRING),
+    GEN_IMPORT_ARGC(HudDrawFont, G_HUDDRAWFONT),
+    GEN_IMPORT_ARGC(SanitizeName, G_SANITIZENAME),
+    GEN_IMPORT_ARGC(pvssoundindex, G_PVSSOUNDINDEX),
+};
+
+static constexpr auto syscall_argcs = GEN_SYSCALL_ARGC_TABLE(syscall_argc_defs);
+
+
+// number of args each mod message takes, read from the game_export_t declarations
+static constexpr MsgArgcDef vmmain_argc_defs[] = {
+    GEN_EXPORT_ARGC(Init, GAME_INIT),
+    GEN_EXPORT_ARGC(Shutdown, GAME_SHUTDOWN),
+    GEN_EXPORT_ARGC(Cleanup, GAME_CLEANUP),
+    GEN_EXPORT_ARGC(Precache, GAME_PRECACHE),
+    GEN_EXPORT_ARGC(SetMap, GAME_SETMAP),
+    GEN_EXPORT_ARGC(Restart, GAME_RESTART),
+    GEN_EXPORT_ARGC(SetTime, GAME_SETTIME),
+    GEN_EXPORT_ARGC(SpawnEntities, GAME_SPAWN_ENTITIES),
+    GEN_EXPORT_ARGC(ClientConnect, GAME_CLIENT_CONNECT),
+    GEN_EXPORT_ARGC(ClientBegin, GAME_CLIENT_BEGIN),
+    GEN_EXPORT_ARGC(ClientUserinfoChanged, GAME_CLIENT_USERINFO_CHANGED),
+    GEN_EXPORT_ARGC(ClientDisconnect, GAME_CLIENT_DISCONNECT),
+    GEN_EXPORT_ARGC(ClientCommand, GAME_CLIENT_COMMAND),
+    GEN_EXPORT_ARGC(ClientThink, GAME_CLIENT_THINK),
+    GEN_EXPORT_ARGC(BotBegin, GAME_BOTBEGIN),
+    GEN_EXPORT_ARGC(BotThink, GAME_BOTTHINK),
+    GEN_EXPORT_ARGC(PrepFrame, GAME_PREP_FRAME),
+    GEN_EXPORT_ARGC(RunFrame, GAME_RUN_FRAME),
+    GEN_EXPORT_ARGC(ServerSpawned, GAME_SERVER_SPAWNED),
+    GEN_EXPORT_ARGC(RegisterSounds, GAME_REGISTER_SOUNDS),
+    GEN_EXPORT_ARGC(AllowPaused, GAME_ALLOW_PAUSED),
+    GEN_EXPORT_ARGC(ConsoleCommand, GAME_CONSOLE_COMMAND),
+    GEN_EXPORT_ARGC(ArchivePersistant, GAME_ARCHIVE_PERSISTANT),
+    GEN_EXPORT_ARGC(WriteLevel, GAME_WRITE_LEVEL),
+    GEN_EXPORT_ARGC(ReadLevel, GAME_READ_LEVEL),
+    GEN_EXPORT_ARGC(LevelArchiveValid, GAME_LEVEL_ARCHIVE_VALID),
+    GEN_EXPORT_ARGC(ArchiveInteger, GAME_ARCHIVE_INTEGER),
+    GEN_EXPORT_ARGC(ArchiveFloat, GAME_ARCHIVE_FLOAT),
+    GEN_EXPORT_ARGC(ArchiveString, GAME_ARCHIVE_STRING),
+    GEN_EXPORT_ARGC(ArchiveSvsTime, GAME_ARCHIVE_SVSTIME),
+    GEN_EXPORT_ARGC(TIKI_Orientation, GAME_TIKI_ORIENTATION),
+    GEN_EXPORT_ARGC(DebugCircle, GAME_DEBUG_CIRCLE),
+    GEN_EXPORT_ARGC(SetFrameNumber, GAME_SET_FRAME_NUMBER),
+    GEN_EXPORT_ARGC(SoundCallback, GAME_SOUND_CALLBACK),
+};
+
+static constexpr auto vmmain_argcs = GEN_VMMAIN_ARGC_TABLE(vmmain_argc_defs);
+
+
+const int8_t* MOHBT_GameSupport::SyscallArgcs(int* count) {
+    *count = syscall_argcs.count;
+    return syscall_argcs.argc;
+}
+
+
+const int8_t* MOHBT_GameSupport::VMMainArgcs(int* count) {
+    *count = vmmain_argcs.count;
+    return vmmain_argcs.argc;
+}
@@ -41,8 +41,10 @@ struct Q2R_GameSupport : public GameSupport {
     virtual int QMMEngMsg(int msg) { return qmm_eng_msgs[msg]; }
     virtual int QMMModMsg(int msg) { return qmm_mod_msgs[msg]; }
 
-    virtual intptr_t syscall(intptr_t, ...);
-    virtual intptr_t vmMain(intptr_t, ...);
+    virtual intptr_t syscall_args(intptr_t, intptr_t*, int);
+    virtual intptr_t vmMain_args(intptr_t, intptr_t*, int);
+    virtual const int8_t* SyscallArgcs(int* count);
+    virtual const int8_t* VMMainArgcs(int* count);
 
     virtual const char* DefaultDLLName() { return "game_" X64_DLL; }
     virtual const char* DefaultModDir() { return "baseq2"; }
@@ -83,7 +85,7 @@ private:
     const int qmm_eng_msgs[QMM_ENGINE_MSG_COUNT] = GEN_GAME_QMM_ENG_MSGS();
     // GAME_PREINIT gets called first, which is when QMM has to perform mod/plugin loading, but we
     // don't want to make plugins have to use separate code to handle the actual GAME_INIT message
-    const int qmm_mod_msgs[QMM_MOD_MSG_COUNT] = { GAME_PREINIT, GAME_SHUTDOWN, GAME_CONSOLE_COMMAND, };
+    const int qmm_mod_msgs[QMM_MOD_MSG_COUNT] = { GAME_PREINIT, GAME_SHUTDOWN, GAME_CONSOLE_COMMAND, GAME_RUN_FRAME, };
 };
 
 GEN_GAME_OBJ(Q2R);
@@ -106,9 +108,7 @@ bool Q2R_GameSupport::AutoDetect(APIType engineapi) {
 
 // wrapper syscall function that calls actual engine func from orig_import
 // this is how QMM and plugins will call into the engine
-intptr_t Q2R_GameSupport::syscall(intptr_t cmd, ...) {
-    QMM_GET_SYSCALL_ARGS();
-
+intptr_t Q2R_GameSupport::syscall_args(intptr_t cmd, intptr_t* args, int argc) {
     if (cmd != G_PRINT)
         QMMLOG(QMM_LOG_TRACE, "QMM") << "Q2R_GameSupport::syscall(" << EngMsgName(cmd) << "(" << cmd << ")) called\n";
 
@@ -358,9 +358,7 @@ intptr_t Q2R_GameSupport::syscall(intptr_t cmd, ...) {
 
 // wrapper vmMain function that calls actual mod func from orig_export
 // this is how QMM and plugins will call into the mod
-intptr_t Q2R_GameSupport::vmMain(intptr_t cmd, ...) {
-    QMM_GET_VMMAIN_ARGS();
-
+intptr_t Q2R_GameSupport::vmMain_args(intptr_t cmd, intptr_t* args, int argc) {
     QMMLOG(QMM_LOG_TRACE, "QMM") << "Q2R_GameSupport::vmMain(" << ModMsgName(cmd) << "(" << cmd << ")) called\n";
 
     if (!orig_export)
@@ -811,3 +809,128 @@ game_export_t Q2R_GameSupport::qmm_export = {
     GEN_EXPORT(GetShadowLightData, GAME_GETSHADOWLIGHTDATA),
 };
 #endif // QMM_OS_WINDOWS && QMM_ARCH_64
+
+
+// number of args each engine message takes, read from the game_import_t declarations
+static constexpr MsgArgcDef syscall_argc_defs[] = {
+    GEN_IMPORT_ARGC(Broadcast_Print, G_BROADCAST_PRINT),
+    GEN_IMPORT_ARGC(Com_Print, G_COM_PRINT),
+    GEN_IMPORT_ARGC(Client_Print, G_CLIENT_PRINT),
+    GEN_IMPORT_ARGC(Center_Print, G_CENTERPRINT),
+    GEN_IMPORT_ARGC(sound, G_SOUND),
+    GEN_IMPORT_ARGC(positioned_sound, G_POSITIONED_SOUND),
+    GEN_IMPORT_ARGC(local_sound, G_LOCAL_SOUND),
+    GEN_IMPORT_ARGC(configstring, G_CONFIGSTRING),
+    GEN_IMPORT_ARGC(get_configstring, G_GET_CONFIGSTRING),
+    GEN_IMPORT_ARGC(Com_Error, G_COM_ERROR),
+    GEN_IMPORT_ARGC(modelindex, G_MODELINDEX),
+    GEN_IMPORT_ARGC(soundindex, G_SOUNDINDEX),
+    GEN_IMPORT_ARGC(imageindex, G_IMAGEINDEX),
+    GEN_IMPORT_ARGC(setmodel, G_SETMODEL),
+    GEN_IMPORT_ARGC(trace, G_TRACE),
+    GEN_IMPORT_ARGC(clip, G_CLIP),
+    GEN_IMPORT_ARGC(pointcontents, G_POINT_CONTENTS),
+    GEN_IMPORT_ARGC(inPVS, G_IN_PVS),
+    GEN_IMPORT_ARGC(inPHS, G_IN_PHS),
+    GEN_IMPORT_ARGC(SetAreaPortalState, G_SETAREAPORTALSTATE),
+    GEN_IMPORT_ARGC(AreasConnected, G_AREAS_CONNECTED),
+    GEN_IMPORT_ARGC(linkentity, G_LINKENTITY),
+    GEN_IMPORT_ARGC(unlinkentity, G_UNLINKENTITY),
+    GEN_IMPORT_ARGC(BoxEdicts, G_BOXEDICTS),
+    GEN_IMPORT_ARGC(multicast, G_MULTICAST),
+    GEN_IMPORT_ARGC(unicast, G_UNICAST),
+    GEN_IMPORT_ARGC(WriteChar, G_MSG_WRITECHAR),
+    GEN_IMPORT_ARGC(WriteByte, G_MSG_WRITEBYTE),
+    GEN_IMPORT_ARGC(WriteShort, G_MSG_WRITESHORT),
+    GEN_IMPORT_ARGC(WriteLong, G_MSG_WRITELONG),
+    GEN_IMPORT_ARGC(WriteFloat, G_MSG_WRITEFLOAT),
+    GEN_IMPORT_ARGC(WriteString, G_MSG_WRITESTRING),
+    GEN_IMPORT_ARGC(WritePosition, G_MSG_WRITEPOSITION),
+    GEN_IMPORT_ARGC(WriteDir, G_MSG_WRITEDIR),
+    GEN_IMPORT_ARGC(WriteAngle, G_MSG_WRITEANGLE),
+    GEN_IMPORT_ARGC(WriteEntity, G_MSG_WRITEENTITY),
+    GEN_IMPORT_ARGC(TagMalloc, G_TAGMALLOC),
+    GEN_IMPORT_ARGC(TagFree, G_TAGFREE),
+    GEN_IMPORT_ARGC(FreeTags, G_FREETAGS),
+    GEN_IMPORT_ARGC(cvar, G_CVAR),
+    GEN_IMPORT_ARGC(cvar_set, G_CVAR_SET),
+    GEN_IMPORT_ARGC(cvar_forceset, G_CVAR_FORCESET),
+    GEN_IMPORT_ARGC(argc, G_ARGC),
+    GEN_IMPORT_ARGC(argv, G_ARGV),
+    GEN_IMPORT_ARGC(args, G_ARGS),
+    GEN_IMPORT_ARGC(AddCommandString, G_ADDCOMMANDSTRING),
+    GEN_IMPORT_ARGC(DebugGraph, G_DEBUGGRAPH),
+    GEN_IMPORT_ARGC(GetExtension, G_GET_EXTENSION),
+    GEN_IMPORT_ARGC(Bot_RegisterEdict, G_BOT_REGISTEREDICT),
+    GEN_IMPORT_ARGC(Bot_UnRegisterEdict, G_BOT_UNREGISTEREDICT),
+    GEN_IMPORT_ARGC(Bot_MoveToPoint, G_BOT_MOVETOPOINT),
+    GEN_IMPORT_ARGC(Bot_FollowActor, G_BOT_FOLLOWACTOR),
+    GEN_IMPORT_ARGC(GetPathToGoal, G_GETPATHTOGOAL),
+    GEN_IMPORT_ARGC(Loc_Print, G_LOC_PRINT),
+    GEN_IMPORT_ARGC(Draw_Line, G_DRAW_LINE),
+    GEN_IMPORT_ARGC(Draw_Point, G_DRAW_POINT),
+    GEN_IMPORT_ARGC(Draw_Circle, G_DRAW_CIRCLE),
+    GEN_IMPORT_ARGC(Draw_Bounds, G_DRAW_BOUNDS),
+    GEN_IMPORT_ARGC(Draw_Sphere, G_DRAW_SPHERE),
+    GEN_IMPORT_ARGC(Draw_OrientedWorldText, G_DRAW_ORIENTEDWORLDTEXT),
+    GEN_IMPORT_ARGC(Draw_StaticWorldText, G_DRAW_STATICWORLDTEXT),
+    GEN_IMPORT_ARGC(Draw_Cylinder, G_DRAW_CYLINDER),
+    GEN_IMPORT_ARGC(Draw_Ray, G_DRAW_RAY),
+    GEN_IMPORT_ARGC(Draw_Arrow, G_DRAW_ARROW),
+    GEN_IMPORT_ARGC(ReportMatchDetails_Multicast, G_REPORTMATCHDETAILS_MULTICAST),
+    GEN_IMPORT_ARGC(ServerFrame, G_SERVER_FRAME),
+    GEN_IMPORT_ARGC(SendToClipBoard, G_SENDTOCLIPBOARD),
+    GEN_IMPORT_ARGC(Info_ValueForKey, G_INFO_VALUEFORKEY),
+    GEN_IMPORT_ARGC(Info_RemoveKey, G_INFO_REMOVEKEY),
+    GEN_IMPORT_ARGC(Info_SetValueForKey, G_INFO_SETVALUEFORKEY),
+};
+
+static constexpr auto syscall_argcs = GEN_SYSCALL_ARGC_TABLE(syscall_argc_defs);
+
+
+// number of args each mod message takes, read from the game_export_t declarations
+static constexpr MsgArgcDef vmmain_argc_defs[] = {
+    GEN_EXPORT_ARGC(PreInit, GAME_PREINIT),
+    GEN_EXPORT_ARGC(Init, GAME_INIT),
+    GEN_EXPORT_ARGC(Shutdown, GAME_SHUTDOWN),
+    GEN_EXPORT_ARGC(SpawnEntities, GAME_SPAWN_ENTITIES),
+    GEN_EXPORT_ARGC(WriteGameJson, GAME_WRITE_GAME),
+    GEN_EXPORT_ARGC(ReadGameJson, GAME_READ_GAME),
+    GEN_EXPORT_ARGC(WriteLevelJson, GAME_WRITE_LEVEL),
+    GEN_EXPORT_ARGC(ReadLevelJson, GAME_READ_LEVEL),
+    GEN_EXPORT_ARGC(CanSave, GAME_CAN_SAVE),
+    GEN_EXPORT_ARGC(ClientChooseSlot, GAME_CLIENT_CHOOSESLOT),
+    GEN_EXPORT_ARGC(ClientConnect, GAME_CLIENT_CONNECT),
+    GEN_EXPORT_ARGC(ClientBegin, GAME_CLIENT_BEGIN),
+    GEN_EXPORT_ARGC(ClientUserinfoChanged, GAME_CLIENT_USERINFO_CHANGED),
+    GEN_EXPORT_ARGC(ClientDisconnect, GAME_CLIENT_DISCONNECT),
+    GEN_EXPORT_ARGC(ClientCommand, GAME_CLIENT_COMMAND),
+    GEN_EXPORT_ARGC(ClientThink, GAME_CLIENT_THINK),
+    GEN_EXPORT_ARGC(RunFrame, GAME_RUN_FRAME),
+    GEN_EXPORT_ARGC(PrepFrame, GAME_PREP_FRAME),
+    GEN_EXPORT_ARGC(ServerCommand, GAME_SERVER_COMMAND),
+    GEN_EXPORT_ARGC(Pmove, GAME_PMOVE),
+    GEN_EXPORT_ARGC(GetExtension, GAME_GET_EXTENSION),
+    GEN_EXPORT_ARGC(Bot_SetWeapon, GAME_BOT_SETWEAPON),
+    GEN_EXPORT_ARGC(Bot_TriggerEdict, GAME_BOT_TRIGGEREDICT),
+    GEN_EXPORT_ARGC(Bot_UseItem, GAME_BOT_USEITEM),
+    GEN_EXPORT_ARGC(Bot_GetItemID, GAME_BOT_GETITEMID),
+    GEN_EXPORT_ARGC(Edict_ForceLookAtPoint, GAME_EDICT_FORCELOOKATPOINT),
+    GEN_EXPORT_ARGC(Bot_PickedUpItem, GAME_BOT_PICKEDUPITEM),
+    GEN_EXPORT_ARGC(Entity_IsVisibleToPlayer, GAME_ENTITY_ISVISIBLETOPLAYER),
+    GEN_EXPORT_ARGC(GetShadowLightData, GAME_GETSHADOWLIGHTDATA),
+};
+
+static constexpr auto vmmain_argcs = GEN_VMMAIN_ARGC_TABLE(vmmain_argc_defs);
+
+
+const int8_t* Q2R_GameSupport::SyscallArgcs(int* count) {
+    *count = syscall_argcs.count;
+    return syscall_argcs.argc;
+}
+
+
+const int8_t* Q2R_GameSupport::VMMainArgcs(int* count) {
+    *count = vmmain_argcs.count;
+    return vmmain_argcs.argc;
+}
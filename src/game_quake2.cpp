@@ -36,8 +36,10 @@ struct QUAKE2_GameSupport : public GameSupport {
     virtual int QMMEngMsg(int msg) { return qmm_eng_msgs[msg]; }
     virtual int QMMModMsg(int msg) { return qmm_mod_msgs[msg]; }
 
-    virtual intptr_t syscall(intptr_t, ...);
-    virtual intptr_t vmMain(intptr_t, ...);
+    virtual intptr_t syscall_args(intptr_t, intptr_t*, int);
+    virtual intptr_t vmMain_args(intptr_t, intptr_t*, int);
+    virtual const int8_t* SyscallArgcs(int* count);
+    virtual const int8_t* VMMainArgcs(int* count);
 
     virtual const char* DefaultDLLName() { return "game" MOD_DLL; }
     virtual const char* DefaultModDir() { return "baseq2"; }
@@ -99,9 +101,7 @@ bool QUAKE2_GameSupport::AutoDetect(APIType engineapi) {
 
 // wrapper syscall function that calls actual engine func from orig_import
 // this is how QMM and plugins will call into the engine
-intptr_t QUAKE2_GameSupport::syscall(intptr_t cmd, ...) {
-    QMM_GET_SYSCALL_ARGS();
-
+intptr_t QUAKE2_GameSupport::syscall_args(intptr_t cmd, intptr_t* args, int argc) {
     if (cmd != G_PRINT)
         QMMLOG(QMM_LOG_TRACE, "QMM") << "QUAKE2_GameSupport::syscall(" << EngMsgName(cmd) << "(" << cmd << ")) called\n";
 
@@ -339,9 +339,7 @@ intptr_t QUAKE2_GameSupport::syscall(intptr_t cmd, ...) {
 
 // wrapper vmMain function that calls actual mod func from orig_export
 // this is how QMM and plugins will call into the mod
-intptr_t QUAKE2_GameSupport::vmMain(intptr_t cmd, ...) {
-    QMM_GET_VMMAIN_ARGS();
-
+intptr_t QUAKE2_GameSupport::vmMain_args(intptr_t cmd, intptr_t* args, int argc) {
     QMMLOG(QMM_LOG_TRACE, "QMM") << "QUAKE2_GameSupport::vmMain(" << ModMsgName(cmd) << "(" << cmd << ")) called\n";
 
     if (!orig_export)
@@ -684,3 +682,88 @@ game_export_t QUAKE2_GameSupport::qmm_export = {
     0,			// num_edicts
     0,			// max_edicts
 };
+
+
+// number of args each engine message takes, read from the game_import_t declarations
+static constexpr MsgArgcDef syscall_argc_defs[] = {
+    GEN_IMPORT_ARGC(bprintf, G_BPRINTF),
+    GEN_IMPORT_ARGC(dprintf, G_DPRINTF),
+    GEN_IMPORT_ARGC(cprintf, G_CPRINTF),
+    GEN_IMPORT_ARGC(centerprintf, G_CENTERPRINTF),
+    GEN_IMPORT_ARGC(sound, G_SOUND),
+    GEN_IMPORT_ARGC(positioned_sound, G_POSITIONED_SOUND),
+    GEN_IMPORT_ARGC(configstring, G_CONFIGSTRING),
+    GEN_IMPORT_ARGC(error, G_ERROR),
+    GEN_IMPORT_ARGC(modelindex, G_MODELINDEX),
+    GEN_IMPORT_ARGC(soundindex, G_SOUNDINDEX),
+    GEN_IMPORT_ARGC(imageindex, G_IMAGEINDEX),
+    GEN_IMPORT_ARGC(setmodel, G_SETMODEL),
+    GEN_IMPORT_ARGC(trace, G_TRACE),
+    GEN_IMPORT_ARGC(pointcontents, G_POINT_CONTENTS),
+    GEN_IMPORT_ARGC(inPVS, G_IN_PVS),
+    GEN_IMPORT_ARGC(inPHS, G_IN_PHS),
+    GEN_IMPORT_ARGC(SetAreaPortalState, G_SETAREAPORTALSTATE),
+    GEN_IMPORT_ARGC(AreasConnected, G_AREAS_CONNECTED),
+    GEN_IMPORT_ARGC(linkentity, G_LINKENTITY),
+    GEN_IMPORT_ARGC(unlinkentity, G_UNLINKENTITY),
+    GEN_IMPORT_ARGC(BoxEdicts, G_BOXEDICTS),
+    GEN_IMPORT_ARGC(Pmove, G_PMOVE),
+    GEN_IMPORT_ARGC(multicast, G_MULTICAST),
+    GEN_IMPORT_ARGC(unicast, G_UNICAST),
+    GEN_IMPORT_ARGC(WriteChar, G_MSG_WRITECHAR),
+    GEN_IMPORT_ARGC(WriteByte, G_MSG_WRITEBYTE),
+    GEN_IMPORT_ARGC(WriteShort, G_MSG_WRITESHORT),
+    GEN_IMPORT_ARGC(WriteLong, G_MSG_WRITELONG),
+    GEN_IMPORT_ARGC(WriteFloat, G_MSG_WRITEFLOAT),
+    GEN_IMPORT_ARGC(WriteString, G_MSG_WRITESTRING),
+    GEN_IMPORT_ARGC(WritePosition, G_MSG_WRITEPOSITION),
+    GEN_IMPORT_ARGC(WriteDir, G_MSG_WRITEDIR),
+    GEN_IMPORT_ARGC(WriteAngle, G_MSG_WRITEANGLE),
+    GEN_IMPORT_ARGC(TagMalloc, G_TAGMALLOC),
+    GEN_IMPORT_ARGC(TagFree, G_TAGFREE),
+    GEN_IMPORT_ARGC(FreeTags, G_FREETAGS),
+    GEN_IMPORT_ARGC(cvar, G_CVAR),
+    GEN_IMPORT_ARGC(cvar_set, G_CVAR_SET),
+    GEN_IMPORT_ARGC(cvar_forceset, G_CVAR_FORCESET),
+    GEN_IMPORT_ARGC(argc, G_ARGC),
+    GEN_IMPORT_ARGC(argv, G_ARGV),
+    GEN_IMPORT_ARGC(args, G_ARGS),
+    GEN_IMPORT_ARGC(AddCommandString, G_ADDCOMMANDSTRING),
+    GEN_IMPORT_ARGC(DebugGraph, G_DEBUGGRAPH),
+};
+
+static constexpr auto syscall_argcs = GEN_SYSCALL_ARGC_TABLE(syscall_argc_defs);
+
+
+// number of args each mod message takes, read from the game_export_t declarations
+static constexpr MsgArgcDef vmmain_argc_defs[] = {
+    GEN_EXPORT_ARGC(Init, GAME_INIT),
+    GEN_EXPORT_ARGC(Shutdown, GAME_SHUTDOWN),
+    GEN_EXPORT_ARGC(SpawnEntities, GAME_SPAWN_ENTITIES),
+    GEN_EXPORT_ARGC(WriteGame, GAME_WRITE_GAME),
+    GEN_EXPORT_ARGC(ReadGame, GAME_READ_GAME),
+    GEN_EXPORT_ARGC(WriteLevel, GAME_WRITE_LEVEL),
+    GEN_EXPORT_ARGC(ReadLevel, GAME_READ_LEVEL),
+    GEN_EXPORT_ARGC(ClientConnect, GAME_CLIENT_CONNECT),
+    GEN_EXPORT_ARGC(ClientBegin, GAME_CLIENT_BEGIN),
+    GEN_EXPORT_ARGC(ClientUserinfoChanged, GAME_CLIENT_USERINFO_CHANGED),
+    GEN_EXPORT_ARGC(ClientDisconnect, GAME_CLIENT_DISCONNECT),
+    GEN_EXPORT_ARGC(ClientCommand, GAME_CLIENT_COMMAND),
+    GEN_EXPORT_ARGC(ClientThink, GAME_CLIENT_THINK),
+    GEN_EXPORT_ARGC(RunFrame, GAME_RUN_FRAME),
+    GEN_EXPORT_ARGC(ServerCommand, GAME_SERVER_COMMAND),
+};
+
+static constexpr auto vmmain_argcs = GEN_VMMAIN_ARGC_TABLE(vmmain_argc_defs);
+
+
+const int8_t* QUAKE2_GameSupport::SyscallArgcs(int* count) {
+    *count = syscall_argcs.count;
+    return syscall_argcs.argc;
+}
+
+
+const int8_t* QUAKE2_GameSupport::VMMainArgcs(int* count) {
+    *count = vmmain_argcs.count;
+    return vmmain_argcs.argc;
+}
@@ -40,8 +40,10 @@ struct SIN_GameSupport : public GameSupport {
     virtual int QMMEngMsg(int msg) { return qmm_eng_msgs[msg]; }
     virtual int QMMModMsg(int msg) { return qmm_mod_msgs[msg]; }
 
-    virtual intptr_t syscall(intptr_t, ...);
-    virtual intptr_t vmMain(intptr_t, ...);
+    virtual intptr_t syscall_args(intptr_t, intptr_t*, int);
+    virtual intptr_t vmMain_args(intptr_t, intptr_t*, int);
+    virtual const int8_t* SyscallArgcs(int* count);
+    virtual const int8_t* VMMainArgcs(int* count);
 
     virtual const char* DefaultDLLName() { return "game" MOD_DLL; }
     virtual const char* DefaultModDir() { return "base"; }
@@ -103,9 +105,7 @@ bool SIN_GameSupport::AutoDetect(APIType engineapi) {
 
 // wrapper syscall function that calls actual engine func from orig_import
 // this is how QMM and plugins will call into the engine
-intptr_t SIN_GameSupport::syscall(intptr_t cmd, ...) {
-    QMM_GET_SYSCALL_ARGS();
-
+intptr_t SIN_GameSupport::syscall_args(intptr_t cmd, intptr_t* args, int argc) {
     if (cmd != G_PRINT)
         QMMLOG(QMM_LOG_TRACE, "QMM") << "SIN_GameSupport::syscall(" << EngMsgName(cmd) << "(" << cmd << ")) called\n";
 
@@ -384,9 +384,7 @@ intptr_t SIN_GameSupport::syscall(intptr_t cmd, ...) {
 
 // wrapper vmMain function that calls actual mod func from orig_export
 // this is how QMM and plugins will call into the mod
-intptr_t SIN_GameSupport::vmMain(intptr_t cmd, ...) {
-    QMM_GET_VMMAIN_ARGS();
-
+intptr_t SIN_GameSupport::vmMain_args(intptr_t cmd, intptr_t* args, int argc) {
     QMMLOG(QMM_LOG_TRACE, "QMM") << "SIN_GameSupport::vmMain(" << ModMsgName(cmd) << "(" << cmd << ")) called\n";
 
     if (!orig_export)
@@ -865,3 +863,133 @@ game_export_t SIN_GameSupport::qmm_export = {
 };
 
 #endif // QMM_ARCH_32
+
+
+// number of args each engine message takes, read from the game_import_t declarations
+static constexpr MsgArgcDef syscall_argc_defs[] = {
+    GEN_IMPORT_ARGC(bprintf, G_BPRINTF),
+    GEN_IMPORT_ARGC(dprintf, G_DPRINTF),
+    GEN_IMPORT_ARGC(printf, G_PRINTF),
+    GEN_IMPORT_ARGC(cprintf, G_CPRINTF),
+    GEN_IMPORT_ARGC(centerprintf, G_CENTERPRINTF),
+    GEN_IMPORT_ARGC(sound, G_SOUND),
+    GEN_IMPORT_ARGC(positioned_sound, G_POSITIONED_SOUND),
+    GEN_IMPORT_ARGC(configstring, G_CONFIGSTRING),
+    GEN_IMPORT_ARGC(error, G_ERROR),
+    GEN_IMPORT_ARGC(modelindex, G_MODELINDEX),
+    GEN_IMPORT_ARGC(soundindex, G_SOUNDINDEX),
+    GEN_IMPORT_ARGC(imageindex, G_IMAGEINDEX),
+    GEN_IMPORT_ARGC(itemindex, G_ITEMINDEX),
+    GEN_IMPORT_ARGC(setmodel, G_SETMODEL),
+    GEN_IMPORT_ARGC(trace, G_TRACE),
+    GEN_IMPORT_ARGC(fulltrace, G_FULLTRACE),
+    GEN_IMPORT_ARGC(pointcontents, G_POINT_CONTENTS),
+    GEN_IMPORT_ARGC(inPVS, G_IN_PVS),
+    GEN_IMPORT_ARGC(inPHS, G_IN_PHS),
+    GEN_IMPORT_ARGC(SetAreaPortalState, G_SETAREAPORTALSTATE),
+    GEN_IMPORT_ARGC(AreasConnected, G_AREAS_CONNECTED),
+    GEN_IMPORT_ARGC(linkentity, G_LINKENTITY),
+    GEN_IMPORT_ARGC(unlinkentity, G_UNLINKENTITY),
+    GEN_IMPORT_ARGC(BoxEdicts, G_BOXEDICTS),
+    GEN_IMPORT_ARGC(Pmove, G_PMOVE),
+    GEN_IMPORT_ARGC(multicast, G_MULTICAST),
+    GEN_IMPORT_ARGC(unicast, G_UNICAST),
+    GEN_IMPORT_ARGC(WriteChar, G_MSG_WRITECHAR),
+    GEN_IMPORT_ARGC(WriteByte, G_MSG_WRITEBYTE),
+    GEN_IMPORT_ARGC(WriteShort, G_MSG_WRITESHORT),
+    GEN_IMPORT_ARGC(WriteLong, G_MSG_WRITELONG),
+    GEN_IMPORT_ARGC(WriteFloat, G_MSG_WRITEFLOAT),
+    GEN_IMPORT_ARGC(WriteString, G_MSG_WRITESTRING),
+    GEN_IMPORT_ARGC(WritePosition, G_MSG_WRITEPOSITION),
+    GEN_IMPORT_ARGC(WriteDir, G_MSG_WRITEDIR),
+    GEN_IMPORT_ARGC(WriteAngle, G_MSG_WRITEANGLE),
+    GEN_IMPORT_ARGC(TagMalloc, G_TAGMALLOC),
+    GEN_IMPORT_ARGC(TagFree, G_TAGFREE),
+    GEN_IMPORT_ARGC(FreeTags, G_FREETAGS),
+    GEN_IMPORT_ARGC(cvar, G_CVAR),
+    GEN_IMPORT_ARGC(cvar_set, G_CVAR_SET),
+    GEN_IMPORT_ARGC(cvar_forceset, G_CVAR_FORCESET),
+    GEN_IMPORT_ARGC(argc, G_ARGC),
+    GEN_IMPORT_ARGC(argv, G_ARGV),
+    GEN_IMPORT_ARGC(args, G_ARGS),
+    GEN_IMPORT_ARGC(AddCommandString, G_ADDCOMMANDSTRING),
+    GEN_IMPORT_ARGC(DebugGraph, G_DEBUGGRAPH),
+    GEN_IMPORT_ARGC(LoadFile, G_LOADFILE),
+    GEN_IMPORT_ARGC(GameDir, G_GAMEDIR),
+    GEN_IMPORT_ARGC(PlayerDir, G_PLAYERDIR),
+    GEN_IMPORT_ARGC(CreatePath, G_CREATEPATH),
+    GEN_IMPORT_ARGC(SoundLength, G_SOUNDLENGTH),
+    GEN_IMPORT_ARGC(IsModel, G_ISMODEL),
+    GEN_IMPORT_ARGC(NumAnims, G_NUMANIMS),
+    GEN_IMPORT_ARGC(NumSkins, G_NUMSKINS),
+    GEN_IMPORT_ARGC(NumGroups, G_NUMGROUPS),
+    GEN_IMPORT_ARGC(InitCommands, G_INITCOMMANDS),
+    GEN_IMPORT_ARGC(CalculateBounds, G_CALCULATEBOUNDS),
+    GEN_IMPORT_ARGC(Anim_NameForNum, G_ANIM_NAMEFORNUM),
+    GEN_IMPORT_ARGC(Anim_NumForName, G_ANIM_NUMFORNAME),
+    GEN_IMPORT_ARGC(Anim_Random, G_ANIM_RANDOM),
+    GEN_IMPORT_ARGC(Anim_NumFrames, G_ANIM_NUMFRAMES),
+    GEN_IMPORT_ARGC(Anim_Time, G_ANIM_TIME),
+    GEN_IMPORT_ARGC(Anim_Delta, G_ANIM_DELTA),
+    GEN_IMPORT_ARGC(Frame_Commands, G_FRAME_COMMANDS),
+    GEN_IMPORT_ARGC(Frame_Delta, G_FRAME_DELTA),
+    GEN_IMPORT_ARGC(Frame_Time, G_FRAME_TIME),
+    GEN_IMPORT_ARGC(Skin_NameForNum, G_SKIN_NAMEFORNUM),
+    GEN_IMPORT_ARGC(Skin_NumForName, G_SKIN_NUMFORNAME),
+    GEN_IMPORT_ARGC(Group_NameToNum, G_GROUP_NAMETONUM),
+    GEN_IMPORT_ARGC(Group_NumToName, G_GROUP_NUMTONAME),
+    GEN_IMPORT_ARGC(Group_DamageMultiplier, G_GROUP_DAMAGEMULTIPLIER),
+    GEN_IMPORT_ARGC(Group_Flags, G_GROUP_FLAGS),
+    GEN_IMPORT_ARGC(GetBoneInfo, G_GETBONEINFO),
+    GEN_IMPORT_ARGC(GetBoneGroupName, G_GETBONEGROUPNAME),
+    GEN_IMPORT_ARGC(GetBoneTransform, G_GETBONETRANSFORM),
+    GEN_IMPORT_ARGC(Alias_Add, G_ALIAS_ADD),
+    GEN_IMPORT_ARGC(Alias_FindRandom, G_ALIAS_FINDRANDOM),
+    GEN_IMPORT_ARGC(Alias_Dump, G_ALIAS_DUMP),
+    GEN_IMPORT_ARGC(Alias_Clear, G_ALIAS_CLEAR),
+    GEN_IMPORT_ARGC(GlobalAlias_Add, G_GLOBALALIAS_ADD),
+    GEN_IMPORT_ARGC(GlobalAlias_FindRandom, G_GLOBALALIAS_FINDRANDOM),
+    GEN_IMPORT_ARGC(GlobalAlias_Dump, G_GLOBALALIAS_DUMP),
+    GEN_IMPORT_ARGC(GlobalAlias_Clear, G_GLOBALALIAS_CLEAR),
+    GEN_IMPORT_ARGC(CalcCRC, G_CALCCRC),
+    GEN_IMPORT_ARGC(Surf_NumSurfaces, G_SURF_NUMSURFACES),
+    GEN_IMPORT_ARGC(Surf_Surfaces, G_SURF_SURFACES),
+    GEN_IMPORT_ARGC(IncrementStatusCount, G_INCREMENTSTATUSCOUNT),
+};
+
+static constexpr auto syscall_argcs = GEN_SYSCALL_ARGC_TABLE(syscall_argc_defs);
+
+
+// number of args each mod message takes, read from the game_export_t declarations
+static constexpr MsgArgcDef vmmain_argc_defs[] = {
+    GEN_EXPORT_ARGC(Init, GAME_INIT),
+    GEN_EXPORT_ARGC(Shutdown, GAME_SHUTDOWN),
+    GEN_EXPORT_ARGC(SpawnEntities, GAME_SPAWN_ENTITIES),
+    GEN_EXPORT_ARGC(WriteGame, GAME_WRITE_GAME),
+    GEN_EXPORT_ARGC(ReadGame, GAME_READ_GAME),
+    GEN_EXPORT_ARGC(WriteLevel, GAME_WRITE_LEVEL),
+    GEN_EXPORT_ARGC(ReadLevel, GAME_READ_LEVEL),
+    GEN_EXPORT_ARGC(ClientConnect, GAME_CLIENT_CONNECT),
+    GEN_EXPORT_ARGC(ClientBegin, GAME_CLIENT_BEGIN),
+    GEN_EXPORT_ARGC(ClientUserinfoChanged, GAME_CLIENT_USERINFO_CHANGED),
+    GEN_EXPORT_ARGC(ClientDisconnect, GAME_CLIENT_DISCONNECT),
+    GEN_EXPORT_ARGC(ClientCommand, GAME_CLIENT_COMMAND),
+    GEN_EXPORT_ARGC(ClientThink, GAME_CLIENT_THINK),
+    GEN_EXPORT_ARGC(RunFrame, GAME_RUN_FRAME),
+    GEN_EXPORT_ARGC(ServerCommand, GAME_SERVER_COMMAND),
+    GEN_EXPORT_ARGC(CreateSurfaces, GAME_CREATESURFACES),
+};
+
+static constexpr auto vmmain_argcs = GEN_VMMAIN_ARGC_TABLE(vmmain_argc_defs);
+
+
+const int8_t* SIN_GameSupport::SyscallArgcs(int* count) {
+    *count = syscall_argcs.count;
+    return syscall_argcs.argc;
+}
+
+
+const int8_t* SIN_GameSupport::VMMainArgcs(int* count) {
+    *count = vmmain_argcs.count;
+    return vmmain_argcs.argc;
+}
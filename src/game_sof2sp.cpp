@@ -33,8 +33,10 @@ struct SOF2SP_GameSupport : public GameSupport {
     virtual int QMMEngMsg(int msg) { return qmm_eng_msgs[msg]; }
     virtual int QMMModMsg(int msg) { return qmm_mod_msgs[msg]; }
 
-    virtual intptr_t syscall(intptr_t, ...);
-    virtual intptr_t vmMain(intptr_t, ...);
+    virtual intptr_t syscall_args(intptr_t, intptr_t*, int);
+    virtual intptr_t vmMain_args(intptr_t, intptr_t*, int);
+    virtual const int8_t* SyscallArgcs(int* count);
+    virtual const int8_t* VMMainArgcs(int* count);
 
     virtual const char* DefaultDLLName() { return "game" MOD_DLL; }
     virtual const char* DefaultModDir() { return "."; }
@@ -84,9 +86,7 @@ bool SOF2SP_GameSupport::AutoDetect(APIType engineapi) {
 
 // wrapper syscall function that calls actual engine func from orig_import
 // this is how QMM and plugins will call into the engine
-intptr_t SOF2SP_GameSupport::syscall(intptr_t cmd, ...) {
-    QMM_GET_SYSCALL_ARGS();
-
+intptr_t SOF2SP_GameSupport::syscall_args(intptr_t cmd, intptr_t* args, int argc) {
     if (cmd != G_PRINT)
         QMMLOG(QMM_LOG_TRACE, "QMM") << "SOF2SP_GameSupport::syscall(" << EngMsgName(cmd) << "(" << cmd << ")) called\n";
 
@@ -257,9 +257,7 @@ intptr_t SOF2SP_GameSupport::syscall(intptr_t cmd, ...) {
 
 // wrapper vmMain function that calls actual mod func from orig_export
 // this is how QMM and plugins will call into the mod
-intptr_t SOF2SP_GameSupport::vmMain(intptr_t cmd, ...) {
-    QMM_GET_VMMAIN_ARGS();
-
+intptr_t SOF2SP_GameSupport::vmMain_args(intptr_t cmd, intptr_t* args, int argc) {
     QMMLOG(QMM_LOG_TRACE, "QMM") << "SOF2SP_GameSupport::vmMain(" << ModMsgName(cmd) << "(" << cmd << ")) called\n";
 
 
@@ -674,3 +672,164 @@ game_export_t SOF2SP_GameSupport::qmm_export = {
 };
 
 #endif // QMM_ARCH_32
+
+
+// number of args each engine message takes, read from the game_import_t declarations
+static constexpr MsgArgcDef syscall_argc_defs[] = {
+    GEN_IMPORT_ARGC(Printf, G_PRINTF),
+    GEN_IMPORT_ARGC(DPrintf, G_DPRINTF),
+    GEN_IMPORT_ARGC(DPrintf2, G_DPRINTF2),
+    GEN_IMPORT_ARGC(snprintf, G_SNPRINTF),
+    GEN_IMPORT_ARGC(ErrorF, G_ERRORF),
+    GEN_IMPORT_ARGC(FS_FOpenFile, G_FS_FOPEN_FILE),
+    GEN_IMPORT_ARGC(FS_Read, G_FS_READ),
+    GEN_IMPORT_ARGC(FS_Write, G_FS_WRITE),
+    GEN_IMPORT_ARGC(FS_FCloseFile, G_FS_FCLOSE_FILE),
+    GEN_IMPORT_ARGC(FS_ReadFile, G_FS_READFILE),
+    GEN_IMPORT_ARGC(FS_FreeFile, G_FS_FREEFILE),
+    GEN_IMPORT_ARGC(FS_FileAvailable, G_FS_FILEAVAILABLE),
+    GEN_IMPORT_ARGC(FS_ListFiles, G_FS_LISTFILES),
+    GEN_IMPORT_ARGC(FS_FreeFileList, G_FS_FREEFILELIST),
+    GEN_IMPORT_ARGC(unknown14, G_UNKNOWN14),
+    GEN_IMPORT_ARGC(Milliseconds, G_MILLISECONDS),
+    GEN_IMPORT_ARGC(unknown16, G_UNKNOWN16),
+    GEN_IMPORT_ARGC(unknown17, G_UNKNOWN17),
+    GEN_IMPORT_ARGC(SendConsoleCommand, G_SEND_CONSOLE_COMMAND),
+    GEN_IMPORT_ARGC(ExecuteConsoleCommand, G_EXECUTE_CONSOLE_COMMAND),
+    GEN_IMPORT_ARGC(Argc, G_ARGC),
+    GEN_IMPORT_ARGC(Argv, G_ARGV),
+    GEN_IMPORT_ARGC(Args, G_ARGS),
+    GEN_IMPORT_ARGC(Cvar_IsModified, G_CVAR_ISMODIFIED),
+    GEN_IMPORT_ARGC(Cvar_Register, G_CVAR_REGISTER),
+    GEN_IMPORT_ARGC(Cvar_Update, G_CVAR_UPDATE),
+    GEN_IMPORT_ARGC(Cvar_Set, G_CVAR_SET),
+    GEN_IMPORT_ARGC(Cvar_Get, G_CVAR_GET),
+    GEN_IMPORT_ARGC(Cvar_SetValue, G_CVAR_SETVALUE),
+    GEN_IMPORT_ARGC(Cvar_VariableIntegerValue, G_CVAR_VARIABLE_INTEGER_VALUE),
+    GEN_IMPORT_ARGC(Cvar_VariableFloatValue, G_CVAR_VARIABLE_FLOAT_VALUE),
+    GEN_IMPORT_ARGC(Cvar_VariableStringBuffer, G_CVAR_VARIABLE_STRING_BUFFER),
+    GEN_IMPORT_ARGC(Malloc, G_MALLOC),
+    GEN_IMPORT_ARGC(Free, G_FREE),
+    GEN_IMPORT_ARGC(unknown34, G_UNKNOWN34),
+    GEN_IMPORT_ARGC(CM_RegisterTerrain, G_CM_REGISTERTERRAIN),
+    GEN_IMPORT_ARGC(unknown36, G_UNKNOWN36),
+    GEN_IMPORT_ARGC(unknown37, G_UNKNOWN37),
+    GEN_IMPORT_ARGC(unknown38, G_UNKNOWN38),
+    GEN_IMPORT_ARGC(unknown39, G_UNKNOWN39),
+    GEN_IMPORT_ARGC(unknown40, G_UNKNOWN40),
+    GEN_IMPORT_ARGC(unknown41, G_UNKNOWN41),
+    GEN_IMPORT_ARGC(unknown42, G_UNKNOWN42),
+    GEN_IMPORT_ARGC(unknown43, G_UNKNOWN43),
+    GEN_IMPORT_ARGC(unknown44, G_UNKNOWN44),
+    GEN_IMPORT_ARGC(unknown45, G_UNKNOWN45),
+    GEN_IMPORT_ARGC(unknown46, G_UNKNOWN46),
+    GEN_IMPORT_ARGC(unknown47, G_UNKNOWN47),
+    GEN_IMPORT_ARGC(unknown48, G_UNKNOWN48),
+    GEN_IMPORT_ARGC(unknown49, G_UNKNOWN49),
+    GEN_IMPORT_ARGC(unknown50, G_UNKNOWN50),
+    GEN_IMPORT_ARGC(Trace, G_TRACE),
+    GEN_IMPORT_ARGC(unknown52, G_UNKNOWN52),
+    GEN_IMPORT_ARGC(unknown53, G_UNKNOWN53),
+    GEN_IMPORT_ARGC(LocateGameData, G_LOCATE_GAME_DATA),
+    GEN_IMPORT_ARGC(SendServerCommand, G_SEND_SERVER_COMMAND),
+    GEN_IMPORT_ARGC(unknown56, G_UNKNOWN56),
+    GEN_IMPORT_ARGC(unknown57, G_UNKNOWN57),
+    GEN_IMPORT_ARGC(unknown58, G_UNKNOWN58),
+    GEN_IMPORT_ARGC(unknown59, G_UNKNOWN59),
+    GEN_IMPORT_ARGC(unknown60, G_UNKNOWN60),
+    GEN_IMPORT_ARGC(unknown61, G_UNKNOWN61),
+    GEN_IMPORT_ARGC(unknown62, G_UNKNOWN62),
+    GEN_IMPORT_ARGC(unknown63, G_UNKNOWN63),
+    GEN_IMPORT_ARGC(unknown64, G_UNKNOWN64),
+    GEN_IMPORT_ARGC(unknown65, G_UNKNOWN65),
+    GEN_IMPORT_ARGC(unknown66, G_UNKNOWN66),
+    GEN_IMPORT_ARGC(unknown69, G_UNKNOWN69),
+    GEN_IMPORT_ARGC(unknown70, G_UNKNOWN70),
+    GEN_IMPORT_ARGC(PointContents, G_POINT_CONTENTS),
+    GEN_IMPORT_ARGC(unknown72, G_UNKNOWN72),
+    GEN_IMPORT_ARGC(SetBrushModel, G_SET_BRUSH_MODEL),
+    GEN_IMPORT_ARGC(SetActiveSubBSP, G_SET_ACTIVE_SUBBSP),
+    GEN_IMPORT_ARGC(unknown75, G_UNKNOWN75),
+    GEN_IMPORT_ARGC(unknown76, G_UNKNOWN76),
+    GEN_IMPORT_ARGC(SetConfigstring, G_SET_CONFIGSTRING),
+    GEN_IMPORT_ARGC(GetConfigstring, G_GET_CONFIGSTRING),
+    GEN_IMPORT_ARGC(GetServerInfo, G_GET_SERVERINFO),
+    GEN_IMPORT_ARGC(AdjustAreaPortalState, G_ADJUSTAREAPORTALSTATE),
+    GEN_IMPORT_ARGC(unknown81, G_UNKNOWN81),
+    GEN_IMPORT_ARGC(unknown82, G_UNKNOWN82),
+    GEN_IMPORT_ARGC(unknown83, G_UNKNOWN83),
+    GEN_IMPORT_ARGC(unknown84, G_UNKNOWN84),
+    GEN_IMPORT_ARGC(TIKI_RegisterModel, G_TIKI_REGISTERMODEL),
+    GEN_IMPORT_ARGC(unknown86, G_UNKNOWN86),
+    GEN_IMPORT_ARGC(unknown87, G_UNKNOWN87),
+    GEN_IMPORT_ARGC(unknown88, G_UNKNOWN88),
+    GEN_IMPORT_ARGC(unknown89, G_UNKNOWN89),
+    GEN_IMPORT_ARGC(unknown90, G_UNKNOWN90),
+    GEN_IMPORT_ARGC(unknown91, G_UNKNOWN91),
+    GEN_IMPORT_ARGC(unknown92, G_UNKNOWN92),
+    GEN_IMPORT_ARGC(unknown93, G_UNKNOWN93),
+    GEN_IMPORT_ARGC(unknown94, G_UNKNOWN94),
+    GEN_IMPORT_ARGC(unknown95, G_UNKNOWN95),
+    GEN_IMPORT_ARGC(GetEntityToken, G_GET_ENTITY_TOKEN),
+    GEN_IMPORT_ARGC(unknown97, G_UNKNOWN97),
+    GEN_IMPORT_ARGC(unknown98, G_UNKNOWN98),
+    GEN_IMPORT_ARGC(unknown99, G_UNKNOWN99),
+    GEN_IMPORT_ARGC(unknown100, G_UNKNOWN100),
+    GEN_IMPORT_ARGC(unknown101, G_UNKNOWN101),
+    GEN_IMPORT_ARGC(unknown102, G_UNKNOWN102),
+    GEN_IMPORT_ARGC(unknown103, G_UNKNOWN103),
+    GEN_IMPORT_ARGC(unknown104, G_UNKNOWN104),
+    GEN_IMPORT_ARGC(unknown105, G_UNKNOWN105),
+    GEN_IMPORT_ARGC(unknown106, G_UNKNOWN106),
+    GEN_IMPORT_ARGC(unknown107, G_UNKNOWN107),
+    GEN_IMPORT_ARGC(unknown108, G_UNKNOWN108),
+    GEN_IMPORT_ARGC(unknown109, G_UNKNOWN109),
+    GEN_IMPORT_ARGC(unknown110, G_UNKNOWN110),
+    GEN_IMPORT_ARGC(CM_TM_Upload, G_CM_TM_UPLOAD),
+    GEN_IMPORT_ARGC(SaveTerrainImageToDisk, G_SAVETERRAINIMAGETODISK),
+};
+
+static constexpr auto syscall_argcs = GEN_SYSCALL_ARGC_TABLE(syscall_argc_defs);
+
+
+// number of args each mod message takes, read from the game_export_t declarations
+static constexpr MsgArgcDef vmmain_argc_defs[] = {
+    GEN_EXPORT_ARGC(Init, GAME_INIT),
+    GEN_EXPORT_ARGC(Shutdown, GAME_SHUTDOWN),
+    GEN_EXPORT_ARGC(ClientConnect, GAME_CLIENT_CONNECT),
+    GEN_EXPORT_ARGC(ClientBegin, GAME_CLIENT_BEGIN),
+    GEN_EXPORT_ARGC(ClientDisconnect, GAME_CLIENT_DISCONNECT),
+    GEN_EXPORT_ARGC(ClientCommand, GAME_CLIENT_COMMAND),
+    GEN_EXPORT_ARGC(ClientThink, GAME_CLIENT_THINK),
+    GEN_EXPORT_ARGC(RunFrame, GAME_RUN_FRAME),
+    GEN_EXPORT_ARGC(IsClientActive, GAME_IS_CLIENT_ACTIVE),
+    GEN_EXPORT_ARGC(ConsoleCommand, GAME_CONSOLE_COMMAND),
+    GEN_EXPORT_ARGC(SpawnRMGEntity, GAME_SPAWN_RMG_ENTITY),
+    GEN_EXPORT_ARGC(arioche, GAME_ARIOCHE),
+    GEN_EXPORT_ARGC(EntityList, GAME_ENTITY_LIST),
+    GEN_EXPORT_ARGC(WriteLevel, GAME_WRITE_LEVEL),
+    GEN_EXPORT_ARGC(unknown16, GAME_UNKNOWN16),
+    GEN_EXPORT_ARGC(Save, GAME_SAVE),
+    GEN_EXPORT_ARGC(GameAllowedToSaveHere, GAME_GAMEALLOWEDTOSAVEHERE),
+    GEN_EXPORT_ARGC(CanPlayCinematic, GAME_CAN_PLAY_CINEMATIC),
+    GEN_EXPORT_ARGC(unknown20, GAME_UNKNOWN20),
+    GEN_EXPORT_ARGC(unknown21, GAME_UNKNOWN21),
+    GEN_EXPORT_ARGC(unknown22, GAME_UNKNOWN22),
+    GEN_EXPORT_ARGC(unknown23, GAME_UNKNOWN23),
+    GEN_EXPORT_ARGC(unknown24, GAME_UNKNOWN24),
+    GEN_EXPORT_ARGC(unknown25, GAME_UNKNOWN25),
+};
+
+static constexpr auto vmmain_argcs = GEN_VMMAIN_ARGC_TABLE(vmmain_argc_defs);
+
+
+const int8_t* SOF2SP_GameSupport::SyscallArgcs(int* count) {
+    *count = syscall_argcs.count;
+    return syscall_argcs.argc;
+}
+
+
+const int8_t* SOF2SP_GameSupport::VMMainArgcs(int* count) {
+    *count = vmmain_argcs.count;
+    return vmmain_argcs.argc;
+}
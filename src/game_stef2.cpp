@@ -38,8 +38,10 @@ struct STEF2_GameSupport : public GameSupport {
     virtual int QMMEngMsg(int msg) { return qmm_eng_msgs[msg]; }
     virtual int QMMModMsg(int msg) { return qmm_mod_msgs[msg]; }
 
-    virtual intptr_t syscall(intptr_t, ...);
-    virtual intptr_t vmMain(intptr_t, ...);
+    virtual intptr_t syscall_args(intptr_t, intptr_t*, int);
+    virtual intptr_t vmMain_args(intptr_t, intptr_t*, int);
+    virtual const int8_t* SyscallArgcs(int* count);
+    virtual const int8_t* VMMainArgcs(int* count);
 
     virtual const char* DefaultDLLName() { return "game" MOD_DLL; }
     virtual const char* DefaultModDir() { return "BASE"; }
@@ -91,9 +93,7 @@ bool STEF2_GameSupport::AutoDetect(APIType engineapi) {
 
 // wrapper syscall function that calls actual engine func from orig_import
 // this is how QMM and plugins will call into the engine
-intptr_t STEF2_GameSupport::syscall(intptr_t cmd, ...) {
-    QMM_GET_SYSCALL_ARGS();
-
+intptr_t STEF2_GameSupport::syscall_args(intptr_t cmd, intptr_t* args, int argc) {
     if (cmd != G_PRINT)
         QMMLOG(QMM_LOG_TRACE, "QMM") << "STEF2_GameSupport::syscall(" << EngMsgName(cmd) << "(" << cmd << ")) called\n";
 
@@ -495,9 +495,7 @@ intptr_t STEF2_GameSupport::syscall(intptr_t cmd, ...) {
 
 // wrapper vmMain function that calls actual mod func from orig_export
 // this is how QMM and plugins will call into the mod
-intptr_t STEF2_GameSupport::vmMain(intptr_t cmd, ...) {
-    QMM_GET_VMMAIN_ARGS();
-
+intptr_t STEF2_GameSupport::vmMain_args(intptr_t cmd, intptr_t* args, int argc) {
     QMMLOG(QMM_LOG_TRACE, "QMM") << "STEF2_GameSupport::vmMain(" << ModMsgName(cmd) << "(" << cmd << ")) called\n";
 
     if (!orig_export)
@@ -1427,3 +1425,399 @@ game_export_t STEF2_GameSupport::qmm_export = {
 };
 
 #endif // QMM_ARCH_32
+
+
+// number of args each engine message takes, read from the game_import_t declarations
+static constexpr MsgArgcDef syscall_argc_defs[] = {
+    GEN_IMPORT_ARGC(Printf, G_PRINTF),
+    GEN_IMPORT_ARGC(DPrintf, G_DPRINTF),
+    GEN_IMPORT_ARGC(WPrintf, G_WPRINTF),
+    GEN_IMPORT_ARGC(WDPrintf, G_WDPRINTF),
+    GEN_IMPORT_ARGC(DebugPrintf, G_DEBUGPRINTF),
+    GEN_IMPORT_ARGC(LocalizeFilePath, G_LOCALIZEFILEPATH),
+    GEN_IMPORT_ARGC(Error, G_ERROR),
+    GEN_IMPORT_ARGC(Milliseconds, G_MILLISECONDS),
+    GEN_IMPORT_ARGC(Malloc, G_MALLOC),
+    GEN_IMPORT_ARGC(Free, G_FREE),
+    GEN_IMPORT_ARGC(cvar, G_CVAR),
+    GEN_IMPORT_ARGC(cvar_get, G_CVAR_GET),
+    GEN_IMPORT_ARGC(cvar_set, G_CVAR_SET),
+    GEN_IMPORT_ARGC(Cvar_VariableStringBuffer, G_CVAR_VARIABLE_STRING_BUFFER),
+    GEN_IMPORT_ARGC(Cvar_Register, G_CVAR_REGISTER),
+    GEN_IMPORT_ARGC(Cvar_VariableValue, G_CVAR_VARIABLEVALUE),
+    GEN_IMPORT_ARGC(Cvar_Update, G_CVAR_UPDATE),
+    GEN_IMPORT_ARGC(Cvar_VariableIntegerValue, G_CVAR_VARIABLE_INTEGER_VALUE),
+    GEN_IMPORT_ARGC(argc, G_ARGC),
+    GEN_IMPORT_ARGC(argv, G_ARGV),
+    GEN_IMPORT_ARGC(args, G_ARGS),
+    GEN_IMPORT_ARGC(AddCommand, G_ADDCOMMAND),
+    GEN_IMPORT_ARGC(FS_ReadFile, G_FS_READFILE),
+    GEN_IMPORT_ARGC(FS_Exists, G_FS_EXISTS),
+    GEN_IMPORT_ARGC(FS_FreeFile, G_FS_FREEFILE),
+    GEN_IMPORT_ARGC(FS_WriteFile, G_FS_WRITEFILE),
+    GEN_IMPORT_ARGC(FS_FOpenFileWrite, G_FS_FOPEN_FILE_WRITE),
+    GEN_IMPORT_ARGC(FS_FOpenFileAppend, G_FS_FOPEN_FILE_APPEND),
+    GEN_IMPORT_ARGC(FS_ListFiles, G_FS_LISTFILES),
+    GEN_IMPORT_ARGC(FS_PrepFileWrite, G_FS_PREPFILEWRITE),
+    GEN_IMPORT_ARGC(FS_Write, G_FS_WRITE),
+    GEN_IMPORT_ARGC(FS_Read, G_FS_READ),
+    GEN_IMPORT_ARGC(FS_FCloseFile, G_FS_FCLOSE_FILE),
+    GEN_IMPORT_ARGC(FS_FTell, G_FS_FTELL),
+    GEN_IMPORT_ARGC(FS_FSeek, G_FS_FSEEK),
+    GEN_IMPORT_ARGC(FS_Flush, G_FS_FLUSH),
+    GEN_IMPORT_ARGC(FS_DeleteFile, G_FS_DELETEFILE),
+    GEN_IMPORT_ARGC(FS_GetFileList, G_FS_GETFILELIST),
+    GEN_IMPORT_ARGC(GetArchiveFileName, G_GETARCHIVEFILENAME),
+    GEN_IMPORT_ARGC(SendConsoleCommand, G_SEND_CONSOLE_COMMAND),
+    GEN_IMPORT_ARGC(DebugGraph, G_DEBUGGRAPH),
+    GEN_IMPORT_ARGC(SendServerCommand, G_SEND_SERVER_COMMAND),
+    GEN_IMPORT_ARGC(GetNumFreeReliableServerCommands, G_GETNUMFREERELIABLESERVERCOMMANDS),
+    GEN_IMPORT_ARGC(setConfigstring, G_SET_CONFIGSTRING),
+    GEN_IMPORT_ARGC(getConfigstring, G_GET_CONFIGSTRING),
+    GEN_IMPORT_ARGC(setUserinfo, G_SET_USERINFO),
+    GEN_IMPORT_ARGC(getUserinfo, G_GET_USERINFO),
+    GEN_IMPORT_ARGC(SetBrushModel, G_SET_BRUSH_MODEL),
+    GEN_IMPORT_ARGC(trace, G_TRACE),
+    GEN_IMPORT_ARGC(fulltrace, G_FULLTRACE),
+    GEN_IMPORT_ARGC(pointcontents, G_POINT_CONTENTS),
+    GEN_IMPORT_ARGC(pointbrushnum, G_POINTBRUSHNUM),
+    GEN_IMPORT_ARGC(inPVS, G_IN_PVS),
+    GEN_IMPORT_ARGC(inPVSIgnorePortals, G_IN_PVS_IGNOREPORTALS),
+    GEN_IMPORT_ARGC(AdjustAreaPortalState, G_ADJUSTAREAPORTALSTATE),
+    GEN_IMPORT_ARGC(AreasConnected, G_AREAS_CONNECTED),
+    GEN_IMPORT_ARGC(GetLightingGroup, G_GETLIGHTINGGROUP),
+    GEN_IMPORT_ARGC(SetDynamicLight, G_SETDYNAMICLIGHT),
+    GEN_IMPORT_ARGC(SetDynamicLightDefault, G_SETDYNAMICLIGHTDEFAULT),
+    GEN_IMPORT_ARGC(SetWindDirection, G_SETWINDDIRECTION),
+    GEN_IMPORT_ARGC(SetWindIntensity, G_SETWINDINTENSITY),
+    GEN_IMPORT_ARGC(SetWeatherInfo, G_SETWEATHERINFO),
+    GEN_IMPORT_ARGC(SetTimeScale, G_SETTIMESCALE),
+    GEN_IMPORT_ARGC(linkentity, G_LINKENTITY),
+    GEN_IMPORT_ARGC(unlinkentity, G_UNLINKENTITY),
+    GEN_IMPORT_ARGC(AreaEntities, G_AREAENTITIES),
+    GEN_IMPORT_ARGC(ClipToEntity, G_CLIPTOENTITY),
+    GEN_IMPORT_ARGC(objectivenameindex, G_OBJECTIVENAMEINDEX),
+    GEN_IMPORT_ARGC(archetypeindex, G_ARCHETYPEINDEX),
+    GEN_IMPORT_ARGC(imageindex, G_IMAGEINDEX),
+    GEN_IMPORT_ARGC(failedcondition, G_FAILEDCONDITION),
+    GEN_IMPORT_ARGC(itemindex, G_ITEMINDEX),
+    GEN_IMPORT_ARGC(soundindex, G_SOUNDINDEX),
+    GEN_IMPORT_ARGC(modelindex, G_MODELINDEX),
+    GEN_IMPORT_ARGC(SetLightStyle, G_SETLIGHTSTYLE),
+    GEN_IMPORT_ARGC(GameDir, G_GAMEDIR),
+    GEN_IMPORT_ARGC(IsModel, G_ISMODEL),
+    GEN_IMPORT_ARGC(setmodel, G_SETMODEL),
+    GEN_IMPORT_ARGC(setviewmodel, G_SETVIEWMODEL),
+    GEN_IMPORT_ARGC(NumAnims, G_NUMANIMS),
+    GEN_IMPORT_ARGC(NumSkins, G_NUMSKINS),
+    GEN_IMPORT_ARGC(NumSurfaces, G_NUMSURFACES),
+    GEN_IMPORT_ARGC(NumTags, G_NUMTAGS),
+    GEN_IMPORT_ARGC(NumMorphs, G_NUMMORPHS),
+    GEN_IMPORT_ARGC(InitCommands, G_INITCOMMANDS),
+    GEN_IMPORT_ARGC(CalculateBounds, G_CALCULATEBOUNDS),
+    GEN_IMPORT_ARGC(TIKI_CacheAnim, G_TIKI_CACHEANIM),
+    GEN_IMPORT_ARGC(Anim_NameForNum, G_ANIM_NAMEFORNUM),
+    GEN_IMPORT_ARGC(Anim_NumForName, G_ANIM_NUMFORNAME),
+    GEN_IMPORT_ARGC(Anim_Random, G_ANIM_RANDOM),
+    GEN_IMPORT_ARGC(Anim_NumFrames, G_ANIM_NUMFRAMES),
+    GEN_IMPORT_ARGC(Anim_Time, G_ANIM_TIME),
+    GEN_IMPORT_ARGC(Anim_Delta, G_ANIM_DELTA),
+    GEN_IMPORT_ARGC(Anim_AbsoluteDelta, G_ANIM_ABSOLUTEDELTA),
+    GEN_IMPORT_ARGC(Anim_Flags, G_ANIM_FLAGS),
+    GEN_IMPORT_ARGC(Anim_HasCommands, G_ANIM_HASCOMMANDS),
+    GEN_IMPORT_ARGC(Frame_Commands, G_FRAME_COMMANDS),
+    GEN_IMPORT_ARGC(Frame_Delta, G_FRAME_DELTA),
+    GEN_IMPORT_ARGC(Frame_Time, G_FRAME_TIME),
+    GEN_IMPORT_ARGC(Frame_Bounds, G_FRAME_BOUNDS),
+    GEN_IMPORT_ARGC(Surface_NameToNum, G_SURFACE_NAMETONUM),
+    GEN_IMPORT_ARGC(Surface_NumToName, G_SURFACE_NUMTONAME),
+    GEN_IMPORT_ARGC(Surface_Flags, G_SURFACE_FLAGS),
+    GEN_IMPORT_ARGC(Surface_NumSkins, G_SURFACE_NUMSKINS),
+    GEN_IMPORT_ARGC(Morph_NumForName, G_MORPH_NUMFORNAME),
+    GEN_IMPORT_ARGC(Morph_NameForNum, G_MORPH_NAMEFORNUM),
+    GEN_IMPORT_ARGC(GetExpression, G_GETEXPRESSION),
+    GEN_IMPORT_ARGC(Tag_NumForName, G_TAG_NUMFORNAME),
+    GEN_IMPORT_ARGC(Tag_NameForNum, G_TAG_NAMEFORNUM),
+    GEN_IMPORT_ARGC(Tag_Orientation, G_TAG_ORIENTATION),
+    GEN_IMPORT_ARGC(Tag_OrientationEx, G_TAG_ORIENTATIONEX),
+    GEN_IMPORT_ARGC(Bone_GetParentNum, G_BONE_GETPARENTNUM),
+    GEN_IMPORT_ARGC(Alias_Add, G_ALIAS_ADD),
+    GEN_IMPORT_ARGC(Alias_FindRandom, G_ALIAS_FINDRANDOM),
+    GEN_IMPORT_ARGC(Alias_Find, G_ALIAS_FIND),
+    GEN_IMPORT_ARGC(Alias_Dump, G_ALIAS_DUMP),
+    GEN_IMPORT_ARGC(Alias_Clear, G_ALIAS_CLEAR),
+    GEN_IMPORT_ARGC(Alias_FindDialog, G_ALIAS_FINDDIALOG),
+    GEN_IMPORT_ARGC(Alias_FindSpecificAnim, G_ALIAS_FINDSPECIFICANIM),
+    GEN_IMPORT_ARGC(Alias_CheckLoopAnim, G_ALIAS_CHECKLOOPANIM),
+    GEN_IMPORT_ARGC(Alias_GetList, G_ALIAS_GETLIST),
+    GEN_IMPORT_ARGC(Alias_UpdateDialog, G_ALIAS_UPDATEDIALOG),
+    GEN_IMPORT_ARGC(Alias_AddActorDialog, G_ALIAS_ADDACTORDIALOG),
+    GEN_IMPORT_ARGC(NameForNum, G_NAMEFORNUM),
+    GEN_IMPORT_ARGC(GlobalAlias_Add, G_GLOBALALIAS_ADD),
+    GEN_IMPORT_ARGC(GlobalAlias_FindRandom, G_GLOBALALIAS_FINDRANDOM),
+    GEN_IMPORT_ARGC(GlobalAlias_Find, G_GLOBALALIAS_FIND),
+    GEN_IMPORT_ARGC(GlobalAlias_Dump, G_GLOBALALIAS_DUMP),
+    GEN_IMPORT_ARGC(GlobalAlias_Clear, G_GLOBALALIAS_CLEAR),
+    GEN_IMPORT_ARGC(isClientActive, G_ISCLIENTACTIVE),
+    GEN_IMPORT_ARGC(centerprintf, G_CENTERPRINTF),
+    GEN_IMPORT_ARGC(locationprintf, G_LOCATIONPRINTF),
+    GEN_IMPORT_ARGC(Sound, G_SOUND),
+    GEN_IMPORT_ARGC(StopSound, G_STOPSOUND),
+    GEN_IMPORT_ARGC(SoundLength, G_SOUNDLENGTH),
+    GEN_IMPORT_ARGC(GetNextMorphTarget, G_GETNEXTMORPHTARGET),
+    GEN_IMPORT_ARGC(CalcCRC, G_CALCCRC),
+    GEN_IMPORT_ARGC(LocateGameData, G_LOCATE_GAME_DATA),
+    GEN_IMPORT_ARGC(SetFarPlane, G_SETFARPLANE),
+    GEN_IMPORT_ARGC(TikiReload, G_TIKIRELOAD),
+    GEN_IMPORT_ARGC(TikiLoadFromTS, G_TIKILOADFROMTS),
+    GEN_IMPORT_ARGC(ToolServerGetData, G_TOOLSERVERGETDATA),
+    GEN_IMPORT_ARGC(SetSkyPortal, G_SETSKYPORTAL),
+    GEN_IMPORT_ARGC(WidgetPrintf, G_WIDGETPRINTF),
+    GEN_IMPORT_ARGC(ProcessLoadingScreen, G_PROCESSLOADINGSCREEN),
+    GEN_IMPORT_ARGC(MObjective_GetDescription, G_MOBJECTIVE_GETDESCRIPTION),
+    GEN_IMPORT_ARGC(MObjective_SetDescription, G_MOBJECTIVE_SETDESCRIPTION),
+    GEN_IMPORT_ARGC(MObjective_GetShowObjective, G_MOBJECTIVE_GETSHOWOBJECTIVE),
+    GEN_IMPORT_ARGC(MObjective_SetShowObjective, G_MOBJECTIVE_SETSHOWOBJECTIVE),
+    GEN_IMPORT_ARGC(MObjective_GetObjectiveComplete, G_MOBJECTIVE_GETOBJECTIVECOMPLETE),
+    GEN_IMPORT_ARGC(MObjective_SetObjectiveComplete, G_MOBJECTIVE_SETOBJECTIVECOMPLETE),
+    GEN_IMPORT_ARGC(MObjective_GetObjectiveFailed, G_MOBJECTIVE_GETOBJECTIVEFAILED),
+    GEN_IMPORT_ARGC(MObjective_SetObjectiveFailed, G_MOBJECTIVE_SETOBJECTIVEFAILED),
+    GEN_IMPORT_ARGC(MObjective_GetNameFromIndex, G_MOBJECTIVE_GETNAMEFROMINDEX),
+    GEN_IMPORT_ARGC(MObjective_GetIndexFromName, G_MOBJECTIVE_GETINDEXFROMNAME),
+    GEN_IMPORT_ARGC(MObjective_NewObjective, G_MOBJECTIVE_NEWOBJECTIVE),
+    GEN_IMPORT_ARGC(MObjective_ClearObjectiveList, G_MOBJECTIVE_CLEAROBJECTIVELIST),
+    GEN_IMPORT_ARGC(MObjective_ParseObjectiveFile, G_MOBJECTIVE_PARSEOBJECTIVEFILE),
+    GEN_IMPORT_ARGC(MObjective_Update, G_MOBJECTIVE_UPDATE),
+    GEN_IMPORT_ARGC(MObjective_GetNumObjectives, G_MOBJECTIVE_GETNUMOBJECTIVES),
+    GEN_IMPORT_ARGC(MObjective_GetNumActiveObjectives, G_MOBJECTIVE_GETNUMACTIVEOBJECTIVES),
+    GEN_IMPORT_ARGC(MObjective_GetNumCompleteObjectives, G_MOBJECTIVE_GETNUMCOMPLETEOBJECTIVES),
+    GEN_IMPORT_ARGC(MObjective_GetNumFailedObjectives, G_MOBJECTIVE_GETNUMFAILEDOBJECTIVES),
+    GEN_IMPORT_ARGC(MObjective_GetNumIncompleteObjectives, G_MOBJECTIVE_GETNUMINCOMPLETEOBJECTIVES),
+    GEN_IMPORT_ARGC(MI_GetShader, G_MI_GETSHADER),
+    GEN_IMPORT_ARGC(MI_SetShader, G_MI_SETSHADER),
+    GEN_IMPORT_ARGC(MI_GetInformationData, G_MI_GETINFORMATIONDATA),
+    GEN_IMPORT_ARGC(MI_SetInformationData, G_MI_SETINFORMATIONDATA),
+    GEN_IMPORT_ARGC(MI_GetNameFromIndex, G_MI_GETNAMEFROMINDEX),
+    GEN_IMPORT_ARGC(MI_GetIndexFromName, G_MI_GETINDEXFROMNAME),
+    GEN_IMPORT_ARGC(MI_NewInformation, G_MI_NEWINFORMATION),
+    GEN_IMPORT_ARGC(MI_ClearInformationList, G_MI_CLEARINFORMATIONLIST),
+    GEN_IMPORT_ARGC(MI_SetShowInformation, G_MI_SETSHOWINFORMATION),
+    GEN_IMPORT_ARGC(MI_GetShowInformation, G_MI_GETSHOWINFORMATION),
+    GEN_IMPORT_ARGC(SR_InitializeStringResource, G_SR_INITIALIZESTRINGRESOURCE),
+    GEN_IMPORT_ARGC(SR_UninitializeStringResource, G_SR_UNINITIALIZESTRINGRESOURCE),
+    GEN_IMPORT_ARGC(SR_LoadLevelStrings, G_SR_LOADLEVELSTRINGS),
+    GEN_IMPORT_ARGC(GetViewModeMask, G_GETVIEWMODEMASK),
+    GEN_IMPORT_ARGC(GetViewModeClassMask, G_GETVIEWMODECLASSMASK),
+    GEN_IMPORT_ARGC(GetViewModeSendInMode, G_GETVIEWMODESENDINMODE),
+    GEN_IMPORT_ARGC(GetViewModeSendNotInMode, G_GETVIEWMODESENDNOTINMODE),
+    GEN_IMPORT_ARGC(GetViewModeScreenBlend, G_GETVIEWMODESCREENBLEND),
+    GEN_IMPORT_ARGC(GetLevelDefs, G_GETLEVELDEFS),
+    GEN_IMPORT_ARGC(areSublevels, G_ARESUBLEVELS),
+    GEN_IMPORT_ARGC(SurfaceTypeToName, G_SURFACETYPETONAME),
+    GEN_IMPORT_ARGC(AAS_EntityInfo, G_AAS_ENTITYINFO),
+    GEN_IMPORT_ARGC(AAS_Initialized, G_AAS_INITIALIZED),
+    GEN_IMPORT_ARGC(AAS_PresenceTypeBoundingBox, G_AAS_PRESENCETYPEBOUNDINGBOX),
+    GEN_IMPORT_ARGC(AAS_Time, G_AAS_TIME),
+    GEN_IMPORT_ARGC(AAS_PointAreaNum, G_AAS_POINTAREANUM),
+    GEN_IMPORT_ARGC(AAS_PointReachabilityAreaIndex, G_AAS_POINTREACHABILITYAREAINDEX),
+    GEN_IMPORT_ARGC(AAS_TraceAreas, G_AAS_TRACEAREAS),
+    GEN_IMPORT_ARGC(AAS_BBoxAreas, G_AAS_BBOXAREAS),
+    GEN_IMPORT_ARGC(AAS_AreaInfo, G_AAS_AREAINFO),
+    GEN_IMPORT_ARGC(AAS_PointContents, G_AAS_POINTCONTENTS),
+    GEN_IMPORT_ARGC(AAS_NextBSPEntity, G_AAS_NEXTBSPENTITY),
+    GEN_IMPORT_ARGC(AAS_ValueForBSPEpairKey, G_AAS_VALUEFORBSPEPAIRKEY),
+    GEN_IMPORT_ARGC(AAS_VectorForBSPEpairKey, G_AAS_VECTORFORBSPEPAIRKEY),
+    GEN_IMPORT_ARGC(AAS_FloatForBSPEpairKey, G_AAS_FLOATFORBSPEPAIRKEY),
+    GEN_IMPORT_ARGC(AAS_IntForBSPEpairKey, G_AAS_INTFORBSPEPAIRKEY),
+    GEN_IMPORT_ARGC(AAS_AreaReachability, G_AAS_AREAREACHABILITY),
+    GEN_IMPORT_ARGC(AAS_AreaTravelTimeToGoalArea, G_AAS_AREATRAVELTIMETOGOALAREA),
+    GEN_IMPORT_ARGC(AAS_EnableRoutingArea, G_AAS_ENABLEROUTINGAREA),
+    GEN_IMPORT_ARGC(AAS_PredictRoute, G_AAS_PREDICTROUTE),
+    GEN_IMPORT_ARGC(AAS_AlternativeRouteGoals, G_AAS_ALTERNATIVEROUTEGOALS),
+    GEN_IMPORT_ARGC(AAS_Swimming, G_AAS_SWIMMING),
+    GEN_IMPORT_ARGC(AAS_PredictClientMovement, G_AAS_PREDICTCLIENTMOVEMENT),
+    GEN_IMPORT_ARGC(EA_Command, G_EA_COMMAND),
+    GEN_IMPORT_ARGC(EA_Say, G_EA_SAY),
+    GEN_IMPORT_ARGC(EA_SayTeam, G_EA_SAYTEAM),
+    GEN_IMPORT_ARGC(EA_Action, G_EA_ACTION),
+    GEN_IMPORT_ARGC(EA_Gesture, G_EA_GESTURE),
+    GEN_IMPORT_ARGC(EA_Talk, G_EA_TALK),
+    GEN_IMPORT_ARGC(EA_ToggleFireState, G_EA_TOGGLEFIRESTATE),
+    GEN_IMPORT_ARGC(EA_Attack, G_EA_ATTACK),
+    GEN_IMPORT_ARGC(EA_Use, G_EA_USE),
+    GEN_IMPORT_ARGC(EA_Respawn, G_EA_RESPAWN),
+    GEN_IMPORT_ARGC(EA_MoveUp, G_EA_MOVEUP),
+    GEN_IMPORT_ARGC(EA_MoveDown, G_EA_MOVEDOWN),
+    GEN_IMPORT_ARGC(EA_MoveForward, G_EA_MOVEFORWARD),
+    GEN_IMPORT_ARGC(EA_MoveBack, G_EA_MOVEBACK),
+    GEN_IMPORT_ARGC(EA_MoveLeft, G_EA_MOVELEFT),
+    GEN_IMPORT_ARGC(EA_MoveRight, G_EA_MOVERIGHT),
+    GEN_IMPORT_ARGC(EA_Crouch, G_EA_CROUCH),
+    GEN_IMPORT_ARGC(EA_SelectWeapon, G_EA_SELECTWEAPON),
+    GEN_IMPORT_ARGC(EA_Jump, G_EA_JUMP),
+    GEN_IMPORT_ARGC(EA_DelayedJump, G_EA_DELAYEDJUMP),
+    GEN_IMPORT_ARGC(EA_Move, G_EA_MOVE),
+    GEN_IMPORT_ARGC(EA_View, G_EA_VIEW),
+    GEN_IMPORT_ARGC(EA_EndRegular, G_EA_ENDREGULAR),
+    GEN_IMPORT_ARGC(EA_GetInput, G_EA_GETINPUT),
+    GEN_IMPORT_ARGC(EA_ResetInput, G_EA_RESETINPUT),
+    GEN_IMPORT_ARGC(BotLoadCharacter, G_BOTLOADCHARACTER),
+    GEN_IMPORT_ARGC(BotFreeCharacter, G_BOTFREECHARACTER),
+    GEN_IMPORT_ARGC(Characteristic_Float, G_CHARACTERISTIC_FLOAT),
+    GEN_IMPORT_ARGC(Characteristic_BFloat, G_CHARACTERISTIC_BFLOAT),
+    GEN_IMPORT_ARGC(Characteristic_Integer, G_CHARACTERISTIC_INTEGER),
+    GEN_IMPORT_ARGC(Characteristic_BInteger, G_CHARACTERISTIC_BINTEGER),
+    GEN_IMPORT_ARGC(Characteristic_String, G_CHARACTERISTIC_STRING),
+    GEN_IMPORT_ARGC(BotAllocChatState, G_BOTALLOCCHATSTATE),
+    GEN_IMPORT_ARGC(BotFreeChatState, G_BOTFREECHATSTATE),
+    GEN_IMPORT_ARGC(BotQueueConsoleMessage, G_BOTQUEUECONSOLEMESSAGE),
+    GEN_IMPORT_ARGC(BotRemoveConsoleMessage, G_BOTREMOVECONSOLEMESSAGE),
+    GEN_IMPORT_ARGC(BotNextConsoleMessage, G_BOTNEXTCONSOLEMESSAGE),
+    GEN_IMPORT_ARGC(BotNumConsoleMessages, G_BOTNUMCONSOLEMESSAGES),
+    GEN_IMPORT_ARGC(BotInitialChat, G_BOTINITIALCHAT),
+    GEN_IMPORT_ARGC(BotNumInitialChats, G_BOTNUMINITIALCHATS),
+    GEN_IMPORT_ARGC(BotReplyChat, G_BOTREPLYCHAT),
+    GEN_IMPORT_ARGC(BotChatLength, G_BOTCHATLENGTH),
+    GEN_IMPORT_ARGC(BotEnterChat, G_BOTENTERCHAT),
+    GEN_IMPORT_ARGC(BotGetChatMessage, G_BOTGETCHATMESSAGE),
+    GEN_IMPORT_ARGC(StringContains, G_STRINGCONTAINS),
+    GEN_IMPORT_ARGC(BotFindMatch, G_BOTFINDMATCH),
+    GEN_IMPORT_ARGC(BotMatchVariable, G_BOTMATCHVARIABLE),
+    GEN_IMPORT_ARGC(UnifyWhiteSpaces, G_UNIFYWHITESPACES),
+    GEN_IMPORT_ARGC(BotReplaceSynonyms, G_BOTREPLACESYNONYMS),
+    GEN_IMPORT_ARGC(BotLoadChatFile, G_BOTLOADCHATFILE),
+    GEN_IMPORT_ARGC(BotSetChatGender, G_BOTSETCHATGENDER),
+    GEN_IMPORT_ARGC(BotSetChatName, G_BOTSETCHATNAME),
+    GEN_IMPORT_ARGC(BotResetGoalState, G_BOTRESETGOALSTATE),
+    GEN_IMPORT_ARGC(BotResetAvoidGoals, G_BOTRESETAVOIDGOALS),
+    GEN_IMPORT_ARGC(BotRemoveFromAvoidGoals, G_BOTREMOVEFROMAVOIDGOALS),
+    GEN_IMPORT_ARGC(BotPushGoal, G_BOTPUSHGOAL),
+    GEN_IMPORT_ARGC(BotPopGoal, G_BOTPOPGOAL),
+    GEN_IMPORT_ARGC(BotEmptyGoalStack, G_BOTEMPTYGOALSTACK),
+    GEN_IMPORT_ARGC(BotDumpAvoidGoals, G_BOTDUMPAVOIDGOALS),
+    GEN_IMPORT_ARGC(BotDumpGoalStack, G_BOTDUMPGOALSTACK),
+    GEN_IMPORT_ARGC(BotGoalName, G_BOTGOALNAME),
+    GEN_IMPORT_ARGC(BotGetTopGoal, G_BOTGETTOPGOAL),
+    GEN_IMPORT_ARGC(BotGetSecondGoal, G_BOTGETSECONDGOAL),
+    GEN_IMPORT_ARGC(BotChooseLTGItem, G_BOTCHOOSELTGITEM),
+    GEN_IMPORT_ARGC(BotChooseNBGItem, G_BOTCHOOSENBGITEM),
+    GEN_IMPORT_ARGC(BotTouchingGoal, G_BOTTOUCHINGGOAL),
+    GEN_IMPORT_ARGC(BotItemGoalInVisButNotVisible, G_BOTITEMGOALINVISBUTNOTVISIBLE),
+    GEN_IMPORT_ARGC(BotGetLevelItemGoal, G_BOTGETLEVELITEMGOAL),
+    GEN_IMPORT_ARGC(BotGetNextCampSpotGoal, G_BOTGETNEXTCAMPSPOTGOAL),
+    GEN_IMPORT_ARGC(BotGetMapLocationGoal, G_BOTGETMAPLOCATIONGOAL),
+    GEN_IMPORT_ARGC(BotAvoidGoalTime, G_BOTAVOIDGOALTIME),
+    GEN_IMPORT_ARGC(BotSetAvoidGoalTime, G_BOTSETAVOIDGOALTIME),
+    GEN_IMPORT_ARGC(BotInitLevelItems, G_BOTINITLEVELITEMS),
+    GEN_IMPORT_ARGC(BotUpdateEntityItems, G_BOTUPDATEENTITYITEMS),
+    GEN_IMPORT_ARGC(BotLoadItemWeights, G_BOTLOADITEMWEIGHTS),
+    GEN_IMPORT_ARGC(BotFreeItemWeights, G_BOTFREEITEMWEIGHTS),
+    GEN_IMPORT_ARGC(BotInterbreedGoalFuzzyLogic, G_BOTINTERBREEDGOALFUZZYLOGIC),
+    GEN_IMPORT_ARGC(BotSaveGoalFuzzyLogic, G_BOTSAVEGOALFUZZYLOGIC),
+    GEN_IMPORT_ARGC(BotMutateGoalFuzzyLogic, G_BOTMUTATEGOALFUZZYLOGIC),
+    GEN_IMPORT_ARGC(BotAllocGoalState, G_BOTALLOCGOALSTATE),
+    GEN_IMPORT_ARGC(BotFreeGoalState, G_BOTFREEGOALSTATE),
+    GEN_IMPORT_ARGC(BotResetMoveState, G_BOTRESETMOVESTATE),
+    GEN_IMPORT_ARGC(BotMoveToGoal, G_BOTMOVETOGOAL),
+    GEN_IMPORT_ARGC(BotMoveInDirection, G_BOTMOVEINDIRECTION),
+    GEN_IMPORT_ARGC(BotResetAvoidReach, G_BOTRESETAVOIDREACH),
+    GEN_IMPORT_ARGC(BotResetLastAvoidReach, G_BOTRESETLASTAVOIDREACH),
+    GEN_IMPORT_ARGC(BotReachabilityArea, G_BOTREACHABILITYAREA),
+    GEN_IMPORT_ARGC(BotMovementViewTarget, G_BOTMOVEMENTVIEWTARGET),
+    GEN_IMPORT_ARGC(BotPredictVisiblePosition, G_BOTPREDICTVISIBLEPOSITION),
+    GEN_IMPORT_ARGC(BotAllocMoveState, G_BOTALLOCMOVESTATE),
+    GEN_IMPORT_ARGC(BotFreeMoveState, G_BOTFREEMOVESTATE),
+    GEN_IMPORT_ARGC(BotInitMoveState, G_BOTINITMOVESTATE),
+    GEN_IMPORT_ARGC(BotAddAvoidSpot, G_BOTADDAVOIDSPOT),
+    GEN_IMPORT_ARGC(BotChooseBestFightWeapon, G_BOTCHOOSEBESTFIGHTWEAPON),
+    GEN_IMPORT_ARGC(BotGetWeaponInfo, G_BOTGETWEAPONINFO),
+    GEN_IMPORT_ARGC(BotLoadWeaponWeights, G_BOTLOADWEAPONWEIGHTS),
+    GEN_IMPORT_ARGC(BotAllocWeaponState, G_BOTALLOCWEAPONSTATE),
+    GEN_IMPORT_ARGC(BotFreeWeaponState, G_BOTFREEWEAPONSTATE),
+    GEN_IMPORT_ARGC(BotResetWeaponState, G_BOTRESETWEAPONSTATE),
+    GEN_IMPORT_ARGC(GeneticParentsAndChildSelection, G_GENETICPARENTSANDCHILDSELECTION),
+    GEN_IMPORT_ARGC(Print, G_BOTPRINT),
+    GEN_IMPORT_ARGC(PointContents, G_BOTPOINTCONTENTS),
+    GEN_IMPORT_ARGC(BSPEntityData, G_BSPENTITYDATA),
+    GEN_IMPORT_ARGC(BSPModelMinsMaxsOrigin, G_BSPMODELMINSMAXSORIGIN),
+    GEN_IMPORT_ARGC(BotClientCommand, G_BOTCLIENTCOMMAND),
+    GEN_IMPORT_ARGC(AvailableMemory, G_AVAILABLEMEMORY),
+    GEN_IMPORT_ARGC(HunkAlloc, G_HUNKALLOC),
+    GEN_IMPORT_ARGC(FS_FOpenFile, G_FS_FOPEN_FILE),
+    GEN_IMPORT_ARGC(FS_Seek, G_FS_SEEK),
+    GEN_IMPORT_ARGC(DebugLineCreate, G_DEBUGLINECREATE),
+    GEN_IMPORT_ARGC(DebugLineDelete, G_DEBUGLINEDELETE),
+    GEN_IMPORT_ARGC(DebugLineShow, G_DEBUGLINESHOW),
+    GEN_IMPORT_ARGC(DebugPolygonCreate, G_DEBUGPOLYGONCREATE),
+    GEN_IMPORT_ARGC(DebugPolygonDelete, G_DEBUGPOLYGONDELETE),
+    GEN_IMPORT_ARGC(DropClient, G_DROP_CLIENT),
+    GEN_IMPORT_ARGC(SV_GetServerinfo, G_SV_GETSERVERINFO),
+    GEN_IMPORT_ARGC(BotAllocateClient, G_BOTALLOCATECLIENT),
+    GEN_IMPORT_ARGC(BotGetSnapshotEntity, G_BOTGETSNAPSHOTENTITY),
+    GEN_IMPORT_ARGC(BotGetConsoleMessage, G_BOTGETCONSOLEMESSAGE),
+    GEN_IMPORT_ARGC(BotLibSetup, G_BOTLIBSETUP),
+    GEN_IMPORT_ARGC(BotLibShutdown, G_BOTLIBSHUTDOWN),
+    GEN_IMPORT_ARGC(BotLibVarSet, G_BOTLIBVARSET),
+    GEN_IMPORT_ARGC(BotLibVarGet, G_BOTLIBVARGET),
+    GEN_IMPORT_ARGC(PC_AddGlobalDefine, G_PC_ADDGLOBALDEFINE),
+    GEN_IMPORT_ARGC(PC_LoadSourceHandle, G_PC_LOADSOURCEHANDLE),
+    GEN_IMPORT_ARGC(PC_FreeSourceHandle, G_PC_FREESOURCEHANDLE),
+    GEN_IMPORT_ARGC(PC_SourceFileAndLine, G_PC_SOURCEFILEANDLINE),
+    GEN_IMPORT_ARGC(BotLibStartFrame, G_BOTLIBSTARTFRAME),
+    GEN_IMPORT_ARGC(BotLibLoadMap, G_BOTLIBLOADMAP),
+    GEN_IMPORT_ARGC(BotLibUpdateEntity, G_BOTLIBUPDATEENTITY),
+    GEN_IMPORT_ARGC(Test, G_TEST),
+    GEN_IMPORT_ARGC(BotUserCommand, G_BOTUSERCOMMAND),
+};
+
+static constexpr auto syscall_argcs = GEN_SYSCALL_ARGC_TABLE(syscall_argc_defs);
+
+
+// number of args each mod message takes, read from the game_export_t declarations
+static constexpr MsgArgcDef vmmain_argc_defs[] = {
+    GEN_EXPORT_ARGC(Init, GAME_INIT),
+    GEN_EXPORT_ARGC(Shutdown, GAME_SHUTDOWN),
+    GEN_EXPORT_ARGC(Cleanup, GAME_CLEANUP),
+    GEN_EXPORT_ARGC(SpawnEntities, GAME_SPAWN_ENTITIES),
+    GEN_EXPORT_ARGC(PostLoad, GAME_POSTLOAD),
+    GEN_EXPORT_ARGC(PostSublevelLoad, GAME_POSTSUBLEVELLOAD),
+    GEN_EXPORT_ARGC(ClientConnect, GAME_CLIENT_CONNECT),
+    GEN_EXPORT_ARGC(ClientBegin, GAME_CLIENT_BEGIN),
+    GEN_EXPORT_ARGC(ClientUserinfoChanged, GAME_CLIENT_USERINFO_CHANGED),
+    GEN_EXPORT_ARGC(ClientDisconnect, GAME_CLIENT_DISCONNECT),
+    GEN_EXPORT_ARGC(ClientCommand, GAME_CLIENT_COMMAND),
+    GEN_EXPORT_ARGC(ClientThink, GAME_CLIENT_THINK),
+    GEN_EXPORT_ARGC(PrepFrame, GAME_PREP_FRAME),
+    GEN_EXPORT_ARGC(RunFrame, GAME_RUN_FRAME),
+    GEN_EXPORT_ARGC(SendEntity, GAME_SEND_ENTITY),
+    GEN_EXPORT_ARGC(UpdateEntityStateForClient, GAME_UPDATE_ENTITYSTATE_FOR_CLIENT),
+    GEN_EXPORT_ARGC(UpdatePlayerStateForClient, GAME_UPDATE_PLAYERSTATE_FOR_CLIENT),
+    GEN_EXPORT_ARGC(ExtraEntitiesToSend, GAME_EXTRA_ENTITIES_TO_SEND),
+    GEN_EXPORT_ARGC(GetEntityCurrentAnimFrame, GAME_GETENTITY_CURRENT_ANIMFRAME),
+    GEN_EXPORT_ARGC(ConsoleCommand, GAME_CONSOLE_COMMAND),
+    GEN_EXPORT_ARGC(WritePersistant, GAME_WRITE_PERSISTANT),
+    GEN_EXPORT_ARGC(ReadPersistant, GAME_READ_PERSISTANT),
+    GEN_EXPORT_ARGC(WriteLevel, GAME_WRITE_LEVEL),
+    GEN_EXPORT_ARGC(ReadLevel, GAME_READ_LEVEL),
+    GEN_EXPORT_ARGC(LevelArchiveValid, GAME_LEVEL_ARCHIVE_VALID),
+    GEN_EXPORT_ARGC(inMultiplayerGame, GAME_IN_MULTIPLAYER_GAME),
+    GEN_EXPORT_ARGC(isDefined, GAME_IS_DEFINED),
+    GEN_EXPORT_ARGC(getDefine, GAME_GET_DEFINE),
+    GEN_EXPORT_ARGC(BotAIStartFrame, BOTAI_START_FRAME),
+    GEN_EXPORT_ARGC(AddBot_f, GAME_ADDBOT_F),
+    GEN_EXPORT_ARGC(GetTotalGameFrames, GAME_GETTOTALGAMEFRAMES),
+};
+
+static constexpr auto vmmain_argcs = GEN_VMMAIN_ARGC_TABLE(vmmain_argc_defs);
+
+
+const int8_t* STEF2_GameSupport::SyscallArgcs(int* count) {
+    *count = syscall_argcs.count;
+    return syscall_argcs.argc;
+}
+
+
+const int8_t* STEF2_GameSupport::VMMainArgcs(int* count) {
+    *count = vmmain_argcs.count;
+    return vmmain_argcs.argc;
+}
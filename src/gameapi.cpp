@@ -10,6 +10,7 @@ Created By:
 */
 
 #include "version.h"
+#include <cstdarg>
 #include <vector>
 #include "gameapi.hpp"
 
@@ -114,3 +115,68 @@ const char* APIType_Function(APIType api) {
 		return "unknown";
 	};
 }
+
+
+intptr_t GameSupport::syscall(intptr_t cmd, ...) {
+	QMM_GET_SYSCALL_ARGS_N(this->SyscallArgc(cmd));
+	return this->syscall_args(cmd, args, argc);
+}
+
+
+intptr_t GameSupport::vmMain(intptr_t cmd, ...) {
+	QMM_GET_VMMAIN_ARGS_N(this->VMMainArgc(cmd));
+	return this->vmMain_args(cmd, args, argc);
+}
+
+
+int GameSupport::SyscallArgc(intptr_t cmd) {
+	int count = 0;
+	const int8_t* argcs = this->SyscallArgcs(&count);
+	if (argcs) {
+		if (cmd < 0 || cmd >= count || argcs[cmd] < 0)
+			return QMM_MAX_SYSCALL_ARGS;
+		return argcs[cmd];
+	}
+
+	// games that support QVMs already describe every engine message a mod can call in their QVM syscall table. messages
+	// that aren't in the table, or whose args aren't known, get every arg unpacked like before
+	const QVMSyscallDesc* descs = this->QVMSyscalls(&count);
+	if (!descs || cmd < 0 || cmd >= count || !descs[cmd].valid || !descs[cmd].exactargs)
+		return QMM_MAX_SYSCALL_ARGS;
+	return descs[cmd].numargs;
+}
+
+
+int GameSupport::VMMainArgc(intptr_t cmd) {
+	int count = 0;
+	const int8_t* argcs = this->VMMainArgcs(&count);
+	if (!argcs || cmd < 0 || cmd >= count || argcs[cmd] < 0)
+		return QMM_MAX_VMMAIN_ARGS;
+	return argcs[cmd];
+}
+
+
+intptr_t api_call_args(eng_syscall func, intptr_t cmd, const intptr_t* args, int argc) {
+	const intptr_t* a = args;
+	switch (argc) {
+	case 1: return func(cmd, a[0]);
+	case 2: return func(cmd, a[0], a[1]);
+	case 3: return func(cmd, a[0], a[1], a[2]);
+	case 4: return func(cmd, a[0], a[1], a[2], a[3]);
+	case 5: return func(cmd, a[0], a[1], a[2], a[3], a[4]);
+	case 6: return func(cmd, a[0], a[1], a[2], a[3], a[4], a[5]);
+	case 7: return func(cmd, a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+	case 8: return func(cmd, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+	case 9: return func(cmd, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8]);
+	case 10: return func(cmd, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9]);
+	case 11: return func(cmd, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9], a[10]);
+	case 12: return func(cmd, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11]);
+	case 13: return func(cmd, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11], a[12]);
+	case 14: return func(cmd, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11], a[12], a[13]);
+	case 15: return func(cmd, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11], a[12], a[13], a[14]);
+	case 16: return func(cmd, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11], a[12], a[13], a[14], a[15]);
+	case 17: return func(cmd, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11], a[12], a[13], a[14], a[15], a[16]);
+	case 18: return func(cmd, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11], a[12], a[13], a[14], a[15], a[16], a[17]);
+	default: return func(cmd);
+	}
+}
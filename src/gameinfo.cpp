@@ -24,11 +24,15 @@ Created By:
 #include "plugin.hpp"
 #include "mod.hpp"      // g_mod
 #include "qvm.h"        // QVM_MAGIC
+#include "stats.hpp"
 #include "util.hpp"
 
 // Currently-loaded game & game engine info.
 GameInfo gameinfo;
 
+// How many Route calls are in progress (plugin hooks can make syscalls, which route back through QMM)
+static int s_route_depth = 0;
+
 /* About cgame passthrough hack (not Quake 2 Remaster (Q2R), see comments before GetCGameAPI() for that):
    Some single player games, like Star Trek Voyager: Elite Force (STVOYSP), Jedi Knight 2 (JK2SP) and Jedi
    Academy (JASP), place the game (server side) and cgame (client side) in the same DLL. The game system
@@ -75,6 +79,7 @@ intptr_t GameInfo::msg_G_PRINT;                // Value of G_PRINT for the detec
 intptr_t GameInfo::msg_GAME_INIT;              // Value of GAME_INIT for the detected game
 intptr_t GameInfo::msg_GAME_CONSOLE_COMMAND;   // Value of GAME_CONSOLE_COMMAND for the detected game
 intptr_t GameInfo::msg_GAME_SHUTDOWN;          // Value of GAME_SHUTDOWN for the detected game
+intptr_t GameInfo::msg_GAME_RUN_FRAME;         // Value of GAME_RUN_FRAME for the detected game
 
 
 void* GameInfo::HandleEntry(void* import, void* extra, APIType engine) {
@@ -112,6 +117,9 @@ void* GameInfo::HandleEntry(void* import, void* extra, APIType engine) {
     if (!cfg_loglevel.empty())
         log_set_severity(log_severity_from_name(cfg_loglevel));
 
+    // start collecting routing statistics right away (otherwise use "qmm stats start")
+    g_stats_active = cfg_get_bool(g_cfg, "routestats", false);
+
     // detect game (possibly take setting from config file, or auto-detect)
     std::string cfg_game = cfg_get_string(g_cfg, "game", "auto");
     // check command line arguments for a game code
@@ -127,6 +135,7 @@ void* GameInfo::HandleEntry(void* import, void* extra, APIType engine) {
     GameInfo::msg_GAME_INIT = this->game->QMMModMsg(QMM_GAME_INIT);
     GameInfo::msg_GAME_CONSOLE_COMMAND = this->game->QMMModMsg(QMM_GAME_CONSOLE_COMMAND);
     GameInfo::msg_GAME_SHUTDOWN = this->game->QMMModMsg(QMM_GAME_SHUTDOWN);
+    GameInfo::msg_GAME_RUN_FRAME = this->game->QMMModMsg(QMM_GAME_RUN_FRAME);
 
     // call the game-specific entry handler (e.g. Q3A_GameSupport::Entry) which will set up the internals to interact
     // the engine and the mod
@@ -311,7 +320,25 @@ bool GameInfo::LoadPlugin(std::string plugin_path) {
 }
 
 
-intptr_t GameInfo::Route(bool is_syscall, intptr_t cmd, intptr_t* args) const {
+void GameInfo::UpdatePassthroughs() {
+    if (!this->game)
+        return;
+
+    // get passthrough setting from config
+    bool use_passthrough = cfg_get_bool(g_cfg, "passthrough", true);
+
+    int count = this->game->UpdatePassthroughs(use_passthrough);
+
+    QMMLOG(QMM_LOG_DEBUG, "QMM") << "GameInfo::UpdatePassthroughs(): " << count << " import/export function(s) bypass QMM\n";
+}
+
+
+bool GameInfo::IsRouting() const {
+    return s_route_depth > 0;
+}
+
+
+intptr_t GameInfo::Route(bool is_syscall, intptr_t cmd, intptr_t* args, int argc) const {
     const char* msg_name;
     const char* func_name;
     GameSupport* gamesupport = this->game;
@@ -337,21 +364,34 @@ intptr_t GameInfo::Route(bool is_syscall, intptr_t cmd, intptr_t* args) const {
     // store previous globals (in case of re-entrancy)
     plugin_globals old_globals = g_plugin_globals;
 
+    // routing statistics (only timed while "qmm stats start" is active)
+    const bool stats = g_stats_active;
+    const uint64_t stats_route_start = stats ? stats_time() : 0;
+    uint64_t stats_phase_start = stats_route_start;
+
+    // pick up plugin subscription changes, but not while an outer Route is still walking the hook lists
+    if (!s_route_depth)
+        plugins_update_hooks();
+    s_route_depth++;
+
     // begin passing calls to plugins' pre-hook functions
-    for (Plugin& p : g_plugins) {
+    for (Plugin* p : plugins_hooks(is_syscall, cmd, false)) {
         g_plugin_globals.plugin_result = QMM_UNUSED;
         // allow plugins to see the current final_ret value
         g_plugin_globals.final_return = final_ret;
 
-        QMMLOG(QMM_LOG_TRACE, "QMM") << "Plugin \"" << p.plugininfo->name << "\" QMM_" << func_name << "( " << msg_name << "(" << cmd << ")) called\n";
+        QMMLOG(QMM_LOG_TRACE, "QMM") << "Plugin \"" << p->plugininfo->name << "\" QMM_" << func_name << "( " << msg_name << "(" << cmd << ")) called\n";
 
         // call plugin's pre-hook and store return value
+        uint64_t stats_call_start = stats ? stats_time() : 0;
         if (is_syscall)
-            plugin_ret = p.QMM_syscall(cmd, args);
+            plugin_ret = p->QMM_syscall(cmd, args);
         else
-            plugin_ret = p.QMM_vmMain(cmd, args);
+            plugin_ret = p->QMM_vmMain(cmd, args);
+        if (stats)
+            stats_add(p->stats, is_syscall, cmd, STATS_PRE, stats_time() - stats_call_start, g_plugin_globals.plugin_result);
 
-        QMMLOG(QMM_LOG_TRACE, "QMM") << "Plugin \"" << p.plugininfo->name << "\" QMM_" << func_name << "( " << msg_name << "(" << cmd << ")) returning " << plugin_ret << " with result " << Plugin::plugin_result_to_str(g_plugin_globals.plugin_result) << "\n";
+        QMMLOG(QMM_LOG_TRACE, "QMM") << "Plugin \"" << p->plugininfo->name << "\" QMM_" << func_name << "( " << msg_name << "(" << cmd << ")) returning " << plugin_ret << " with result " << Plugin::plugin_result_to_str(g_plugin_globals.plugin_result) << "\n";
 
         // set new max result
         max_result = util_max(g_plugin_globals.plugin_result, max_result);
@@ -359,10 +399,10 @@ intptr_t GameInfo::Route(bool is_syscall, intptr_t cmd, intptr_t* args) const {
         g_plugin_globals.high_result = max_result;
         // invalid/error result values
         if (g_plugin_globals.plugin_result == QMM_UNUSED) {
-            QMMLOG(QMM_LOG_WARNING, "QMM") << func_name << "(" << msg_name << "): Plugin \"" << p.plugininfo->name << "\" did not set result flag\n";
+            QMMLOG(QMM_LOG_WARNING, "QMM") << func_name << "(" << msg_name << "): Plugin \"" << p->plugininfo->name << "\" did not set result flag\n";
         }
         else if (g_plugin_globals.plugin_result == QMM_ERROR) {
-            QMMLOG(QMM_LOG_ERROR, "QMM") << func_name << "(" << msg_name << "): Plugin \"" << p.plugininfo->name << "\" set result flag QMM_ERROR\n";
+            QMMLOG(QMM_LOG_ERROR, "QMM") << func_name << "(" << msg_name << "): Plugin \"" << p->plugininfo->name << "\" set result flag QMM_ERROR\n";
         }
         // if plugin resulted in QMM_OVERRIDE or QMM_SUPERCEDE, set final_ret to this return value
         else if (g_plugin_globals.plugin_result >= QMM_OVERRIDE) {
@@ -370,16 +410,28 @@ intptr_t GameInfo::Route(bool is_syscall, intptr_t cmd, intptr_t* args) const {
         }
     }
 
+    if (stats) {
+        uint64_t now = stats_time();
+        stats_add(g_stats, is_syscall, cmd, STATS_PRE, now - stats_phase_start, max_result);
+        stats_phase_start = now;
+    }
+
     // call real function (unless a plugin resulted in QMM_SUPERCEDE)
     if (max_result < QMM_SUPERCEDE) {
         QMMLOG(QMM_LOG_TRACE, "QMM") << "Real " << func_name << "(" << msg_name << "(" << cmd << ")) called\n";
 
         if (is_syscall)
-            real_ret = gamesupport->syscall(cmd, QMM_PUT_SYSCALL_ARGS());
+            real_ret = gamesupport->syscall_args(cmd, args, argc);
         else
-            real_ret = gamesupport->vmMain(cmd, QMM_PUT_VMMAIN_ARGS());
+            real_ret = gamesupport->vmMain_args(cmd, args, argc);
 
         QMMLOG(QMM_LOG_TRACE, "QMM") << "Real " << func_name << "(" << msg_name << "(" << cmd << ")) returning " << real_ret << "\n";
+
+        if (stats) {
+            uint64_t now = stats_time();
+            stats_add(g_stats, is_syscall, cmd, STATS_REAL, now - stats_phase_start, QMM_UNUSED);
+            stats_phase_start = now;
+        }
     }
     else {
         QMMLOG(QMM_LOG_TRACE, "QMM") << "Real " << func_name << "(" << msg_name << "(" << cmd << ")) superceded\n";
@@ -393,24 +445,27 @@ intptr_t GameInfo::Route(bool is_syscall, intptr_t cmd, intptr_t* args) const {
         final_ret = real_ret;
 
     // pass calls to plugins' post-hook functions (QMM_OVERRIDE or QMM_SUPERCEDE can still change final_ret)
-    for (Plugin& p : g_plugins) {
+    for (Plugin* p : plugins_hooks(is_syscall, cmd, true)) {
         g_plugin_globals.plugin_result = QMM_UNUSED;
         // allow plugins to see the current final_ret value
         g_plugin_globals.final_return = final_ret;
 
-        QMMLOG(QMM_LOG_TRACE, "QMM") << "Plugin \"" << p.plugininfo->name << "\" QMM_" << func_name << "_Post( " << msg_name << "(" << cmd << ")) called\n";
+        QMMLOG(QMM_LOG_TRACE, "QMM") << "Plugin \"" << p->plugininfo->name << "\" QMM_" << func_name << "_Post( " << msg_name << "(" << cmd << ")) called\n";
 
         // call plugin's post-hook and store return value
+        uint64_t stats_call_start = stats ? stats_time() : 0;
         if (is_syscall)
-            plugin_ret = p.QMM_syscall_Post(cmd, args);
+            plugin_ret = p->QMM_syscall_Post(cmd, args);
         else
-            plugin_ret = p.QMM_vmMain_Post(cmd, args);
+            plugin_ret = p->QMM_vmMain_Post(cmd, args);
+        if (stats)
+            stats_add(p->stats, is_syscall, cmd, STATS_POST, stats_time() - stats_call_start, g_plugin_globals.plugin_result);
 
-        QMMLOG(QMM_LOG_TRACE, "QMM") << "Plugin \"" << p.plugininfo->name << "\" QMM_" << func_name << "_Post( " << msg_name << "(" << cmd << ")) returning " << plugin_ret << " with result " << Plugin::plugin_result_to_str(g_plugin_globals.plugin_result) << "\n";
+        QMMLOG(QMM_LOG_TRACE, "QMM") << "Plugin \"" << p->plugininfo->name << "\" QMM_" << func_name << "_Post( " << msg_name << "(" << cmd << ")) returning " << plugin_ret << " with result " << Plugin::plugin_result_to_str(g_plugin_globals.plugin_result) << "\n";
 
         // ignore QMM_UNUSED so plugins can just use return, but still show a message for QMM_ERROR
         if (g_plugin_globals.plugin_result == QMM_ERROR) {
-            QMMLOG(QMM_LOG_ERROR, "QMM") << func_name << "(" << msg_name << "): Plugin \"" << p.plugininfo->name << "\" set result flag QMM_ERROR\n";
+            QMMLOG(QMM_LOG_ERROR, "QMM") << func_name << "(" << msg_name << "): Plugin \"" << p->plugininfo->name << "\" set result flag QMM_ERROR\n";
         }
         // if plugin resulted in QMM_OVERRIDE or QMM_SUPERCEDE, set final_ret to this return value
         else if (g_plugin_globals.plugin_result >= QMM_OVERRIDE) {
@@ -418,6 +473,27 @@ intptr_t GameInfo::Route(bool is_syscall, intptr_t cmd, intptr_t* args) const {
         }
     }
 
+    if (stats) {
+        uint64_t now = stats_time();
+        stats_add(g_stats, is_syscall, cmd, STATS_POST, now - stats_phase_start, QMM_UNUSED);
+        stats_add_call(is_syscall, cmd, now - stats_route_start);
+    }
+
+    // buffer vmMain messages for plugins' QMM_vmMain_Batch, and deliver them once the frame is done (or before the
+    // plugins are unloaded)
+    if (!is_syscall) {
+        plugins_batch_add(cmd, args, argc, final_ret);
+        if (cmd == GameInfo::msg_GAME_RUN_FRAME || cmd == GameInfo::msg_GAME_SHUTDOWN)
+            plugins_batch_deliver();
+    }
+
+    s_route_depth--;
+
+    // pick up subscription changes made by hooks during this call right away, so newly hooked import/export slots
+    // stop bypassing QMM before the engine or mod calls them again
+    if (!s_route_depth)
+        plugins_update_hooks();
+
     // restore previous globals (stored in case of re-entrancy)
     g_plugin_globals = old_globals;
 
@@ -11,6 +11,11 @@ Created By:
 
 
 #define _CRT_SECURE_NO_WARNINGS
+#include <cstdio>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
 #include "version.h"
 #include "log.hpp"
 #include "format.hpp"
@@ -19,7 +24,10 @@ Created By:
 #include "plugin.hpp"   // g_plugins
 #include "main.hpp"     // ArgV
 #include "mod.hpp"      // g_mod
+#include "stats.hpp"
 #include "util.hpp"
+#include "qvm_jit.h"
+#include "qvm_aot.h"
 
 
 /* This file contains all the entry points for QMM.
@@ -85,9 +93,10 @@ static void HandleQMMCommand(intptr_t arg_start);
       is returned to engine
 
    syscall (mod->engine) call flow for QVM mods only:
-   1. QVM system calls <GAME>_QVMSyscall function
-   2. pointer arguments are converted: if not NULL, the QVM data segment base address is added
-   3. call qmm_syscall with converted arguments (continue with next section as if it were a DLL mod)
+   1. QVM system calls Mod::QVM_syscall function
+   2. pointer arguments are converted using the game's QVM syscall table: if not NULL, the QVM data segment base
+      address is added
+   3. call qmm_syscall_args with converted arguments (continue with next section as if it were a DLL mod)
 
    syscall (mod->engine) call flow:
    1. call is handled by qmm_syscall()
@@ -167,8 +176,6 @@ C_DLLEXPORT void* GetModuleAPI(int apiversion, void* import) {
 
 
 C_DLLEXPORT intptr_t vmMain(intptr_t cmd, ...) {
-    QMM_GET_VMMAIN_ARGS();
-
     // if this is a call from cgame and we need to pass this call onto the mod
     if (cgameinfo.syscall && !cgameinfo.is_from_QMM) {
         // cancel if cgame portion of mod isn't actually loaded yet
@@ -177,7 +184,9 @@ C_DLLEXPORT intptr_t vmMain(intptr_t cmd, ...) {
 
         QMMLOG(QMM_LOG_TRACE, "QMM") << "Passthrough vmMain(" << cmd << ") called\n";
 
-        intptr_t ret = cgameinfo.vmMain(cmd, QMM_PUT_VMMAIN_ARGS());
+        // cgame messages aren't in the game's arg count table, so pass every arg on
+        QMM_GET_VMMAIN_ARGS();
+        intptr_t ret = api_call_args(cgameinfo.vmMain, cmd, args, argc);
 
         QMMLOG(QMM_LOG_TRACE, "QMM") << "Passthrough vmMain(" << cmd << ") returning " << ret << "\n";
 
@@ -194,6 +203,14 @@ C_DLLEXPORT intptr_t vmMain(intptr_t cmd, ...) {
     // clear passthrough flag
     cgameinfo.is_from_QMM = false;
 
+    // only pull the args this message actually takes. from here on, every layer passes the same array along
+    QMM_GET_VMMAIN_ARGS_N(gameinfo.game ? gameinfo.game->VMMainArgc(cmd) : 0);
+
+    return qmm_vmMain_args(cmd, args, argc);
+}
+
+
+intptr_t qmm_vmMain_args(intptr_t cmd, intptr_t* args, int argc) {
     // couldn't load engine info, so we will just call syscall(G_ERROR) to exit
     if (!gameinfo.game) {
         if (!gameinfo.is_shutdown) {
@@ -283,6 +300,11 @@ C_DLLEXPORT intptr_t vmMain(intptr_t cmd, ...) {
         }
         QMMLOG(QMM_LOG_NOTICE, "QMM") << "Successfully loaded " << g_plugins.size() << " plugin(s)\n";
 
+        // now that we know which syscalls plugins hook, let the QVM handle the rest of the pure ones itself
+        g_mod.UpdateQVMIntrinsics();
+        // and let the engine and mod call each other directly for messages no plugin hooks
+        gameinfo.UpdatePassthroughs();
+
         // exec the qmmexec cfg
         std::string cfg_execcfg = cfg_get_string(g_cfg, "execcfg", "qmmexec.cfg");
         if (!cfg_execcfg.empty()) {
@@ -315,7 +337,7 @@ C_DLLEXPORT intptr_t vmMain(intptr_t cmd, ...) {
     }
 
     // route call to plugins and mod
-    intptr_t ret = gameinfo.Route(false, cmd, args); // true = is_syscall
+    intptr_t ret = gameinfo.Route(false, cmd, args, argc); // true = is_syscall
 
     // handle shut down (this is after the plugins and mod get called with GAME_SHUTDOWN)
     if (cmd == GameInfo::msg_GAME_SHUTDOWN) {
@@ -350,12 +372,18 @@ C_DLLEXPORT intptr_t vmMain(intptr_t cmd, ...) {
 
 
 intptr_t qmm_syscall(intptr_t cmd, ...) {
-    QMM_GET_SYSCALL_ARGS();
+    // only pull the args this message actually takes. from here on, every layer passes the same array along
+    QMM_GET_SYSCALL_ARGS_N(gameinfo.game->SyscallArgc(cmd));
+
+    return qmm_syscall_args(cmd, args, argc);
+}
+
 
+intptr_t qmm_syscall_args(intptr_t cmd, intptr_t* args, int argc) {
     QMMLOG(QMM_LOG_DEBUG, "QMM") << "syscall(" << gameinfo.game->EngMsgName(cmd) << "(" << cmd << ")) called\n";
 
     // route call to plugins and mod
-    intptr_t ret = gameinfo.Route(true, cmd, args); // true = is_syscall
+    intptr_t ret = gameinfo.Route(true, cmd, args, argc); // true = is_syscall
 
     QMMLOG(QMM_LOG_DEBUG, "QMM") << "syscall(" << gameinfo.game->EngMsgName(cmd) << "(" << cmd << ")) returning " << ret << "\n";
 
@@ -363,13 +391,152 @@ intptr_t qmm_syscall(intptr_t cmd, ...) {
 }
 
 
+// Print the QVM functions with the most time from the profiler, and write every profiled call stack to a collapsed
+// stack file (one "func1;func2;func3 nanoseconds" line per call stack) for flame graph tools
+static void QVMProfDump(size_t count) {
+    const qvm_prof* prof = g_mod.vm.prof;
+    if (!prof || prof->numnodes <= 1) {
+        CONSOLE_PRINT("(QMM) No QVM profiler data, use \"qmm qvmprof start\" first\n");
+        return;
+    }
+
+    // combine each function's nodes from every call stack
+    struct FuncStats {
+        int func = 0;
+        uint64_t calls = 0;
+        uint64_t instructions = 0;
+        uint64_t time = 0;
+    };
+    std::map<int, FuncStats> funcmap;
+    uint64_t totaltime = 0;
+    for (size_t i = 1; i < prof->numnodes; i++) {
+        const qvm_prof_node& node = prof->nodes[i];
+        FuncStats& stats = funcmap[node.func];
+        stats.func = node.func;
+        stats.calls += node.calls;
+        stats.instructions += node.instructions;
+        stats.time += node.time;
+        totaltime += node.time;
+    }
+
+    std::vector<FuncStats> funcs;
+    for (auto& [func, stats] : funcmap)
+        funcs.push_back(stats);
+    std::sort(funcs.begin(), funcs.end(), [](const FuncStats& a, const FuncStats& b) { return a.time > b.time; });
+
+    CONSOLE_PRINTF("(QMM) QVM profile ({} functions, {} call stacks, {} total usec){}\n", funcs.size(), prof->numnodes - 1, totaltime / 1000, prof->active ? "" : " (stopped)");
+    CONSOLE_PRINT ("(QMM)  time%       usec      calls   instructions function\n");
+    CONSOLE_PRINT ("(QMM) ------ ---------- ---------- -------------- --------\n");
+    for (size_t i = 0; i < funcs.size() && i < count; i++) {
+        const FuncStats& stats = funcs[i];
+        double percent = totaltime ? 100.0 * (double)stats.time / (double)totaltime : 0.0;
+        CONSOLE_PRINTF("(QMM) {:>6.2f} {:>10} {:>10} {:>14} {}\n", percent, stats.time / 1000, stats.calls, stats.instructions, g_mod.QVMFunctionName(stats.func));
+    }
+
+    std::string path = fmt::format("{}/qvm_prof.folded", gameinfo.qmm_dir);
+    FILE* fp = fopen(path.c_str(), "w");
+    if (!fp) {
+        CONSOLE_PRINTF("(QMM) Unable to write QVM call stacks to \"{}\"\n", path);
+        return;
+    }
+    for (size_t i = 1; i < prof->numnodes; i++) {
+        const qvm_prof_node& node = prof->nodes[i];
+        if (!node.time)
+            continue;
+        // build the call stack by walking up to the root
+        std::string stack = g_mod.QVMFunctionName(node.func);
+        for (int parent = node.parent; parent > 0; parent = prof->nodes[parent].parent)
+            stack = g_mod.QVMFunctionName(prof->nodes[parent].func) + ";" + stack;
+        fmt::print(fp, "{} {}\n", stack, node.time);
+    }
+    fclose(fp);
+    CONSOLE_PRINTF("(QMM) QVM call stacks written to \"{}\"\n", path);
+}
+
+
+// Name of a routed message for the routing statistics tables
+static std::string StatsMsgName(bool is_syscall, intptr_t cmd) {
+    if (is_syscall)
+        return fmt::format("syscall {}({})", gameinfo.game->EngMsgName(cmd), cmd);
+    return fmt::format("vmMain {}({})", gameinfo.game->ModMsgName(cmd), cmd);
+}
+
+
+// Print the routed messages with the most total time, with the time split into plugin pre-hooks, the real call, and
+// plugin post-hooks. If plid is given, print that plugin's hook calls (from table) instead
+static void StatsDump(size_t count, const StatsTable& table, plugin_id plid) {
+    struct MsgStats {
+        bool is_syscall = false;
+        intptr_t cmd = 0;
+        uint64_t time = 0;
+        const StatsEntry* entry = nullptr;
+    };
+    std::vector<MsgStats> msgs;
+    uint64_t totaltime = 0;
+    auto add = [&msgs, &totaltime](bool is_syscall, intptr_t cmd, const StatsEntry& entry) {
+        MsgStats stats;
+        stats.is_syscall = is_syscall;
+        stats.cmd = cmd;
+        stats.entry = &entry;
+        uint64_t calls = 0;
+        for (const StatsCounter& counter : entry.phases) {
+            stats.time += counter.time;
+            calls += counter.calls;
+        }
+        // the arrays have entries for messages that were never routed
+        if (!calls)
+            return;
+        totaltime += stats.time;
+        msgs.push_back(stats);
+    };
+    for (int is_syscall = 0; is_syscall < 2; is_syscall++) {
+        for (size_t cmd = 0; cmd < table.cmds[is_syscall].size(); cmd++)
+            add(is_syscall, (intptr_t)cmd, table.cmds[is_syscall][cmd]);
+        for (auto& [cmd, entry] : table.othercmds[is_syscall])
+            add(is_syscall, cmd, entry);
+    }
+    if (msgs.empty()) {
+        CONSOLE_PRINTF("(QMM) No routing statistics{}, use \"qmm stats start\" first\n", plid ? " for this plugin" : "");
+        return;
+    }
+    std::sort(msgs.begin(), msgs.end(), [](const MsgStats& a, const MsgStats& b) { return a.time > b.time; });
+
+    const char* state = g_stats_active ? "" : " (stopped)";
+    if (plid) {
+        CONSOLE_PRINTF("(QMM) Routing statistics for \"{}\" ({} messages, {} total usec){}\n", plid->name, msgs.size(), totaltime / 1000, state);
+        CONSOLE_PRINT ("(QMM)  time%  pre calls   pre usec  post calls  post usec max hook usec  override supercede message\n");
+        CONSOLE_PRINT ("(QMM) ------ ---------- ---------- ---------- ---------- ------------- --------- --------- -------\n");
+    }
+    else {
+        CONSOLE_PRINTF("(QMM) Routing statistics ({} messages, {} total usec){}\n", msgs.size(), totaltime / 1000, state);
+        CONSOLE_PRINT ("(QMM)  time%      calls   pre usec  real usec  post usec   max usec  override supercede message\n");
+        CONSOLE_PRINT ("(QMM) ------ ---------- ---------- ---------- ---------- ---------- --------- --------- -------\n");
+    }
+    for (size_t i = 0; i < msgs.size() && i < count; i++) {
+        const MsgStats& stats = msgs[i];
+        const StatsCounter& pre = stats.entry->phases[STATS_PRE];
+        const StatsCounter& real = stats.entry->phases[STATS_REAL];
+        const StatsCounter& post = stats.entry->phases[STATS_POST];
+        double percent = totaltime ? 100.0 * (double)stats.time / (double)totaltime : 0.0;
+        // a plugin's pre and post hooks are timed separately, so its max is the longest single hook call. the totals
+        // keep the longest whole routed call
+        if (plid)
+            CONSOLE_PRINTF("(QMM) {:>6.2f} {:>10} {:>10} {:>10} {:>10} {:>13} {:>9} {:>9} {}\n", percent, pre.calls, pre.time / 1000, post.calls, post.time / 1000, std::max(pre.maxtime, post.maxtime) / 1000, pre.overrides + post.overrides, pre.supercedes + post.supercedes, StatsMsgName(stats.is_syscall, stats.cmd));
+        else
+            CONSOLE_PRINTF("(QMM) {:>6.2f} {:>10} {:>10} {:>10} {:>10} {:>10} {:>9} {:>9} {}\n", percent, pre.calls, pre.time / 1000, real.time / 1000, post.time / 1000, stats.entry->maxtime / 1000, pre.overrides, pre.supercedes, StatsMsgName(stats.is_syscall, stats.cmd));
+    }
+}
+
+
 static void HandleQMMCommand(intptr_t arg_start) {
-    char arg1[10] = "", arg2[10] = "";
+    char arg1[10] = "", arg2[10] = "", arg3[10] = "";
 
     int argc = (int)ENG_SYSCALL(QMM_ENG_MSG(QMM_G_ARGC));
     ArgV(arg_start + 1, arg1, sizeof(arg1));
     if (argc > arg_start + 2)
         ArgV(arg_start + 2, arg2, sizeof(arg2));
+    if (argc > arg_start + 3)
+        ArgV(arg_start + 3, arg3, sizeof(arg3));
 
     if (str_striequal("status", arg1) || str_striequal("info", arg1)) {
         CONSOLE_PRINT ("(QMM) QMM v" QMM_VERSION " (" QMM_OS " " QMM_ARCH ")\n");
@@ -386,6 +553,8 @@ static void HandleQMMCommand(intptr_t arg_start) {
             CONSOLE_PRINT ("(QMM) QVM mod information\n");
             CONSOLE_PRINT ("(QMM) -------------------\n");
             CONSOLE_PRINTF("(QMM) QVM magic number   : {:x} ({})\n", g_mod.vm.magic, g_mod.vm.magic == QVM_MAGIC ? "QVM_MAGIC" : "QVM_MAGIC_VER2");
+            if (g_mod.vm.jumptargets)
+                CONSOLE_PRINTF("(QMM) QVM jump targets   : {} (checked)\n", g_mod.vm.numjumptargets);
             CONSOLE_PRINTF("(QMM) QVM file size      : {}\n", g_mod.vm.filesize);
             CONSOLE_PRINTF("(QMM) QVM memory base    : {}\n", fmt::ptr(g_mod.vm.memory));
             CONSOLE_PRINTF("(QMM) QVM memory size    : {}\n", g_mod.vm.memorysize);
@@ -393,9 +562,32 @@ static void HandleQMMCommand(intptr_t arg_start) {
             CONSOLE_PRINTF("(QMM) QVM codeseg size   : {}\n", g_mod.vm.codeseglen);
             CONSOLE_PRINTF("(QMM) QVM dataseg size   : {}\n", g_mod.vm.dataseglen);
             CONSOLE_PRINTF("(QMM) QVM stack size     : {}\n", g_mod.vm.stacksize);
+            if (g_mod.vm.stackanalyzed)
+                CONSOLE_PRINTF("(QMM) QVM stack needed   : {}{}\n", g_mod.vm.stackneeded, g_mod.vm.stackrecursive ? " (not counting recursive calls)" : g_mod.vm.stackindirectcycle ? " (not counting possible recursion through function pointers)" : "");
+            else
+                CONSOLE_PRINT ("(QMM) QVM stack needed   : unknown (analysis did not finish)\n");
             CONSOLE_PRINTF("(QMM) QVM hunk size      : {}\n", g_mod.vm.hunksize);
-            CONSOLE_PRINTF("(QMM) QVM hunk usage     : {}\n", g_mod.vm.hunkhigh - g_mod.vm.hunkptr);
-            CONSOLE_PRINTF("(QMM) QVM data validation: {}\n", g_mod.vm.verify_data ? "on" : "off");
+            qvm_hunkstats hunkstats;
+            qvm_hunk_stats(&g_mod.vm, &hunkstats);
+            CONSOLE_PRINTF("(QMM) QVM hunk usage     : {} live, {} peak, {} fragmented ({} allocations)\n", hunkstats.live, hunkstats.peak, hunkstats.fragmented, hunkstats.allocs);
+            CONSOLE_PRINTF("(QMM) QVM code cache     : {}\n", g_mod.vm.cachemap ? "on (loaded from cache file)" : cfg_get_bool(g_cfg, "qvmcache", true) ? "on (decoded from QVM file)" : "off");
+            if (g_mod.vm.allocator->flags & QVM_ALLOC_HUGEPAGE)
+                CONSOLE_PRINTF("(QMM) QVM huge pages     : on ({} of {} bytes in huge pages)\n", qvm_hugepage_bytes(&g_mod.vm), g_mod.vm.memorysize);
+            else
+                CONSOLE_PRINTF("(QMM) QVM huge pages     : {}\n", cfg_get_bool(g_cfg, "qvmhugepages", false) && !(g_mod.vm.allocator->flags & QVM_ALLOC_GUARDED) ? "off (not supported)" : "off");
+            if (g_mod.vm.trace)
+                CONSOLE_PRINTF("(QMM) QVM flight recorder: on ({} entries, {} events recorded)\n", g_mod.vm.trace->mask + 1, g_mod.vm.trace->count);
+            else
+                CONSOLE_PRINTF("(QMM) QVM flight recorder: off\n");
+            CONSOLE_PRINTF("(QMM) QVM data validation: {}\n", g_mod.vm.allocator->flags & QVM_ALLOC_GUARDED ? "on (guard pages)" : g_mod.vm.verify_data ? "on" : "off");
+            if (g_mod.vm.jit)
+                CONSOLE_PRINTF("(QMM) QVM JIT            : on ({} bytes native code)\n", qvm_jit_codesize(&g_mod.vm));
+            else
+                CONSOLE_PRINTF("(QMM) QVM JIT            : {}\n", cfg_get_bool(g_cfg, "qvmjit", false) && !g_mod.vm.aot ? "off (compilation failed, using interpreter)" : "off");
+            if (g_mod.vm.aot)
+                CONSOLE_PRINTF("(QMM) QVM native module  : on ({})\n", qvm_aot_path(&g_mod.vm));
+            else
+                CONSOLE_PRINTF("(QMM) QVM native module  : {}\n", cfg_get_bool(g_cfg, "qvmaot", false) ? "off (translation failed)" : "off");
         }
     }
     else if (str_striequal("list", arg1)) {
@@ -438,6 +630,59 @@ static void HandleQMMCommand(intptr_t arg_start) {
         log_set_severity(severity);
         CONSOLE_PRINTF("(QMM) Log level set to {}\n", log_name_from_severity(severity));
     }
+    else if (str_striequal("qvmprof", arg1)) {
+        if (!g_mod.vm.memory) {
+            CONSOLE_PRINT("(QMM) The loaded mod is not a QVM\n");
+            return;
+        }
+        if (str_striequal("start", arg2)) {
+            if (qvm_prof_start(&g_mod.vm))
+                CONSOLE_PRINT("(QMM) QVM profiler started\n");
+            else
+                CONSOLE_PRINT("(QMM) Unable to start QVM profiler\n");
+        }
+        else if (str_striequal("stop", arg2)) {
+            qvm_prof_stop(&g_mod.vm);
+            CONSOLE_PRINT("(QMM) QVM profiler stopped\n");
+        }
+        else if (str_striequal("dump", arg2)) {
+            int count = argc > arg_start + 3 ? atoi(arg3) : 20;
+            QVMProfDump(count > 0 ? (size_t)count : 20);
+        }
+        else {
+            CONSOLE_PRINT("(QMM) qmm qvmprof <start|stop|dump> [count] - profiles QVM mod functions, dump shows the top count (default 20)\n");
+        }
+    }
+    else if (str_striequal("stats", arg1)) {
+        if (str_striequal("start", arg2)) {
+            g_stats_active = true;
+            CONSOLE_PRINT("(QMM) Routing statistics started\n");
+        }
+        else if (str_striequal("stop", arg2)) {
+            g_stats_active = false;
+            CONSOLE_PRINT("(QMM) Routing statistics stopped\n");
+        }
+        else if (str_striequal("reset", arg2)) {
+            stats_clear(g_stats);
+            for (Plugin& p : g_plugins)
+                stats_clear(p.stats);
+            CONSOLE_PRINT("(QMM) Routing statistics reset\n");
+        }
+        else if (str_striequal("plugin", arg2)) {
+            size_t pid = (size_t)atoi(arg3);
+            if (pid > 0 && pid <= g_plugins.size())
+                StatsDump(SIZE_MAX, g_plugins[pid - 1].stats, g_plugins[pid - 1].plugininfo);
+            else
+                CONSOLE_PRINTF("(QMM) Unable to find plugin #{}\n", arg3);
+        }
+        else if (argc == arg_start + 2 || str_striequal("top", arg2)) {
+            int count = argc > arg_start + 3 ? atoi(arg3) : 20;
+            StatsDump(count > 0 ? (size_t)count : 20, g_stats, nullptr);
+        }
+        else {
+            CONSOLE_PRINT("(QMM) qmm stats [start|stop|reset|top [count]|plugin <id>] - times routed messages, top shows the top count (default 20)\n");
+        }
+    }
     else if (str_striequal("reload", arg1)) {
         g_cfg = cfg_load(gameinfo.cfg_path);
         CONSOLE_PRINT("(QMM) Configuration file reloaded!\n");
@@ -468,6 +713,8 @@ static void HandleQMMCommand(intptr_t arg_start) {
         CONSOLE_PRINT("(QMM) qmm list - displays information about loaded QMM plugins\n");
         CONSOLE_PRINT("(QMM) qmm plugin <id> - outputs info on plugin with id\n");
         CONSOLE_PRINT("(QMM) qmm loglevel <level> - changes QMM log level: TRACE, DEBUG, INFO, NOTICE, WARNING, ERROR, FATAL\n");
+        CONSOLE_PRINT("(QMM) qmm qvmprof <start|stop|dump> [count] - profiles QVM mod functions\n");
+        CONSOLE_PRINT("(QMM) qmm stats [start|stop|reset|top [count]|plugin <id>] - times routed messages per message and plugin\n");
         CONSOLE_PRINT("(QMM) qmm reload - reloads the QMM configuration file\n");
         CONSOLE_PRINT("(QMM) qmm credits - QMM credits\n");
     }
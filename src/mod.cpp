@@ -10,8 +10,10 @@ Created By:
 */
 
 #include <cstdint>
+#include <cstring>
 #include <vector>
 #include <string>
+#include <sstream>
 #include "log.hpp"
 #include "qmmapi.h"
 #include "gameapi.hpp"
@@ -20,6 +22,8 @@ Created By:
 #include "main.hpp"         // qmm_syscall
 #include "mod.hpp"
 #include "qvm.h"
+#include "qvm_jit.h"
+#include "qvm_aot.h"
 #include "plugin.hpp"
 #include "util.hpp"
 
@@ -52,6 +56,12 @@ Mod& Mod::operator=(Mod&& other) noexcept {
     std::swap(this->vm, other.vm);
     // swap since a Mod "owns" the dll handle
     std::swap(this->dll, other.dll);
+    std::swap(this->qvmsymbols, other.qvmsymbols);
+    // swap since snapshots belong to the QVM
+    std::swap(this->qvmsnapshots, other.qvmsnapshots);
+    std::swap(this->nextqvmsnapshot, other.nextqvmsnapshot);
+    this->qvmsyscalls = other.qvmsyscalls;
+    this->numqvmsyscalls = other.numqvmsyscalls;
     this->path = other.path;
     this->api = other.api;
 
@@ -108,12 +118,86 @@ void Mod::Unload() {
         gameinfo.game->ModUnload();
     dll_close(this->dll);
     this->dll = nullptr;
+    for (auto& snapshot : this->qvmsnapshots)
+        qvm_snapshot_free(&snapshot.second);
+    this->qvmsnapshots.clear();
     qvm_unload(&this->vm);
     qvm_init(&this->vm);
+    this->qvmsymbols.clear();
+    this->qvmsyscalls = nullptr;
+    this->numqvmsyscalls = 0;
     this->api = QMM_API_ERROR;
 }
 
 
+std::string Mod::QVMFunctionName(int instruction) {
+    auto it = this->qvmsymbols.find(instruction);
+    if (it != this->qvmsymbols.end())
+        return it->second;
+    return "func_" + std::to_string(instruction);
+}
+
+
+void Mod::UpdateQVMIntrinsics() {
+    if (this->api != QMM_API_QVM || !this->vm.memory)
+        return;
+
+    // get intrinsics setting from config
+    bool use_intrinsics = cfg_get_bool(g_cfg, "qvmintrinsics", true);
+
+    int count = 0;
+    for (int cmd = 0; cmd < this->numqvmsyscalls; cmd++) {
+        const QVMSyscallDesc& desc = this->qvmsyscalls[cmd];
+        if (!desc.valid || desc.intrinsic == QVM_INTRINSIC_NONE)
+            continue;
+        // a hooked syscall must go through QMM so plugins see it
+        bool native = use_intrinsics && !plugins_hook_syscall(cmd);
+        if (qvm_set_intrinsic(&this->vm, cmd, native ? desc.intrinsic : QVM_INTRINSIC_NONE) && native)
+            count++;
+    }
+
+    QMMLOG(QMM_LOG_DEBUG, "QMM") << "Mod::UpdateQVMIntrinsics(): " << count << " syscall(s) handled natively by the QVM\n";
+}
+
+
+int Mod::QVMSnapshot() {
+    if (this->api != QMM_API_QVM || !this->vm.memory)
+        return 0;
+
+    qvm_snap snap;
+    if (!qvm_snapshot(&this->vm, &snap))
+        return 0;
+
+    int id = this->nextqvmsnapshot++;
+    this->qvmsnapshots[id] = snap;
+
+    QMMLOG(QMM_LOG_DEBUG, "QMM") << "Mod::QVMSnapshot(): Took snapshot " << id << " (" << (snap.memory ? "copy" : "copy-on-write") << ")\n";
+
+    return id;
+}
+
+
+bool Mod::QVMRestore(int id) {
+    auto it = this->qvmsnapshots.find(id);
+    if (it == this->qvmsnapshots.end()) {
+        QMMLOG(QMM_LOG_ERROR, "QMM") << "Mod::QVMRestore(" << id << "): Unknown snapshot\n";
+        return false;
+    }
+
+    return qvm_restore(&this->vm, &it->second);
+}
+
+
+void Mod::QVMSnapshotFree(int id) {
+    auto it = this->qvmsnapshots.find(id);
+    if (it == this->qvmsnapshots.end())
+        return;
+
+    qvm_snapshot_free(&it->second);
+    this->qvmsnapshots.erase(it);
+}
+
+
 intptr_t Mod::QVM_vmMain(intptr_t cmd, ...) {
     // if qvm isn't loaded, we need to error
     if (!g_mod.vm.memory) {
@@ -125,11 +209,12 @@ intptr_t Mod::QVM_vmMain(intptr_t cmd, ...) {
         return 0;
     }
 
-    QMM_GET_VMMAIN_ARGS();
+    // only pull the args this message takes (QVMs can't take more than QVM_MAX_VMMAIN_ARGS)
+    QMM_GET_VMMAIN_ARGS_N(util_min(gameinfo.game->VMMainArgc(cmd), QVM_MAX_VMMAIN_ARGS));
 
     // generate new 32-bit int array from the intptr_t args, and also include cmd at the front
     int qvmargs[QVM_MAX_VMMAIN_ARGS + 1] = { (int)cmd };
-    for (int i = 0; i < QVM_MAX_VMMAIN_ARGS; i++) {
+    for (int i = 0; i < argc; i++) {
         qvmargs[i + 1] = (int)args[i];
     }
 
@@ -151,19 +236,57 @@ intptr_t Mod::QVM_vmMain(intptr_t cmd, ...) {
 
 int Mod::QVM_syscall(uint8_t* membase, int cmd, int* args) {
     // check for plugin qvm function registration
-    if (cmd >= QMM_QVM_FUNC_STARTING_ID && g_registered_qvm_funcs.count(cmd)) {
-        Plugin* p = g_registered_qvm_funcs[cmd];
+    if (cmd >= QMM_QVM_FUNC_STARTING_ID) {
+        auto it = g_registered_qvm_funcs.find(cmd);
+        if (it != g_registered_qvm_funcs.end()) {
+            Plugin* p = it->second;
 
-        // make sure plugin has the handler function (shouldn't have been registered, but check anyway)
-        if (!p->QMM_QVMHandler)
-            return 0;
+            // make sure plugin has the handler function (shouldn't have been registered, but check anyway)
+            if (!p->QMM_QVMHandler)
+                return 0;
 
-        // pass the negative-1 form since that's the number the plugin probably stored and expects
-        return p->QMM_QVMHandler(-cmd - 1, args);
+            // pass the negative-1 form since that's the number the plugin probably stored and expects
+            return p->QMM_QVMHandler(-cmd - 1, args);
+        }
     }
 
-    // call the game-specific QVM syscall handler
-    return gameinfo.game->QVMSyscall(membase, cmd, args);
+    // look up the game's argument descriptor for this syscall
+    if (cmd < 0 || cmd >= g_mod.numqvmsyscalls || !g_mod.qvmsyscalls[cmd].valid) {
+        QMMLOG(QMM_LOG_TRACE, "QMM") << "Mod::QVM_syscall(" << gameinfo.game->EngMsgName(cmd) << "(" << cmd << ")): Unsupported syscall\n";
+        return 0;
+    }
+    const QVMSyscallDesc& desc = g_mod.qvmsyscalls[cmd];
+
+    // convert pointer args: if not NULL, add the QVM data segment base address
+    intptr_t engargs[QMM_MAX_SYSCALL_ARGS] = {};
+    for (int i = 0; i < desc.numargs; i++) {
+        if ((desc.ptrargs & (1u << i)) && args[i])
+            engargs[i] = (intptr_t)(membase + args[i]);
+        else
+            engargs[i] = (intptr_t)args[i];
+    }
+
+    // syscalls whose args aren't known are called like ( void ) by QVMs, but still pass every (zeroed) arg on
+    intptr_t ret = qmm_syscall_args(cmd, engargs, desc.exactargs ? desc.numargs : QMM_MAX_SYSCALL_ARGS);
+
+    switch (desc.ret) {
+    case QVM_RET_ARG0:
+        // the engine returns the real dest pointer, so just return the QVM's own pointer
+        return args[0];
+    case QVM_RET_HUNK_STRING:
+        // the engine returns a pointer to a string in engine memory, so copy it into the QVM hunk
+        if (!ret)
+            return 0;
+        return qvm_hunk_alloc(&g_mod.vm, strlen((char*)ret) + 1, (void*)ret);
+    case QVM_RET_HUNK_ALLOC:
+        // the engine returns a pointer to a block in engine memory, so allocate the block in the QVM hunk instead
+        if (!ret)
+            return 0;
+        return qvm_hunk_alloc(&g_mod.vm, args[0] ? args[0] : 1, nullptr);
+    case QVM_RET_VALUE:
+    default:
+        return (int)ret;
+    }
 }
 
 
@@ -171,6 +294,13 @@ bool Mod::LoadQVM(std::string file) {
     EngineFileRead f;
     bool verify_data;
     size_t hunk_size;
+    size_t stack_size;
+    bool use_jit;
+    bool use_guard;
+    bool use_aot;
+    bool use_cache;
+    bool use_hugepages;
+    qvm_alloc* allocator = nullptr;
 
     // load file using engine functions to read into pk3s if necessary
     uint8_t* filedata = f.Open(file);
@@ -183,13 +313,97 @@ bool Mod::LoadQVM(std::string file) {
     verify_data = cfg_get_bool(g_cfg, "qvmverifydata", true);
     // get hunk size setting from config
     hunk_size = (size_t)cfg_get_int(g_cfg, "qvmhunksize", 0);
+    // get stack size setting from config (-1 to size it from call graph analysis)
+    int stack_cfg = cfg_get_int(g_cfg, "qvmstacksize", 0);
+    stack_size = stack_cfg < 0 ? QVM_STACK_AUTO : (size_t)stack_cfg;
+    // get JIT setting from config
+    use_jit = cfg_get_bool(g_cfg, "qvmjit", false);
+    // get guard page setting from config
+    use_guard = cfg_get_bool(g_cfg, "qvmguard", false);
+    // get native translation setting from config
+    use_aot = cfg_get_bool(g_cfg, "qvmaot", false);
+    // get decoded code cache setting from config
+    use_cache = cfg_get_bool(g_cfg, "qvmcache", true);
+    // get huge page setting from config
+    use_hugepages = cfg_get_bool(g_cfg, "qvmhugepages", false);
+
+    // decoded code and native modules are cached here
+    std::string cachedir = gameinfo.qmm_dir + "/qvmcache";
+    if (use_cache || use_aot)
+        path_mkdir(cachedir);
+
+#ifdef QVM_SNAPSHOT_COW
+    // use mmap for VM memory so snapshots can be restored copy-on-write
+    allocator = &qvm_allocator_mapped;
+#endif
+
+    // back VM memory with huge pages to cut TLB misses (snapshots are then restored by copying)
+    if (use_hugepages) {
+#ifdef QVM_HUGEPAGE_SUPPORTED
+        allocator = &qvm_allocator_hugepage;
+#else
+        QMMLOG(QMM_LOG_WARNING, "QMM") << "Mod::LoadQVM(\"" << path_basename(file) << "\"): QVM huge pages are not supported on this platform\n";
+#endif
+    }
+
+    // catch out-of-bounds data accesses with guard pages instead of masking
+    if (use_guard) {
+#ifdef QVM_GUARDED_SUPPORTED
+        allocator = &qvm_allocator_guarded;
+#else
+        QMMLOG(QMM_LOG_WARNING, "QMM") << "Mod::LoadQVM(\"" << path_basename(file) << "\"): QVM guard pages are not supported on this platform\n";
+#endif
+    }
+
+    // get the game's QVM syscall argument descriptors
+    this->qvmsyscalls = gameinfo.game->QVMSyscalls(&this->numqvmsyscalls);
 
     // attempt to load mod
-    if (!qvm_load(&this->vm, filedata, f.Size(), Mod::QVM_syscall, verify_data, hunk_size, nullptr)) {
+    if (!qvm_load_ex(&this->vm, filedata, f.Size(), Mod::QVM_syscall, verify_data, hunk_size, stack_size, allocator, use_cache ? cachedir.c_str() : nullptr)) {
         QMMLOG(QMM_LOG_ERROR, "QMM") << "Mod::LoadQVM(\"" << file << "\"): QVM load failed\n";
         return false;
     }
 
+    // write crash dumps next to the QMM DLL instead of whatever the engine's current directory is
+    qvm_set_dumpdir(&this->vm, gameinfo.qmm_dir.c_str());
+
+    // record recent calls, returns, jumps, and syscalls for crash dumps, if enabled
+    int trace_size = cfg_get_int(g_cfg, "qvmflightrecorder", 256);
+    if (trace_size > 0 && !qvm_trace_start(&this->vm, (size_t)trace_size))
+        QMMLOG(QMM_LOG_WARNING, "QMM") << "Mod::LoadQVM(\"" << path_basename(file) << "\"): QVM flight recorder could not be started\n";
+
+    // load function names from the q3asm .map file next to the QVM, if there is one (used by "qmm qvmprof")
+    std::string mapfile = file.substr(0, file.size() - path_baseext(file).size()) + ".map";
+    EngineFileRead fmap;
+    uint8_t* mapdata = fmap.Open(mapfile);
+    if (mapdata) {
+        // each line is "<segment> <hex value> <name>", and the value of a code segment (0) symbol is an instruction index
+        std::istringstream lines(std::string((const char*)mapdata, (size_t)fmap.Size()));
+        std::string line;
+        while (std::getline(lines, line)) {
+            std::istringstream fields(line);
+            int segment;
+            unsigned int value;
+            std::string name;
+            if (fields >> segment >> std::hex >> value >> name && segment == 0)
+                this->qvmsymbols[(int)value] = name;
+        }
+        QMMLOG(QMM_LOG_DEBUG, "QMM") << "Mod::LoadQVM(\"" << path_basename(file) << "\"): Loaded " << this->qvmsymbols.size() << " function names from \"" << path_basename(mapfile) << "\"\n";
+    }
+
+    // translate to a native module (or load a cached one) if enabled. if this fails, the VM falls back to the JIT or
+    // interpreter
+    if (use_aot) {
+        std::string compiler = cfg_get_string(g_cfg, "qvmaotcc", "cc");
+        if (!qvm_aot_load(&this->vm, filedata, f.Size(), cachedir.c_str(), compiler.c_str()))
+            QMMLOG(QMM_LOG_WARNING, "QMM") << "Mod::LoadQVM(\"" << path_basename(file) << "\"): QVM native translation failed, using " << (use_jit ? "JIT" : "interpreter") << "\n";
+    }
+
+    // compile to native code if enabled (and not already translated). if this fails, the VM just keeps using the
+    // interpreter
+    if (use_jit && !this->vm.aot && !qvm_jit_compile(&this->vm))
+        QMMLOG(QMM_LOG_WARNING, "QMM") << "Mod::LoadQVM(\"" << path_basename(file) << "\"): QVM JIT compilation failed, using interpreter\n";
+
     // pass the qvm vmMain function pointer to the game-specific mod load handler
     if (!gameinfo.game->ModLoad((void*)Mod::QVM_vmMain, QMM_API_QVM)) {
         QMMLOG(QMM_LOG_ERROR, "QMM") << "Mod::LoadQVM(\"" << path_basename(file) << "\"): Mod load failed?\n";
@@ -198,7 +412,7 @@ bool Mod::LoadQVM(std::string file) {
         return false;
     }
 
-    QMMLOG(QMM_LOG_DEBUG, "QMM") << "Mod::LoadQVM(\"" << path_basename(file) << "\"): QVM loaded successfully with verify_data " << (this->vm.verify_data ? "on" : "off") << " and hunk size " << this->vm.hunksize << "\n";
+    QMMLOG(QMM_LOG_DEBUG, "QMM") << "Mod::LoadQVM(\"" << path_basename(file) << "\"): QVM loaded successfully with verify_data " << (this->vm.verify_data ? "on" : "off") << ", guard pages " << (this->vm.allocator->flags & QVM_ALLOC_GUARDED ? "on" : "off") << ", hunk size " << this->vm.hunksize << ", decoded code cache " << (this->vm.cachemap ? "hit" : use_cache ? "miss" : "off") << ", native translation " << (this->vm.aot ? "on" : "off") << ", and JIT " << (this->vm.jit ? "on" : "off") << "\n";
 
     this->api = QMM_API_QVM;
     this->path = file;
@@ -10,6 +10,7 @@ Created By:
 */
 
 #define _CRT_SECURE_NO_WARNINGS
+#include <algorithm>
 #include <cstdarg>
 #include <vector>
 #include <string>
@@ -52,6 +53,10 @@ static int s_plugin_helper_QVMExecFunc(plugin_id plid [[maybe_unused]], int func
 static const char* s_plugin_helper_Argv2(plugin_id plid [[maybe_unused]], intptr_t argn);
 static const char* s_plugin_helper_GetConfigString2(plugin_id plid [[maybe_unused]], intptr_t index);
 static const char* s_plugin_helper_ModDir(plugin_id plid [[maybe_unused]]);
+static int s_plugin_helper_QVMSnapshot(plugin_id plid [[maybe_unused]]);
+static int s_plugin_helper_QVMRestore(plugin_id plid [[maybe_unused]], int snapid);
+static void s_plugin_helper_QVMSnapshotFree(plugin_id plid [[maybe_unused]], int snapid);
+static int s_plugin_helper_Subscribe(plugin_id plid, int is_syscall, intptr_t cmd, int hooks);
 
 // Struct of plugin helper functions
 static plugin_funcs s_pluginfuncs = {
@@ -78,6 +83,10 @@ static plugin_funcs s_pluginfuncs = {
     s_plugin_helper_Argv2,
     s_plugin_helper_GetConfigString2,
     s_plugin_helper_ModDir,
+    s_plugin_helper_QVMSnapshot,
+    s_plugin_helper_QVMRestore,
+    s_plugin_helper_QVMSnapshotFree,
+    s_plugin_helper_Subscribe,
 };
 
 // This holds global variables that are available to plugins via helper functions.
@@ -91,6 +100,25 @@ plugin_globals g_plugin_globals = {
 // List of QMM plugins
 std::vector<Plugin> g_plugins;
 
+// Plugins to call for each message in one direction (syscall or vmMain), built from plugin subscriptions
+struct plugin_hook_table {
+    std::vector<std::vector<Plugin*>> pre;      // Plugins with a pre-hook for each message
+    std::vector<std::vector<Plugin*>> post;     // Plugins with a post-hook for each message
+    std::vector<Plugin*> unsubscribed;          // Plugins to call for messages past the end of the table
+    std::vector<std::vector<Plugin*>> batch;    // Plugins buffering each message for QMM_vmMain_Batch (vmMain only)
+    std::vector<Plugin*> batching;              // Plugins buffering any message for QMM_vmMain_Batch (vmMain only)
+};
+
+// Hook tables for vmMain ([0]) and syscall ([1])
+static plugin_hook_table s_hook_tables[2];
+// Set when a plugin changes its subscriptions
+static bool s_hooks_changed = true;
+// g_plugins contents when the hook tables were built (adding or removing plugins moves them)
+static const Plugin* s_hooks_plugins = nullptr;
+static size_t s_hooks_numplugins = 0;
+// Plugin currently in QMM_Attach (not in g_plugins yet)
+static Plugin* s_attaching_plugin = nullptr;
+
 // This holds pseudo-syscall IDs. They are registered to a given plugin, and when the QVM interpreter executes the
 // syscall ID, the plugin's QMM_QVMHandler function is called.
 std::map<int, Plugin*> g_registered_qvm_funcs;
@@ -109,21 +137,22 @@ static plugin_vars s_pluginvars = {
 
 // Wrapper syscall function to pass to plugins
 static intptr_t s_plugin_game_syscall(intptr_t cmd, ...) {
-    QMM_GET_SYSCALL_ARGS();
-    return gameinfo.game->syscall(cmd, QMM_PUT_SYSCALL_ARGS());
+    QMM_GET_SYSCALL_ARGS_N(gameinfo.game->SyscallArgc(cmd));
+    return gameinfo.game->syscall_args(cmd, args, argc);
 }
 
 
 // Wrapper vmMain function to pass to plugins
 static intptr_t s_plugin_game_vmMain(intptr_t cmd, ...) {
-    QMM_GET_VMMAIN_ARGS();
-    return gameinfo.game->vmMain(cmd, QMM_PUT_VMMAIN_ARGS());
+    QMM_GET_VMMAIN_ARGS_N(gameinfo.game->VMMainArgc(cmd));
+    return gameinfo.game->vmMain_args(cmd, args, argc);
 }
 
 
 Plugin::Plugin() : dll(nullptr), QMM_Query(nullptr), QMM_Attach(nullptr), QMM_Detach(nullptr),
     QMM_vmMain(nullptr), QMM_vmMain_Post(nullptr), QMM_syscall(nullptr), QMM_syscall_Post(nullptr),
-    QMM_PluginMessage(nullptr), QMM_QVMHandler(nullptr), plugininfo(nullptr)
+    QMM_PluginMessage(nullptr), QMM_QVMHandler(nullptr), QMM_vmMain_Batch(nullptr), plugininfo(nullptr),
+    syscall_subscribed(false), vmmain_subscribed(false)
 {
 }
 
@@ -158,7 +187,14 @@ Plugin& Plugin::operator=(Plugin&& other) noexcept {
     this->QMM_syscall_Post = other.QMM_syscall_Post;
     this->QMM_PluginMessage = other.QMM_PluginMessage;
     this->QMM_QVMHandler = other.QMM_QVMHandler;
+    this->QMM_vmMain_Batch = other.QMM_vmMain_Batch;
     this->plugininfo = other.plugininfo;
+    this->syscall_hooks = other.syscall_hooks;
+    this->vmmain_hooks = other.vmmain_hooks;
+    this->syscall_subscribed = other.syscall_subscribed;
+    this->vmmain_subscribed = other.vmmain_subscribed;
+    this->batch_events = std::move(other.batch_events);
+    this->stats = std::move(other.stats);
 
     return *this;
 }
@@ -251,12 +287,19 @@ int Plugin::Load(std::string file) {
         return 0;
     }
 
+    // optional batched vmMain callback (needed before QMM_Attach so the plugin can subscribe with QMM_HOOK_BATCH)
+    this->QMM_vmMain_Batch = (Plugin::plugin_batch)dll_symbol(this->dll, "QMM_vmMain_Batch");
+
     // set some pluginvars only available at run-time (this will get repeated for every plugin, but that's ok)
     s_pluginvars.vmbase = (intptr_t)g_mod.vm.memory;
 
     // call QMM_Attach. if it fails (returns 0), destructor will call QMM_Detach and unload DLL
     // QMM_Attach(engine syscall, mod vmmain, pointer to plugin result int, table of plugin helper functions, table of plugin variables)
-    if (!(this->QMM_Attach(s_plugin_game_syscall, s_plugin_game_vmMain, &g_plugin_globals.plugin_result, &s_pluginfuncs, &s_pluginvars))) {
+    // the plugin can subscribe to messages from QMM_Attach, before it is added to g_plugins
+    s_attaching_plugin = this;
+    int attached = this->QMM_Attach(s_plugin_game_syscall, s_plugin_game_vmMain, &g_plugin_globals.plugin_result, &s_pluginfuncs, &s_pluginvars);
+    s_attaching_plugin = nullptr;
+    if (!attached) {
         QMMLOG(QMM_LOG_ERROR, "QMM") << "plugin_load(\"" << path_basename(file) << "\"): QMM_Attach() returned 0\n";
         // treat this failure specially. this is a valid plugin, but it decided on its own that it shouldn't be loaded
         return -1;
@@ -286,7 +329,14 @@ void Plugin::Unload() {
     this->QMM_syscall_Post = nullptr;
     this->QMM_PluginMessage = nullptr;
     this->QMM_QVMHandler = nullptr;
+    this->QMM_vmMain_Batch = nullptr;
     this->plugininfo = nullptr;
+    this->syscall_hooks.clear();
+    this->vmmain_hooks.clear();
+    this->syscall_subscribed = false;
+    this->vmmain_subscribed = false;
+    this->batch_events.clear();
+    stats_clear(this->stats);
 }
 
 
@@ -303,6 +353,155 @@ const char* Plugin::plugin_result_to_str(plugin_res res) {
 }
 
 
+// Check if a plugin buffers any vmMain message for QMM_vmMain_Batch
+static bool s_plugin_batching(const Plugin& p) {
+    if (!p.vmmain_subscribed || !p.QMM_vmMain_Batch)
+        return false;
+    for (uint8_t flags : p.vmmain_hooks) {
+        if (flags & QMM_HOOK_BATCH)
+            return true;
+    }
+    return false;
+}
+
+
+// Check if any loaded plugin would see a message in one direction (syscall or vmMain)
+static bool s_plugins_hook(bool is_syscall, intptr_t cmd) {
+    for (Plugin& p : g_plugins) {
+        // plugins that haven't subscribed to any messages get every message
+        if (!(is_syscall ? p.syscall_subscribed : p.vmmain_subscribed))
+            return true;
+        const std::vector<uint8_t>& hooks = is_syscall ? p.syscall_hooks : p.vmmain_hooks;
+        if (cmd >= 0 && (size_t)cmd < hooks.size() && hooks[(size_t)cmd])
+            return true;
+        // buffered messages are delivered at the end of GAME_RUN_FRAME
+        if (!is_syscall && cmd == GameInfo::msg_GAME_RUN_FRAME && s_plugin_batching(p))
+            return true;
+    }
+    return false;
+}
+
+
+bool plugins_hook_syscall(intptr_t cmd) {
+    return s_plugins_hook(true, cmd);
+}
+
+
+bool plugins_hook_vmmain(intptr_t cmd) {
+    return s_plugins_hook(false, cmd);
+}
+
+
+// Build the hook table for one direction (syscall or vmMain) from the loaded plugins' subscriptions
+static void s_plugins_build_hooks(plugin_hook_table& table, bool is_syscall) {
+    table = plugin_hook_table();
+
+    // the table only needs to cover the highest subscribed message
+    size_t numcmds = 0;
+    for (Plugin& p : g_plugins) {
+        const std::vector<uint8_t>& hooks = is_syscall ? p.syscall_hooks : p.vmmain_hooks;
+        numcmds = std::max(numcmds, hooks.size());
+    }
+    table.pre.resize(numcmds);
+    table.post.resize(numcmds);
+    if (!is_syscall)
+        table.batch.resize(numcmds);
+
+    // go through plugins in load order so hooks are still called in load order
+    for (Plugin& p : g_plugins) {
+        bool subscribed = is_syscall ? p.syscall_subscribed : p.vmmain_subscribed;
+        const std::vector<uint8_t>& hooks = is_syscall ? p.syscall_hooks : p.vmmain_hooks;
+        if (!subscribed)
+            table.unsubscribed.push_back(&p);
+        if (!is_syscall && s_plugin_batching(p))
+            table.batching.push_back(&p);
+        else if (!is_syscall)
+            p.batch_events.clear();
+        for (size_t cmd = 0; cmd < numcmds; cmd++) {
+            int flags = QMM_HOOK_PRE | QMM_HOOK_POST;
+            if (subscribed)
+                flags = cmd < hooks.size() ? hooks[cmd] : 0;
+            if (flags & QMM_HOOK_PRE)
+                table.pre[cmd].push_back(&p);
+            if (flags & QMM_HOOK_POST)
+                table.post[cmd].push_back(&p);
+            if (!is_syscall && (flags & QMM_HOOK_BATCH) && p.QMM_vmMain_Batch)
+                table.batch[cmd].push_back(&p);
+        }
+    }
+}
+
+
+void plugins_update_hooks() {
+    if (!s_hooks_changed && s_hooks_plugins == g_plugins.data() && s_hooks_numplugins == g_plugins.size())
+        return;
+
+    s_plugins_build_hooks(s_hook_tables[0], false);
+    s_plugins_build_hooks(s_hook_tables[1], true);
+    s_hooks_plugins = g_plugins.data();
+    s_hooks_numplugins = g_plugins.size();
+
+    // a newly subscribed message may currently be handled natively by the QVM or bypass QMM entirely
+    if (s_hooks_changed) {
+        g_mod.UpdateQVMIntrinsics();
+        gameinfo.UpdatePassthroughs();
+    }
+    s_hooks_changed = false;
+}
+
+
+const std::vector<Plugin*>& plugins_hooks(bool is_syscall, intptr_t cmd, bool post) {
+    const plugin_hook_table& table = s_hook_tables[is_syscall ? 1 : 0];
+    if (cmd < 0 || (size_t)cmd >= table.pre.size())
+        return table.unsubscribed;
+    return post ? table.post[(size_t)cmd] : table.pre[(size_t)cmd];
+}
+
+
+// Pass a plugin's buffered vmMain messages to its QMM_vmMain_Batch function
+static void s_plugin_batch_deliver(Plugin* p) {
+    if (p->batch_events.empty())
+        return;
+
+    QMMLOG(QMM_LOG_TRACE, "QMM") << "Plugin \"" << p->plugininfo->name << "\" QMM_vmMain_Batch(" << p->batch_events.size() << " events) called\n";
+
+    // swap out the buffer in case the plugin's calls cause more messages to be buffered
+    std::vector<plugin_batch_event> events;
+    events.swap(p->batch_events);
+    p->QMM_vmMain_Batch(events.data(), (intptr_t)events.size());
+    // keep the capacity for the next frame
+    events.clear();
+    if (p->batch_events.empty())
+        p->batch_events.swap(events);
+}
+
+
+void plugins_batch_add(intptr_t cmd, const intptr_t* args, int argc, intptr_t ret) {
+    const plugin_hook_table& table = s_hook_tables[0];
+    if (cmd < 0 || (size_t)cmd >= table.batch.size() || table.batch[(size_t)cmd].empty())
+        return;
+
+    plugin_batch_event event;
+    event.cmd = cmd;
+    for (int i = 0; i < QMM_BATCH_ARGS; i++)
+        event.args[i] = i < argc ? args[i] : 0;
+    event.ret = ret;
+
+    for (Plugin* p : table.batch[(size_t)cmd]) {
+        p->batch_events.push_back(event);
+        // don't let the buffer grow without limit if frames stop coming
+        if (p->batch_events.size() >= QMM_MAX_BATCH_EVENTS)
+            s_plugin_batch_deliver(p);
+    }
+}
+
+
+void plugins_batch_deliver() {
+    for (Plugin* p : s_hook_tables[0].batching)
+        s_plugin_batch_deliver(p);
+}
+
+
 /**
 * @brief Write to the QMM log.
 *
@@ -881,3 +1080,99 @@ static const char* s_plugin_helper_ModDir(plugin_id plid [[maybe_unused]]) {
 
     return ret;
 }
+
+
+/**
+* @brief Take a snapshot of the QVM mod's memory.
+*
+* @param plid Plugin ID of the calling plugin
+* @return Snapshot ID, or 0 if unsuccessful (mod is not a QVM or is running)
+*/
+static int s_plugin_helper_QVMSnapshot(plugin_id plid [[maybe_unused]]) {
+    int ret = g_mod.QVMSnapshot();
+
+    QMMLOG(QMM_LOG_TRACE, "QMM") << "Plugin \"" << ((plugin_info*)plid)->name << " called QVMSnapshot() = " << ret << "\n";
+
+    return ret;
+}
+
+
+/**
+* @brief Restore the QVM mod's memory from a snapshot.
+*
+* @param plid Plugin ID of the calling plugin
+* @param snapid Snapshot ID from QVMSnapshot
+* @return 1 if successful, 0 otherwise
+*/
+static int s_plugin_helper_QVMRestore(plugin_id plid [[maybe_unused]], int snapid) {
+    int ret = g_mod.QVMRestore(snapid) ? 1 : 0;
+
+    QMMLOG(QMM_LOG_TRACE, "QMM") << "Plugin \"" << ((plugin_info*)plid)->name << " called QVMRestore(" << snapid << ") = " << ret << "\n";
+
+    return ret;
+}
+
+
+/**
+* @brief Free a snapshot of the QVM mod's memory.
+*
+* @param plid Plugin ID of the calling plugin
+* @param snapid Snapshot ID from QVMSnapshot
+*/
+static void s_plugin_helper_QVMSnapshotFree(plugin_id plid [[maybe_unused]], int snapid) {
+    g_mod.QVMSnapshotFree(snapid);
+
+    QMMLOG(QMM_LOG_TRACE, "QMM") << "Plugin \"" << ((plugin_info*)plid)->name << " called QVMSnapshotFree(" << snapid << ")\n";
+}
+
+
+/**
+* @brief Set which hooks are called for a message. Once a plugin subscribes to any syscall (or vmMain) message, its
+* syscall (or vmMain) hooks are only called for messages it subscribed to. Changes take effect right away, or once the
+* outermost routed message finishes if called from inside a hook. Changes made in QMM_Attach take effect once the
+* plugin is loaded.
+*
+* @param plid Plugin ID of the calling plugin
+* @param is_syscall 1 for a syscall message, 0 for a vmMain message
+* @param cmd Message
+* @param hooks QMM_HOOK_* flags (0 to unsubscribe)
+* @return 1 if successful, 0 if the message or flags are invalid
+*/
+static int s_plugin_helper_Subscribe(plugin_id plid, int is_syscall, intptr_t cmd, int hooks) {
+    int ret = 0;
+
+    // find the calling plugin (which may still be in QMM_Attach)
+    Plugin* plugin = s_attaching_plugin && s_attaching_plugin->plugininfo == (plugin_info*)plid ? s_attaching_plugin : nullptr;
+    for (Plugin& p : g_plugins) {
+        if (p.plugininfo == (plugin_info*)plid) {
+            plugin = &p;
+            break;
+        }
+    }
+
+    // QMM_HOOK_BATCH is only for vmMain messages, and only if the plugin has a QMM_vmMain_Batch function
+    int valid_hooks = QMM_HOOK_PRE | QMM_HOOK_POST;
+    if (!is_syscall && plugin && plugin->QMM_vmMain_Batch)
+        valid_hooks |= QMM_HOOK_BATCH;
+
+    if (plugin && cmd >= 0 && cmd <= QMM_MAX_HOOK_CMD && !(hooks & ~valid_hooks)) {
+        std::vector<uint8_t>& flags = is_syscall ? plugin->syscall_hooks : plugin->vmmain_hooks;
+        if ((size_t)cmd >= flags.size())
+            flags.resize((size_t)cmd + 1, 0);
+        flags[(size_t)cmd] = (uint8_t)hooks;
+        if (is_syscall)
+            plugin->syscall_subscribed = true;
+        else
+            plugin->vmmain_subscribed = true;
+        s_hooks_changed = true;
+        // the hook lists can't be rebuilt while Route is walking them (Route rebuilds them once it's done), and an
+        // attaching plugin isn't in g_plugins yet
+        if (!gameinfo.IsRouting() && plugin != s_attaching_plugin)
+            plugins_update_hooks();
+        ret = 1;
+    }
+
+    QMMLOG(QMM_LOG_TRACE, "QMM") << "Plugin \"" << ((plugin_info*)plid)->name << " called Subscribe(" << is_syscall << ", " << cmd << ", " << hooks << ") = " << ret << "\n";
+
+    return ret;
+}
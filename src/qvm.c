@@ -12,12 +12,46 @@ Created By:
 #define QMM_LOGGING
 
 #define _CRT_SECURE_NO_WARNINGS
+#define _GNU_SOURCE     // REG_RIP for the guard fault handler
 #include <stdint.h>     // intptr_t and uint8_t
 #include <malloc.h>
-#include <string.h>     // memcpy and memset
+#include <string.h>     // memcpy, memset, and strerror
 #include <stdio.h>
 #include <time.h>       // struct timespec and timespec_get
+#include <math.h>       // sin, cos, sqrt, atan2, floor, and ceil
 #include "qvm.h"
+#include "qvm_jit.h"
+#include "qvm_aot.h"
+
+#ifdef QVM_GUARDED_SUPPORTED
+#include <signal.h>     // sigaction
+#include <sys/mman.h>   // mmap, mprotect, and munmap
+#include <unistd.h>     // sysconf
+#endif
+
+#ifdef QVM_SNAPSHOT_COW
+#include <sys/mman.h>   // mmap, munmap, and memfd_create
+#include <unistd.h>     // sysconf, ftruncate, pread, and close
+#endif
+
+#ifdef QVM_HUGEPAGE_SUPPORTED
+#include <sys/mman.h>   // mmap, munmap, and madvise
+#endif
+
+#ifdef QVM_CACHE_SUPPORTED
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap and munmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close and unlink
+#endif
+
+#include <errno.h>      // errno
+#ifndef _WIN32
+#include <fcntl.h>      // open
+#include <limits.h>     // IOV_MAX
+#include <sys/uio.h>    // writev
+#include <unistd.h>     // close and unlink
+#endif
 
 #ifdef QMM_LOGGING
 void log_c(int severity, const char* tag, const char* fmt, ...);
@@ -27,6 +61,57 @@ enum { QMM_LOG_TRACE, QMM_LOG_DEBUG, QMM_LOG_INFO, QMM_LOG_NOTICE, QMM_LOG_WARNI
 #define log_c(...) /* */
 #endif
 
+static int qvm_interpret(qvm* vm, size_t instruction, int argc, int* argv, const void* const** handlers);
+static void qvm_exec_fail(qvm* vm, qvm_opstack_segment* opstackseg, int* opstack, int* opstackhigh, qvm_op* instruction);
+static int qvm_decode(qvm* vm, const uint8_t* filemem, const qvm_header* header);
+static int qvm_jumptargets(qvm* vm, const uint8_t* filemem, const qvm_header* header);
+static int qvm_verify(qvm* vm);
+static int qvm_fuse(qvm* vm);
+static void qvm_stack_analyze(qvm* vm, const uint8_t* filemem, const qvm_header* header);
+#ifdef QVM_CACHE_SUPPORTED
+static uint64_t qvm_cache_key(const uint8_t* filemem, size_t filesize);
+static int qvm_cache_open(qvm* vm, const char* path, uint64_t key);
+static void qvm_cache_write(const qvm* vm, const char* path, uint64_t key);
+#endif
+static int qvm_hunk_init(qvm* vm);
+static uint64_t qvm_prof_time(void);
+static void qvm_prof_enter(qvm_prof* prof, int func, size_t* instructions);
+static void qvm_prof_leave(qvm_prof* prof, size_t* instructions);
+static void qvm_trace_record(qvm_trace* trace, int type, int instruction);
+
+#ifndef _WIN32
+// A piece of a crash dump file, written with writev
+typedef struct iovec qvm_dump_chunk;
+#else
+// A piece of a crash dump file
+typedef struct {
+    void* iov_base;
+    size_t iov_len;
+} qvm_dump_chunk;
+#endif
+static size_t qvm_dump_add(qvm_dump_chunk* chunks, size_t n, const void* base, size_t len);
+static int qvm_dump_write(const char* path, qvm_dump_chunk* chunks, size_t numchunks);
+
+// Internal fused opcodes (superinstructions), only used by the interpreter. The original instructions are left in the
+// code segment, and the fused opcode replaces only the first instruction's handler (see qvm_fuse)
+enum {
+    QVM_OP_LOCAL_LOAD4 = QVM_OP_NUM_OPS,    // QVM_OP_LOCAL + QVM_OP_LOAD4
+    QVM_OP_LOCAL_LOAD4_CONST_ADD,           // QVM_OP_LOCAL + QVM_OP_LOAD4 + QVM_OP_CONST + QVM_OP_ADD
+    QVM_OP_LOCAL_CONST_STORE4,              // QVM_OP_LOCAL + QVM_OP_CONST + QVM_OP_STORE4
+    QVM_OP_CONST_LOAD4,                     // QVM_OP_CONST + QVM_OP_LOAD4
+    QVM_OP_CONST_ADD,                       // QVM_OP_CONST + QVM_OP_ADD
+    QVM_OP_CONST_CALL,                      // QVM_OP_CONST + QVM_OP_CALL
+    QVM_OP_CONST_CALL_DIRECT,               // QVM_OP_CONST + QVM_OP_CALL + callee's QVM_OP_ENTER (frame size in CALL param)
+    QVM_OP_CONST_EQ,                        // QVM_OP_CONST + QVM_OP_EQ
+    QVM_OP_CONST_NE,                        // QVM_OP_CONST + QVM_OP_NE
+    QVM_OP_CONST_LTI,                       // QVM_OP_CONST + QVM_OP_LTI
+    QVM_OP_CONST_LEI,                       // QVM_OP_CONST + QVM_OP_LEI
+    QVM_OP_CONST_GTI,                       // QVM_OP_CONST + QVM_OP_GTI
+    QVM_OP_CONST_GEI,                       // QVM_OP_CONST + QVM_OP_GEI
+
+    QVM_OP_NUM_FUSED_OPS,                   // Number of QVM opcodes, including fused opcodes
+};
+
 
 void qvm_init(qvm* vm) {
     if (!vm)
@@ -40,11 +125,17 @@ void qvm_init(qvm* vm) {
     vm->memorysize = 0;
 
     vm->codesegment = NULL;
+    vm->dispatch = NULL;
+    vm->verifyinfo = NULL;
+    vm->jumptargets = NULL;
+    vm->numjumptargets = 0;
+    vm->fusedops = NULL;
     vm->datasegment = NULL;
     
     vm->instructioncount = 0;
     vm->codeseglen = 0;
     vm->dataseglen = 0;
+    vm->datamask = 0;
 
     vm->stacksize = 0;
     vm->stacklow = NULL;
@@ -53,17 +144,41 @@ void qvm_init(qvm* vm) {
     vm->hunksize = 0;
     vm->hunklow = 0;
     vm->hunkhigh = 0;
+    vm->hunk = NULL;
 
     vm->stackptr = NULL;
-    vm->hunkptr = 0;
 
     vm->filesize = 0;
     vm->allocator = NULL;
     vm->verify_data = 0;
+
+    vm->opstacks = NULL;
+    vm->opstackseg = NULL;
+
+    vm->jit = NULL;
+    vm->execdepth = 0;
+    vm->failed = 0;
+    vm->prof = NULL;
+    vm->aot = NULL;
+    vm->intrinsics = NULL;
+    vm->numintrinsics = 0;
+    vm->cachemap = NULL;
+    vm->cachemapsize = 0;
+    vm->trace = NULL;
+    vm->dumpdir = NULL;
+    vm->stackneeded = 0;
+    vm->stackrecursive = 0;
+    vm->stackindirectcycle = 0;
+    vm->stackanalyzed = 0;
 }
 
 
 int qvm_load(qvm* vm, const uint8_t* filemem, size_t filesize, qvm_syscall qvmsyscall, int verify_data, size_t hunk_size, qvm_alloc* allocator) {
+    return qvm_load_ex(vm, filemem, filesize, qvmsyscall, verify_data, hunk_size, 0, allocator, NULL);
+}
+
+
+int qvm_load_ex(qvm* vm, const uint8_t* filemem, size_t filesize, qvm_syscall qvmsyscall, int verify_data, size_t hunk_size, size_t stack_size, qvm_alloc* allocator, const char* cachedir) {
     if (!vm || vm->memory || !filemem || !filesize || !qvmsyscall)
         return 0;
 
@@ -82,6 +197,13 @@ int qvm_load(qvm* vm, const uint8_t* filemem, size_t filesize, qvm_syscall qvmsy
     vm->allocator = allocator ? allocator : &qvm_allocator_default;
     vm->hunksize = hunk_size ? hunk_size : QVM_HUNK_SIZE;
 
+#ifdef QVM_GUARDED_SUPPORTED
+    // guarded allocations catch out-of-bounds data accesses with guard regions instead of masking
+    int guarded = (vm->allocator->flags & QVM_ALLOC_GUARDED) != 0;
+#else
+    int guarded = 0;
+#endif
+
     qvm_header header;
 
     // grab a copy of the header
@@ -132,26 +254,92 @@ int qvm_load(qvm* vm, const uint8_t* filemem, size_t filesize, qvm_syscall qvmsy
     // in that space
     QVM_NEXT_POW_2(codeseglen);
     vm->codeseglen = codeseglen;
-    
+
+    int cached = 0;
+#ifdef QVM_CACHE_SUPPORTED
+    // the decoded code only depends on the file contents, so use a cached copy if there is one
+    uint64_t cachekey = 0;
+    char cachepath[1024];
+    if (cachedir) {
+        cachekey = qvm_cache_key(filemem, filesize);
+        snprintf(cachepath, sizeof(cachepath), "%s/qvm_%016llx.qvmc", cachedir, (unsigned long long)cachekey);
+        cached = qvm_cache_open(vm, cachepath, cachekey);
+    }
+#endif
+
+    // decode instructions from the file
+    if (!cached && !qvm_decode(vm, filemem, &header))
+        goto fail;
+
+    // load the version 2 jump target table, if there is one
+    if (!qvm_jumptargets(vm, filemem, &header))
+        goto fail;
+
+    if (!cached) {
+        // verify code and find functions that can run without per-instruction stack checks
+        if (!qvm_verify(vm))
+            goto fail;
+
+        // combine common instruction sequences into superinstructions
+        if (!qvm_fuse(vm))
+            goto fail;
+    }
+
+    // find how much program stack the deepest call path needs
+    qvm_stack_analyze(vm, filemem, &header);
+
+    // size the program stack. q3asm always reserves QVM_PROGRAMSTACK_SIZE as the last symbol in the bss segment, so
+    // that part of bss can be resized without moving anything else
+    size_t stacksize = QVM_PROGRAMSTACK_SIZE;
+    if (header.bsslen >= QVM_PROGRAMSTACK_SIZE) {
+        if (stack_size == QVM_STACK_AUTO) {
+            // leave room for a re-entrant vmMain call (the engine can call vmMain from inside a syscall). without a
+            // finished analysis that rules out recursion, stackneeded is only a lower bound, so then only grow the stack
+            size_t autosize = (vm->stackneeded * 2 + 0x1000 + 0xFFF) & ~(size_t)0xFFF;
+            if (!vm->stackanalyzed)
+                log_c(QMM_LOG_INFO, QMM_LOGGING_TAG, "qvm_load(): Stack analysis did not finish, keeping %zu byte program stack\n", stacksize);
+            else if (autosize > stacksize)
+                stacksize = autosize;
+            else if (vm->stackrecursive)
+                log_c(QMM_LOG_INFO, QMM_LOGGING_TAG, "qvm_load(): Recursive calls found, keeping %zu byte program stack\n", stacksize);
+            else if (vm->stackindirectcycle)
+                log_c(QMM_LOG_INFO, QMM_LOGGING_TAG, "qvm_load(): Possible recursion through function pointers, keeping %zu byte program stack\n", stacksize);
+            else
+                stacksize = autosize;
+        }
+        else if (stack_size) {
+            stacksize = (stack_size + 15) & ~(size_t)15;
+        }
+    }
+
     // data segment is the total size of the individual data segments
-    // bsslen includes QVM_PROGRAMSTACK_SIZE 
+    // bsslen includes QVM_PROGRAMSTACK_SIZE, which is replaced with the chosen stack size
     // also add in the size of the hunk
     size_t dataseglen = header.datalen + header.litlen + header.bsslen + vm->hunksize;
+    if (header.bsslen >= QVM_PROGRAMSTACK_SIZE)
+        dataseglen = dataseglen - QVM_PROGRAMSTACK_SIZE + stacksize;
     if (!dataseglen) {
         log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Invalid QVM file: data segment length is 0\n");
         goto fail;
     }
     // save actual dataseglen before rounding up
     size_t orig_dataseglen = dataseglen;
-    // round data segment size up to next power of 2 for masking data accesses
-    QVM_NEXT_POW_2(dataseglen);
+    // round data segment size up to next power of 2 for masking data accesses. guarded data accesses aren't masked
+    if (!guarded) {
+        QVM_NEXT_POW_2(dataseglen);
+    }
     vm->dataseglen = dataseglen;
 
+    // data mask - disable if verify_data is off (or guard regions catch bad accesses) by using a mask with all bits 1
+    vm->datamask = verify_data && !guarded ? dataseglen - 1 : (size_t)-1;
+
     // the stack will also use all extra space from rounding up the data segment size
-    vm->stacksize = QVM_PROGRAMSTACK_SIZE + (dataseglen - orig_dataseglen);
+    vm->stacksize = stacksize + (dataseglen - orig_dataseglen);
+    if (vm->stackneeded > vm->stacksize)
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_load(): Program stack may overflow: deepest call path needs %zu bytes, stack is %zu bytes\n", vm->stackneeded, vm->stacksize);
 
     // allocate vm memory
-    vm->memorysize = vm->codeseglen + vm->dataseglen;
+    vm->memorysize = vm->dataseglen;
     vm->memory = (uint8_t*)vm->allocator->alloc(vm->memorysize, vm->allocator->ctx);
     if (!vm->memory) {
         log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Memory allocation failed for size %zu\n", vm->memorysize);
@@ -163,31 +351,119 @@ int qvm_load(qvm* vm, const uint8_t* filemem, size_t filesize, qvm_syscall qvmsy
 
     // set segment pointers
     // the stack is allocated by q3asm as the final symbol in BSS segment
-    // | CODE | DATA | LIT | BSS | extrastack from dataseg rounding | hunk |
-    //                 program stack starts here and grows down ----^
+    // | DATA | LIT | BSS | extrastack from dataseg rounding | hunk |
+    //          program stack starts here and grows down ----^
     // program stack is for arguments and local variables
-    vm->codesegment = (qvm_op*)vm->memory;
-    vm->datasegment = vm->memory + codeseglen;
+    vm->datasegment = vm->memory;
 
     // hunk is at the very end of the data segment
-    vm->hunkptr = (int)dataseglen;
-    vm->hunkhigh = vm->hunkptr;
+    vm->hunkhigh = (int)dataseglen;
     vm->hunklow = vm->hunkhigh - (int)vm->hunksize;
+    if (!qvm_hunk_init(vm))
+        goto fail;
 
     // set bounds of stack (last chunk of bss and up to hunk)
     vm->stackptr = (int*)(vm->datasegment + dataseglen - vm->hunksize);
     vm->stackhigh = vm->stackptr;
     vm->stacklow = (int*)((uint8_t*)vm->stackhigh - vm->stacksize);
 
+    // copy data segment (including literals) to VM
+    memcpy(vm->datasegment, filemem + header.dataoffset, header.datalen + header.litlen);
+
+#ifdef QVM_COMPUTED_GOTO
+    // pre-decode each (possibly fused) op into the address of its interpreter handler. this covers the entire
+    // rounded-up code segment, so the padding ops all point at the QVM_OP_UNDEF handler
+    const void* const* handlers = NULL;
+    qvm_interpret(NULL, 0, 0, NULL, &handlers);
+    size_t dispatchcount = codeseglen / sizeof(qvm_op);
+    vm->dispatch = (const void**)malloc(dispatchcount * sizeof(vm->dispatch[0]));
+    if (!vm->dispatch) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Memory allocation failed for dispatch table size %zu\n", dispatchcount * sizeof(vm->dispatch[0]));
+        goto fail;
+    }
+    for (size_t i = 0; i < dispatchcount; i++)
+        vm->dispatch[i] = handlers[vm->fusedops[i]];
+#endif
+
+#ifdef QVM_CACHE_SUPPORTED
+    // save the decoded code for next time
+    if (cachedir && !cached)
+        qvm_cache_write(vm, cachepath, cachekey);
+#endif
+
+    // a winner is us
+    return 1;
+
+fail:
+    // :(
+    qvm_unload(vm);
+    return 0;
+}
+
+
+void qvm_unload(qvm* vm) {
+    if (!vm)
+        return;
+    qvm_jit_free(vm);
+    qvm_aot_free(vm);
+    if (vm->memory)
+        vm->allocator->free(vm->memory, vm->memorysize, vm->allocator->ctx);
+    vm->memory = NULL;
+    // code segment, verifier results, and fused ops point into the cache file if it was used
+    if (vm->cachemap) {
+#ifdef QVM_CACHE_SUPPORTED
+        munmap(vm->cachemap, vm->cachemapsize);
+#endif
+    }
+    else {
+        free(vm->codesegment);
+        free(vm->verifyinfo);
+        free(vm->fusedops);
+    }
+    vm->cachemap = NULL;
+    vm->codesegment = NULL;
+    vm->verifyinfo = NULL;
+    vm->fusedops = NULL;
+    free((void*)vm->dispatch);
+    vm->dispatch = NULL;
+    free(vm->jumptargets);
+    vm->jumptargets = NULL;
+    while (vm->opstacks) {
+        qvm_opstack_segment* next = vm->opstacks->next;
+        free(vm->opstacks);
+        vm->opstacks = next;
+    }
+    vm->opstackseg = NULL;
+    if (vm->prof)
+        free(vm->prof->nodes);
+    free(vm->prof);
+    qvm_trace_stop(vm);
+    free(vm->intrinsics);
+    free(vm->hunk);
+    free(vm->dumpdir);
+    qvm_init(vm);
+}
+
+
+// Decode each instruction from the file into the code segment
+static int qvm_decode(qvm* vm, const uint8_t* filemem, const qvm_header* header) {
+    // the code segment is kept apart from the data segment, so it is never reachable with a data offset
+    vm->codesegment = (qvm_op*)malloc(vm->codeseglen);
+    if (!vm->codesegment) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Memory allocation failed for code segment size %zu\n", vm->codeseglen);
+        return 0;
+    }
+    memset(vm->codesegment, 0, vm->codeseglen);
+
     // start loading instructions from the file's code offset into VM memory block
-    const uint8_t* codeoffset = filemem + header.codeoffset;
+    const uint8_t* codeoffset = filemem + header->codeoffset;
 
     // loop through each op
-    for (uint32_t i = 0; i < header.instructioncount; ++i) {
+    for (uint32_t i = 0; i < header->instructioncount; ++i) {
         // make sure we're not reading past the end of the codesegment in the file
-        if (codeoffset >= filemem + header.codeoffset + header.codelen) {
+        if (codeoffset >= filemem + header->codeoffset + header->codelen) {
             log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Invalid QVM file: can't read instruction at %ud, reached end of file\n", i);
-            goto fail;
+            return 0;
         }
 
         // get the opcode
@@ -196,7 +472,7 @@ int qvm_load(qvm* vm, const uint8_t* filemem, size_t filesize, qvm_syscall qvmsy
         // make sure opcode is valid
         if (opcode < 0 || opcode >= QVM_OP_NUM_OPS) {
             log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Invalid QVM file: invalid opcode value at %ud: %d\n", i, opcode);
-            goto fail;
+            return 0;
         }
         
         // write opcode (to qvmop_t)
@@ -229,9 +505,9 @@ int qvm_load(qvm* vm, const uint8_t* filemem, size_t filesize, qvm_syscall qvmsy
         case QVM_OP_BLOCK_COPY:
             // all the above instructions have 4-byte params
             // make sure we're not reading an int past the end of the codesegment in the file
-            if (codeoffset + 3 >= filemem + header.codeoffset + header.codelen) {
+            if (codeoffset + 3 >= filemem + header->codeoffset + header->codelen) {
                 log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Invalid QVM file: can't read instruction %ud, reached end of file\n", i);
-                goto fail;
+                return 0;
             }
             vm->codesegment[i].param = *(int*)codeoffset;
             codeoffset += 4;
@@ -240,9 +516,9 @@ int qvm_load(qvm* vm, const uint8_t* filemem, size_t filesize, qvm_syscall qvmsy
         case QVM_OP_ARG:
             // this instruction has a 1-byte param
             // make sure we're not reading past the end of the codesegment in the file
-            if (codeoffset >= filemem + header.codeoffset + header.codelen) {
+            if (codeoffset >= filemem + header->codeoffset + header->codelen) {
                 log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Invalid QVM file: can't read instruction %ud, reached end of file\n", i);
-                goto fail;
+                return 0;
             }
             vm->codesegment[i].param = (int)*codeoffset;
             codeoffset++;
@@ -255,27 +531,677 @@ int qvm_load(qvm* vm, const uint8_t* filemem, size_t filesize, qvm_syscall qvmsy
         }
     }
 
-    // copy data segment (including literals) to VM
-    memcpy(vm->datasegment, filemem + header.dataoffset, header.datalen + header.litlen);
+    return 1;
+}
 
-    // a winner is us
+
+// Build the bitmap of allowed QVM_OP_JUMP targets from a version 2 jump target table. Constant jumps (QVM_OP_CONST
+// followed by QVM_OP_JUMP) aren't in the table, so their targets are added too. A missing or malformed table just
+// leaves jump targets unchecked, like a version 1 QVM
+static int qvm_jumptargets(qvm* vm, const uint8_t* filemem, const qvm_header* header) {
+    if (header->magic != QVM_MAGIC_VER2)
+        return 1;
+
+    if (vm->filesize < sizeof(qvm_header_v2)) {
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_load(): Version 2 QVM file is too small for jump target table length, ignoring jump target table\n");
+        return 1;
+    }
+
+    // the table follows the lit segment
+    uint32_t jtrglen;
+    memcpy(&jtrglen, filemem + offsetof(qvm_header_v2, jtrglen), sizeof(jtrglen));
+    size_t jtrgoffset = (size_t)header->dataoffset + header->datalen + header->litlen;
+    if (jtrglen % 4 || jtrgoffset + jtrglen > vm->filesize) {
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_load(): Version 2 QVM file has invalid jump target table length %u, ignoring jump target table\n", jtrglen);
+        return 1;
+    }
+
+    size_t numtargets = jtrglen / 4;
+    const uint8_t* table = filemem + jtrgoffset;
+    for (size_t i = 0; i < numtargets; i++) {
+        uint32_t target;
+        memcpy(&target, table + i * 4, sizeof(target));
+        if (target >= vm->instructioncount) {
+            log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_load(): Version 2 QVM file has invalid jump target %u, ignoring jump target table\n", target);
+            return 1;
+        }
+    }
+
+    // 1 bit for each entry in the code segment, rounded up to 4 bytes so the JIT can test bits with 32-bit loads
+    size_t tablecount = vm->codeseglen / sizeof(qvm_op);
+    size_t codemask = tablecount - 1;
+    size_t bitmapsize = ((tablecount + 31) / 32) * 4;
+    vm->jumptargets = (uint8_t*)malloc(bitmapsize);
+    if (!vm->jumptargets) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Memory allocation failed for jump target bitmap size %zu\n", bitmapsize);
+        return 0;
+    }
+    memset(vm->jumptargets, 0, bitmapsize);
+
+    for (size_t i = 0; i < numtargets; i++) {
+        uint32_t target;
+        memcpy(&target, table + i * 4, sizeof(target));
+        vm->jumptargets[target >> 3] |= (uint8_t)(1 << (target & 7));
+    }
+    for (size_t i = 1; i < vm->instructioncount; i++) {
+        if (vm->codesegment[i].op == QVM_OP_JUMP && vm->codesegment[i - 1].op == QVM_OP_CONST) {
+            size_t target = (size_t)vm->codesegment[i - 1].param & codemask;
+            vm->jumptargets[target >> 3] |= (uint8_t)(1 << (target & 7));
+        }
+    }
+    vm->numjumptargets = numtargets;
+
+    log_c(QMM_LOG_DEBUG, QMM_LOGGING_TAG, "qvm_load(): Loaded %zu jump targets from version 2 jump target table\n", numtargets);
+    return 1;
+}
+
+
+// Number of values each opcode pops from and then pushes onto the opstack
+static const struct {
+    int8_t pops;
+    int8_t pushes;
+} qvm_opstack_effect[QVM_OP_NUM_OPS] = {
+    [QVM_OP_CALL] = { 1, 1 },   // pops function address, callee (or syscall) pushes return value
+    [QVM_OP_PUSH] = { 0, 1 }, [QVM_OP_POP] = { 1, 0 }, [QVM_OP_CONST] = { 0, 1 }, [QVM_OP_LOCAL] = { 0, 1 },
+    [QVM_OP_JUMP] = { 1, 0 },
+    [QVM_OP_EQ] = { 2, 0 }, [QVM_OP_NE] = { 2, 0 },
+    [QVM_OP_LTI] = { 2, 0 }, [QVM_OP_LEI] = { 2, 0 }, [QVM_OP_GTI] = { 2, 0 }, [QVM_OP_GEI] = { 2, 0 },
+    [QVM_OP_LTU] = { 2, 0 }, [QVM_OP_LEU] = { 2, 0 }, [QVM_OP_GTU] = { 2, 0 }, [QVM_OP_GEU] = { 2, 0 },
+    [QVM_OP_EQF] = { 2, 0 }, [QVM_OP_NEF] = { 2, 0 },
+    [QVM_OP_LTF] = { 2, 0 }, [QVM_OP_LEF] = { 2, 0 }, [QVM_OP_GTF] = { 2, 0 }, [QVM_OP_GEF] = { 2, 0 },
+    [QVM_OP_LOAD1] = { 1, 1 }, [QVM_OP_LOAD2] = { 1, 1 }, [QVM_OP_LOAD4] = { 1, 1 },
+    [QVM_OP_STORE1] = { 2, 0 }, [QVM_OP_STORE2] = { 2, 0 }, [QVM_OP_STORE4] = { 2, 0 },
+    [QVM_OP_ARG] = { 1, 0 }, [QVM_OP_BLOCK_COPY] = { 2, 0 },
+    [QVM_OP_SEX8] = { 1, 1 }, [QVM_OP_SEX16] = { 1, 1 },
+    [QVM_OP_NEGI] = { 1, 1 }, [QVM_OP_ADD] = { 2, 1 }, [QVM_OP_SUB] = { 2, 1 },
+    [QVM_OP_DIVI] = { 2, 1 }, [QVM_OP_DIVU] = { 2, 1 }, [QVM_OP_MODI] = { 2, 1 }, [QVM_OP_MODU] = { 2, 1 },
+    [QVM_OP_MULI] = { 2, 1 }, [QVM_OP_MULU] = { 2, 1 },
+    [QVM_OP_BAND] = { 2, 1 }, [QVM_OP_BOR] = { 2, 1 }, [QVM_OP_BXOR] = { 2, 1 }, [QVM_OP_BCOM] = { 1, 1 },
+    [QVM_OP_LSH] = { 2, 1 }, [QVM_OP_RSHI] = { 2, 1 }, [QVM_OP_RSHU] = { 2, 1 },
+    [QVM_OP_NEGF] = { 1, 1 }, [QVM_OP_ADDF] = { 2, 1 }, [QVM_OP_SUBF] = { 2, 1 },
+    [QVM_OP_DIVF] = { 2, 1 }, [QVM_OP_MULF] = { 2, 1 },
+    [QVM_OP_CVIF] = { 1, 1 }, [QVM_OP_CVFI] = { 1, 1 },
+};
+
+
+/* Load-time verifier
+ *
+ * Rejects code that q3asm would never generate: conditional branches to an instruction outside the code segment,
+ * constant calls (QVM_OP_CONST followed by QVM_OP_CALL) to anything other than a QVM_OP_ENTER, and QVM_OP_LEAVE
+ * params that don't match their function's QVM_OP_ENTER param.
+ *
+ * Then, for each function (a QVM_OP_ENTER up to the next one), it tracks the opstack depth at every instruction
+ * relative to the function's entry. A function is verified if every instruction is reached with a single consistent
+ * depth, the depth never goes below 0, and all conditional branches and fallthroughs stay inside the function.
+ * Instructions only reachable by an indirect QVM_OP_JUMP (like switch jump tables) are assumed to start with an empty
+ * opstack, and must then pass the same checks. With a version 2 jump target table, only the instructions in it are
+ * treated this way, since QVM_OP_JUMP can't reach anything else. Any other instruction that wasn't reached is dead code
+ * and is left unverified without failing its function.
+ *
+ * The interpreter only drops per-instruction stack checks after it enters a verified function at a QVM_OP_ENTER,
+ * QVM_OP_LEAVE return, or QVM_OP_JUMP target, and QVM_VERIFIED() confirms the opstack has room from that point. This
+ * is safe even if the assumed depth was wrong, since it only relies on how much the function can push or pop from
+ * the instruction where it was entered.
+ */
+static int qvm_verify(qvm* vm) {
+    qvm_op* codesegment = vm->codesegment;
+    const uint8_t* jumptargets = vm->jumptargets;
+    size_t count = vm->instructioncount;
+    size_t codemask = (vm->codeseglen / sizeof(qvm_op)) - 1;
+    size_t numfuncs = 0;
+    size_t numverified = 0;
+
+    vm->verifyinfo = (qvm_verifyinfo*)malloc((codemask + 1) * sizeof(vm->verifyinfo[0]));
+    // each instruction is added to the worklist at most once (when its depth is first found)
+    size_t* worklist = (size_t*)malloc(count * sizeof(size_t));
+    if (!vm->verifyinfo || !worklist) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Memory allocation failed for verifier\n");
+        free(worklist);
+        return 0;
+    }
+    qvm_verifyinfo* verifyinfo = vm->verifyinfo;
+    for (size_t i = 0; i <= codemask; i++) {
+        verifyinfo[i].depth = -1;
+        verifyinfo[i].room = 0;
+    }
+
+    size_t start = 0;
+    while (start < count) {
+        // code outside of a function stays unverified
+        if (codesegment[start].op != QVM_OP_ENTER) {
+            start++;
+            continue;
+        }
+
+        // function runs until the next QVM_OP_ENTER
+        size_t end = start + 1;
+        while (end < count && codesegment[end].op != QVM_OP_ENTER)
+            end++;
+        numfuncs++;
+
+        // reject malformed code
+        for (size_t i = start; i < end; i++) {
+            qvm_op* op = &codesegment[i];
+            if (op->op >= QVM_OP_EQ && op->op <= QVM_OP_GEF && (unsigned int)op->param >= count) {
+                log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Invalid QVM file: %s at %zu has invalid target %d\n", qvm_opcodename[op->op], i, op->param);
+                goto fail;
+            }
+            if (op->op == QVM_OP_LEAVE && op->param != codesegment[start].param) {
+                log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Invalid QVM file: QVM_OP_LEAVE param at %zu (%d) does not match QVM_OP_ENTER param at %zu (%d)\n", i, op->param, start, codesegment[start].param);
+                goto fail;
+            }
+            if (op->op == QVM_OP_CALL && codesegment[i - 1].op == QVM_OP_CONST && codesegment[i - 1].param >= 0) {
+                size_t target = (size_t)codesegment[i - 1].param;
+                if (target >= count || codesegment[target].op != QVM_OP_ENTER) {
+                    log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Invalid QVM file: QVM_OP_CALL at %zu has invalid target %zu\n", i, target);
+                    goto fail;
+                }
+            }
+        }
+
+        // track opstack depth through the function
+        int ok = 1;
+        int maxdepth = 0;
+        size_t numwork = 0;
+        size_t seed = start;
+        verifyinfo[start].depth = 0;
+        worklist[numwork++] = start;
+        while (ok) {
+            while (ok && numwork) {
+                size_t i = worklist[--numwork];
+                qvm_op* op = &codesegment[i];
+                int depth = verifyinfo[i].depth - qvm_opstack_effect[op->op].pops;
+                if (depth < 0) {
+                    ok = 0;
+                    break;
+                }
+                depth += qvm_opstack_effect[op->op].pushes;
+                // an opstack this deep would overflow no matter where it started
+                if (depth >= QVM_OPSTACK_SIZE) {
+                    ok = 0;
+                    break;
+                }
+                if (depth > maxdepth)
+                    maxdepth = depth;
+
+                // find next instruction(s)
+                size_t next[2];
+                int numnext = 0;
+                switch (op->op) {
+                case QVM_OP_UNDEF:
+                case QVM_OP_LEAVE:
+                    break;
+                case QVM_OP_JUMP:
+                    // an indirect jump re-checks its target at runtime, but a constant jump inside the function
+                    // gives its target a known depth
+                    if (i > start && codesegment[i - 1].op == QVM_OP_CONST) {
+                        size_t target = (size_t)codesegment[i - 1].param & codemask;
+                        if (target >= start && target < end)
+                            next[numnext++] = target;
+                    }
+                    break;
+                case QVM_OP_EQ: case QVM_OP_NE:
+                case QVM_OP_LTI: case QVM_OP_LEI: case QVM_OP_GTI: case QVM_OP_GEI:
+                case QVM_OP_LTU: case QVM_OP_LEU: case QVM_OP_GTU: case QVM_OP_GEU:
+                case QVM_OP_EQF: case QVM_OP_NEF:
+                case QVM_OP_LTF: case QVM_OP_LEF: case QVM_OP_GTF: case QVM_OP_GEF:
+                    next[numnext++] = (size_t)op->param;
+                    // fall through
+                default:
+                    next[numnext++] = i + 1;
+                    break;
+                }
+
+                for (int n = 0; n < numnext; n++) {
+                    // branching or falling out of the function
+                    if (next[n] < start || next[n] >= end) {
+                        ok = 0;
+                        break;
+                    }
+                    if (verifyinfo[next[n]].depth < 0) {
+                        verifyinfo[next[n]].depth = (int16_t)depth;
+                        worklist[numwork++] = next[n];
+                    }
+                    else if (verifyinfo[next[n]].depth != depth) {
+                        ok = 0;
+                        break;
+                    }
+                }
+            }
+            if (!ok)
+                break;
+
+            // start from the next instruction that wasn't reached (an indirect jump target) with an empty opstack
+            while (seed < end && (verifyinfo[seed].depth >= 0 || (jumptargets && !QVM_JUMPTARGET(jumptargets, seed))))
+                seed++;
+            if (seed == end)
+                break;
+            verifyinfo[seed].depth = 0;
+            worklist[numwork++] = seed;
+        }
+
+        for (size_t i = start; i < end; i++) {
+            if (!ok)
+                verifyinfo[i].depth = -1;
+            else if (verifyinfo[i].depth >= 0)
+                verifyinfo[i].room = (int16_t)(maxdepth - verifyinfo[i].depth);
+        }
+        if (ok)
+            numverified++;
+
+        start = end;
+    }
+
+    free(worklist);
+    log_c(QMM_LOG_DEBUG, QMM_LOGGING_TAG, "qvm_load(): Verified %zu of %zu functions for unchecked execution\n", numverified, numfuncs);
     return 1;
 
 fail:
-    // :(
-    qvm_unload(vm);
+    free(worklist);
     return 0;
 }
 
 
-void qvm_unload(qvm* vm) {
-    if (!vm)
+/* Superinstruction fusion
+ *
+ * q3lcc output is mostly made of a few fixed instruction sequences. For each instruction that starts one of these
+ * sequences, this picks a fused opcode whose handler does the whole sequence at once and then skips past it.
+ *
+ * The code segment itself is not changed or compacted: the original instructions stay where they are (and keep their
+ * own handlers), so every jump target, RII, and instruction index in dumps and the JIT stays valid. A jump into the
+ * middle of a sequence just runs the remaining original instructions.
+ */
+static int qvm_fuse(qvm* vm) {
+    qvm_op* codesegment = vm->codesegment;
+    size_t count = vm->instructioncount;
+    size_t tablecount = vm->codeseglen / sizeof(qvm_op);
+    size_t numfused = 0;
+
+    vm->fusedops = (uint8_t*)malloc(tablecount * sizeof(vm->fusedops[0]));
+    if (!vm->fusedops) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Memory allocation failed for fused op table size %zu\n", tablecount * sizeof(vm->fusedops[0]));
+        return 0;
+    }
+
+    for (size_t i = 0; i < tablecount; i++) {
+        uint8_t fused = (uint8_t)codesegment[i].op;
+
+        // opcodes of the next 3 instructions (QVM_OP_UNDEF past the end)
+        qvm_opcode next1 = i + 1 < count ? codesegment[i + 1].op : QVM_OP_UNDEF;
+        qvm_opcode next2 = i + 2 < count ? codesegment[i + 2].op : QVM_OP_UNDEF;
+        qvm_opcode next3 = i + 3 < count ? codesegment[i + 3].op : QVM_OP_UNDEF;
+
+        if (i < count && codesegment[i].op == QVM_OP_LOCAL) {
+            if (next1 == QVM_OP_LOAD4 && next2 == QVM_OP_CONST && next3 == QVM_OP_ADD)
+                fused = QVM_OP_LOCAL_LOAD4_CONST_ADD;
+            else if (next1 == QVM_OP_LOAD4)
+                fused = QVM_OP_LOCAL_LOAD4;
+            else if (next1 == QVM_OP_CONST && next2 == QVM_OP_STORE4)
+                fused = QVM_OP_LOCAL_CONST_STORE4;
+        }
+        else if (i < count && codesegment[i].op == QVM_OP_CONST) {
+            switch (next1) {
+            case QVM_OP_LOAD4: fused = QVM_OP_CONST_LOAD4; break;
+            case QVM_OP_ADD: fused = QVM_OP_CONST_ADD; break;
+            case QVM_OP_CALL: {
+                // a call to a known function does the callee's QVM_OP_ENTER itself, so store the callee's frame size
+                // in the (otherwise unused) QVM_OP_CALL param
+                size_t target = (size_t)codesegment[i].param;
+                if (codesegment[i].param >= 0 && target < count && codesegment[target].op == QVM_OP_ENTER) {
+                    codesegment[i + 1].param = codesegment[target].param;
+                    fused = QVM_OP_CONST_CALL_DIRECT;
+                }
+                else {
+                    fused = QVM_OP_CONST_CALL;
+                }
+                break;
+            }
+            case QVM_OP_EQ: fused = QVM_OP_CONST_EQ; break;
+            case QVM_OP_NE: fused = QVM_OP_CONST_NE; break;
+            case QVM_OP_LTI: fused = QVM_OP_CONST_LTI; break;
+            case QVM_OP_LEI: fused = QVM_OP_CONST_LEI; break;
+            case QVM_OP_GTI: fused = QVM_OP_CONST_GTI; break;
+            case QVM_OP_GEI: fused = QVM_OP_CONST_GEI; break;
+            default: break;
+            }
+        }
+
+        if (fused >= QVM_OP_NUM_OPS)
+            numfused++;
+        vm->fusedops[i] = fused;
+    }
+
+    log_c(QMM_LOG_DEBUG, QMM_LOGGING_TAG, "qvm_load(): Fused %zu instruction sequences into superinstructions\n", numfused);
+    return 1;
+}
+
+
+/* Call graph stack analysis
+ *
+ * Finds how much program stack vmMain (the function at instruction 0) can use, by walking the call graph. Each
+ * function's QVM_OP_ENTER param is the size of its stack frame (locals, outgoing args, return instruction and frame
+ * size), and a callee's frame starts right below its caller's, so a function needs its own frame plus the most any of
+ * its callees need.
+ *
+ * Constant calls (QVM_OP_CONST followed by QVM_OP_CALL) go straight to their target. An indirect call (through a
+ * function pointer) could go to any function whose address is taken: one pushed with QVM_OP_CONST for anything other
+ * than a call, or one whose instruction index appears as a word in the data segment. Both can match data addresses and
+ * plain integers too, which only makes the result larger. vmMain is only called by the engine. Syscalls don't use the
+ * program stack.
+ *
+ * Recursive calls are skipped, so with recursion the result is only the deepest non-recursive path and
+ * vm->stackrecursive is set. Cycles that only close through an indirect call aren't counted as recursion, since the
+ * set of indirect call targets is a rough guess and would make almost every QVM look recursive. They set
+ * vm->stackindirectcycle instead, since they can't be ruled out either. vm->stackanalyzed is only set if the walk
+ * finished.
+ */
+
+// Node for all indirect call targets (in place of an instruction index)
+#define QVM_STACK_INDIRECT ((size_t)-1)
+// Node state flags
+#define QVM_STACK_VISITING              1
+#define QVM_STACK_DONE                  2
+#define QVM_STACK_ADDRTAKEN             4
+
+// Call graph walk position
+typedef struct {
+    size_t node;                // Instruction index of function's QVM_OP_ENTER, or QVM_STACK_INDIRECT
+    size_t pos;                 // Next instruction to look at for calls
+    size_t deepest;             // Most stack needed by any callee so far
+} qvm_stack_walk;
+
+
+// Find the next function called by a node, starting at walk->pos. Returns QVM_STACK_INDIRECT for an indirect call, or
+// count if there are no more calls
+static size_t qvm_stack_next_callee(const qvm* vm, const uint8_t* state, qvm_stack_walk* walk) {
+    const qvm_op* codesegment = vm->codesegment;
+    size_t count = vm->instructioncount;
+
+    // the indirect node calls every function whose address is taken
+    if (walk->node == QVM_STACK_INDIRECT) {
+        while (walk->pos < count) {
+            size_t i = walk->pos++;
+            if (state[i] & QVM_STACK_ADDRTAKEN)
+                return i;
+        }
+        return count;
+    }
+
+    // look at calls until the next function
+    while (walk->pos < count && codesegment[walk->pos].op != QVM_OP_ENTER) {
+        size_t i = walk->pos++;
+        if (codesegment[i].op != QVM_OP_CALL)
+            continue;
+        if (codesegment[i - 1].op != QVM_OP_CONST)
+            return QVM_STACK_INDIRECT;
+        // syscalls don't use the program stack, and the verifier already rejected other bad targets
+        int target = codesegment[i - 1].param;
+        if (target >= 0 && (size_t)target < count && codesegment[target].op == QVM_OP_ENTER)
+            return (size_t)target;
+    }
+    return count;
+}
+
+
+static void qvm_stack_analyze(qvm* vm, const uint8_t* filemem, const qvm_header* header) {
+    const qvm_op* codesegment = vm->codesegment;
+    size_t count = vm->instructioncount;
+
+    if (codesegment[0].op != QVM_OP_ENTER)
         return;
-    if (vm->memory)
-        vm->allocator->free(vm->memory, vm->memorysize, vm->allocator->ctx);
-    vm->memory = NULL;
-    qvm_init(vm);
+
+    // state flags and stack needed for each function (by QVM_OP_ENTER instruction index), plus the indirect node at
+    // index count
+    uint8_t* state = (uint8_t*)calloc(count + 1, sizeof(uint8_t));
+    size_t* needed = (size_t*)calloc(count + 1, sizeof(size_t));
+    // each node can only be on the walk stack once
+    qvm_stack_walk* walk = (qvm_stack_walk*)malloc((count + 1) * sizeof(qvm_stack_walk));
+    if (!state || !needed || !walk) {
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_load(): Memory allocation failed for stack analysis\n");
+        goto done;
+    }
+
+    // find functions whose address is taken (except vmMain)
+    for (size_t i = 0; i < count; i++) {
+        int target = codesegment[i].param;
+        if (codesegment[i].op == QVM_OP_CONST && (i + 1 >= count || codesegment[i + 1].op != QVM_OP_CALL) &&
+            target >= 0 && (size_t)target < count && codesegment[target].op == QVM_OP_ENTER)
+            state[target] |= QVM_STACK_ADDRTAKEN;
+    }
+    for (size_t offset = 0; offset + 4 <= header->datalen; offset += 4) {
+        uint32_t target;
+        memcpy(&target, filemem + header->dataoffset + offset, sizeof(target));
+        if (target < count && codesegment[target].op == QVM_OP_ENTER)
+            state[target] |= QVM_STACK_ADDRTAKEN;
+    }
+    state[0] &= ~QVM_STACK_ADDRTAKEN;
+
+    // depth-first walk from vmMain. a node's stack need is final once all of its callees are done. while a node is on
+    // the walk stack, its entry in needed holds its walk stack position instead
+    size_t depth = 0;
+    size_t indirectpos = QVM_STACK_INDIRECT;
+    walk[depth++] = (qvm_stack_walk){ 0, 1, 0 };
+    state[0] |= QVM_STACK_VISITING;
+    needed[0] = 0;
+    while (depth) {
+        qvm_stack_walk* top = &walk[depth - 1];
+        size_t callee = qvm_stack_next_callee(vm, state, top);
+        size_t index = callee == QVM_STACK_INDIRECT ? count : callee;
+
+        if (callee == count) {
+            // all callees done
+            index = top->node == QVM_STACK_INDIRECT ? count : top->node;
+            size_t frame = top->node == QVM_STACK_INDIRECT || codesegment[top->node].param < 0 ? 0 : (size_t)codesegment[top->node].param;
+            needed[index] = frame + top->deepest;
+            state[index] = (uint8_t)((state[index] & ~QVM_STACK_VISITING) | QVM_STACK_DONE);
+            depth--;
+            if (top->node == QVM_STACK_INDIRECT)
+                indirectpos = QVM_STACK_INDIRECT;
+            if (depth && needed[index] > walk[depth - 1].deepest)
+                walk[depth - 1].deepest = needed[index];
+        }
+        else if (state[index] & QVM_STACK_DONE) {
+            if (needed[index] > top->deepest)
+                top->deepest = needed[index];
+        }
+        else if (state[index] & QVM_STACK_VISITING) {
+            // the cycle goes through the indirect node if it is on the walk stack above the callee
+            if (indirectpos == QVM_STACK_INDIRECT || indirectpos < needed[index])
+                vm->stackrecursive = 1;
+            else
+                vm->stackindirectcycle = 1;
+        }
+        else {
+            state[index] |= QVM_STACK_VISITING;
+            needed[index] = depth;
+            if (callee == QVM_STACK_INDIRECT)
+                indirectpos = depth;
+            walk[depth++] = (qvm_stack_walk){ callee, callee == QVM_STACK_INDIRECT ? 0 : callee + 1, 0 };
+        }
+    }
+    vm->stackneeded = needed[0];
+    vm->stackanalyzed = 1;
+
+    log_c(QMM_LOG_DEBUG, QMM_LOGGING_TAG, "qvm_load(): Deepest call path from vmMain needs %zu bytes of program stack%s\n", vm->stackneeded, vm->stackrecursive ? " (not counting recursive calls)" : "");
+
+done:
+    free(state);
+    free(needed);
+    free(walk);
+}
+
+
+#ifdef QVM_CACHE_SUPPORTED
+/* Decoded code cache
+ *
+ * A cache file holds everything qvm_load() builds from the code segment: the decoded instructions, the verifier
+ * results, and the fused opcode table. They are stored exactly as they are laid out in memory, so a cache file can be
+ * mapped with mmap and used directly. The dispatch table holds handler addresses, so it is rebuilt from the fused
+ * opcode table on every load. JIT output also holds absolute addresses and is not cached (qvm_aot_load() has its own
+ * cache of native modules).
+ *
+ * The file is just a header followed by the 3 tables, each starting at a multiple of 8 bytes:
+ * | qvm_cache_header | codesegment (codeseglen) | verifyinfo (numentries) | fusedops (numentries) |
+ */
+
+// Magic number is stored in file as 51 56 4D 43 ("QVMC")
+#define QVM_CACHE_MAGIC                 0x434D5651
+
+// Decoded code cache file header
+typedef struct {
+    uint32_t magic;             // QVM_CACHE_MAGIC
+    uint32_t version;           // QVM_CACHE_VERSION
+    uint64_t key;               // Hash of the .qvm file this was built from
+    uint64_t filesize;          // Size of the .qvm file
+    uint64_t instructioncount;  // Number of instructions
+    uint64_t codeseglen;        // Size of code segment in memory
+    uint32_t opsize;            // sizeof(qvm_op)
+    uint32_t numfusedops;       // QVM_OP_NUM_FUSED_OPS, since fused opcode values are stored
+    uint64_t verifyoffset;      // Offset of verifier results
+    uint64_t fusedoffset;       // Offset of fused opcode table
+    uint64_t size;              // Size of entire file
+} qvm_cache_header;
+
+// Round up to a multiple of 8 bytes
+#define QVM_CACHE_ALIGN(x) (((x) + 7) & ~(uint64_t)7)
+
+
+// Hash the QVM file and the cache format version (FNV-1a)
+static uint64_t qvm_cache_key(const uint8_t* filemem, size_t filesize) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < filesize; i++)
+        hash = (hash ^ filemem[i]) * 0x100000001B3ull;
+
+    uint32_t version = QVM_CACHE_VERSION;
+    const uint8_t* p = (const uint8_t*)&version;
+    for (size_t i = 0; i < sizeof(version); i++)
+        hash = (hash ^ p[i]) * 0x100000001B3ull;
+    return hash;
+}
+
+
+// Fill in a cache file header for a VM
+static void qvm_cache_header_init(qvm_cache_header* header, const qvm* vm, uint64_t key) {
+    uint64_t numentries = vm->codeseglen / sizeof(qvm_op);
+
+    memset(header, 0, sizeof(*header));
+    header->magic = QVM_CACHE_MAGIC;
+    header->version = QVM_CACHE_VERSION;
+    header->key = key;
+    header->filesize = vm->filesize;
+    header->instructioncount = vm->instructioncount;
+    header->codeseglen = vm->codeseglen;
+    header->opsize = sizeof(qvm_op);
+    header->numfusedops = QVM_OP_NUM_FUSED_OPS;
+    header->verifyoffset = QVM_CACHE_ALIGN(sizeof(qvm_cache_header) + vm->codeseglen);
+    header->fusedoffset = QVM_CACHE_ALIGN(header->verifyoffset + numentries * sizeof(qvm_verifyinfo));
+    header->size = header->fusedoffset + numentries * sizeof(uint8_t);
+}
+
+
+// Map a cache file and point the VM's code segment, verifier results, and fused opcode table into it. Returns 0 if the
+// file doesn't exist or doesn't match the VM
+static int qvm_cache_open(qvm* vm, const char* path, uint64_t key) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(qvm_cache_header)) {
+        close(fd);
+        return 0;
+    }
+
+    size_t mapsize = (size_t)st.st_size;
+    void* map = mmap(NULL, mapsize, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after closing the file
+    close(fd);
+    if (map == MAP_FAILED)
+        return 0;
+
+    // the file has to match exactly what decoding this VM would build
+    qvm_cache_header expected;
+    qvm_cache_header_init(&expected, vm, key);
+    if (memcmp(map, &expected, sizeof(expected)) != 0 || mapsize != expected.size) {
+        log_c(QMM_LOG_DEBUG, QMM_LOGGING_TAG, "qvm_load(): Ignoring stale cache file \"%s\"\n", path);
+        munmap(map, mapsize);
+        return 0;
+    }
+
+    qvm_op* codesegment = (qvm_op*)((uint8_t*)map + sizeof(qvm_cache_header));
+    uint8_t* fusedops = (uint8_t*)map + expected.fusedoffset;
+
+    // opcodes index the interpreter's handler tables, so make sure a damaged file can't send it out of bounds
+    for (size_t i = 0; i < vm->codeseglen / sizeof(qvm_op); i++) {
+        if ((unsigned int)codesegment[i].op >= QVM_OP_NUM_OPS || fusedops[i] >= QVM_OP_NUM_FUSED_OPS) {
+            log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_load(): Ignoring damaged cache file \"%s\"\n", path);
+            munmap(map, mapsize);
+            return 0;
+        }
+    }
+
+    // direct calls jump straight past their target's QVM_OP_ENTER with the frame size stored in the QVM_OP_CALL
+    for (size_t i = 0; i < vm->instructioncount; i++) {
+        if (fusedops[i] != QVM_OP_CONST_CALL_DIRECT)
+            continue;
+        size_t target = (size_t)codesegment[i].param;
+        if (i + 1 >= vm->instructioncount || codesegment[i + 1].op != QVM_OP_CALL || codesegment[i].param < 0 ||
+            target >= vm->instructioncount || codesegment[target].op != QVM_OP_ENTER ||
+            codesegment[target].param != codesegment[i + 1].param) {
+            log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_load(): Ignoring damaged cache file \"%s\"\n", path);
+            munmap(map, mapsize);
+            return 0;
+        }
+    }
+
+    vm->cachemap = map;
+    vm->cachemapsize = mapsize;
+    vm->codesegment = codesegment;
+    vm->verifyinfo = (qvm_verifyinfo*)((uint8_t*)map + expected.verifyoffset);
+    vm->fusedops = fusedops;
+
+    log_c(QMM_LOG_DEBUG, QMM_LOGGING_TAG, "qvm_load(): Loaded decoded code from cache file \"%s\"\n", path);
+    return 1;
+}
+
+
+// Write a VM's code segment, verifier results, and fused opcode table to a cache file. Failure is only logged, since
+// the VM is already loaded
+static void qvm_cache_write(const qvm* vm, const char* path, uint64_t key) {
+    qvm_cache_header header;
+    qvm_cache_header_init(&header, vm, key);
+    size_t numentries = vm->codeseglen / sizeof(qvm_op);
+    static const uint8_t padding[8] = { 0 };
+
+    // write to a temp file so a partial cache file is never loaded
+    char tmppath[1040];
+    snprintf(tmppath, sizeof(tmppath), "%s.tmp", path);
+    FILE* f = fopen(tmppath, "wb");
+    if (!f) {
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_load(): Unable to write cache file \"%s\"\n", tmppath);
+        return;
+    }
+
+    size_t verifypad = (size_t)(header.verifyoffset - sizeof(header) - vm->codeseglen);
+    size_t fusedpad = (size_t)(header.fusedoffset - header.verifyoffset - numentries * sizeof(qvm_verifyinfo));
+    int ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+             fwrite(vm->codesegment, vm->codeseglen, 1, f) == 1 &&
+             fwrite(padding, 1, verifypad, f) == verifypad &&
+             fwrite(vm->verifyinfo, sizeof(qvm_verifyinfo), numentries, f) == numentries &&
+             fwrite(padding, 1, fusedpad, f) == fusedpad &&
+             fwrite(vm->fusedops, sizeof(uint8_t), numentries, f) == numentries;
+    if (fclose(f) != 0)
+        ok = 0;
+
+    if (!ok || rename(tmppath, path) != 0) {
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_load(): Unable to write cache file \"%s\"\n", path);
+        unlink(tmppath);
+        return;
+    }
+
+    log_c(QMM_LOG_DEBUG, QMM_LOGGING_TAG, "qvm_load(): Saved decoded code to cache file \"%s\"\n", path);
 }
+#endif
 
 
 int qvm_exec(qvm* vm, int argc, int* argv) {
@@ -283,12 +1209,99 @@ int qvm_exec(qvm* vm, int argc, int* argv) {
 }
 
 
+#ifdef QVM_GUARDED_SUPPORTED
+// Run a guarded VM function, catching faults in its guard regions. sigsetjmp is called here instead of in
+// qvm_interpret, since it would stop the compiler from keeping the interpreter's locals in registers
+static int qvm_exec_guarded(qvm* vm, size_t instruction, int argc, int* argv) {
+    // program stack pointer before this execution, since the faulting execution's own is lost
+    int* stackptr = vm->stackptr;
+
+    qvm_guard guard;
+    if (sigsetjmp(guard.env, 0)) {
+        log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error: data segment access out of bounds (offset %td)\n", instruction, (uint8_t*)guard.faultaddr - vm->datasegment);
+
+        // qvm_interpret had already set up this execution's opstack segment, so dump with an empty opstack and the
+        // program stack from before it started
+        qvm_opstack_segment* opstackseg = vm->opstackseg;
+        int* opstackhigh = opstackseg->data + QVM_OPSTACK_SIZE;
+        vm->stackptr = stackptr;
+        qvm_exec_fail(vm, opstackseg, opstackhigh, opstackhigh, NULL);
+        return 0;
+    }
+
+    qvm_guard_push(&guard, vm);
+    int ret = qvm_interpret(vm, instruction, argc, argv, NULL);
+    qvm_guard_pop(&guard);
+    return ret;
+}
+#endif
+
+
 int qvm_exec_ex(qvm* vm, size_t instruction, int argc, int* argv) {
+#ifdef QVM_GUARDED_SUPPORTED
+    if (vm && vm->memory && (vm->allocator->flags & QVM_ALLOC_GUARDED))
+        return qvm_exec_guarded(vm, instruction, argc, argv);
+#endif
+    return qvm_interpret(vm, instruction, argc, argv, NULL);
+}
+
+
+static int qvm_interpret(qvm* vm, size_t instruction, int argc, int* argv, const void* const** handlers) {
+#ifdef QVM_COMPUTED_GOTO
+    // handler address for each opcode, used by qvm_load() to pre-decode the code segment
+    static const void* const qvm_handlers[QVM_OP_NUM_FUSED_OPS] = {
+        [QVM_OP_UNDEF] = &&QVM_CASE(UNDEF), [QVM_OP_NOP] = &&QVM_CASE(NOP), [QVM_OP_BREAK] = &&QVM_CASE(BREAK),
+        [QVM_OP_ENTER] = &&QVM_CASE(ENTER), [QVM_OP_LEAVE] = &&QVM_CASE(LEAVE), [QVM_OP_CALL] = &&QVM_CASE(CALL),
+        [QVM_OP_PUSH] = &&QVM_CASE(PUSH), [QVM_OP_POP] = &&QVM_CASE(POP), [QVM_OP_CONST] = &&QVM_CASE(CONST),
+        [QVM_OP_LOCAL] = &&QVM_CASE(LOCAL), [QVM_OP_JUMP] = &&QVM_CASE(JUMP),
+        [QVM_OP_EQ] = &&QVM_CASE(EQ), [QVM_OP_NE] = &&QVM_CASE(NE),
+        [QVM_OP_LTI] = &&QVM_CASE(LTI), [QVM_OP_LEI] = &&QVM_CASE(LEI), [QVM_OP_GTI] = &&QVM_CASE(GTI), [QVM_OP_GEI] = &&QVM_CASE(GEI),
+        [QVM_OP_LTU] = &&QVM_CASE(LTU), [QVM_OP_LEU] = &&QVM_CASE(LEU), [QVM_OP_GTU] = &&QVM_CASE(GTU), [QVM_OP_GEU] = &&QVM_CASE(GEU),
+        [QVM_OP_EQF] = &&QVM_CASE(EQF), [QVM_OP_NEF] = &&QVM_CASE(NEF),
+        [QVM_OP_LTF] = &&QVM_CASE(LTF), [QVM_OP_LEF] = &&QVM_CASE(LEF), [QVM_OP_GTF] = &&QVM_CASE(GTF), [QVM_OP_GEF] = &&QVM_CASE(GEF),
+        [QVM_OP_LOAD1] = &&QVM_CASE(LOAD1), [QVM_OP_LOAD2] = &&QVM_CASE(LOAD2), [QVM_OP_LOAD4] = &&QVM_CASE(LOAD4),
+        [QVM_OP_STORE1] = &&QVM_CASE(STORE1), [QVM_OP_STORE2] = &&QVM_CASE(STORE2), [QVM_OP_STORE4] = &&QVM_CASE(STORE4),
+        [QVM_OP_ARG] = &&QVM_CASE(ARG), [QVM_OP_BLOCK_COPY] = &&QVM_CASE(BLOCK_COPY),
+        [QVM_OP_SEX8] = &&QVM_CASE(SEX8), [QVM_OP_SEX16] = &&QVM_CASE(SEX16),
+        [QVM_OP_NEGI] = &&QVM_CASE(NEGI), [QVM_OP_ADD] = &&QVM_CASE(ADD), [QVM_OP_SUB] = &&QVM_CASE(SUB),
+        [QVM_OP_DIVI] = &&QVM_CASE(DIVI), [QVM_OP_DIVU] = &&QVM_CASE(DIVU), [QVM_OP_MODI] = &&QVM_CASE(MODI), [QVM_OP_MODU] = &&QVM_CASE(MODU),
+        [QVM_OP_MULI] = &&QVM_CASE(MULI), [QVM_OP_MULU] = &&QVM_CASE(MULU),
+        [QVM_OP_BAND] = &&QVM_CASE(BAND), [QVM_OP_BOR] = &&QVM_CASE(BOR), [QVM_OP_BXOR] = &&QVM_CASE(BXOR), [QVM_OP_BCOM] = &&QVM_CASE(BCOM),
+        [QVM_OP_LSH] = &&QVM_CASE(LSH), [QVM_OP_RSHI] = &&QVM_CASE(RSHI), [QVM_OP_RSHU] = &&QVM_CASE(RSHU),
+        [QVM_OP_NEGF] = &&QVM_CASE(NEGF), [QVM_OP_ADDF] = &&QVM_CASE(ADDF), [QVM_OP_SUBF] = &&QVM_CASE(SUBF),
+        [QVM_OP_DIVF] = &&QVM_CASE(DIVF), [QVM_OP_MULF] = &&QVM_CASE(MULF),
+        [QVM_OP_CVIF] = &&QVM_CASE(CVIF), [QVM_OP_CVFI] = &&QVM_CASE(CVFI),
+        [QVM_OP_LOCAL_LOAD4] = &&QVM_CASE(LOCAL_LOAD4), [QVM_OP_LOCAL_LOAD4_CONST_ADD] = &&QVM_CASE(LOCAL_LOAD4_CONST_ADD),
+        [QVM_OP_LOCAL_CONST_STORE4] = &&QVM_CASE(LOCAL_CONST_STORE4), [QVM_OP_CONST_LOAD4] = &&QVM_CASE(CONST_LOAD4),
+        [QVM_OP_CONST_ADD] = &&QVM_CASE(CONST_ADD), [QVM_OP_CONST_CALL] = &&QVM_CASE(CONST_CALL),
+        [QVM_OP_CONST_CALL_DIRECT] = &&QVM_CASE(CONST_CALL_DIRECT),
+        [QVM_OP_CONST_EQ] = &&QVM_CASE(CONST_EQ), [QVM_OP_CONST_NE] = &&QVM_CASE(CONST_NE),
+        [QVM_OP_CONST_LTI] = &&QVM_CASE(CONST_LTI), [QVM_OP_CONST_LEI] = &&QVM_CASE(CONST_LEI),
+        [QVM_OP_CONST_GTI] = &&QVM_CASE(CONST_GTI), [QVM_OP_CONST_GEI] = &&QVM_CASE(CONST_GEI),
+    };
+#endif
+
+    // only fetching the handler table (called from qvm_load)
+    if (handlers) {
+#ifdef QVM_COMPUTED_GOTO
+        *handlers = qvm_handlers;
+#else
+        *handlers = NULL;
+#endif
+        return 0;
+    }
+
     if (!vm || !vm->memory) {
         log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_exec(%zu): Initialization error: given qvm is not loaded.\n", instruction);
         return 0;
     }
 
+    // a previous execution failed and this is a re-entrant call before the VM gets unloaded
+    if (vm->failed) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_exec(%zu): Initialization error: given qvm has failed.\n", instruction);
+        return 0;
+    }
+
     // make sure instruction is in range
     if (instruction >= vm->instructioncount) {
         log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_exec(%zu): Initialization error: given instruction id %zu is out of range [0, %zu).\n", instruction, instruction, vm->instructioncount);
@@ -310,6 +1323,22 @@ int qvm_exec_ex(qvm* vm, size_t instruction, int argc, int* argv) {
     // local copy of code segment pointer
     qvm_op* codesegment = vm->codesegment;
 
+#ifdef QVM_COMPUTED_GOTO
+    // local copy of pre-decoded handler addresses (parallel to codesegment)
+    const void** dispatch = vm->dispatch;
+#endif
+
+    // local copy of verifier results (parallel to codesegment)
+    const qvm_verifyinfo* verifyinfo = vm->verifyinfo;
+
+    // local copy of allowed jump targets (NULL if not checked)
+    const uint8_t* jumptargets = vm->jumptargets;
+
+#ifndef QVM_COMPUTED_GOTO
+    // local copy of fused opcodes (parallel to codesegment)
+    const uint8_t* fusedops = vm->fusedops;
+#endif
+
     // set up bitmasks for safety
     // code mask (masking qvmop_t indexes)
     size_t codemask = (vm->codeseglen / sizeof(qvm_op)) - 1;
@@ -317,8 +1346,8 @@ int qvm_exec_ex(qvm* vm, size_t instruction, int argc, int* argv) {
     // local copy of data segment pointer
     uint8_t* datasegment = vm->datasegment;
 
-    // data mask - disable if verify_data is off by using a mask with all bits 1
-    size_t datamask = vm->verify_data ? vm->dataseglen - 1 : (size_t)-1;
+    // local copy of data mask
+    size_t datamask = vm->datamask;
 
     // local "register" copy of stack pointer. this is purely for locality/speed.
     // it gets synced to qvm object before syscalls and restored after syscalls.
@@ -328,6 +1357,25 @@ int qvm_exec_ex(qvm* vm, size_t instruction, int argc, int* argv) {
     int* stacklow = vm->stacklow;
     int* stackhigh = vm->stackhigh;
 
+    // get the opstack segment for this execution: the first one, or the one after the execution that made the
+    // syscall this re-entrant execution came from. segments stay allocated until the VM is unloaded
+    qvm_opstack_segment* opstackseg = vm->opstackseg ? vm->opstackseg->next : vm->opstacks;
+    if (!opstackseg) {
+        opstackseg = (qvm_opstack_segment*)malloc(sizeof(qvm_opstack_segment));
+        if (!opstackseg) {
+            log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_exec(%zu): Initialization error: memory allocation failed for opstack segment\n", instruction);
+            return 0;
+        }
+        opstackseg->prev = vm->opstackseg;
+        opstackseg->next = NULL;
+        if (vm->opstackseg)
+            vm->opstackseg->next = opstackseg;
+        else
+            vm->opstacks = opstackseg;
+    }
+    opstackseg->opstack = NULL;
+    vm->opstackseg = opstackseg;
+
     // size of new stack frame, need to store RII, framesize, and vmMain args
     if (!argv)
         argc = 0;
@@ -367,81 +1415,133 @@ int qvm_exec_ex(qvm* vm, size_t instruction, int argc, int* argv) {
      */
 
     // opstack for math/comparison/temp/etc operations (instead of using registers)
-    // +2 for some extra space to "harmlessly" read 2 values (like QVM_OP_BLOCK_COPY) if opstack is empty (like at start)
-    int opstacklow[QVM_OPSTACK_SIZE + 2];
-    memset(opstacklow, 0, sizeof(opstacklow));
+    // this isn't cleared, except for the 2 extra values past the end that can be read if opstack is empty
+    int* opstacklow = opstackseg->data;
+    opstacklow[QVM_OPSTACK_SIZE] = 0;
+    opstacklow[QVM_OPSTACK_SIZE + 1] = 0;
     // opstack pointer (starts at end of block, grows down)
     int* opstack = opstacklow + QVM_OPSTACK_SIZE;
     // save upper bound of opstack for bounds checking
     int* opstackhigh = opstack;
 
-    // current op
-    qvm_opcode op;
-    // hardcoded param for op
+    // track re-entrant executions so a failure doesn't unload the VM out from under an outer execution
+    vm->execdepth++;
+
+#ifndef QVM_COMPUTED_GOTO
+    // current op (may be a fused op)
+    int op;
+#endif
+    // hardcoded param for op
     int param;
+    // target instruction index for QVM_OP_CALL
+    int jump_to;
+    // check stacks after every instruction. this is turned off while running a verified function that has enough
+    // opstack room (see qvm_verify), and turned back on at any call, return, or jump that leaves it
+    int checked = 1;
+
+    // profiler data, if profiling. this is checked at every function entry and exit
+    qvm_prof* prof = vm->prof && vm->prof->active ? vm->prof : NULL;
+    // profiler node to return to when this execution ends
+    int profnode = prof ? prof->node : 0;
+    // instructions run since the last function entry or exit (only counted while checking stacks, see QVM_VERIFIED)
+    size_t profcount = 0;
+    // flight recorder, if recording. this is checked at every call, return, jump, and syscall
+    qvm_trace* trace = vm->trace;
+    // time between outermost executions isn't spent in any function. for a re-entrant execution, the time since the
+    // syscall started is counted for the function that made it
+    if (prof && vm->execdepth == 1)
+        prof->lasttime = qvm_prof_time();
 
 #if defined(_DEBUG)
     struct timespec time_start;
     (void)timespec_get(&time_start, TIME_UTC);
 #endif
-    
-    // main instruction loop
-    do {
-        // verify program stack pointer is in program stack
-        // using > to allow starting at 1 past the end of block
-        if (programstack <= stacklow || programstack > stackhigh) {
-            ptrdiff_t stackusage = (uint8_t*)stackhigh - (uint8_t*)programstack;
-            log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: program stack overflow! Program stack size is currently %td, max is %zu.\n", instruction, opptr - codesegment, stackusage, vm->stacksize);
+
+    // run the translated native module if the VM has one (and isn't being profiled)
+    if (vm->aot && !prof) {
+        size_t errinstr = instruction;
+        if (!qvm_aot_exec(vm, instruction, &programstack, &opstack, &errinstr)) {
+            // point opptr just past the failed instruction, like the interpreter
+            opptr = codesegment + errinstr + 1;
             goto fail;
         }
-        // verify opstack pointer is in op stack
-        // using > to allow starting at 1 past the end of block
-        if (opstack <= opstacklow || opstack > opstackhigh) {
-            ptrdiff_t stackusage = (uint8_t*)opstackhigh - (uint8_t*)opstack;
-            log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: opstack overflow! Opstack size is currently %td, max is %d.\n", instruction, opptr - codesegment, stackusage, QVM_OPSTACK_SIZE);
+        goto done;
+    }
+
+    // run native code if the VM has been compiled (and isn't being profiled)
+    if (vm->jit && !prof) {
+        size_t errinstr = instruction;
+        if (!qvm_jit_exec(vm, instruction, &programstack, &opstack, opstacklow, opstackhigh, &errinstr)) {
+            // point opptr just past the failed instruction, like the interpreter
+            opptr = codesegment + errinstr + 1;
             goto fail;
         }
+        goto done;
+    }
+
+    // main instruction loop
+#ifdef QVM_COMPUTED_GOTO
+    // each handler dispatches the next instruction itself, so just jump into the first one
+    QVM_NEXT();
+#else
+    for (;;) {
+        if (checked) {
+            QVM_CHECK_STACKS();
+            profcount++;
+        }
 
-        // get the instruction's opcode and param
-        op = (qvm_opcode)opptr->op;
+        // get the instruction's (possibly fused) opcode and param
+        op = fusedops[opptr - codesegment];
         param = opptr->param;
 
         // throughout the interpreter loop, opptr points to the next instruction
         opptr++;
 
         switch (op) {
+#endif
         // miscellaneous opcodes
 
-        case QVM_OP_UNDEF:
+        QVM_CASE(UNDEF):
             // undefined - used as alignment padding at end of codesegment. treat as error
+#ifndef QVM_COMPUTED_GOTO
             // explicit fallthrough
         default:
             // anything else
-            log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: unhandled opcode %d\n", instruction, opptr - 1 - codesegment, op);
+#endif
+            log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: unhandled opcode %d\n", instruction, opptr - 1 - codesegment, opptr[-1].op);
             goto fail;
 
-        case QVM_OP_NOP:
+        QVM_CASE(NOP):
             // no op
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_BREAK:
+        QVM_CASE(BREAK):
             // break to debugger, dump qvm info
             vm->stackptr = programstack;
             qvm_dump(vm, opstack, opstackhigh, opptr - 1);
-            break;
+            QVM_NEXT();
 
         // functions
 
-        case QVM_OP_ENTER:
+        QVM_CASE(ENTER):
             // enter a function:
             // prepare new stack frame on program stack (size=param).
             // store param in programstack[1]. this gets verified to match in QVM_OP_LEAVE.
             QVM_STACKFRAME(param);
+            // always check the program stack here, since it is only checked at function boundaries while unchecked
+            if (programstack <= stacklow)
+                goto programstack_overflow;
             programstack[0] = 0; // leave blank. an QVM_OP_CALL within this function will place RII here
             programstack[1] = param;
-            break;
-
-        case QVM_OP_LEAVE:
+            if (prof)
+                qvm_prof_enter(prof, (int)(opptr - 1 - codesegment), &profcount);
+            if (trace)
+                qvm_trace_record(trace, QVM_TRACE_CALL, (int)(opptr - 1 - codesegment));
+            // run unchecked if this function was verified and the opstack has room for it
+            checked = !QVM_VERIFIED(opptr - 1 - codesegment);
+            QVM_NEXT();
+
+        QVM_CASE(LEAVE):
             // leave a function:
             // verify the value saved in programstack[1] matches param, then remove stack frame (size=param).
             // then, grab RII from top of previous stack frame and then jump to it
@@ -451,209 +1551,251 @@ int qvm_exec_ex(qvm* vm, size_t instruction, int argc, int* argv) {
             }
             // clean up stack frame
             QVM_STACKFRAME(-param);
+            if (programstack > stackhigh)
+                goto programstack_overflow;
+            if (prof)
+                qvm_prof_leave(prof, &profcount);
             // if RII from previous frame is our negative sentinel, signal end of instruction loop
             if (programstack[0] < 0)
-                opptr = NULL;
-            else
-                QVM_JUMP(programstack[0]);
-            break;
-
-        case QVM_OP_CALL: {
+                goto done;
+            if (trace)
+                qvm_trace_record(trace, QVM_TRACE_RETURN, programstack[0]);
+            QVM_JUMP(programstack[0]);
+            // the caller may not have been verified, or the callee may have left the opstack at a different depth
+            checked = !QVM_VERIFIED(opptr - codesegment);
+            QVM_NEXT();
+
+        QVM_CASE(CALL):
             // call a function:
             // address in opstack[0]
-            int jump_to = opstack[0];
+            jump_to = opstack[0];
             QVM_POP();
 
+        do_call:
+
             // negative address means an engine trap
             if (jump_to < 0) {
+                int ret;
+
+                if (trace)
+                    qvm_trace_syscall(vm, (int)(opptr - 1 - codesegment), -jump_to - 1, &programstack[2]);
+
+                // pure syscalls with a native implementation are handled without leaving the VM
+                if (vm->intrinsics && qvm_intrinsic_call(vm, -jump_to - 1, &programstack[2], &ret)) {
+                    QVM_PUSH(ret);
+                    QVM_NEXT();
+                }
+
                 // store local program stack pointer in qvm object for re-entrancy
                 vm->stackptr = programstack;
+                // store opstack pointer in segment so qvm_dump can show it if a re-entrant execution fails
+                opstackseg->opstack = opstack;
+
+#ifdef QVM_GUARDED_SUPPORTED
+                // faults in engine code are not caught as guard region faults
+                qvm_guard* guard = qvm_guard_suspend();
+#endif
 
                 // pass call to game-specific syscall handler which will adjust pointer arguments
                 // and then call the normal QMM syscall entry point so it can be routed to plugins
-                int ret = vm->syscall(datasegment, -jump_to - 1, &programstack[2]);
+                ret = vm->syscall(datasegment, -jump_to - 1, &programstack[2]);
+
+#ifdef QVM_GUARDED_SUPPORTED
+                qvm_guard_resume(guard);
+#endif
 
                 // program stack pointer in qvm object may have changed if re-entrant
                 programstack = vm->stackptr;
 
+                // a re-entrant execution failed, so this one can't continue either
+                if (vm->failed)
+                    goto fail;
+
                 // place return value on top of opstack like a VM function return value
                 QVM_PUSH(ret);
-                break;
+                QVM_NEXT();
             }
             // otherwise, normal VM function call
 
             // place RII in top slot of program stack
             programstack[0] = (int)(opptr - codesegment);
 
-            // jump to VM function at address
+            // jump to VM function at address. checks stay on until the callee's QVM_OP_ENTER
             QVM_JUMP(jump_to);
-            break;
-        }
+            checked = 1;
+            QVM_NEXT();
 
         // stack opcodes
 
-        case QVM_OP_PUSH:
+        QVM_CASE(PUSH):
             // pushes an unused value onto the opstack (mostly for unused return values)
             QVM_PUSH(0);
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_POP:
+        QVM_CASE(POP):
             // pops the top value off the opstack (mostly for unused return values)
             QVM_POP();
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_CONST:
+        QVM_CASE(CONST):
             // pushes a hardcoded value onto the opstack
             QVM_PUSH(param);
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_LOCAL:
+        QVM_CASE(LOCAL):
             // pushes a specified local variable address (relative to start of data segment) onto the opstack
             QVM_PUSH( (int)((uint8_t*)programstack + param - datasegment) );
-            break;
+            QVM_NEXT();
 
         // branching
 
-        case QVM_OP_JUMP:
+        QVM_CASE(JUMP):
+            // with a version 2 jump target table, only jump to known targets
+            if (jumptargets && !QVM_JUMPTARGET(jumptargets, (size_t)opstack[0] & codemask))
+                goto jump_target_invalid;
+            if (trace)
+                qvm_trace_record(trace, QVM_TRACE_JUMP, opstack[0]);
             // jump to address in opstack[0]
             QVM_JUMP(opstack[0]);
             QVM_POP();
-            break;
+            // the target is only known at runtime, so see if it can run unchecked
+            checked = !QVM_VERIFIED(opptr - codesegment);
+            QVM_NEXT();
 
-        case QVM_OP_EQ:
+        QVM_CASE(EQ):
             // if opstack[1] == opstack[0], goto address in param
             QVM_JUMP_SIF( == );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_NE:
+        QVM_CASE(NE):
             // if opstack[1] != opstack[0], goto address in param
             QVM_JUMP_SIF( != );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_LTI:
+        QVM_CASE(LTI):
             // if opstack[1] < opstack[0], goto address in param
             QVM_JUMP_SIF( < );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_LEI:
+        QVM_CASE(LEI):
             // if opstack[1] <= opstack[0], goto address in param
             QVM_JUMP_SIF( <= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_GTI:
+        QVM_CASE(GTI):
             // if opstack[1] > opstack[0], goto address in param
             QVM_JUMP_SIF( > );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_GEI:
+        QVM_CASE(GEI):
             // if opstack[1] >= opstack[0], goto address in param
             QVM_JUMP_SIF( >= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_LTU:
+        QVM_CASE(LTU):
             // if opstack[1] < opstack[0] (unsigned), goto address in param
             QVM_JUMP_UIF( < );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_LEU:
+        QVM_CASE(LEU):
             // if opstack[1] <= opstack[0] (unsigned), goto address in param
             QVM_JUMP_UIF( <= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_GTU:
+        QVM_CASE(GTU):
             // if opstack[1] > opstack[0] (unsigned), goto address in param
             QVM_JUMP_UIF( > );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_GEU:
+        QVM_CASE(GEU):
             // if opstack[1] >= opstack[0] (unsigned), goto address in param
             QVM_JUMP_UIF( >= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_EQF:
+        QVM_CASE(EQF):
             // if opstack[1] == opstack[0] (float), goto address in param
             QVM_JUMP_FIF( == );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_NEF:
+        QVM_CASE(NEF):
             // if opstack[1] != opstack[0] (float), goto address in param
             QVM_JUMP_FIF( != );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_LTF:
+        QVM_CASE(LTF):
             // if opstack[1] < opstack[0] (float), goto address in param
             QVM_JUMP_FIF( < );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_LEF:
+        QVM_CASE(LEF):
             // if opstack[1] <= opstack[0] (float), goto address in param
             QVM_JUMP_FIF( <= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_GTF:
+        QVM_CASE(GTF):
             // if opstack[1] > opstack[0] (float), goto address in param
             QVM_JUMP_FIF( > );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_GEF:
+        QVM_CASE(GEF):
             // if opstack[1] >= opstack[0] (float), goto address in param
             QVM_JUMP_FIF( >= );
-            break;
+            QVM_NEXT();
 
         // memory/pointer management
 
-        case QVM_OP_LOAD1: {
+        QVM_CASE(LOAD1): {
             // get 1-byte value at address stored in opstack[0] and store back in opstack[0]
             uint8_t* src = datasegment + (opstack[0] & datamask);
             opstack[0] = (int)*src;
-            break;
+            QVM_NEXT();
         }
 
-        case QVM_OP_LOAD2: {
+        QVM_CASE(LOAD2): {
             // get 2-byte value at address stored in opstack[0] and store back in opstack[0]
             uint16_t* src = (uint16_t*)(datasegment + (opstack[0] & datamask));
             opstack[0] = (int)*src;
-            break;
+            QVM_NEXT();
         }
 
-        case QVM_OP_LOAD4: {
+        QVM_CASE(LOAD4): {
             // get 4-byte value at address stored in opstack[0] and store back in opstack[0]
             int* src = (int*)(datasegment + (opstack[0] & datamask));
             opstack[0] = *src;
-            break;
+            QVM_NEXT();
         }
 
-        case QVM_OP_STORE1: {
+        QVM_CASE(STORE1): {
             // store 1-byte value from opstack[0] into address stored in opstack[1]
             uint8_t* dst = datasegment + (opstack[1] & datamask);
             *dst = (uint8_t)(opstack[0] & 0xFF);
             QVM_POPN(2);
-            break;
+            QVM_NEXT();
         }
 
-        case QVM_OP_STORE2: {
+        QVM_CASE(STORE2): {
             // store 2-byte value from opstack[0] into address stored in opstack[1] 
             uint16_t* dst = (uint16_t*)(datasegment + (opstack[1] & datamask));
             *dst = (uint16_t)(opstack[0] & 0xFFFF);
             QVM_POPN(2);
-            break;
+            QVM_NEXT();
         }
 
-        case QVM_OP_STORE4: {
+        QVM_CASE(STORE4): {
             // store 4-byte value from opstack[0] into address stored in opstack[1]
             int* dst = (int*)(datasegment + (opstack[1] & datamask));
             *dst = opstack[0];
             QVM_POPN(2);
-            break;
+            QVM_NEXT();
         }
 
-        case QVM_OP_ARG:
+        QVM_CASE(ARG):
             // set a function-call arg (offset = param) to the value on top of opstack
             *(int*)((uint8_t*)programstack + param) = opstack[0];
             QVM_POP();
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_BLOCK_COPY: {
+        QVM_CASE(BLOCK_COPY): {
             // copy mem from address in opstack[0] to address in opstack[1] for 'param' number of bytes
             int srci = (opstack[0] & datamask);
             int dsti = (opstack[1] & datamask);
@@ -662,171 +1804,276 @@ int qvm_exec_ex(qvm* vm, size_t instruction, int argc, int* argv) {
 
             // skip if src/dst are the same
             if (srci == dsti)
-                break;
+                QVM_NEXT();
 
             // make sure the src and dst ranges don't go out of memory bounds
             int count = param;
             count = ((srci + count) & datamask) - srci;
             count = ((dsti + count) & datamask) - dsti;
+            if (count <= 0)
+                QVM_NEXT();
 
             uint8_t* src = datasegment + srci;
             uint8_t* dst = datasegment + dsti;
 
             memcpy(dst, src, count);
 
-            break;
+            QVM_NEXT();
         }
 
         // sign extensions
 
-        case QVM_OP_SEX8:
+        QVM_CASE(SEX8):
             // 8-bit
             if (opstack[0] & 0x80)
                 opstack[0] |= 0xFFFFFF00;
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_SEX16:
+        QVM_CASE(SEX16):
             // 16-bit
             if (opstack[0] & 0x8000)
                 opstack[0] |= 0xFFFF0000;
-            break;
+            QVM_NEXT();
 
         // arithmetic/operators
 
-        case QVM_OP_NEGI:
+        QVM_CASE(NEGI):
             // negation
             QVM_SSOP( - );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_ADD:
+        QVM_CASE(ADD):
             // addition
             QVM_SOP( += );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_SUB:
+        QVM_CASE(SUB):
             // subtraction
             QVM_SOP( -= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_DIVI:
+        QVM_CASE(DIVI):
             // division
             if (opstack[0] == 0) {
-                log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: %s division by 0!\n", instruction, opptr - 1 - codesegment, qvm_opcodename[op]);
+                log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: %s division by 0!\n", instruction, opptr - 1 - codesegment, qvm_opcodename[opptr[-1].op]);
                 goto fail;
             }
             QVM_SOP( /= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_DIVU:
+        QVM_CASE(DIVU):
             // unsigned division
             if (opstack[0] == 0) {
-                log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: %s division by 0!\n", instruction, opptr - 1 - codesegment, qvm_opcodename[op]);
+                log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: %s division by 0!\n", instruction, opptr - 1 - codesegment, qvm_opcodename[opptr[-1].op]);
                 goto fail;
             }
             QVM_UOP( /= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_MODI:
+        QVM_CASE(MODI):
             // modulus
             if (opstack[0] == 0) {
-                log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: %s division by 0!\n", instruction, opptr - 1 - codesegment, qvm_opcodename[op]);
+                log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: %s division by 0!\n", instruction, opptr - 1 - codesegment, qvm_opcodename[opptr[-1].op]);
                 goto fail;
             }
             QVM_SOP( %= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_MODU:
+        QVM_CASE(MODU):
             // unsigned modulus
             if (opstack[0] == 0) {
-                log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: %s division by 0!\n", instruction, opptr - 1 - codesegment, qvm_opcodename[op]);
+                log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: %s division by 0!\n", instruction, opptr - 1 - codesegment, qvm_opcodename[opptr[-1].op]);
                 goto fail;
             }
             QVM_UOP( %= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_MULI:
+        QVM_CASE(MULI):
             // multiplication
             QVM_SOP( *= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_MULU:
+        QVM_CASE(MULU):
             // unsigned multiplication
             QVM_UOP( *= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_BAND:
+        QVM_CASE(BAND):
             // bitwise AND
             QVM_SOP( &= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_BOR:
+        QVM_CASE(BOR):
             // bitwise OR
             QVM_SOP( |= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_BXOR:
+        QVM_CASE(BXOR):
             // bitwise XOR
             QVM_SOP( ^= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_BCOM:
+        QVM_CASE(BCOM):
             // bitwise one's compliment
             QVM_SSOP( ~ );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_LSH:
+        QVM_CASE(LSH):
             // unsigned bitwise LEFTSHIFT
             QVM_UOP( <<= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_RSHI:
+        QVM_CASE(RSHI):
             // bitwise RIGHTSHIFT
             QVM_SOP( >>= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_RSHU:
+        QVM_CASE(RSHU):
             // unsigned bitwise RIGHTSHIFT
             QVM_UOP( >>= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_NEGF:
+        QVM_CASE(NEGF):
             // float negation
             QVM_SFOP( - );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_ADDF:
+        QVM_CASE(ADDF):
             // float addition
             QVM_FOP( += );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_SUBF:
+        QVM_CASE(SUBF):
             // float subtraction
             QVM_FOP( -= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_DIVF:
+        QVM_CASE(DIVF):
             // float division
             QVM_FOP( /= );
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_MULF:
+        QVM_CASE(MULF):
             // float multiplication
             QVM_FOP( *= );
-            break;
+            QVM_NEXT();
 
         // format conversion
 
-        case QVM_OP_CVIF:
+        QVM_CASE(CVIF):
             // convert opstack[0] int->float
             *(float*)&opstack[0] = (float)opstack[0];
-            break;
+            QVM_NEXT();
 
-        case QVM_OP_CVFI:
+        QVM_CASE(CVFI):
             // convert opstack[0] float->int
             opstack[0] = (int)*(float*)&opstack[0];
-            break;
+            QVM_NEXT();
+
+        // superinstructions (see qvm_fuse). param is the first instruction's param, opptr points to the second
+        // instruction, and each handler skips opptr past the rest of its sequence
+
+        QVM_CASE(LOCAL_LOAD4): {
+            // push 4-byte value of a local variable
+            int* src = (int*)(datasegment + ((int)((uint8_t*)programstack + param - datasegment) & datamask));
+            QVM_PUSH(*src);
+            opptr++;
+            QVM_NEXT();
+        }
+
+        QVM_CASE(LOCAL_LOAD4_CONST_ADD): {
+            // push 4-byte value of a local variable plus a hardcoded value
+            int* src = (int*)(datasegment + ((int)((uint8_t*)programstack + param - datasegment) & datamask));
+            QVM_PUSH(*src + opptr[1].param);
+            opptr += 3;
+            QVM_NEXT();
+        }
+
+        QVM_CASE(LOCAL_CONST_STORE4): {
+            // store a hardcoded 4-byte value into a local variable
+            int* dst = (int*)(datasegment + ((int)((uint8_t*)programstack + param - datasegment) & datamask));
+            *dst = opptr[0].param;
+            opptr += 2;
+            QVM_NEXT();
+        }
+
+        QVM_CASE(CONST_LOAD4): {
+            // push 4-byte value at a hardcoded address
+            int* src = (int*)(datasegment + (param & datamask));
+            QVM_PUSH(*src);
+            opptr++;
+            QVM_NEXT();
+        }
+
+        QVM_CASE(CONST_ADD):
+            // add a hardcoded value to opstack[0]
+            opstack[0] += param;
+            opptr++;
+            QVM_NEXT();
+
+        QVM_CASE(CONST_CALL):
+            // call a hardcoded function address without going through the opstack
+            jump_to = param;
+            opptr++;
+            goto do_call;
+
+        QVM_CASE(CONST_CALL_DIRECT):
+            // call a hardcoded VM function and do its QVM_OP_ENTER here. qvm_fuse made sure the target is a
+            // QVM_OP_ENTER and stored its frame size in the QVM_OP_CALL param, so nothing needs to be popped or masked.
+            // place RII (the instruction after the QVM_OP_CALL) in top slot of program stack
+            programstack[0] = (int)(opptr + 1 - codesegment);
+            jump_to = param;
+            param = opptr->param;
+            // prepare new stack frame, same as QVM_OP_ENTER
+            QVM_STACKFRAME(param);
+            if (programstack <= stacklow)
+                goto programstack_overflow;
+            programstack[0] = 0;
+            programstack[1] = param;
+            if (prof)
+                qvm_prof_enter(prof, jump_to, &profcount);
+            if (trace)
+                qvm_trace_record(trace, QVM_TRACE_CALL, jump_to);
+            // continue at the instruction after the callee's QVM_OP_ENTER
+            opptr = codesegment + jump_to + 1;
+            checked = !QVM_VERIFIED(jump_to);
+            QVM_NEXT();
+
+        QVM_CASE(CONST_EQ):
+            // if opstack[0] == param, goto address in next instruction's param
+            QVM_CONST_JUMP_SIF( == );
+            QVM_NEXT();
+
+        QVM_CASE(CONST_NE):
+            // if opstack[0] != param, goto address in next instruction's param
+            QVM_CONST_JUMP_SIF( != );
+            QVM_NEXT();
+
+        QVM_CASE(CONST_LTI):
+            // if opstack[0] < param, goto address in next instruction's param
+            QVM_CONST_JUMP_SIF( < );
+            QVM_NEXT();
+
+        QVM_CASE(CONST_LEI):
+            // if opstack[0] <= param, goto address in next instruction's param
+            QVM_CONST_JUMP_SIF( <= );
+            QVM_NEXT();
+
+        QVM_CASE(CONST_GTI):
+            // if opstack[0] > param, goto address in next instruction's param
+            QVM_CONST_JUMP_SIF( > );
+            QVM_NEXT();
+
+        QVM_CASE(CONST_GEI):
+            // if opstack[0] >= param, goto address in next instruction's param
+            QVM_CONST_JUMP_SIF( >= );
+            QVM_NEXT();
+#ifndef QVM_COMPUTED_GOTO
         } // switch (op)
-    } while (opptr);
+    } // main instruction loop
+#endif
+
+done:
 
 #if defined(_DEBUG)
     struct timespec time_end;
@@ -848,45 +2095,268 @@ int qvm_exec_ex(qvm* vm, size_t instruction, int argc, int* argv) {
     // save our local program stack pointer back into the qvm object
     vm->stackptr = programstack;
 
+    // return to the outer execution's opstack segment
+    vm->opstackseg = opstackseg->prev;
+    vm->execdepth--;
+
+    // return to the function that made the syscall, if this was a re-entrant execution
+    if (prof)
+        prof->node = profnode;
+
     // return value is stored on the top of the opstack (pushed just before QVM_OP_LEAVE)
     return opstack[0];
 
+programstack_overflow: {
+    ptrdiff_t stackusage = (uint8_t*)stackhigh - (uint8_t*)programstack;
+    log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: program stack overflow! Program stack size is currently %td, max is %zu.\n", instruction, opptr - codesegment, stackusage, vm->stacksize);
+    goto fail;
+}
+
+jump_target_invalid:
+    log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: jump target %d is not in the jump target table\n", instruction, opptr - 1 - codesegment, opstack[0]);
+    goto fail;
+
+opstack_overflow: {
+    ptrdiff_t stackusage = (uint8_t*)opstackhigh - (uint8_t*)opstack;
+    log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %td: opstack overflow! Opstack size is currently %td, max is %d.\n", instruction, opptr - codesegment, stackusage, QVM_OPSTACK_SIZE);
+    goto fail;
+}
+
 fail:
     // save our local program stack pointer back into the qvm object (for dump)
     vm->stackptr = programstack;
 
-    // generate dumps
-    qvm_dump(vm, opstack, opstackhigh, opptr - 1);
-    
-    // unload
-    qvm_unload(vm);
+    // return to the function that made the syscall, if this was a re-entrant execution
+    if (prof)
+        prof->node = profnode;
+
+    qvm_exec_fail(vm, opstackseg, opstack, opstackhigh, opptr - 1);
     return 0;
 }
 
 
+// Clean up after a failed execution
+static void qvm_exec_fail(qvm* vm, qvm_opstack_segment* opstackseg, int* opstack, int* opstackhigh, qvm_op* instruction) {
+    // generate dumps, unless this is an outer execution unwinding after a re-entrant execution failed
+    if (!vm->failed)
+        qvm_dump(vm, opstack, opstackhigh, instruction);
+    vm->failed = 1;
+
+    vm->opstackseg = opstackseg->prev;
+
+    // unload once the outermost execution has unwound, since outer executions are still using the VM
+    if (--vm->execdepth == 0)
+        qvm_unload(vm);
+}
+
+
+// The hunk allocator is a two-level segregated fit (TLSF) allocator. The hunk is split into QVM_HUNK_ALIGNMENT-byte
+// granules, and every block (free or allocated) is at least QVM_HUNK_MIN_BLOCK granules. Free blocks are kept in lists
+// by size class: the first level is the power of 2 of the size, and the second level splits that range into
+// QVM_HUNK_SL_COUNT linear steps. Bitmaps of non-empty lists let alloc find a free block that fits in constant time.
+// Block info is kept outside of VM memory (in struct qvm_hunk) so VM code can't corrupt it:
+// - tags[first granule] holds the block size in granules, plus QVM_HUNK_TAG_FREE if it is free
+// - tags[last granule] holds the first granule, plus QVM_HUNK_TAG_FOOT (so free can merge with the previous block)
+// - links[first granule] and links[first granule + 1] hold the next and previous blocks in a free block's list
+// All other tags are 0, so a pointer to the middle of a block is never mistaken for a block
+#define QVM_HUNK_SL_BITS                3
+#define QVM_HUNK_SL_COUNT               (1 << QVM_HUNK_SL_BITS)
+#define QVM_HUNK_FL_COUNT               30
+#define QVM_HUNK_MIN_BLOCK              2
+#define QVM_HUNK_TAG_FOOT               0x80000000u
+#define QVM_HUNK_TAG_FREE               0x40000000u
+#define QVM_HUNK_TAG_SIZE               0x3FFFFFFFu
+#define QVM_HUNK_NONE                   0xFFFFFFFFu
+
+struct qvm_hunk {
+    int base;                                               // Offset of first granule in data segment
+    uint32_t numgranules;                                   // Number of granules
+    uint32_t flbitmap;                                      // Bit set for each first level with a non-empty list
+    uint32_t slbitmap[QVM_HUNK_FL_COUNT];                   // Bit set for each non-empty list in a first level
+    uint32_t lists[QVM_HUNK_FL_COUNT][QVM_HUNK_SL_COUNT];   // First block in each free list (QVM_HUNK_NONE if empty)
+    size_t live;                                            // Granules in allocated blocks
+    size_t peak;                                            // Highest value of live
+    size_t allocs;                                          // Number of allocated blocks
+    uint32_t* tags;                                         // Block tags for each granule (see above)
+    uint32_t* links;                                        // Free list links for each granule (see above)
+};
+
+
+// Index of highest set bit (x must not be 0)
+static int qvm_hunk_fls(uint32_t x) {
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(x);
+#else
+    int i = 0;
+    while (x >>= 1)
+        i++;
+    return i;
+#endif
+}
+
+
+// Index of lowest set bit (x must not be 0)
+static int qvm_hunk_ffs(uint32_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    int i = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+
+// Get the free list for a block size (in granules)
+static void qvm_hunk_mapping(uint32_t size, int* fl, int* sl) {
+    if (size < QVM_HUNK_SL_COUNT) {
+        *fl = 0;
+        *sl = (int)size;
+    }
+    else {
+        int t = qvm_hunk_fls(size);
+        *sl = (int)(size >> (t - QVM_HUNK_SL_BITS)) - QVM_HUNK_SL_COUNT;
+        *fl = t - QVM_HUNK_SL_BITS + 1;
+    }
+}
+
+
+static void qvm_hunk_insert(struct qvm_hunk* hunk, uint32_t block, uint32_t size) {
+    int fl, sl;
+    qvm_hunk_mapping(size, &fl, &sl);
+    uint32_t next = hunk->lists[fl][sl];
+
+    hunk->tags[block] = size | QVM_HUNK_TAG_FREE;
+    hunk->tags[block + size - 1] = block | QVM_HUNK_TAG_FOOT;
+    hunk->links[block] = next;
+    hunk->links[block + 1] = QVM_HUNK_NONE;
+    if (next != QVM_HUNK_NONE)
+        hunk->links[next + 1] = block;
+    hunk->lists[fl][sl] = block;
+    hunk->flbitmap |= 1u << fl;
+    hunk->slbitmap[fl] |= 1u << sl;
+}
+
+
+static void qvm_hunk_remove(struct qvm_hunk* hunk, uint32_t block, uint32_t size) {
+    int fl, sl;
+    qvm_hunk_mapping(size, &fl, &sl);
+    uint32_t next = hunk->links[block];
+    uint32_t prev = hunk->links[block + 1];
+
+    if (next != QVM_HUNK_NONE)
+        hunk->links[next + 1] = prev;
+    if (prev != QVM_HUNK_NONE) {
+        hunk->links[prev] = next;
+    }
+    else {
+        hunk->lists[fl][sl] = next;
+        if (next == QVM_HUNK_NONE) {
+            hunk->slbitmap[fl] &= ~(1u << sl);
+            if (!hunk->slbitmap[fl])
+                hunk->flbitmap &= ~(1u << fl);
+        }
+    }
+}
+
+
+// Set up the hunk allocator with the whole hunk as a single free block
+static int qvm_hunk_init(qvm* vm) {
+    int base = (vm->hunklow + (QVM_HUNK_ALIGNMENT - 1)) & ~(QVM_HUNK_ALIGNMENT - 1);
+    uint32_t numgranules = vm->hunkhigh > base ? (uint32_t)(vm->hunkhigh - base) / QVM_HUNK_ALIGNMENT : 0;
+
+    // state and per-granule info are one allocation, so snapshots can copy it in one go
+    size_t size = sizeof(struct qvm_hunk) + 2 * (size_t)numgranules * sizeof(uint32_t);
+    struct qvm_hunk* hunk = (struct qvm_hunk*)malloc(size);
+    if (!hunk) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_load(): Memory allocation failed for hunk allocator size %zu\n", size);
+        return 0;
+    }
+    memset(hunk, 0, size);
+    memset(hunk->lists, 0xFF, sizeof(hunk->lists));
+    hunk->base = base;
+    hunk->numgranules = numgranules;
+    hunk->tags = (uint32_t*)(hunk + 1);
+    hunk->links = hunk->tags + numgranules;
+
+    if (numgranules >= QVM_HUNK_MIN_BLOCK)
+        qvm_hunk_insert(hunk, 0, numgranules);
+
+    vm->hunk = hunk;
+    return 1;
+}
+
+
 int qvm_hunk_alloc(qvm* vm, size_t size, const void* init) {
     if (!vm->memory) {
         log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_hunk_alloc(): VM not loaded\n");
         return 0;
     }
 
+    struct qvm_hunk* hunk = vm->hunk;
+
+    // size in granules
+    size_t want = (size + (QVM_HUNK_ALIGNMENT - 1)) / QVM_HUNK_ALIGNMENT;
+    if (want < QVM_HUNK_MIN_BLOCK)
+        want = QVM_HUNK_MIN_BLOCK;
+
+    // round up to the start of the next size class, so any block in the list found below is big enough
+    uint32_t search = 0;
+    if (size && want <= hunk->numgranules) {
+        search = (uint32_t)want;
+        if (search >= QVM_HUNK_SL_COUNT)
+            search += (1u << (qvm_hunk_fls(search) - QVM_HUNK_SL_BITS)) - 1;
+    }
+
+    // find the first non-empty list at or above the size class
+    uint32_t block = QVM_HUNK_NONE;
+    if (search) {
+        int fl, sl;
+        qvm_hunk_mapping(search, &fl, &sl);
+        uint32_t slmap = fl < QVM_HUNK_FL_COUNT ? hunk->slbitmap[fl] & (~0u << sl) : 0;
+        if (!slmap) {
+            uint32_t flmap = fl + 1 < QVM_HUNK_FL_COUNT ? hunk->flbitmap & (~0u << (fl + 1)) : 0;
+            if (flmap) {
+                fl = qvm_hunk_ffs(flmap);
+                slmap = hunk->slbitmap[fl];
+            }
+        }
+        if (slmap)
+            block = hunk->lists[fl][qvm_hunk_ffs(slmap)];
+    }
+
     // size 0 or not enough space left for size
-    if (!size || (vm->hunkptr - (int)size < vm->hunklow)){
+    if (block == QVM_HUNK_NONE) {
         log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_hunk_alloc(): Hunk allocation failed for size %zu\n", size);
         return 0;
     }
 
-    // round up size for alignment
-    size_t realsize = (size + (QVM_HUNK_ALIGNMENT-1)) & ~(QVM_HUNK_ALIGNMENT - 1);
+    uint32_t blocksize = hunk->tags[block] & QVM_HUNK_TAG_SIZE;
+    qvm_hunk_remove(hunk, block, blocksize);
+
+    // give the rest back if it's big enough to be a block of its own
+    if (blocksize - want >= QVM_HUNK_MIN_BLOCK) {
+        qvm_hunk_insert(hunk, block + (uint32_t)want, blocksize - (uint32_t)want);
+        blocksize = (uint32_t)want;
+    }
+    hunk->tags[block] = blocksize;
+    hunk->tags[block + blocksize - 1] = block | QVM_HUNK_TAG_FOOT;
 
-    vm->hunkptr -= (int)realsize;
+    hunk->live += blocksize;
+    if (hunk->live > hunk->peak)
+        hunk->peak = hunk->live;
+    hunk->allocs++;
 
+    int ptr = hunk->base + (int)block * QVM_HUNK_ALIGNMENT;
     if (init)
-        memcpy(vm->datasegment + vm->hunkptr, init, size);
+        memcpy(vm->datasegment + ptr, init, size);
     else
-        memset(vm->datasegment + vm->hunkptr, 0, size);
+        memset(vm->datasegment + ptr, 0, size);
 
-    return vm->hunkptr;
+    return ptr;
 }
 
 
@@ -902,17 +2372,20 @@ void qvm_hunk_free(qvm* vm, int ptr, size_t size, void* out) {
         return;
     }
 
-    // if this ptr was not the most recently-allocated block, fail
-    if (ptr != vm->hunkptr) {
-        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_hunk_free(): Trying to free out of order: got %d, expected %d\n", ptr, vm->hunkptr);
+    struct qvm_hunk* hunk = vm->hunk;
+
+    // make sure this is the start of an allocated block
+    uint32_t block = (uint32_t)(ptr - hunk->base) / QVM_HUNK_ALIGNMENT;
+    uint32_t tag = block < hunk->numgranules ? hunk->tags[block] : 0;
+    uint32_t blocksize = tag & QVM_HUNK_TAG_SIZE;
+    if (ptr < hunk->base || (ptr - hunk->base) % QVM_HUNK_ALIGNMENT || (tag & (QVM_HUNK_TAG_FOOT | QVM_HUNK_TAG_FREE)) ||
+        blocksize < QVM_HUNK_MIN_BLOCK || blocksize > hunk->numgranules - block) {
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_hunk_free(): Trying to free invalid pointer %d\n", ptr);
         return;
     }
 
-    // round up size for alignment
-    size_t realsize = (size + (QVM_HUNK_ALIGNMENT - 1)) & ~(QVM_HUNK_ALIGNMENT - 1);
-
     // size too big or 0
-    if (!size || (ptr + (int)realsize > vm->hunkhigh)) {
+    if (!size || size > (size_t)blocksize * QVM_HUNK_ALIGNMENT) {
         log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_hunk_free(): Trying to free invalid size %zu\n", size);
         return;
     }
@@ -921,7 +2394,453 @@ void qvm_hunk_free(qvm* vm, int ptr, size_t size, void* out) {
     if (out)
         memcpy(out, vm->datasegment + ptr, size);
 
-    vm->hunkptr += (int)realsize;
+    hunk->live -= blocksize;
+    hunk->allocs--;
+
+    // merge with the next block if it's free
+    uint32_t next = block + blocksize;
+    if (next < hunk->numgranules && (hunk->tags[next] & QVM_HUNK_TAG_FREE)) {
+        uint32_t nextsize = hunk->tags[next] & QVM_HUNK_TAG_SIZE;
+        qvm_hunk_remove(hunk, next, nextsize);
+        hunk->tags[block + blocksize - 1] = 0;
+        hunk->tags[next] = 0;
+        blocksize += nextsize;
+    }
+
+    // merge with the previous block if it's free
+    if (block) {
+        uint32_t prev = hunk->tags[block - 1] & QVM_HUNK_TAG_SIZE;
+        if ((hunk->tags[block - 1] & QVM_HUNK_TAG_FOOT) && (hunk->tags[prev] & QVM_HUNK_TAG_FREE)) {
+            uint32_t prevsize = hunk->tags[prev] & QVM_HUNK_TAG_SIZE;
+            qvm_hunk_remove(hunk, prev, prevsize);
+            hunk->tags[block - 1] = 0;
+            hunk->tags[block] = 0;
+            block = prev;
+            blocksize += prevsize;
+        }
+    }
+
+    qvm_hunk_insert(hunk, block, blocksize);
+}
+
+
+void qvm_hunk_stats(const qvm* vm, qvm_hunkstats* stats) {
+    memset(stats, 0, sizeof(*stats));
+    if (!vm || !vm->memory || !vm->hunk)
+        return;
+
+    const struct qvm_hunk* hunk = vm->hunk;
+    stats->size = (size_t)hunk->numgranules * QVM_HUNK_ALIGNMENT;
+    stats->live = hunk->live * QVM_HUNK_ALIGNMENT;
+    stats->peak = hunk->peak * QVM_HUNK_ALIGNMENT;
+    stats->allocs = hunk->allocs;
+    // granules too small to split off stay in their allocated block, so everything else is free
+    stats->free = stats->size - stats->live;
+
+    // the largest free block is in the highest non-empty list
+    if (hunk->flbitmap) {
+        int fl = qvm_hunk_fls(hunk->flbitmap);
+        int sl = qvm_hunk_fls(hunk->slbitmap[fl]);
+        for (uint32_t block = hunk->lists[fl][sl]; block != QVM_HUNK_NONE; block = hunk->links[block]) {
+            size_t blocksize = (size_t)(hunk->tags[block] & QVM_HUNK_TAG_SIZE) * QVM_HUNK_ALIGNMENT;
+            if (blocksize > stats->largestfree)
+                stats->largestfree = blocksize;
+        }
+    }
+    stats->fragmented = stats->free - stats->largestfree;
+}
+
+
+int qvm_snapshot(qvm* vm, qvm_snap* snap) {
+    if (!snap)
+        return 0;
+
+    snap->memory = NULL;
+    snap->fd = -1;
+    snap->memorysize = 0;
+    snap->hunk = NULL;
+
+    if (!vm || !vm->memory) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_snapshot(): Given qvm is not loaded.\n");
+        return 0;
+    }
+    if (vm->execdepth) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_snapshot(): Cannot take a snapshot while the qvm is running.\n");
+        return 0;
+    }
+
+    // copy hunk allocator state
+    size_t hunksize = sizeof(struct qvm_hunk) + 2 * (size_t)vm->hunk->numgranules * sizeof(uint32_t);
+    snap->hunk = (struct qvm_hunk*)malloc(hunksize);
+    if (!snap->hunk) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_snapshot(): Memory allocation failed for size %zu\n", hunksize);
+        return 0;
+    }
+    memcpy(snap->hunk, vm->hunk, hunksize);
+
+    snap->memorysize = vm->memorysize;
+    snap->stackptr = (uint8_t*)vm->stackptr - vm->datasegment;
+
+#ifdef QVM_SNAPSHOT_COW
+    if (vm->allocator->flags & QVM_ALLOC_MAPPED) {
+        size_t pagesize = (size_t)sysconf(_SC_PAGESIZE);
+        size_t len = (vm->memorysize + pagesize - 1) & ~(pagesize - 1);
+
+        // copy VM memory into a new memfd through a temporary shared mapping
+        int fd = memfd_create("qvm_snapshot", MFD_CLOEXEC);
+        if (fd != -1 && ftruncate(fd, (off_t)len) == 0) {
+            uint8_t* copy = (uint8_t*)mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (copy != (uint8_t*)MAP_FAILED) {
+                memcpy(copy, vm->memory, vm->memorysize);
+                munmap(copy, len);
+                // map it privately over VM memory, so the VM shares pages with the snapshot until it writes to them
+                if (mmap(vm->memory, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) != MAP_FAILED) {
+                    snap->fd = fd;
+                    return 1;
+                }
+                log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_snapshot(): Unable to map snapshot over qvm memory (%s), using a plain copy\n", strerror(errno));
+            }
+        }
+        if (fd != -1)
+            close(fd);
+        // fall back to a plain copy
+    }
+#endif
+
+    snap->memory = (uint8_t*)malloc(vm->memorysize);
+    if (!snap->memory) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_snapshot(): Memory allocation failed for size %zu\n", vm->memorysize);
+        qvm_snapshot_free(snap);
+        return 0;
+    }
+    memcpy(snap->memory, vm->memory, vm->memorysize);
+
+    return 1;
+}
+
+
+int qvm_restore(qvm* vm, const qvm_snap* snap) {
+    if (!vm || !vm->memory) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_restore(): Given qvm is not loaded.\n");
+        return 0;
+    }
+    if (vm->execdepth) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_restore(): Cannot restore a snapshot while the qvm is running.\n");
+        return 0;
+    }
+    if (!snap || (!snap->memory && snap->fd == -1) || !snap->hunk || snap->memorysize != vm->memorysize ||
+        snap->hunk->numgranules != vm->hunk->numgranules) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_restore(): Snapshot does not match qvm memory size %zu\n", vm->memorysize);
+        return 0;
+    }
+
+    if (snap->memory) {
+        memcpy(vm->memory, snap->memory, vm->memorysize);
+    }
+#ifdef QVM_SNAPSHOT_COW
+    else {
+        size_t pagesize = (size_t)sysconf(_SC_PAGESIZE);
+        size_t len = (vm->memorysize + pagesize - 1) & ~(pagesize - 1);
+
+        // map the snapshot privately over VM memory again, which drops every page the VM wrote to since
+        int mapped = 0;
+        if (vm->allocator->flags & QVM_ALLOC_MAPPED) {
+            mapped = mmap(vm->memory, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, snap->fd, 0) != MAP_FAILED;
+            if (!mapped)
+                log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_restore(): Unable to map snapshot over qvm memory (%s), copying it instead\n", strerror(errno));
+        }
+
+        // otherwise read it back in
+        for (size_t done = 0; !mapped && done < vm->memorysize; ) {
+            ssize_t n = pread(snap->fd, vm->memory + done, vm->memorysize - done, (off_t)done);
+            if (n <= 0) {
+                log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_restore(): Unable to read snapshot memory\n");
+                return 0;
+            }
+            done += (size_t)n;
+        }
+    }
+#endif
+
+    vm->stackptr = (int*)(vm->datasegment + snap->stackptr);
+    // the hunk state's per-granule pointers point into its own allocation, so fix them up after copying
+    memcpy(vm->hunk, snap->hunk, sizeof(struct qvm_hunk) + 2 * (size_t)snap->hunk->numgranules * sizeof(uint32_t));
+    vm->hunk->tags = (uint32_t*)(vm->hunk + 1);
+    vm->hunk->links = vm->hunk->tags + vm->hunk->numgranules;
+
+    return 1;
+}
+
+
+void qvm_snapshot_free(qvm_snap* snap) {
+    if (!snap)
+        return;
+
+    free(snap->memory);
+    snap->memory = NULL;
+    free(snap->hunk);
+    snap->hunk = NULL;
+#ifdef QVM_SNAPSHOT_COW
+    // the VM's private mapping (if any) keeps its own reference to the memfd
+    if (snap->fd != -1)
+        close(snap->fd);
+#endif
+    snap->fd = -1;
+    snap->memorysize = 0;
+}
+
+
+int qvm_set_intrinsic(qvm* vm, int cmd, qvm_intrinsic intrinsic) {
+    if (!vm || !vm->memory || cmd < 0 || intrinsic < QVM_INTRINSIC_NONE || intrinsic >= QVM_INTRINSIC_NUM)
+        return 0;
+
+    // grow table to fit this syscall number
+    if ((size_t)cmd >= vm->numintrinsics) {
+        if (intrinsic == QVM_INTRINSIC_NONE)
+            return 1;
+        size_t numintrinsics = (size_t)cmd + 1;
+        uint8_t* intrinsics = (uint8_t*)realloc(vm->intrinsics, numintrinsics);
+        if (!intrinsics) {
+            log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_set_intrinsic(): Unable to allocate intrinsic table\n");
+            return 0;
+        }
+        memset(intrinsics + vm->numintrinsics, QVM_INTRINSIC_NONE, numintrinsics - vm->numintrinsics);
+        vm->intrinsics = intrinsics;
+        vm->numintrinsics = numintrinsics;
+    }
+
+    vm->intrinsics[cmd] = (uint8_t)intrinsic;
+    return 1;
+}
+
+
+// Pi (M_PI isn't standard C)
+#define QVM_PI 3.14159265358979323846
+
+
+// Get a real pointer to "size" bytes at data segment offset "ptr", or NULL if any of them are outside the data segment
+static void* qvm_intrinsic_ptr(qvm* vm, int ptr, size_t size) {
+    if ((unsigned int)ptr > vm->dataseglen || size > vm->dataseglen - (unsigned int)ptr)
+        return NULL;
+    return vm->datasegment + (unsigned int)ptr;
+}
+
+
+// Get a float arg from its bits
+static float qvm_intrinsic_float(int arg) {
+    float f;
+    memcpy(&f, &arg, sizeof(f));
+    return f;
+}
+
+
+// Get the bits of a float return value
+static int qvm_intrinsic_ret(float f) {
+    int ret;
+    memcpy(&ret, &f, sizeof(ret));
+    return ret;
+}
+
+
+int qvm_intrinsic_call(qvm* vm, int cmd, int* args, int* ret) {
+    if (cmd < 0 || (size_t)cmd >= vm->numintrinsics)
+        return 0;
+
+    // these match the engine implementations (float args are promoted to double for libm, like the engine does)
+    switch (vm->intrinsics[cmd]) {
+    case QVM_INTRINSIC_MEMSET: {
+        void* dest = args[2] >= 0 ? qvm_intrinsic_ptr(vm, args[0], (size_t)args[2]) : NULL;
+        if (!dest)
+            return 0;
+        memset(dest, args[1], (size_t)args[2]);
+        *ret = args[0];
+        return 1;
+    }
+    case QVM_INTRINSIC_MEMCPY: {
+        void* dest = args[2] >= 0 ? qvm_intrinsic_ptr(vm, args[0], (size_t)args[2]) : NULL;
+        void* src = args[2] >= 0 ? qvm_intrinsic_ptr(vm, args[1], (size_t)args[2]) : NULL;
+        if (!dest || !src)
+            return 0;
+        // the QVM can't tell the difference, and overlapping blocks are harmless
+        memmove(dest, src, (size_t)args[2]);
+        *ret = args[0];
+        return 1;
+    }
+    case QVM_INTRINSIC_STRNCPY: {
+        char* dest = args[2] >= 0 ? (char*)qvm_intrinsic_ptr(vm, args[0], (size_t)args[2]) : NULL;
+        char* src = (char*)qvm_intrinsic_ptr(vm, args[1], 0);
+        if (!dest || !src)
+            return 0;
+        // source string must end (or reach count) inside the data segment
+        size_t avail = vm->dataseglen - (unsigned int)args[1];
+        size_t count = (size_t)args[2];
+        size_t len = strnlen(src, count < avail ? count : avail);
+        if (len == avail && len < count)
+            return 0;
+        memmove(dest, src, len);
+        memset(dest + len, 0, count - len);
+        *ret = args[0];
+        return 1;
+    }
+    case QVM_INTRINSIC_SIN:
+        *ret = qvm_intrinsic_ret((float)sin(qvm_intrinsic_float(args[0])));
+        return 1;
+    case QVM_INTRINSIC_COS:
+        *ret = qvm_intrinsic_ret((float)cos(qvm_intrinsic_float(args[0])));
+        return 1;
+    case QVM_INTRINSIC_SQRT:
+        *ret = qvm_intrinsic_ret((float)sqrt(qvm_intrinsic_float(args[0])));
+        return 1;
+    case QVM_INTRINSIC_ATAN2:
+        *ret = qvm_intrinsic_ret((float)atan2(qvm_intrinsic_float(args[0]), qvm_intrinsic_float(args[1])));
+        return 1;
+    case QVM_INTRINSIC_FLOOR:
+        *ret = qvm_intrinsic_ret((float)floor(qvm_intrinsic_float(args[0])));
+        return 1;
+    case QVM_INTRINSIC_CEIL:
+        *ret = qvm_intrinsic_ret((float)ceil(qvm_intrinsic_float(args[0])));
+        return 1;
+    case QVM_INTRINSIC_MATRIXMULTIPLY: {
+        float (*in1)[3] = (float (*)[3])qvm_intrinsic_ptr(vm, args[0], sizeof(float[3][3]));
+        float (*in2)[3] = (float (*)[3])qvm_intrinsic_ptr(vm, args[1], sizeof(float[3][3]));
+        float (*out)[3] = (float (*)[3])qvm_intrinsic_ptr(vm, args[2], sizeof(float[3][3]));
+        if (!args[0] || !args[1] || !args[2] || !in1 || !in2 || !out)
+            return 0;
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++)
+                out[i][j] = in1[i][0] * in2[0][j] + in1[i][1] * in2[1][j] + in1[i][2] * in2[2][j];
+        }
+        *ret = 0;
+        return 1;
+    }
+    case QVM_INTRINSIC_ANGLEVECTORS: {
+        // output vectors are optional (NULL)
+        float* angles = (float*)qvm_intrinsic_ptr(vm, args[0], sizeof(float[3]));
+        float* forward = args[1] ? (float*)qvm_intrinsic_ptr(vm, args[1], sizeof(float[3])) : NULL;
+        float* right = args[2] ? (float*)qvm_intrinsic_ptr(vm, args[2], sizeof(float[3])) : NULL;
+        float* up = args[3] ? (float*)qvm_intrinsic_ptr(vm, args[3], sizeof(float[3])) : NULL;
+        if (!args[0] || !angles || (args[1] && !forward) || (args[2] && !right) || (args[3] && !up))
+            return 0;
+        // angles are pitch, yaw, roll in degrees
+        float angle = (float)(angles[0] * (QVM_PI * 2 / 360));
+        float sp = (float)sin(angle), cp = (float)cos(angle);
+        angle = (float)(angles[1] * (QVM_PI * 2 / 360));
+        float sy = (float)sin(angle), cy = (float)cos(angle);
+        angle = (float)(angles[2] * (QVM_PI * 2 / 360));
+        float sr = (float)sin(angle), cr = (float)cos(angle);
+        if (forward) {
+            forward[0] = cp * cy;
+            forward[1] = cp * sy;
+            forward[2] = -sp;
+        }
+        if (right) {
+            right[0] = (-1 * sr * sp * cy + -1 * cr * -sy);
+            right[1] = (-1 * sr * sp * sy + -1 * cr * cy);
+            right[2] = -1 * sr * cp;
+        }
+        if (up) {
+            up[0] = (cr * sp * cy + -sr * -sy);
+            up[1] = (cr * sp * sy + -sr * cy);
+            up[2] = cr * cp;
+        }
+        *ret = 0;
+        return 1;
+    }
+    default:
+        return 0;
+    }
+}
+
+
+int qvm_trace_start(qvm* vm, size_t entries) {
+    if (!vm || !vm->memory) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_trace_start(): Given qvm is not loaded.\n");
+        return 0;
+    }
+
+    if (vm->execdepth) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_trace_start(): Cannot start recording while the qvm is running.\n");
+        return 0;
+    }
+
+    qvm_trace_stop(vm);
+
+    size_t count = entries ? entries : 1;
+    QVM_NEXT_POW_2(count);
+
+    qvm_trace* trace = (qvm_trace*)malloc(sizeof(qvm_trace));
+    if (!trace) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_trace_start(): Memory allocation failed for flight recorder\n");
+        return 0;
+    }
+    trace->entries = (qvm_trace_entry*)calloc(count, sizeof(qvm_trace_entry));
+    if (!trace->entries) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_trace_start(): Memory allocation failed for flight recorder entries size %zu\n", count * sizeof(qvm_trace_entry));
+        free(trace);
+        return 0;
+    }
+    trace->mask = count - 1;
+    trace->count = 0;
+
+    vm->trace = trace;
+    return 1;
+}
+
+
+void qvm_trace_stop(qvm* vm) {
+    if (!vm || !vm->trace)
+        return;
+
+    free(vm->trace->entries);
+    free(vm->trace);
+    vm->trace = NULL;
+}
+
+
+// Add a call, return, or jump to the flight recorder
+static void qvm_trace_record(qvm_trace* trace, int type, int instruction) {
+    qvm_trace_entry* entry = &trace->entries[trace->count++ & trace->mask];
+    entry->type = type;
+    entry->instruction = instruction;
+    entry->cmd = 0;
+    memset(entry->args, 0, sizeof(entry->args));
+}
+
+
+void qvm_trace_syscall(qvm* vm, int instruction, int cmd, const int* args) {
+    qvm_trace* trace = vm->trace;
+    if (!trace)
+        return;
+
+    qvm_trace_entry* entry = &trace->entries[trace->count++ & trace->mask];
+    entry->type = QVM_TRACE_SYSCALL;
+    entry->instruction = instruction;
+    entry->cmd = cmd;
+    // the outermost frame can be smaller than the saved arguments, so don't read past the top of the program stack
+    for (int i = 0; i < QVM_TRACE_ARGS; i++)
+        entry->args[i] = args + i < vm->stackhigh ? args[i] : 0;
+}
+
+
+int qvm_set_dumpdir(qvm* vm, const char* dir) {
+    if (!vm || !vm->memory) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_set_dumpdir(): Given qvm is not loaded.\n");
+        return 0;
+    }
+
+    char* copy = NULL;
+    if (dir && *dir) {
+        size_t len = strlen(dir) + 1;
+        copy = (char*)malloc(len);
+        if (!copy) {
+            log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_set_dumpdir(): Memory allocation failed for crash dump directory\n");
+            return 0;
+        }
+        memcpy(copy, dir, len);
+    }
+    free(vm->dumpdir);
+    vm->dumpdir = copy;
+    return 1;
 }
 
 
@@ -929,91 +2848,159 @@ void qvm_dump(qvm* vm, int* opstack, int* opstackhigh, qvm_op* instruction) {
     if (!vm->memory)
         return;
 
-    // dump code segment to file
-    FILE* fp = fopen("qvm_dump_code.bin", "w");
-    fwrite(vm->codesegment, 1, vm->codeseglen, fp);
-    fclose(fp);
-    
-    // dump data segment to file
-    fp = fopen("qvm_dump_data.bin", "w");
-    fwrite(vm->datasegment, 1, vm->dataseglen, fp);
-    fclose(fp);
-
-    // dump annotated info to file
-    fp = fopen("qvm_dump.txt", "w");
-    fputs("VM state:\n-----\n", fp);
-
-    // op stack
-    int* opstackptr = opstack;
-    fputs("Opstack (hex): ", fp);
-    while (opstackptr < opstackhigh) {
-        fprintf(fp, "%08x ", *opstackptr);
-        opstackptr++;
-    }
-    opstackptr = opstack;
-    fputs("\nOpstack (dec): ", fp);
-    while (opstackptr < opstackhigh) {
-        fprintf(fp, "%d ", *opstackptr);
-        opstackptr++;
-    }
-    fputs("\n\n", fp);
-
-    // IP
-    fprintf(fp, "Instruction pointer offset: %td (%08tx)\nInstruction: %s %d\n\n", instruction - vm->codesegment, instruction - vm->codesegment, qvm_opcodename[instruction->op], instruction->param);
-    
-    // program stack
-    fputs("Stack:\n-----\n", fp);
-    int* stackptr = vm->stackptr;
-    while (stackptr < vm->stackhigh) {
-        fprintf(fp, "0x%08x (%d) (RII)\n", stackptr[0], stackptr[0]);
-        fprintf(fp, "0x%08x (%d) (Framesize)\n", stackptr[1], stackptr[1]);
-        for (int i = 2; i < stackptr[1] / 4; i++)
-            fprintf(fp, "0x%08x (%d)\n", stackptr[i], stackptr[i]);
-        stackptr += (stackptr[1] / 4);
-        fputs("-----\n", fp);
-        fflush(fp);
-    }
-    fputs("\n", fp);
-
-    // data segment
-    fputs("Data segment:\n-----\n", fp);
-    uint8_t* p = vm->datasegment;
-    while (p < vm->datasegment + vm->dataseglen) {
-        // print offset
-        fprintf(fp, "%04tX ", p - vm->datasegment);
-
-        // print hex values
-        for (int b = 0; b < 32; b++) {
-            // halfway through the row, print a gap
-            if (b == 16)
-                fputs("   ", fp);
-            // if this row runs out of data before the end, print empty spaces
-            if (p + b >= vm->datasegment + vm->dataseglen)
-                fputs("   ", fp);
-            else
-                fprintf(fp, " %02X", p[b]);
-        }
+    qvm_dump_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = QVM_DUMP_MAGIC;
+    header.version = QVM_DUMP_VERSION;
+    header.headersize = sizeof(header);
+    header.vmmagic = vm->magic;
+    header.time = (int64_t)time(NULL);
+    header.instruction = instruction ? (int32_t)(instruction - vm->codesegment) : -1;
+    header.instructioncount = (uint32_t)vm->instructioncount;
+    header.codeseglen = (uint32_t)vm->codeseglen;
+    header.dataseglen = (uint32_t)vm->dataseglen;
+    header.stackptr = (uint32_t)((uint8_t*)vm->stackptr - vm->datasegment);
+    header.stackhigh = (uint32_t)((uint8_t*)vm->stackhigh - vm->datasegment);
+    header.opstackcount = opstack < opstackhigh ? (uint32_t)(opstackhigh - opstack) : 0;
+
+    // op stacks of outer executions that are waiting on a syscall which started a re-entrant execution
+    qvm_opstack_segment* outer = vm->opstackseg ? vm->opstackseg->prev : NULL;
+    for (qvm_opstack_segment* seg = outer; seg; seg = seg->prev) {
+        if (seg->opstack)
+            header.outercount++;
+    }
 
-        fputs("    ", fp);
+    // flight recorder entries, which wrap around the end of the ring buffer once it fills up
+    qvm_trace* trace = vm->trace;
+    size_t tracefirst = 0;
+    if (trace) {
+        header.tracetotal = trace->count;
+        header.tracecount = trace->count > trace->mask ? (uint32_t)(trace->mask + 1) : (uint32_t)trace->count;
+        tracefirst = (size_t)((trace->count - header.tracecount) & trace->mask);
+    }
 
-        // print characters
-        for (int b = 0; b < 32; b++) {
-            // halfway through the row, print a gap
-            if (b == 16)
-                fprintf(fp, " ");
-            // if this row runs out of data before the end, print empty spaces
-            if (p + b >= vm->datasegment + vm->dataseglen)
-                fprintf(fp, " ");
-            else
-                fprintf(fp, "%c", (p[b] < 32 || p[b] >= 127) ? '.' : *(char*)&p[b]);
+    // one chunk each for the header, opstack, 2 for each outer opstack, 2 for the flight recorder, and both segments
+    size_t numchunks = 7 + 2 * (size_t)header.outercount;
+    qvm_dump_chunk* chunks = (qvm_dump_chunk*)malloc(numchunks * sizeof(qvm_dump_chunk) + header.outercount * sizeof(uint32_t));
+    if (!chunks) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_dump(): Memory allocation failed for crash dump\n");
+        return;
+    }
+    uint32_t* outercounts = (uint32_t*)(chunks + numchunks);
+
+    size_t n = 0;
+    n = qvm_dump_add(chunks, n, &header, sizeof(header));
+    n = qvm_dump_add(chunks, n, opstack, header.opstackcount * sizeof(int));
+    uint32_t o = 0;
+    for (qvm_opstack_segment* seg = outer; seg; seg = seg->prev) {
+        if (!seg->opstack)
+            continue;
+        outercounts[o] = (uint32_t)(seg->data + QVM_OPSTACK_SIZE - seg->opstack);
+        n = qvm_dump_add(chunks, n, &outercounts[o], sizeof(uint32_t));
+        n = qvm_dump_add(chunks, n, seg->opstack, outercounts[o] * sizeof(int));
+        o++;
+    }
+    if (trace) {
+        size_t tail = trace->mask + 1 - tracefirst;
+        if (tail > header.tracecount)
+            tail = header.tracecount;
+        n = qvm_dump_add(chunks, n, trace->entries + tracefirst, tail * sizeof(qvm_trace_entry));
+        n = qvm_dump_add(chunks, n, trace->entries, (header.tracecount - tail) * sizeof(qvm_trace_entry));
+    }
+    n = qvm_dump_add(chunks, n, vm->codesegment, vm->codeseglen);
+    n = qvm_dump_add(chunks, n, vm->datasegment, vm->dataseglen);
+
+    // name the dump by time so an earlier one is never overwritten
+    char stamp[32];
+    time_t now = (time_t)header.time;
+    struct tm tm;
+#ifndef _WIN32
+    localtime_r(&now, &tm);
+#else
+    localtime_s(&tm, &now);
+#endif
+    strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm);
+
+    const char* dir = vm->dumpdir ? vm->dumpdir : ".";
+    char path[1024];
+    int ok = 0;
+    for (int i = 0; i < 100 && !ok; i++) {
+        int len;
+        if (i)
+            len = snprintf(path, sizeof(path), "%s/qvm_dump_%s_%d.qvmd", dir, stamp, i);
+        else
+            len = snprintf(path, sizeof(path), "%s/qvm_dump_%s.qvmd", dir, stamp);
+        if (len < 0 || (size_t)len >= sizeof(path)) {
+            ok = -1;
+            break;
         }
+        ok = qvm_dump_write(path, chunks, n);
+    }
+    free(chunks);
+
+    if (ok > 0)
+        log_c(QMM_LOG_NOTICE, QMM_LOGGING_TAG, "qvm_dump(): Wrote crash dump to \"%s\"\n", path);
+    else
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_dump(): Unable to write crash dump\n");
+}
+
+
+// Set chunks[n] to the given memory and return the next chunk index
+static size_t qvm_dump_add(qvm_dump_chunk* chunks, size_t n, const void* base, size_t len) {
+    chunks[n].iov_base = (void*)base;
+    chunks[n].iov_len = len;
+    return n + 1;
+}
 
-        fprintf(fp, "\n");
-        fflush(fp);
 
-        p += 32;
+// Write chunks to a new file at path. Returns 1 if written, 0 if the file already exists, or -1 on any other error (a
+// partly written file is deleted)
+static int qvm_dump_write(const char* path, qvm_dump_chunk* chunks, size_t numchunks) {
+#ifndef _WIN32
+    int fd = open(path, O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (fd < 0)
+        return errno == EEXIST ? 0 : -1;
+
+    // writev can stop short (mostly for very large segments), so pick up where it left off
+    while (numchunks) {
+        ssize_t written = writev(fd, chunks, numchunks > IOV_MAX ? IOV_MAX : (int)numchunks);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            close(fd);
+            unlink(path);
+            return -1;
+        }
+        while (numchunks && (size_t)written >= chunks->iov_len) {
+            written -= (ssize_t)chunks->iov_len;
+            chunks++;
+            numchunks--;
+        }
+        if (numchunks) {
+            chunks->iov_base = (uint8_t*)chunks->iov_base + written;
+            chunks->iov_len -= (size_t)written;
+        }
+    }
+    if (close(fd) < 0) {
+        unlink(path);
+        return -1;
     }
-    fclose(fp);
+    return 1;
+#else
+    // "x" fails if the file exists
+    FILE* fp = fopen(path, "wbx");
+    if (!fp)
+        return errno == EEXIST ? 0 : -1;
+
+    int ok = 1;
+    for (size_t i = 0; i < numchunks && ok; i++)
+        ok = fwrite(chunks[i].iov_base, 1, chunks[i].iov_len, fp) == chunks[i].iov_len;
+    if (fclose(fp) != 0 || !ok) {
+        remove(path);
+        return -1;
+    }
+    return 1;
+#endif
 }
 
 
@@ -1094,5 +3081,369 @@ static void qvm_free_default(void* ptr, ptrdiff_t size, void* ctx) {
 }
 
 
+int qvm_prof_start(qvm* vm) {
+    if (!vm || !vm->memory) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_prof_start(): Given qvm is not loaded.\n");
+        return 0;
+    }
+
+    // a running execution could be using the existing nodes
+    if (vm->execdepth) {
+        log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_prof_start(): Cannot start profiling while the qvm is running.\n");
+        return 0;
+    }
+
+    if (!vm->prof) {
+        vm->prof = (qvm_prof*)malloc(sizeof(qvm_prof));
+        if (!vm->prof) {
+            log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_prof_start(): Memory allocation failed for profiler\n");
+            return 0;
+        }
+        memset(vm->prof, 0, sizeof(qvm_prof));
+    }
+    qvm_prof* prof = vm->prof;
+
+    // room for a node per function, which will usually be enough for all the call stacks in a typical mod
+    if (!prof->nodes) {
+        size_t maxnodes = 1024;
+        prof->nodes = (qvm_prof_node*)malloc(maxnodes * sizeof(qvm_prof_node));
+        if (!prof->nodes) {
+            log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_prof_start(): Memory allocation failed for profiler nodes\n");
+            return 0;
+        }
+        prof->maxnodes = maxnodes;
+    }
+
+    // root node, outside of any VM function
+    qvm_prof_node* root = &prof->nodes[0];
+    root->func = -1;
+    root->parent = -1;
+    root->child = -1;
+    root->sibling = -1;
+    root->calls = 0;
+    root->instructions = 0;
+    root->time = 0;
+
+    prof->numnodes = 1;
+    prof->node = 0;
+    prof->lasttime = qvm_prof_time();
+    prof->active = 1;
+    return 1;
+}
+
+
+void qvm_prof_stop(qvm* vm) {
+    if (vm && vm->prof)
+        vm->prof->active = 0;
+}
+
+
+// Current time in nanoseconds
+static uint64_t qvm_prof_time(void) {
+    struct timespec ts;
+    (void)timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+
+// Count the time and instructions since the last function entry or exit for the running function. Nothing is counted
+// for the root node, since that is only setup before the first QVM_OP_ENTER of an outermost execution
+static void qvm_prof_charge(qvm_prof* prof, size_t* instructions) {
+    uint64_t now = qvm_prof_time();
+    if (prof->node) {
+        qvm_prof_node* node = &prof->nodes[prof->node];
+        node->time += now - prof->lasttime;
+        node->instructions += *instructions;
+    }
+    prof->lasttime = now;
+    *instructions = 0;
+}
+
+
+// Called from QVM_OP_ENTER: find (or add) the node for the given function called from the running function
+static void qvm_prof_enter(qvm_prof* prof, int func, size_t* instructions) {
+    if (!prof->active)
+        return;
+
+    // the QVM_OP_ENTER itself was already counted, but belongs to the called function
+    if (*instructions)
+        (*instructions)--;
+    qvm_prof_charge(prof, instructions);
+    *instructions = 1;
+
+    int parent = prof->node;
+    int node = prof->nodes[parent].child;
+    while (node != -1 && prof->nodes[node].func != func)
+        node = prof->nodes[node].sibling;
+
+    if (node == -1) {
+        if (prof->numnodes == prof->maxnodes) {
+            size_t maxnodes = prof->maxnodes * 2;
+            qvm_prof_node* nodes = (qvm_prof_node*)realloc(prof->nodes, maxnodes * sizeof(qvm_prof_node));
+            if (!nodes) {
+                // stop profiling, since function exits would no longer line up with the nodes
+                log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_prof_enter(): Memory allocation failed for profiler nodes, stopping profiler\n");
+                prof->active = 0;
+                return;
+            }
+            prof->nodes = nodes;
+            prof->maxnodes = maxnodes;
+        }
+
+        node = (int)prof->numnodes++;
+        qvm_prof_node* n = &prof->nodes[node];
+        n->func = func;
+        n->parent = parent;
+        n->child = -1;
+        n->sibling = prof->nodes[parent].child;
+        n->calls = 0;
+        n->instructions = 0;
+        n->time = 0;
+        prof->nodes[parent].child = node;
+    }
+
+    prof->nodes[node].calls++;
+    prof->node = node;
+}
+
+
+// Called from QVM_OP_LEAVE: return to the calling function's node
+static void qvm_prof_leave(qvm_prof* prof, size_t* instructions) {
+    if (!prof->active)
+        return;
+
+    qvm_prof_charge(prof, instructions);
+
+    if (prof->nodes[prof->node].parent != -1)
+        prof->node = prof->nodes[prof->node].parent;
+}
+
+
 // Default VM allocator (uses malloc/free)
-qvm_alloc qvm_allocator_default = { qvm_alloc_default, qvm_free_default, NULL };
+qvm_alloc qvm_allocator_default = { qvm_alloc_default, qvm_free_default, NULL, 0 };
+
+
+#ifdef QVM_SNAPSHOT_COW
+static void* qvm_alloc_mapped(ptrdiff_t size, void* ctx) {
+    (void)ctx;
+    size_t pagesize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t len = ((size_t)size + pagesize - 1) & ~(pagesize - 1);
+    void* ptr = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return ptr != MAP_FAILED ? ptr : NULL;
+}
+
+
+static void qvm_free_mapped(void* ptr, ptrdiff_t size, void* ctx) {
+    (void)ctx;
+    size_t pagesize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t len = ((size_t)size + pagesize - 1) & ~(pagesize - 1);
+    munmap(ptr, len);
+}
+
+
+// Mapped VM allocator (uses mmap, see QVM_ALLOC_MAPPED)
+qvm_alloc qvm_allocator_mapped = { qvm_alloc_mapped, qvm_free_mapped, NULL, QVM_ALLOC_MAPPED };
+#endif
+
+
+#ifdef QVM_HUGEPAGE_SUPPORTED
+static void* qvm_alloc_hugepage(ptrdiff_t size, void* ctx) {
+    (void)ctx;
+    size_t len = ((size_t)size + QVM_HUGEPAGE_SIZE - 1) & ~(size_t)(QVM_HUGEPAGE_SIZE - 1);
+
+#ifdef MAP_HUGETLB
+    // explicit huge pages, only available if the admin reserved some (vm.nr_hugepages)
+    void* ptr = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED)
+        return ptr;
+#endif
+
+    // transparent huge pages need a huge page aligned range, so map an extra huge page and trim the ends
+    uint8_t* base = (uint8_t*)mmap(NULL, len + QVM_HUGEPAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == (uint8_t*)MAP_FAILED)
+        return NULL;
+    uint8_t* aligned = (uint8_t*)(((uintptr_t)base + QVM_HUGEPAGE_SIZE - 1) & ~(uintptr_t)(QVM_HUGEPAGE_SIZE - 1));
+    if (aligned > base)
+        munmap(base, (size_t)(aligned - base));
+    if (base + QVM_HUGEPAGE_SIZE > aligned)
+        munmap(aligned + len, (size_t)(base + QVM_HUGEPAGE_SIZE - aligned));
+
+#ifdef MADV_HUGEPAGE
+    // only a hint: if THP is disabled, memory just stays in normal pages
+    madvise(aligned, len, MADV_HUGEPAGE);
+#endif
+    return aligned;
+}
+
+
+static void qvm_free_hugepage(void* ptr, ptrdiff_t size, void* ctx) {
+    (void)ctx;
+    size_t len = ((size_t)size + QVM_HUGEPAGE_SIZE - 1) & ~(size_t)(QVM_HUGEPAGE_SIZE - 1);
+    munmap(ptr, len);
+}
+
+
+// Huge page VM allocator (uses mmap with MAP_HUGETLB or MADV_HUGEPAGE, see QVM_ALLOC_HUGEPAGE)
+qvm_alloc qvm_allocator_hugepage = { qvm_alloc_hugepage, qvm_free_hugepage, NULL, QVM_ALLOC_HUGEPAGE };
+#endif
+
+
+size_t qvm_hugepage_bytes(const qvm* vm) {
+    if (!vm || !vm->memory)
+        return 0;
+
+#ifdef QVM_HUGEPAGE_SUPPORTED
+    FILE* f = fopen("/proc/self/smaps", "r");
+    if (!f)
+        return 0;
+
+    // find the mapping that holds VM memory, then its page size and transparent huge page count
+    uintptr_t addr = (uintptr_t)vm->memory;
+    size_t mapsize = 0;
+    size_t pagesize = 0;
+    size_t hugebytes = 0;
+    int found = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        unsigned long long start, end, kb;
+        if (sscanf(line, "%llx-%llx ", &start, &end) == 2 && strchr(line, '-') < strchr(line, ' ')) {
+            // a new mapping starts, so stop if the VM's mapping was already read
+            if (found)
+                break;
+            found = addr >= start && addr < end;
+            mapsize = (size_t)(end - start);
+        }
+        else if (found && sscanf(line, "KernelPageSize: %llu kB", &kb) == 1) {
+            pagesize = (size_t)kb * 1024;
+        }
+        else if (found && sscanf(line, "AnonHugePages: %llu kB", &kb) == 1) {
+            hugebytes = (size_t)kb * 1024;
+        }
+    }
+    fclose(f);
+
+    // the whole mapping is in huge pages if it came from hugetlbfs
+    if (pagesize >= QVM_HUGEPAGE_SIZE)
+        hugebytes = mapsize;
+    // the mapping can be merged with neighboring ones
+    return hugebytes < vm->memorysize ? hugebytes : vm->memorysize;
+#else
+    return 0;
+#endif
+}
+
+
+#ifdef QVM_GUARDED_SUPPORTED
+// Innermost guard on this thread (NULL if VM code isn't running)
+static _Thread_local qvm_guard* qvm_guard_current = NULL;
+// Previous SIGSEGV action, for faults that aren't in a guard region
+static struct sigaction qvm_guard_oldaction;
+static int qvm_guard_installed = 0;
+
+
+static void qvm_guard_handler(int sig, siginfo_t* info, void* context) {
+    qvm_guard* guard = qvm_guard_current;
+    uintptr_t addr = (uintptr_t)info->si_addr;
+
+    // fault in the guard regions of the running VM
+    if (guard) {
+        uintptr_t low = (uintptr_t)guard->vm->datasegment - QVM_GUARD_SIZE;
+        uintptr_t high = (uintptr_t)guard->vm->datasegment + guard->vm->dataseglen + QVM_GUARD_SIZE;
+        if (addr >= low && addr < high) {
+            guard->faultaddr = info->si_addr;
+#if defined(__linux__) && defined(__x86_64__)
+            guard->faultpc = (void*)((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP];
+#else
+            guard->faultpc = NULL;
+#endif
+            qvm_guard_current = guard->prev;
+            siglongjmp(guard->env, 1);
+        }
+    }
+
+    // anything else goes to the previous handler
+    if (qvm_guard_oldaction.sa_flags & SA_SIGINFO) {
+        qvm_guard_oldaction.sa_sigaction(sig, info, context);
+    }
+    else if (qvm_guard_oldaction.sa_handler == SIG_DFL || qvm_guard_oldaction.sa_handler == SIG_IGN) {
+        // restore the previous action and return, so the faulting instruction runs again and faults with it
+        sigaction(SIGSEGV, &qvm_guard_oldaction, NULL);
+        qvm_guard_installed = 0;
+    }
+    else {
+        qvm_guard_oldaction.sa_handler(sig);
+    }
+}
+
+
+void qvm_guard_push(qvm_guard* guard, const qvm* vm) {
+    guard->vm = vm;
+    guard->faultaddr = NULL;
+    guard->faultpc = NULL;
+    guard->prev = qvm_guard_current;
+    qvm_guard_current = guard;
+}
+
+
+void qvm_guard_pop(qvm_guard* guard) {
+    if (qvm_guard_current == guard)
+        qvm_guard_current = guard->prev;
+}
+
+
+qvm_guard* qvm_guard_suspend(void) {
+    qvm_guard* guard = qvm_guard_current;
+    qvm_guard_current = NULL;
+    return guard;
+}
+
+
+void qvm_guard_resume(qvm_guard* guard) {
+    qvm_guard_current = guard;
+}
+
+
+static void* qvm_alloc_guarded(ptrdiff_t size, void* ctx) {
+    (void)ctx;
+
+    // install the fault handler. this is done here instead of at startup so it goes in after any engine handler
+    if (!qvm_guard_installed) {
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = qvm_guard_handler;
+        sigemptyset(&action.sa_mask);
+        // SIGSEGV isn't blocked in the handler, so siglongjmp doesn't need to restore the signal mask
+        action.sa_flags = SA_SIGINFO | SA_NODEFER;
+        if (sigaction(SIGSEGV, &action, &qvm_guard_oldaction) != 0) {
+            log_c(QMM_LOG_ERROR, QMM_LOGGING_TAG, "qvm_alloc_guarded(): Unable to install fault handler\n");
+            return NULL;
+        }
+        qvm_guard_installed = 1;
+    }
+
+    // reserve the guard regions and the allocation together, then make the allocation accessible
+    size_t pagesize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t len = ((size_t)size + pagesize - 1) & ~(pagesize - 1);
+    uint8_t* base = (uint8_t*)mmap(NULL, len + 2 * QVM_GUARD_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == (uint8_t*)MAP_FAILED)
+        return NULL;
+    if (mprotect(base + QVM_GUARD_SIZE, len, PROT_READ | PROT_WRITE) != 0) {
+        munmap(base, len + 2 * QVM_GUARD_SIZE);
+        return NULL;
+    }
+
+    return base + QVM_GUARD_SIZE;
+}
+
+
+static void qvm_free_guarded(void* ptr, ptrdiff_t size, void* ctx) {
+    (void)ctx;
+    size_t pagesize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t len = ((size_t)size + pagesize - 1) & ~(pagesize - 1);
+    munmap((uint8_t*)ptr - QVM_GUARD_SIZE, len + 2 * QVM_GUARD_SIZE);
+}
+
+
+// Guarded VM allocator (uses mmap with guard regions, see QVM_ALLOC_GUARDED)
+qvm_alloc qvm_allocator_guarded = { qvm_alloc_guarded, qvm_free_guarded, NULL, QVM_ALLOC_GUARDED | QVM_ALLOC_MAPPED };
+#endif
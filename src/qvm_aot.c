@@ -0,0 +1,622 @@
+/*
+QMM2 - Q3 MultiMod 2
+Copyright 2025-2026
+https://github.com/thecybermind/qmm2/
+3-clause BSD license: https://opensource.org/license/bsd-3-clause
+
+Created By:
+    Kevin Masterson < k.m.masterson@gmail.com >
+
+*/
+
+#define QMM_LOGGING
+
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdint.h>     // intptr_t and uint8_t
+#include <stdio.h>      // fopen, fprintf, and snprintf
+#include <stdlib.h>     // malloc, free, and system
+#include <string.h>     // memcpy and memset
+#include "qvm.h"
+#include "qvm_aot.h"
+
+#ifdef QMM_LOGGING
+void log_c(int severity, const char* tag, const char* fmt, ...);
+enum { QMM_LOG_TRACE, QMM_LOG_DEBUG, QMM_LOG_INFO, QMM_LOG_NOTICE, QMM_LOG_WARNING, QMM_LOG_ERROR, QMM_LOG_FATAL };
+#define QMM_LOGGING_TAG "QMM"
+#else
+#define log_c(...) /* */
+#endif
+
+#ifdef QVM_AOT_SUPPORTED
+
+#include <dlfcn.h>      // dlopen, dlsym, and dlclose
+#include <setjmp.h>     // setjmp and longjmp
+#include <unistd.h>     // access and unlink
+
+/* Translated code overview
+ *
+ * Each QVM function (a QVM_OP_ENTER up to the next one) becomes a C function "f<index>" that returns the QVM function's
+ * return value. Only functions that passed load-time verification (see qvm_verify) can be translated, since the known
+ * opstack depth at each instruction lets opstack slot n become a C local "s<n>", which the compiler can keep in a
+ * register. The program stack is the real one in the data segment, with frames built exactly like the interpreter
+ * (including the RII slot) so qvm_dump output and syscall arguments are the same.
+ *
+ * Conditional branches and constant jumps become gotos. Constant calls become direct C calls, and other calls go
+ * through qvm_aot_call(), which finds the function by instruction index or makes a syscall. An indirect QVM_OP_JUMP
+ * (like a switch jump table) goes through a switch over every instruction in the function that starts with an empty
+ * opstack.
+ *
+ * Translated code calls back into QMM through function pointers in a qvm_aot_ctx for syscalls, block copies, and
+ * errors. The error callback longjmps back to qvm_aot_exec.
+ */
+
+// Runtime error kinds reported by translated code
+enum {
+    QVM_AOT_ERR_NONE,
+    QVM_AOT_ERR_UNDEF,          // invalid instruction, jump target, or call target
+    QVM_AOT_ERR_PROGRAMSTACK,   // program stack overflow
+    QVM_AOT_ERR_LEAVE,          // QVM_OP_LEAVE param does not match stack frame size
+    QVM_AOT_ERR_DIV0,           // division by 0
+    QVM_AOT_ERR_CALLDEPTH,      // too many nested calls
+    QVM_AOT_ERR_NESTED,         // a re-entrant execution (from a syscall) failed
+};
+
+// Context passed to translated code for a single execution. This must match the definition in qvm_aot_prelude
+struct qvm_aot_ctx {
+    uint8_t* datasegment;       // VM data segment
+    int* programstack;          // Program stack pointer of the calling function, set before each call
+    int* stacklow;              // Lowest address of program stack
+    int calldepth;              // Number of nested calls remaining before QVM_AOT_ERR_CALLDEPTH
+    int (*syscall)(struct qvm_aot_ctx* ctx, int cmd, int* programstack);
+    void (*blockcopy)(struct qvm_aot_ctx* ctx, int dst, int src, int count);
+    void (*error)(struct qvm_aot_ctx* ctx, int kind, int instruction, int* programstack);
+};
+
+// State for a single execution, only used on this side
+typedef struct {
+    struct qvm_aot_ctx ctx;     // Context passed to translated code (must be first)
+    qvm* vm;                    // VM being run
+    jmp_buf env;                // Where the error callback jumps to
+    int errinstr;               // Failing instruction index (-1 if unknown)
+    int* errprogramstack;       // Program stack pointer at the error
+} qvm_aot_run;
+
+// Native module state
+struct qvm_aot {
+    void* handle;               // dlopen handle
+    int (*call)(struct qvm_aot_ctx* ctx, int target, int instruction); // qvm_aot_call() from the module
+    char path[1024];            // Module path
+};
+
+// Start of every translated C file
+static const char* qvm_aot_prelude =
+    "#include <stdint.h>\n"
+    "#include <string.h>\n"
+    "\n"
+    "struct qvm_aot_ctx {\n"
+    "    uint8_t* datasegment;\n"
+    "    int* programstack;\n"
+    "    int* stacklow;\n"
+    "    int calldepth;\n"
+    "    int (*syscall)(struct qvm_aot_ctx* ctx, int cmd, int* programstack);\n"
+    "    void (*blockcopy)(struct qvm_aot_ctx* ctx, int dst, int src, int count);\n"
+    "    void (*error)(struct qvm_aot_ctx* ctx, int kind, int instruction, int* programstack);\n"
+    "};\n"
+    "\n"
+    "static inline float F(int i) { float f; memcpy(&f, &i, 4); return f; }\n"
+    "static inline int I(float f) { int i; memcpy(&i, &f, 4); return i; }\n"
+    "static inline int L2(const uint8_t* p) { uint16_t v; memcpy(&v, p, 2); return v; }\n"
+    "static inline int L4(const uint8_t* p) { int v; memcpy(&v, p, 4); return v; }\n"
+    "static inline void S2(uint8_t* p, int v) { uint16_t x = (uint16_t)v; memcpy(p, &x, 2); }\n"
+    "static inline void S4(uint8_t* p, int v) { memcpy(p, &v, 4); }\n"
+    "#define ERR(k, i) c->error(c, k, i, ps)\n"
+    "\n"
+    "int qvm_aot_call(struct qvm_aot_ctx* c, int t, int i);\n";
+
+
+// Hash the QVM file and anything else baked into the translated code (FNV-1a)
+static uint64_t aot_key(const qvm* vm, const uint8_t* filemem, size_t filesize) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < filesize; i++)
+        hash = (hash ^ filemem[i]) * 0x100000001B3ull;
+
+    uint64_t extra[2] = { (uint64_t)vm->datamask, QVM_AOT_VERSION };
+    const uint8_t* p = (const uint8_t*)extra;
+    for (size_t i = 0; i < sizeof(extra); i++)
+        hash = (hash ^ p[i]) * 0x100000001B3ull;
+    return hash;
+}
+
+
+// Is instruction i the 2nd half of a QVM_OP_CONST + op pair in the same function?
+#define AOT_AFTER_CONST(i) ((i) > start && codesegment[(i) - 1].op == QVM_OP_CONST)
+
+// Can an indirect QVM_OP_JUMP go to instruction i? Any instruction with an empty opstack, unless a version 2 jump target
+// table says otherwise
+#define AOT_DISPATCH_TARGET(i) (verifyinfo[i].depth == 0 && (!vm->jumptargets || QVM_JUMPTARGET(vm->jumptargets, i)))
+
+
+// Translate a single function [start, end) into C
+static int aot_translate_func(qvm* vm, FILE* fp, size_t start, size_t end, uint8_t* label) {
+    qvm_op* codesegment = vm->codesegment;
+    const qvm_verifyinfo* verifyinfo = vm->verifyinfo;
+    size_t count = vm->instructioncount;
+    // jump targets are masked like the interpreter
+    size_t codemask = (vm->codeseglen / sizeof(qvm_op)) - 1;
+
+    if (verifyinfo[start].depth < 0) {
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_aot_load(): Function at %zu did not pass verification\n", start);
+        return 0;
+    }
+
+    // labels for constant branch and jump targets
+    for (size_t i = start; i < end; i++) {
+        qvm_op* op = &codesegment[i];
+        if (op->op >= QVM_OP_EQ && op->op <= QVM_OP_GEF && (size_t)op->param >= start && (size_t)op->param < end)
+            label[op->param] = 1;
+        if (op->op == QVM_OP_JUMP && AOT_AFTER_CONST(i) && ((size_t)codesegment[i - 1].param & codemask) >= start && ((size_t)codesegment[i - 1].param & codemask) < end)
+            label[(size_t)codesegment[i - 1].param & codemask] = 1;
+    }
+
+    // a jump needs the dispatch switch if its target isn't a constant known to be on the opstack
+    int hasdispatch = 0;
+    for (size_t i = start; i < end; i++) {
+        if (codesegment[i].op == QVM_OP_JUMP && (!AOT_AFTER_CONST(i) || label[i]))
+            hasdispatch = 1;
+    }
+    if (hasdispatch) {
+        for (size_t i = start; i < end; i++) {
+            if (AOT_DISPATCH_TARGET(i))
+                label[i] = 1;
+        }
+    }
+
+    // the verifier stores how far past its depth each instruction can push, which from the QVM_OP_ENTER is the max
+    int maxdepth = verifyinfo[start].room + 1;
+    int param = codesegment[start].param;
+
+    fprintf(fp, "\nstatic int f%zu(struct qvm_aot_ctx* c) {\n", start);
+    fputs("    uint8_t* const ds = c->datasegment;\n", fp);
+    fprintf(fp, "    int* ps = (int*)((uint8_t*)c->programstack - %d);\n", param);
+    for (int n = 0; n < maxdepth; n++)
+        fprintf(fp, "    int s%d = 0;\n", n);
+    if (hasdispatch)
+        fputs("    int t = 0, ji = 0;\n", fp);
+    fprintf(fp, "    if (ps <= c->stacklow) c->error(c, %d, %zu, c->programstack);\n", QVM_AOT_ERR_PROGRAMSTACK, start);
+    fprintf(fp, "    if (--c->calldepth < 0) c->error(c, %d, %zu, c->programstack);\n", QVM_AOT_ERR_CALLDEPTH, start);
+    fprintf(fp, "    ps[0] = 0;\n    ps[1] = %d;\n", param);
+
+    for (size_t i = start + 1; i < end; i++) {
+        qvm_op* op = &codesegment[i];
+        int d = verifyinfo[i].depth;
+        int p = op->param;
+        // dead code that the verifier never reached (with a version 2 jump target table) can't be run
+        if (d < 0)
+            continue;
+        // opstack[0] and opstack[1] in the interpreter
+        int o0 = d - 1;
+        int o1 = d - 2;
+
+        if (label[i])
+            fprintf(fp, "L%zu:\n", i);
+
+        switch (op->op) {
+        case QVM_OP_NOP:
+        case QVM_OP_BREAK:
+        case QVM_OP_POP:
+            break;
+        case QVM_OP_ENTER:
+        case QVM_OP_UNDEF:
+        default:
+            fprintf(fp, "    ERR(%d, %zu);\n", QVM_AOT_ERR_UNDEF, i);
+            break;
+        case QVM_OP_LEAVE:
+            fprintf(fp, "    if (ps[1] != %d) ERR(%d, %zu);\n", p, QVM_AOT_ERR_LEAVE, i);
+            fputs("    c->calldepth++;\n", fp);
+            if (d > 0)
+                fprintf(fp, "    return s%d;\n", o0);
+            else
+                fputs("    return 0;\n", fp);
+            break;
+        case QVM_OP_CALL:
+            fprintf(fp, "    ps[0] = %zu;\n    c->programstack = ps;\n", i + 1);
+            // only a function entry has a C function to call directly, anything else goes through qvm_aot_call (which
+            // raises the same runtime error as the interpreter)
+            if (AOT_AFTER_CONST(i) && codesegment[i - 1].param >= 0 && (size_t)codesegment[i - 1].param < count &&
+                codesegment[codesegment[i - 1].param].op == QVM_OP_ENTER)
+                fprintf(fp, "    s%d = s%d == %d ? f%d(c) : qvm_aot_call(c, s%d, %zu);\n", o0, o0, codesegment[i - 1].param, codesegment[i - 1].param, o0, i);
+            else if (AOT_AFTER_CONST(i) && codesegment[i - 1].param < 0)
+                fprintf(fp, "    s%d = s%d == %d ? c->syscall(c, %d, ps) : qvm_aot_call(c, s%d, %zu);\n", o0, o0, codesegment[i - 1].param, -codesegment[i - 1].param - 1, o0, i);
+            else
+                fprintf(fp, "    s%d = qvm_aot_call(c, s%d, %zu);\n", o0, o0, i);
+            break;
+        case QVM_OP_PUSH:
+            fprintf(fp, "    s%d = 0;\n", d);
+            break;
+        case QVM_OP_CONST:
+            fprintf(fp, "    s%d = %d;\n", d, p);
+            break;
+        case QVM_OP_LOCAL:
+            fprintf(fp, "    s%d = (int)((uint8_t*)ps + %d - ds);\n", d, p);
+            break;
+        case QVM_OP_JUMP:
+            if (AOT_AFTER_CONST(i) && ((size_t)codesegment[i - 1].param & codemask) >= start && ((size_t)codesegment[i - 1].param & codemask) < end)
+                fprintf(fp, "    if (((uint32_t)s%d & 0x%zXU) == %zu) goto L%zu;\n", o0, codemask, (size_t)codesegment[i - 1].param & codemask, (size_t)codesegment[i - 1].param & codemask);
+            if (hasdispatch && d == 1)
+                fprintf(fp, "    t = s%d;\n    ji = %zu;\n    goto dispatch;\n", o0, i);
+            else
+                fprintf(fp, "    ERR(%d, %zu);\n", QVM_AOT_ERR_UNDEF, i);
+            break;
+
+        case QVM_OP_EQ:  fprintf(fp, "    if (s%d == s%d) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_NE:  fprintf(fp, "    if (s%d != s%d) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_LTI: fprintf(fp, "    if (s%d < s%d) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_LEI: fprintf(fp, "    if (s%d <= s%d) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_GTI: fprintf(fp, "    if (s%d > s%d) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_GEI: fprintf(fp, "    if (s%d >= s%d) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_LTU: fprintf(fp, "    if ((uint32_t)s%d < (uint32_t)s%d) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_LEU: fprintf(fp, "    if ((uint32_t)s%d <= (uint32_t)s%d) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_GTU: fprintf(fp, "    if ((uint32_t)s%d > (uint32_t)s%d) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_GEU: fprintf(fp, "    if ((uint32_t)s%d >= (uint32_t)s%d) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_EQF: fprintf(fp, "    if (F(s%d) == F(s%d)) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_NEF: fprintf(fp, "    if (F(s%d) != F(s%d)) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_LTF: fprintf(fp, "    if (F(s%d) < F(s%d)) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_LEF: fprintf(fp, "    if (F(s%d) <= F(s%d)) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_GTF: fprintf(fp, "    if (F(s%d) > F(s%d)) goto L%d;\n", o1, o0, p); break;
+        case QVM_OP_GEF: fprintf(fp, "    if (F(s%d) >= F(s%d)) goto L%d;\n", o1, o0, p); break;
+
+        case QVM_OP_LOAD1:  fprintf(fp, "    s%d = *DS(s%d);\n", o0, o0); break;
+        case QVM_OP_LOAD2:  fprintf(fp, "    s%d = L2(DS(s%d));\n", o0, o0); break;
+        case QVM_OP_LOAD4:  fprintf(fp, "    s%d = L4(DS(s%d));\n", o0, o0); break;
+        case QVM_OP_STORE1: fprintf(fp, "    *DS(s%d) = (uint8_t)s%d;\n", o1, o0); break;
+        case QVM_OP_STORE2: fprintf(fp, "    S2(DS(s%d), s%d);\n", o1, o0); break;
+        case QVM_OP_STORE4: fprintf(fp, "    S4(DS(s%d), s%d);\n", o1, o0); break;
+        case QVM_OP_ARG:    fprintf(fp, "    S4((uint8_t*)ps + %d, s%d);\n", p, o0); break;
+        case QVM_OP_BLOCK_COPY: fprintf(fp, "    c->blockcopy(c, s%d, s%d, %d);\n", o1, o0, p); break;
+
+        // same as the interpreter, which doesn't clear the upper bits of positive values
+        case QVM_OP_SEX8:   fprintf(fp, "    if (s%d & 0x80) s%d |= (int)0xFFFFFF00;\n", o0, o0); break;
+        case QVM_OP_SEX16:  fprintf(fp, "    if (s%d & 0x8000) s%d |= (int)0xFFFF0000;\n", o0, o0); break;
+
+        case QVM_OP_NEGI: fprintf(fp, "    s%d = -s%d;\n", o0, o0); break;
+        case QVM_OP_ADD:  fprintf(fp, "    s%d += s%d;\n", o1, o0); break;
+        case QVM_OP_SUB:  fprintf(fp, "    s%d -= s%d;\n", o1, o0); break;
+        case QVM_OP_DIVI: fprintf(fp, "    if (!s%d) ERR(%d, %zu);\n    s%d /= s%d;\n", o0, QVM_AOT_ERR_DIV0, i, o1, o0); break;
+        case QVM_OP_DIVU: fprintf(fp, "    if (!s%d) ERR(%d, %zu);\n    s%d = (int)((uint32_t)s%d / (uint32_t)s%d);\n", o0, QVM_AOT_ERR_DIV0, i, o1, o1, o0); break;
+        case QVM_OP_MODI: fprintf(fp, "    if (!s%d) ERR(%d, %zu);\n    s%d %%= s%d;\n", o0, QVM_AOT_ERR_DIV0, i, o1, o0); break;
+        case QVM_OP_MODU: fprintf(fp, "    if (!s%d) ERR(%d, %zu);\n    s%d = (int)((uint32_t)s%d %% (uint32_t)s%d);\n", o0, QVM_AOT_ERR_DIV0, i, o1, o1, o0); break;
+        case QVM_OP_MULI: fprintf(fp, "    s%d *= s%d;\n", o1, o0); break;
+        case QVM_OP_MULU: fprintf(fp, "    s%d = (int)((uint32_t)s%d * (uint32_t)s%d);\n", o1, o1, o0); break;
+        case QVM_OP_BAND: fprintf(fp, "    s%d &= s%d;\n", o1, o0); break;
+        case QVM_OP_BOR:  fprintf(fp, "    s%d |= s%d;\n", o1, o0); break;
+        case QVM_OP_BXOR: fprintf(fp, "    s%d ^= s%d;\n", o1, o0); break;
+        case QVM_OP_BCOM: fprintf(fp, "    s%d = ~s%d;\n", o0, o0); break;
+        // shift counts are masked like x86 shift instructions do, since larger shifts are undefined in C
+        case QVM_OP_LSH:  fprintf(fp, "    s%d = (int)((uint32_t)s%d << (s%d & 31));\n", o1, o1, o0); break;
+        case QVM_OP_RSHI: fprintf(fp, "    s%d >>= (s%d & 31);\n", o1, o0); break;
+        case QVM_OP_RSHU: fprintf(fp, "    s%d = (int)((uint32_t)s%d >> (s%d & 31));\n", o1, o1, o0); break;
+
+        case QVM_OP_NEGF: fprintf(fp, "    s%d = I(-F(s%d));\n", o0, o0); break;
+        case QVM_OP_ADDF: fprintf(fp, "    s%d = I(F(s%d) + F(s%d));\n", o1, o1, o0); break;
+        case QVM_OP_SUBF: fprintf(fp, "    s%d = I(F(s%d) - F(s%d));\n", o1, o1, o0); break;
+        case QVM_OP_DIVF: fprintf(fp, "    s%d = I(F(s%d) / F(s%d));\n", o1, o1, o0); break;
+        case QVM_OP_MULF: fprintf(fp, "    s%d = I(F(s%d) * F(s%d));\n", o1, o1, o0); break;
+        case QVM_OP_CVIF: fprintf(fp, "    s%d = I((float)s%d);\n", o0, o0); break;
+        case QVM_OP_CVFI: fprintf(fp, "    s%d = (int)F(s%d);\n", o0, o0); break;
+        }
+    }
+
+    // the verifier makes sure the last instruction doesn't fall out of the function, but the C compiler doesn't know
+    fprintf(fp, "    ERR(%d, %zu);\n    return 0;\n", QVM_AOT_ERR_UNDEF, end - 1);
+
+    if (hasdispatch) {
+        fprintf(fp, "dispatch:\n    switch ((uint32_t)t & 0x%zXU) {\n", codemask);
+        for (size_t i = start + 1; i < end; i++) {
+            if (AOT_DISPATCH_TARGET(i))
+                fprintf(fp, "    case %zu: goto L%zu;\n", i, i);
+        }
+        fprintf(fp, "    }\n    c->error(c, %d, ji, ps);\n    return 0;\n", QVM_AOT_ERR_UNDEF);
+    }
+
+    fputs("}\n", fp);
+    return 1;
+}
+
+
+// Translate the VM's code segment into a C file
+static int aot_translate(qvm* vm, const char* path, uint64_t key) {
+    qvm_op* codesegment = vm->codesegment;
+    size_t count = vm->instructioncount;
+    int ret = 0;
+
+    uint8_t* label = (uint8_t*)calloc(count, 1);
+    FILE* fp = fopen(path, "w");
+    if (!label || !fp) {
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_aot_load(): Unable to create \"%s\"\n", path);
+        goto done;
+    }
+
+    fputs(qvm_aot_prelude, fp);
+    // mask data segment offsets like the interpreter (or sign-extend them, like the interpreter with a mask of all 1s)
+    if (vm->datamask != (size_t)-1)
+        fprintf(fp, "#define DS(a) (ds + ((uint32_t)(a) & 0x%XU))\n", (uint32_t)vm->datamask);
+    else
+        fputs("#define DS(a) (ds + (int)(a))\n", fp);
+    fprintf(fp, "\nconst uint64_t qvm_aot_key = 0x%016llXULL;\n\n", (unsigned long long)key);
+
+    for (size_t i = 0; i < count; i++) {
+        if (codesegment[i].op == QVM_OP_ENTER)
+            fprintf(fp, "static int f%zu(struct qvm_aot_ctx* c);\n", i);
+    }
+
+    for (size_t start = 0; start < count; ) {
+        if (codesegment[start].op != QVM_OP_ENTER) {
+            start++;
+            continue;
+        }
+        size_t end = start + 1;
+        while (end < count && codesegment[end].op != QVM_OP_ENTER)
+            end++;
+        if (!aot_translate_func(vm, fp, start, end, label))
+            goto done;
+        start = end;
+    }
+
+    // entry point for calls by instruction index
+    fputs("\nint qvm_aot_call(struct qvm_aot_ctx* c, int t, int i) {\n", fp);
+    fputs("    if (t < 0)\n        return c->syscall(c, -t - 1, c->programstack);\n", fp);
+    fprintf(fp, "    switch ((uint32_t)t & 0x%zXU) {\n", (vm->codeseglen / sizeof(qvm_op)) - 1);
+    for (size_t i = 0; i < count; i++) {
+        if (codesegment[i].op == QVM_OP_ENTER)
+            fprintf(fp, "    case %zu: return f%zu(c);\n", i, i);
+    }
+    fprintf(fp, "    }\n    c->error(c, %d, i, c->programstack);\n    return 0;\n}\n", QVM_AOT_ERR_UNDEF);
+
+    ret = !ferror(fp);
+
+done:
+    if (fp && fclose(fp) != 0)
+        ret = 0;
+    free(label);
+    return ret;
+}
+
+
+// Syscall callback for translated code
+static int aot_syscall(struct qvm_aot_ctx* ctx, int cmd, int* programstack) {
+    qvm_aot_run* run = (qvm_aot_run*)ctx;
+    qvm* vm = run->vm;
+    int ret;
+
+    if (vm->trace)
+        qvm_trace_syscall(vm, -1, cmd, &programstack[2]);
+
+    // pure syscalls with a native implementation are handled without leaving the VM
+    if (vm->intrinsics && qvm_intrinsic_call(vm, cmd, &programstack[2], &ret))
+        return ret;
+
+    // store program stack pointer in qvm object for re-entrancy
+    vm->stackptr = programstack;
+    // the opstack lives in translated code's locals, so qvm_dump will just show it as empty
+    vm->opstackseg->opstack = vm->opstackseg->data + QVM_OPSTACK_SIZE;
+
+#ifdef QVM_GUARDED_SUPPORTED
+    // faults in engine code are not caught as guard region faults
+    qvm_guard* guard = qvm_guard_suspend();
+#endif
+
+    ret = vm->syscall(vm->datasegment, cmd, &programstack[2]);
+
+#ifdef QVM_GUARDED_SUPPORTED
+    qvm_guard_resume(guard);
+#endif
+
+    // a re-entrant execution failed, so this one can't continue either
+    if (vm->failed)
+        ctx->error(ctx, QVM_AOT_ERR_NESTED, -1, programstack);
+
+    return ret;
+}
+
+
+// QVM_OP_BLOCK_COPY callback for translated code. Same logic as the interpreter
+static void aot_blockcopy(struct qvm_aot_ctx* ctx, int dsti, int srci, int count) {
+    qvm_aot_run* run = (qvm_aot_run*)ctx;
+    size_t datamask = run->vm->datamask;
+
+    srci = (int)(srci & datamask);
+    dsti = (int)(dsti & datamask);
+
+    // skip if src/dst are the same
+    if (srci == dsti)
+        return;
+
+    // make sure the src and dst ranges don't go out of memory bounds
+    count = (int)(((srci + count) & datamask) - srci);
+    count = (int)(((dsti + count) & datamask) - dsti);
+    if (count <= 0)
+        return;
+
+    memcpy(ctx->datasegment + dsti, ctx->datasegment + srci, count);
+}
+
+
+// Error callback for translated code. Unwinds back to qvm_aot_exec
+static void aot_error(struct qvm_aot_ctx* ctx, int kind, int instruction, int* programstack) {
+    qvm_aot_run* run = (qvm_aot_run*)ctx;
+    run->errinstr = instruction;
+    run->errprogramstack = programstack;
+    longjmp(run->env, kind);
+}
+
+
+// Try to load a compiled module, checking that it was built for this key
+static struct qvm_aot* aot_open(const char* path, uint64_t key) {
+    void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (!handle)
+        return NULL;
+
+    const uint64_t* modkey = (const uint64_t*)dlsym(handle, "qvm_aot_key");
+    void* call = dlsym(handle, "qvm_aot_call");
+    if (!modkey || !call || *modkey != key) {
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_aot_load(): Native module \"%s\" does not match QVM\n", path);
+        dlclose(handle);
+        return NULL;
+    }
+
+    struct qvm_aot* aot = (struct qvm_aot*)calloc(1, sizeof(struct qvm_aot));
+    if (!aot) {
+        dlclose(handle);
+        return NULL;
+    }
+    aot->handle = handle;
+    *(void**)&aot->call = call;
+    snprintf(aot->path, sizeof(aot->path), "%s", path);
+    return aot;
+}
+
+
+int qvm_aot_load(qvm* vm, const uint8_t* filemem, size_t filesize, const char* cachedir, const char* compiler) {
+    if (!vm || !vm->memory || !filemem || !filesize || !cachedir || !compiler)
+        return 0;
+
+    if (vm->aot)
+        return 1;
+
+    uint64_t key = aot_key(vm, filemem, filesize);
+    char sopath[1024], cpath[1024], tmppath[1024], cmd[4096];
+    snprintf(sopath, sizeof(sopath), "%s/qvm_%016llx.so", cachedir, (unsigned long long)key);
+    snprintf(cpath, sizeof(cpath), "%s/qvm_%016llx.c", cachedir, (unsigned long long)key);
+    snprintf(tmppath, sizeof(tmppath), "%s/qvm_%016llx.so.tmp", cachedir, (unsigned long long)key);
+
+    // translate and compile if this QVM hasn't been seen before
+    if (access(sopath, F_OK) != 0) {
+        log_c(QMM_LOG_INFO, QMM_LOGGING_TAG, "qvm_aot_load(): Translating QVM into \"%s\" and compiling, this may take a while\n", cpath);
+        if (!aot_translate(vm, cpath, key))
+            return 0;
+
+        // -fwrapv since QVM integer math wraps on overflow. build to a temp file so a partial module is never loaded
+        int n = snprintf(cmd, sizeof(cmd), "%s -O2 -shared -fPIC -fwrapv -fno-strict-aliasing -w -o \"%s\" \"%s\"", compiler, tmppath, cpath);
+        if (n < 0 || (size_t)n >= sizeof(cmd))
+            return 0;
+        int status = system(cmd);
+        if (status != 0) {
+            log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_aot_load(): Compiler command failed (%d): %s\n", status, cmd);
+            unlink(tmppath);
+            return 0;
+        }
+        if (rename(tmppath, sopath) != 0) {
+            log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_aot_load(): Unable to move compiled module to \"%s\"\n", sopath);
+            unlink(tmppath);
+            return 0;
+        }
+    }
+
+    struct qvm_aot* aot = aot_open(sopath, key);
+    if (!aot) {
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_aot_load(): Unable to load native module \"%s\": %s\n", sopath, dlerror());
+        return 0;
+    }
+
+    vm->aot = aot;
+    log_c(QMM_LOG_DEBUG, QMM_LOGGING_TAG, "qvm_aot_load(): Loaded native module \"%s\"\n", sopath);
+    return 1;
+}
+
+
+void qvm_aot_free(qvm* vm) {
+    if (!vm || !vm->aot)
+        return;
+
+    dlclose(vm->aot->handle);
+    free(vm->aot);
+    vm->aot = NULL;
+}
+
+
+const char* qvm_aot_path(const qvm* vm) {
+    if (!vm || !vm->aot)
+        return NULL;
+    return vm->aot->path;
+}
+
+
+int qvm_aot_exec(qvm* vm, size_t instruction, int** programstack, int** opstack, size_t* errinstr) {
+    qvm_aot_run run;
+    run.ctx.datasegment = vm->datasegment;
+    run.ctx.programstack = *programstack;
+    run.ctx.stacklow = vm->stacklow;
+    run.ctx.calldepth = QVM_AOT_MAX_CALL_DEPTH;
+    run.ctx.syscall = aot_syscall;
+    run.ctx.blockcopy = aot_blockcopy;
+    run.ctx.error = aot_error;
+    run.vm = vm;
+    run.errinstr = -1;
+    run.errprogramstack = NULL;
+
+    int err = setjmp(run.env);
+    if (err == QVM_AOT_ERR_NONE) {
+        int ret = vm->aot->call(&run.ctx, (int)instruction, (int)instruction);
+        // return value goes on the opstack, like it was pushed just before QVM_OP_LEAVE
+        --*opstack;
+        **opstack = ret;
+        return 1;
+    }
+
+    if (run.errprogramstack)
+        *programstack = run.errprogramstack;
+    size_t at = run.errinstr >= 0 ? (size_t)run.errinstr : instruction;
+    *errinstr = at;
+
+    switch (err) {
+    case QVM_AOT_ERR_UNDEF:
+        log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %zu: invalid instruction, jump target, or call target\n", instruction, at);
+        break;
+    case QVM_AOT_ERR_PROGRAMSTACK:
+        log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %zu: program stack overflow! Program stack size is currently %td, max is %zu.\n", instruction, at, (uint8_t*)vm->stackhigh - (uint8_t*)*programstack, vm->stacksize);
+        break;
+    case QVM_AOT_ERR_LEAVE:
+        log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %zu: QVM_OP_LEAVE param (%d) does not match QVM_OP_ENTER param (%d)\n", instruction, at, vm->codesegment[at].param, (*programstack)[1]);
+        break;
+    case QVM_AOT_ERR_DIV0:
+        log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %zu: %s division by 0!\n", instruction, at, qvm_opcodename[vm->codesegment[at].op]);
+        break;
+    case QVM_AOT_ERR_CALLDEPTH:
+        log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %zu: too many nested function calls (max is %d)\n", instruction, at, QVM_AOT_MAX_CALL_DEPTH);
+        break;
+    case QVM_AOT_ERR_NESTED:
+    default:
+        // already reported by the nested execution
+        break;
+    }
+
+    return 0;
+}
+
+#else // !QVM_AOT_SUPPORTED
+
+int qvm_aot_load(qvm* vm, const uint8_t* filemem, size_t filesize, const char* cachedir, const char* compiler) {
+    (void)vm; (void)filemem; (void)filesize; (void)cachedir; (void)compiler;
+    log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_aot_load(): Native QVM translation is not supported on this platform\n");
+    return 0;
+}
+
+
+void qvm_aot_free(qvm* vm) {
+    (void)vm;
+}
+
+
+const char* qvm_aot_path(const qvm* vm) {
+    (void)vm;
+    return NULL;
+}
+
+
+int qvm_aot_exec(qvm* vm, size_t instruction, int** programstack, int** opstack, size_t* errinstr) {
+    (void)vm; (void)programstack; (void)opstack;
+    *errinstr = instruction;
+    return 0;
+}
+
+#endif // QVM_AOT_SUPPORTED
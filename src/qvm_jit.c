@@ -0,0 +1,954 @@
+/*
+QMM2 - Q3 MultiMod 2
+Copyright 2025-2026
+https://github.com/thecybermind/qmm2/
+3-clause BSD license: https://opensource.org/license/bsd-3-clause
+
+Created By:
+    Kevin Masterson < k.m.masterson@gmail.com >
+
+*/
+
+#define QMM_LOGGING
+
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdint.h>     // intptr_t and uint8_t
+#include <stdlib.h>     // malloc and free
+#include <string.h>     // memcpy and memset
+#include "qvm.h"
+#include "qvm_jit.h"
+
+#ifdef QMM_LOGGING
+void log_c(int severity, const char* tag, const char* fmt, ...);
+enum { QMM_LOG_TRACE, QMM_LOG_DEBUG, QMM_LOG_INFO, QMM_LOG_NOTICE, QMM_LOG_WARNING, QMM_LOG_ERROR, QMM_LOG_FATAL };
+#define QMM_LOGGING_TAG "QMM"
+#else
+#define log_c(...) /* */
+#endif
+
+#ifdef QVM_JIT_SUPPORTED
+
+#include <sys/mman.h>   // mmap, mprotect, and munmap
+
+/* Native code overview
+ *
+ * Each QVM instruction is translated into a fixed template of x86-64 instructions, in order, so the native code for
+ * instruction i starts at instrtable[i]. While native code is running, these registers are reserved:
+ *
+ * rbx = pointer to qvm_jit state struct
+ * r12 = VM data segment
+ * r13 = program stack pointer (same as the interpreter's "programstack")
+ * r14 = opstack pointer (same as the interpreter's "opstack")
+ * r15 = saved native stack pointer around calls into C code
+ *
+ * QVM function calls use native call/ret, so QVM_OP_LEAVE is a native "ret". The program stack frames are still
+ * built exactly like the interpreter (including the RII slot) so qvm_dump output is the same.
+ *
+ * All stack and frame checks done by the interpreter are also done here, and each check that fails calls an error
+ * stub. The error stub uses its return address to find which instruction failed, then unwinds the native stack back
+ * to the entry stub using the native stack pointer saved at entry.
+ */
+
+// Runtime error kinds reported by native code
+enum {
+    QVM_JIT_ERR_NONE,
+    QVM_JIT_ERR_UNDEF,          // invalid instruction or jump target
+    QVM_JIT_ERR_OPSTACK,        // opstack overflow
+    QVM_JIT_ERR_PROGRAMSTACK,   // program stack overflow
+    QVM_JIT_ERR_LEAVE,          // QVM_OP_LEAVE param does not match stack frame size
+    QVM_JIT_ERR_DIV0,           // division by 0
+    QVM_JIT_ERR_CALLDEPTH,      // too many nested calls
+    QVM_JIT_ERR_NESTED,         // a re-entrant execution (from a syscall) failed
+    QVM_JIT_ERR_FAULT,          // data segment access out of bounds (caught by guard regions, not native code)
+
+    QVM_JIT_ERR_NUM
+};
+
+// Native code bytes to reserve per QVM instruction (largest template is QVM_OP_CALL at about 60)
+#define QVM_JIT_MAX_OP_SIZE     96
+// Native code bytes to reserve for entry/error/syscall stubs
+#define QVM_JIT_STUB_SIZE       1024
+
+// JIT state. Native code keeps a pointer to this in rbx, so all fields used by native code must be at offsets < 128
+struct qvm_jit {
+    void** instrtable;          // Native code address for each instruction (size of codesegment, including padding)
+    qvm* vm;                    // VM this state belongs to
+    uint8_t* datasegment;       // VM data segment
+    int* opstacklow;            // Lowest address of opstack for the current execution
+    int* opstackhigh;           // Highest address of opstack for the current execution
+    int* stacklow;              // Lowest address of program stack
+    int* stackhigh;             // Highest address of program stack
+    void* savedrsp;             // Native stack pointer saved by entry stub, used to unwind on error
+    int calldepth;              // Number of nested calls remaining before QVM_JIT_ERR_CALLDEPTH
+    int errkind;                // Error kind set by native code
+    uint8_t* errsite;           // Return address of the failed check
+    int* outprogramstack;       // Program stack pointer when native code returned
+    int* outopstack;            // Opstack pointer when native code returned
+
+    uint8_t* code;              // Native code block
+    size_t codesize;            // Size of native code block
+    size_t codeused;            // Number of bytes of native code generated
+    int (*entry)(struct qvm_jit* jit, int* programstack, int* opstack, void* target); // Entry stub
+};
+
+// Offset of qvm_jit field for a disp8 memory operand
+#define JIT_OFS(f)      ((uint8_t)offsetof(struct qvm_jit, f))
+
+// Native code buffer used while compiling
+typedef struct {
+    uint8_t* buf;               // Start of buffer
+    size_t size;                // Size of buffer
+    size_t pos;                 // Current write position (may go past size, which is checked after each instruction)
+} qvm_jit_buf;
+
+// A rel32 that needs to be pointed at an instruction once all instructions are generated
+typedef struct {
+    size_t pos;                 // Offset of rel32 in buffer
+    uint32_t target;            // Target instruction index
+} qvm_jit_fixup;
+
+// Addresses of generated stubs
+typedef struct {
+    uint8_t* err[QVM_JIT_ERR_NUM];  // Error stubs (call these, so the return address identifies the failing check)
+    uint8_t* syscall;               // Syscall stub (call with negative syscall target in eax)
+} qvm_jit_stubs;
+
+
+// Append bytes to the buffer
+static void jit_emit(qvm_jit_buf* b, const void* bytes, size_t n) {
+    if (b->pos + n <= b->size)
+        memcpy(b->buf + b->pos, bytes, n);
+    b->pos += n;
+}
+
+// Append a string literal of bytes
+#define EMIT(s)         jit_emit(b, s, sizeof(s) - 1)
+
+
+static void jit_emit1(qvm_jit_buf* b, uint8_t v) {
+    jit_emit(b, &v, 1);
+}
+
+
+static void jit_emit4(qvm_jit_buf* b, int32_t v) {
+    jit_emit(b, &v, 4);
+}
+
+
+static void jit_emit8(qvm_jit_buf* b, uint64_t v) {
+    jit_emit(b, &v, 8);
+}
+
+
+// Append rel32 to a given native address
+static void jit_emit_rel32(qvm_jit_buf* b, const uint8_t* target) {
+    jit_emit4(b, (int32_t)(target - (b->buf + b->pos + 4)));
+}
+
+
+// call <target>
+static void jit_emit_call(qvm_jit_buf* b, const uint8_t* target) {
+    jit_emit1(b, 0xE8);
+    jit_emit_rel32(b, target);
+}
+
+
+// Check opstack after a push, like the interpreter's (opstack <= opstacklow) check
+static void jit_emit_check_push(qvm_jit_buf* b, qvm_jit_stubs* stubs) {
+    EMIT("\x4C\x3B\x73"); jit_emit1(b, JIT_OFS(opstacklow));   // cmp r14, [rbx+opstacklow]
+    EMIT("\x77\x05");                                           // ja +5
+    jit_emit_call(b, stubs->err[QVM_JIT_ERR_OPSTACK]);         // call err_opstack
+}
+
+
+// Check opstack after a pop, like the interpreter's (opstack > opstackhigh) check
+static void jit_emit_check_pop(qvm_jit_buf* b, qvm_jit_stubs* stubs) {
+    EMIT("\x4C\x3B\x73"); jit_emit1(b, JIT_OFS(opstackhigh));  // cmp r14, [rbx+opstackhigh]
+    EMIT("\x76\x05");                                           // jbe +5
+    jit_emit_call(b, stubs->err[QVM_JIT_ERR_OPSTACK]);         // call err_opstack
+}
+
+
+// Call a C function with args already in rdi/rsi/rdx/rcx, aligning the native stack
+static void jit_emit_ccall(qvm_jit_buf* b, void* func) {
+    EMIT("\x49\x89\xE7");                       // mov r15, rsp
+    EMIT("\x48\x83\xE4\xF0");                   // and rsp, -16
+    EMIT("\x48\xB8"); jit_emit8(b, (uint64_t)(uintptr_t)func); // mov rax, func
+    EMIT("\xFF\xD0");                           // call rax
+    EMIT("\x4C\x89\xFC");                       // mov rsp, r15
+}
+
+
+// Load a data segment address from opstack (at disp8 offset) into rax, applying the data mask
+static void jit_emit_dataaddr(qvm_jit_buf* b, uint8_t disp, int usemask, uint32_t datamask) {
+    if (usemask) {
+        EMIT("\x41\x8B\x46"); jit_emit1(b, disp);   // mov eax, [r14+disp]
+        jit_emit1(b, 0x25); jit_emit4(b, (int32_t)datamask); // and eax, datamask
+    }
+    else {
+        // no mask: sign-extend the address like the interpreter does with a mask of all 1s
+        EMIT("\x49\x63\x46"); jit_emit1(b, disp);   // movsxd rax, [r14+disp]
+    }
+}
+
+
+// QVM_OP_BLOCK_COPY helper, called from native code. Same logic as the interpreter
+static void qvm_jit_blockcopy(struct qvm_jit* jit, int dsti, int srci, int count) {
+    size_t datamask = jit->vm->datamask;
+
+    srci = (int)(srci & datamask);
+    dsti = (int)(dsti & datamask);
+
+    // skip if src/dst are the same
+    if (srci == dsti)
+        return;
+
+    // make sure the src and dst ranges don't go out of memory bounds
+    count = (int)(((srci + count) & datamask) - srci);
+    count = (int)(((dsti + count) & datamask) - dsti);
+    if (count <= 0)
+        return;
+
+    memcpy(jit->datasegment + dsti, jit->datasegment + srci, count);
+}
+
+
+// QVM_OP_BREAK helper, called from native code
+static void qvm_jit_break(struct qvm_jit* jit, int* opstack, int instruction, int* programstack) {
+    jit->vm->stackptr = programstack;
+    qvm_dump(jit->vm, opstack, jit->opstackhigh, jit->vm->codesegment + instruction);
+}
+
+
+// Syscall helper, called from native code
+static int qvm_jit_syscall(qvm* vm, int cmd, int* args) {
+    int ret;
+    if (vm->trace)
+        qvm_trace_syscall(vm, -1, cmd, args);
+    // pure syscalls with a native implementation are handled without leaving the VM
+    if (vm->intrinsics && qvm_intrinsic_call(vm, cmd, args, &ret))
+        return ret;
+    return vm->syscall(vm->datasegment, cmd, args);
+}
+
+
+// Syscall helper for guarded VMs, called from native code. Faults in engine code are not caught as guard region faults
+static int qvm_jit_syscall_guarded(qvm* vm, int cmd, int* args) {
+    int ret;
+    if (vm->trace)
+        qvm_trace_syscall(vm, -1, cmd, args);
+    if (vm->intrinsics && qvm_intrinsic_call(vm, cmd, args, &ret))
+        return ret;
+    qvm_guard* guard = qvm_guard_suspend();
+    ret = vm->syscall(vm->datasegment, cmd, args);
+    qvm_guard_resume(guard);
+    return ret;
+}
+
+
+// Generate entry, error, and syscall stubs at the start of the buffer
+static void jit_emit_stubs(qvm_jit_buf* b, qvm_jit_stubs* stubs, struct qvm_jit* jit) {
+    // entry stub: int entry(struct qvm_jit* jit, int* programstack, int* opstack, void* target)
+    jit->entry = (int (*)(struct qvm_jit*, int*, int*, void*))(b->buf + b->pos);
+    EMIT("\x53\x55\x41\x54\x41\x55\x41\x56\x41\x57");          // push rbx, rbp, r12, r13, r14, r15
+    EMIT("\x48\x89\xFB");                                       // mov rbx, rdi
+    EMIT("\xFF\x73"); jit_emit1(b, JIT_OFS(savedrsp));          // push [rbx+savedrsp] (for re-entrant executions)
+    EMIT("\x48\x89\x63"); jit_emit1(b, JIT_OFS(savedrsp));      // mov [rbx+savedrsp], rsp
+    EMIT("\x4C\x8B\x63"); jit_emit1(b, JIT_OFS(datasegment));   // mov r12, [rbx+datasegment]
+    EMIT("\x49\x89\xF5");                                       // mov r13, rsi
+    EMIT("\x49\x89\xD6");                                       // mov r14, rdx
+    EMIT("\x83\x6B"); jit_emit1(b, JIT_OFS(calldepth)); EMIT("\x01"); // sub dword [rbx+calldepth], 1 (matches the QVM_OP_LEAVE)
+    EMIT("\xFF\xD1");                                           // call rcx
+    EMIT("\x4C\x89\x6B"); jit_emit1(b, JIT_OFS(outprogramstack)); // mov [rbx+outprogramstack], r13
+    EMIT("\x4C\x89\x73"); jit_emit1(b, JIT_OFS(outopstack));    // mov [rbx+outopstack], r14
+    EMIT("\x31\xC0");                                           // xor eax, eax
+    uint8_t* exitpath = b->buf + b->pos;
+    EMIT("\x8F\x43"); jit_emit1(b, JIT_OFS(savedrsp));          // pop [rbx+savedrsp]
+    EMIT("\x41\x5F\x41\x5E\x41\x5D\x41\x5C\x5D\x5B");          // pop r15, r14, r13, r12, rbp, rbx
+    EMIT("\xC3");                                               // ret
+
+    // common error handler: ecx = error kind, [rsp] = return address of failed check
+    uint8_t* errcommon = b->buf + b->pos;
+    EMIT("\x48\x8B\x14\x24");                                   // mov rdx, [rsp]
+    EMIT("\x48\x89\x53"); jit_emit1(b, JIT_OFS(errsite));       // mov [rbx+errsite], rdx
+    EMIT("\x89\x4B"); jit_emit1(b, JIT_OFS(errkind));           // mov [rbx+errkind], ecx
+    EMIT("\x4C\x89\x6B"); jit_emit1(b, JIT_OFS(outprogramstack)); // mov [rbx+outprogramstack], r13
+    EMIT("\x4C\x89\x73"); jit_emit1(b, JIT_OFS(outopstack));    // mov [rbx+outopstack], r14
+    EMIT("\x48\x8B\x63"); jit_emit1(b, JIT_OFS(savedrsp));      // mov rsp, [rbx+savedrsp]
+    EMIT("\x89\xC8");                                           // mov eax, ecx
+    jit_emit1(b, 0xE9); jit_emit_rel32(b, exitpath);            // jmp exitpath
+
+    // error stubs
+    for (int kind = QVM_JIT_ERR_NONE + 1; kind < QVM_JIT_ERR_NUM; kind++) {
+        stubs->err[kind] = b->buf + b->pos;
+        jit_emit1(b, 0xB9); jit_emit4(b, kind);                 // mov ecx, kind
+        jit_emit1(b, 0xE9); jit_emit_rel32(b, errcommon);       // jmp errcommon
+    }
+
+    // syscall stub: eax = negative syscall target, [rsp] = return address into QVM_OP_CALL
+    stubs->syscall = b->buf + b->pos;
+    EMIT("\xF7\xD0");                                           // not eax (-target - 1)
+    EMIT("\x89\xC6");                                           // mov esi, eax
+    EMIT("\x48\x8B\x7B"); jit_emit1(b, JIT_OFS(vm));            // mov rdi, [rbx+vm]
+    EMIT("\x4C\x89\xAF"); jit_emit4(b, (int32_t)offsetof(qvm, stackptr)); // mov [rdi+stackptr], r13 (for re-entrancy)
+    EMIT("\x48\x8B\x8F"); jit_emit4(b, (int32_t)offsetof(qvm, opstackseg)); // mov rcx, [rdi+opstackseg]
+    EMIT("\x4C\x89\xB1"); jit_emit4(b, (int32_t)offsetof(qvm_opstack_segment, opstack)); // mov [rcx+opstack], r14 (for qvm_dump)
+    // the helpers check for intrinsics (which can be set or cleared after compiling) before calling vm->syscall
+    if (jit->vm->allocator->flags & QVM_ALLOC_GUARDED) {
+        EMIT("\x48\xB8"); jit_emit8(b, (uint64_t)(uintptr_t)qvm_jit_syscall_guarded); // mov rax, qvm_jit_syscall_guarded
+    }
+    else {
+        EMIT("\x48\xB8"); jit_emit8(b, (uint64_t)(uintptr_t)qvm_jit_syscall); // mov rax, qvm_jit_syscall
+    }
+    EMIT("\x49\x8D\x55\x08");                                   // lea rdx, [r13+8]
+    EMIT("\x49\x89\xE7");                                       // mov r15, rsp
+    EMIT("\x48\x83\xE4\xF0");                                   // and rsp, -16
+    EMIT("\xFF\xD0");                                           // call rax
+    EMIT("\x4C\x89\xFC");                                       // mov rsp, r15
+    EMIT("\x48\x8B\x7B"); jit_emit1(b, JIT_OFS(vm));            // mov rdi, [rbx+vm]
+    EMIT("\x83\xBF"); jit_emit4(b, (int32_t)offsetof(qvm, failed)); EMIT("\x00"); // cmp dword [rdi+failed], 0
+    EMIT("\x0F\x85"); jit_emit_rel32(b, stubs->err[QVM_JIT_ERR_NESTED]);         // jne err_nested
+    EMIT("\x4C\x8B\xAF"); jit_emit4(b, (int32_t)offsetof(qvm, stackptr)); // mov r13, [rdi+stackptr]
+    EMIT("\x49\x83\xEE\x04");                                   // sub r14, 4
+    EMIT("\x41\x89\x06");                                       // mov [r14], eax
+    EMIT("\x4C\x3B\x73"); jit_emit1(b, JIT_OFS(opstacklow));    // cmp r14, [rbx+opstacklow]
+    EMIT("\x0F\x86"); jit_emit_rel32(b, stubs->err[QVM_JIT_ERR_OPSTACK]);        // jbe err_opstack
+    EMIT("\xC3");                                               // ret
+}
+
+
+// Find the instruction containing a native code address
+static size_t jit_find_instruction(struct qvm_jit* jit, const uint8_t* site, size_t fallback) {
+    size_t count = jit->vm->instructioncount;
+    if (!site || site <= (uint8_t*)jit->instrtable[0] || site > jit->code + jit->codeused)
+        return fallback;
+
+    // site is a return address, so the failing instruction contains the byte before it
+    site--;
+    size_t low = 0, high = count;
+    while (high - low > 1) {
+        size_t mid = low + (high - low) / 2;
+        if ((uint8_t*)jit->instrtable[mid] <= site)
+            low = mid;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+
+int qvm_jit_compile(qvm* vm) {
+    if (!vm || !vm->memory)
+        return 0;
+
+    if (vm->jit)
+        return 1;
+
+    struct qvm_jit* jit = NULL;
+    qvm_jit_fixup* fixups = NULL;
+    size_t numfixups = 0;
+    qvm_jit_stubs stubs;
+
+    // all data offsets are masked to a 32-bit immediate
+    if (vm->dataseglen - 1 > 0x7FFFFFFF) {
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_jit_compile(): Data segment too large for JIT (%zu)\n", vm->dataseglen);
+        goto fail;
+    }
+    int usemask = vm->datamask != (size_t)-1;
+    uint32_t datamask = (uint32_t)vm->datamask;
+    size_t tablecount = vm->codeseglen / sizeof(qvm_op);
+    uint32_t codemask = (uint32_t)(tablecount - 1);
+
+    jit = (struct qvm_jit*)calloc(1, sizeof(struct qvm_jit));
+    if (!jit)
+        goto fail;
+    jit->vm = vm;
+    jit->datasegment = vm->datasegment;
+    jit->stacklow = vm->stacklow;
+    jit->stackhigh = vm->stackhigh;
+    jit->calldepth = QVM_JIT_MAX_CALL_DEPTH;
+
+    jit->instrtable = (void**)malloc(tablecount * sizeof(jit->instrtable[0]));
+    // each instruction emits at most 2 branch fixups (QVM_OP_NEF)
+    fixups = (qvm_jit_fixup*)malloc(vm->instructioncount * 2 * sizeof(fixups[0]));
+    if (!jit->instrtable || !fixups) {
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_jit_compile(): Memory allocation failed\n");
+        goto fail;
+    }
+
+    // round up to page size
+    jit->codesize = (vm->instructioncount * QVM_JIT_MAX_OP_SIZE + QVM_JIT_STUB_SIZE + 0xFFF) & ~(size_t)0xFFF;
+    jit->code = (uint8_t*)mmap(NULL, jit->codesize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (jit->code == (uint8_t*)MAP_FAILED) {
+        jit->code = NULL;
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_jit_compile(): Native code allocation failed for size %zu\n", jit->codesize);
+        goto fail;
+    }
+
+    qvm_jit_buf buf = { jit->code, jit->codesize, 0 };
+    qvm_jit_buf* b = &buf;
+
+    jit_emit_stubs(b, &stubs, jit);
+
+    // any jump into the code segment padding is an error
+    for (size_t i = vm->instructioncount; i < tablecount; i++)
+        jit->instrtable[i] = stubs.err[QVM_JIT_ERR_UNDEF];
+
+    for (size_t i = 0; i < vm->instructioncount; i++) {
+        qvm_op* op = &vm->codesegment[i];
+        int param = op->param;
+
+        jit->instrtable[i] = b->buf + b->pos;
+
+        switch (op->op) {
+        // miscellaneous opcodes
+
+        case QVM_OP_NOP:
+            break;
+
+        case QVM_OP_BREAK:
+            EMIT("\x48\x89\xDF");                               // mov rdi, rbx
+            EMIT("\x4C\x89\xF6");                               // mov rsi, r14
+            jit_emit1(b, 0xBA); jit_emit4(b, (int32_t)i);       // mov edx, i
+            EMIT("\x4C\x89\xE9");                               // mov rcx, r13
+            jit_emit_ccall(b, (void*)qvm_jit_break);
+            break;
+
+        // functions
+
+        case QVM_OP_ENTER:
+            if (param < 0) {
+                log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_jit_compile(): Invalid QVM_OP_ENTER param at %zu: %d\n", i, param);
+                goto fail;
+            }
+            EMIT("\x49\x81\xED"); jit_emit4(b, param);          // sub r13, param
+            EMIT("\x4C\x3B\x6B"); jit_emit1(b, JIT_OFS(stacklow)); // cmp r13, [rbx+stacklow]
+            EMIT("\x77\x05");                                   // ja +5
+            jit_emit_call(b, stubs.err[QVM_JIT_ERR_PROGRAMSTACK]);
+            EMIT("\x41\xC7\x45\x00"); jit_emit4(b, 0);          // mov dword [r13], 0
+            EMIT("\x41\xC7\x45\x04"); jit_emit4(b, param);      // mov dword [r13+4], param
+            break;
+
+        case QVM_OP_LEAVE:
+            if (param < 0) {
+                log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_jit_compile(): Invalid QVM_OP_LEAVE param at %zu: %d\n", i, param);
+                goto fail;
+            }
+            EMIT("\x41\x81\x7D\x04"); jit_emit4(b, param);      // cmp dword [r13+4], param
+            EMIT("\x74\x05");                                   // je +5
+            jit_emit_call(b, stubs.err[QVM_JIT_ERR_LEAVE]);
+            EMIT("\x49\x81\xC5"); jit_emit4(b, param);          // add r13, param
+            EMIT("\x4C\x3B\x6B"); jit_emit1(b, JIT_OFS(stackhigh)); // cmp r13, [rbx+stackhigh]
+            EMIT("\x76\x05");                                   // jbe +5
+            jit_emit_call(b, stubs.err[QVM_JIT_ERR_PROGRAMSTACK]);
+            EMIT("\x83\x43"); jit_emit1(b, JIT_OFS(calldepth)); EMIT("\x01"); // add dword [rbx+calldepth], 1
+            EMIT("\xC3");                                       // ret
+            break;
+
+        case QVM_OP_CALL: {
+            EMIT("\x41\x8B\x06");                               // mov eax, [r14]
+            EMIT("\x49\x83\xC6\x04");                           // add r14, 4
+            jit_emit_check_pop(b, &stubs);
+            EMIT("\x85\xC0");                                   // test eax, eax
+            EMIT("\x79\x07");                                   // jns +7
+            jit_emit_call(b, stubs.syscall);                    // call syscall
+            EMIT("\xEB");                                       // jmp done
+            size_t skip = b->pos;
+            jit_emit1(b, 0);
+            jit_emit1(b, 0x25); jit_emit4(b, (int32_t)codemask); // and eax, codemask
+            EMIT("\x41\xC7\x45\x00"); jit_emit4(b, (int32_t)(i + 1)); // mov dword [r13], RII
+            EMIT("\x83\x6B"); jit_emit1(b, JIT_OFS(calldepth)); EMIT("\x01"); // sub dword [rbx+calldepth], 1
+            EMIT("\x75\x05");                                   // jnz +5
+            jit_emit_call(b, stubs.err[QVM_JIT_ERR_CALLDEPTH]);
+            EMIT("\x48\x8B\x4B"); jit_emit1(b, JIT_OFS(instrtable)); // mov rcx, [rbx+instrtable]
+            EMIT("\xFF\x14\xC1");                               // call [rcx+rax*8]
+            if (b->pos <= b->size)
+                b->buf[skip] = (uint8_t)(b->pos - skip - 1);
+            break;
+        }
+
+        // stack opcodes
+
+        case QVM_OP_PUSH:
+            EMIT("\x49\x83\xEE\x04");                           // sub r14, 4
+            EMIT("\x41\xC7\x06"); jit_emit4(b, 0);              // mov dword [r14], 0
+            jit_emit_check_push(b, &stubs);
+            break;
+
+        case QVM_OP_POP:
+            EMIT("\x49\x83\xC6\x04");                           // add r14, 4
+            jit_emit_check_pop(b, &stubs);
+            break;
+
+        case QVM_OP_CONST:
+            EMIT("\x49\x83\xEE\x04");                           // sub r14, 4
+            EMIT("\x41\xC7\x06"); jit_emit4(b, param);          // mov dword [r14], param
+            jit_emit_check_push(b, &stubs);
+            break;
+
+        case QVM_OP_LOCAL:
+            EMIT("\x4C\x89\xE8");                               // mov rax, r13
+            EMIT("\x4C\x29\xE0");                               // sub rax, r12
+            jit_emit1(b, 0x05); jit_emit4(b, param);            // add eax, param
+            EMIT("\x49\x83\xEE\x04");                           // sub r14, 4
+            EMIT("\x41\x89\x06");                               // mov [r14], eax
+            jit_emit_check_push(b, &stubs);
+            break;
+
+        // branching
+
+        case QVM_OP_JUMP:
+            EMIT("\x41\x8B\x06");                               // mov eax, [r14]
+            EMIT("\x49\x83\xC6\x04");                           // add r14, 4
+            jit_emit_check_pop(b, &stubs);
+            jit_emit1(b, 0x25); jit_emit4(b, (int32_t)codemask); // and eax, codemask
+            if (vm->jumptargets) {
+                // with a version 2 jump target table, only jump to known targets
+                EMIT("\x48\xB9"); jit_emit8(b, (uint64_t)(uintptr_t)vm->jumptargets); // mov rcx, jumptargets
+                EMIT("\x0F\xA3\x01");                           // bt [rcx], eax
+                EMIT("\x72\x05");                               // jc +5
+                jit_emit_call(b, stubs.err[QVM_JIT_ERR_UNDEF]);  // call err_undef
+            }
+            EMIT("\x48\x8B\x4B"); jit_emit1(b, JIT_OFS(instrtable)); // mov rcx, [rbx+instrtable]
+            EMIT("\xFF\x24\xC1");                               // jmp [rcx+rax*8]
+            break;
+
+        case QVM_OP_EQ: case QVM_OP_NE:
+        case QVM_OP_LTI: case QVM_OP_LEI: case QVM_OP_GTI: case QVM_OP_GEI:
+        case QVM_OP_LTU: case QVM_OP_LEU: case QVM_OP_GTU: case QVM_OP_GEU:
+        case QVM_OP_EQF: case QVM_OP_NEF:
+        case QVM_OP_LTF: case QVM_OP_LEF: case QVM_OP_GTF: case QVM_OP_GEF: {
+            // like the interpreter, mask the target to the code segment
+            uint32_t target = (uint32_t)param & codemask;
+            if (target >= vm->instructioncount) {
+                log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_jit_compile(): Invalid branch target at %zu: %d\n", i, param);
+                goto fail;
+            }
+
+            int isfloat = (op->op >= QVM_OP_EQF);
+            if (isfloat) {
+                EMIT("\xF3\x41\x0F\x10\x46\x04");               // movss xmm0, [r14+4]
+                EMIT("\xF3\x41\x0F\x10\x0E");                   // movss xmm1, [r14]
+            }
+            else {
+                EMIT("\x41\x8B\x46\x04");                       // mov eax, [r14+4]
+                EMIT("\x41\x8B\x0E");                           // mov ecx, [r14]
+            }
+            EMIT("\x49\x83\xC6\x08");                           // add r14, 8
+            jit_emit_check_pop(b, &stubs);
+
+            // condition codes for jcc rel32 (0F 8x)
+            uint8_t cc = 0;
+            switch (op->op) {
+            case QVM_OP_EQ:  cc = 0x84; break;                  // je
+            case QVM_OP_NE:  cc = 0x85; break;                  // jne
+            case QVM_OP_LTI: cc = 0x8C; break;                  // jl
+            case QVM_OP_LEI: cc = 0x8E; break;                  // jle
+            case QVM_OP_GTI: cc = 0x8F; break;                  // jg
+            case QVM_OP_GEI: cc = 0x8D; break;                  // jge
+            case QVM_OP_LTU: cc = 0x82; break;                  // jb
+            case QVM_OP_LEU: cc = 0x86; break;                  // jbe
+            case QVM_OP_GTU: cc = 0x87; break;                  // ja
+            case QVM_OP_GEU: cc = 0x83; break;                  // jae
+            // float compares use ucomiss (which sets flags like an unsigned compare) ordered so that
+            // unordered (NaN) operands don't take the branch, except for QVM_OP_NEF
+            case QVM_OP_EQF:
+                EMIT("\x0F\x2E\xC1");                           // ucomiss xmm0, xmm1
+                EMIT("\x7A\x06");                               // jp +6
+                cc = 0x84;                                      // je
+                break;
+            case QVM_OP_NEF:
+                EMIT("\x0F\x2E\xC1");                           // ucomiss xmm0, xmm1
+                EMIT("\x0F\x8A");                               // jp target
+                fixups[numfixups].pos = b->pos;
+                fixups[numfixups++].target = target;
+                jit_emit4(b, 0);
+                cc = 0x85;                                      // jne
+                break;
+            case QVM_OP_LTF:
+                EMIT("\x0F\x2E\xC8");                           // ucomiss xmm1, xmm0
+                cc = 0x87;                                      // ja
+                break;
+            case QVM_OP_LEF:
+                EMIT("\x0F\x2E\xC8");                           // ucomiss xmm1, xmm0
+                cc = 0x83;                                      // jae
+                break;
+            case QVM_OP_GTF:
+                EMIT("\x0F\x2E\xC1");                           // ucomiss xmm0, xmm1
+                cc = 0x87;                                      // ja
+                break;
+            case QVM_OP_GEF:
+                EMIT("\x0F\x2E\xC1");                           // ucomiss xmm0, xmm1
+                cc = 0x83;                                      // jae
+                break;
+            default:
+                break;
+            }
+            if (!isfloat)
+                EMIT("\x39\xC8");                               // cmp eax, ecx
+            jit_emit1(b, 0x0F); jit_emit1(b, cc);               // jcc target
+            fixups[numfixups].pos = b->pos;
+            fixups[numfixups++].target = target;
+            jit_emit4(b, 0);
+            break;
+        }
+
+        // memory/pointer management
+
+        case QVM_OP_LOAD1:
+            jit_emit_dataaddr(b, 0, usemask, datamask);
+            EMIT("\x41\x0F\xB6\x04\x04");                       // movzx eax, byte [r12+rax]
+            EMIT("\x41\x89\x06");                               // mov [r14], eax
+            break;
+
+        case QVM_OP_LOAD2:
+            jit_emit_dataaddr(b, 0, usemask, datamask);
+            EMIT("\x41\x0F\xB7\x04\x04");                       // movzx eax, word [r12+rax]
+            EMIT("\x41\x89\x06");                               // mov [r14], eax
+            break;
+
+        case QVM_OP_LOAD4:
+            jit_emit_dataaddr(b, 0, usemask, datamask);
+            EMIT("\x41\x8B\x04\x04");                           // mov eax, [r12+rax]
+            EMIT("\x41\x89\x06");                               // mov [r14], eax
+            break;
+
+        case QVM_OP_STORE1:
+        case QVM_OP_STORE2:
+        case QVM_OP_STORE4:
+            jit_emit_dataaddr(b, 4, usemask, datamask);
+            EMIT("\x41\x8B\x0E");                               // mov ecx, [r14]
+            if (op->op == QVM_OP_STORE1)
+                EMIT("\x41\x88\x0C\x04");                       // mov [r12+rax], cl
+            else if (op->op == QVM_OP_STORE2)
+                EMIT("\x66\x41\x89\x0C\x04");                   // mov [r12+rax], cx
+            else
+                EMIT("\x41\x89\x0C\x04");                       // mov [r12+rax], ecx
+            EMIT("\x49\x83\xC6\x08");                           // add r14, 8
+            jit_emit_check_pop(b, &stubs);
+            break;
+
+        case QVM_OP_ARG:
+            EMIT("\x41\x8B\x06");                               // mov eax, [r14]
+            EMIT("\x49\x83\xC6\x04");                           // add r14, 4
+            jit_emit_check_pop(b, &stubs);
+            EMIT("\x41\x89\x85"); jit_emit4(b, param);          // mov [r13+param], eax
+            break;
+
+        case QVM_OP_BLOCK_COPY:
+            EMIT("\x41\x8B\x76\x04");                           // mov esi, [r14+4]
+            EMIT("\x41\x8B\x16");                               // mov edx, [r14]
+            EMIT("\x49\x83\xC6\x08");                           // add r14, 8
+            jit_emit_check_pop(b, &stubs);
+            EMIT("\x48\x89\xDF");                               // mov rdi, rbx
+            jit_emit1(b, 0xB9); jit_emit4(b, param);            // mov ecx, param
+            jit_emit_ccall(b, (void*)qvm_jit_blockcopy);
+            break;
+
+        // sign extensions (same as the interpreter: only set the upper bits if the sign bit is set)
+
+        case QVM_OP_SEX8:
+            EMIT("\x41\xF6\x06\x80");                           // test byte [r14], 0x80
+            EMIT("\x74\x07");                                   // jz +7
+            EMIT("\x41\x81\x0E\x00\xFF\xFF\xFF");               // or dword [r14], 0xFFFFFF00
+            break;
+
+        case QVM_OP_SEX16:
+            EMIT("\x41\xF7\x06\x00\x80\x00\x00");               // test dword [r14], 0x8000
+            EMIT("\x74\x07");                                   // jz +7
+            EMIT("\x41\x81\x0E\x00\x00\xFF\xFF");               // or dword [r14], 0xFFFF0000
+            break;
+
+        // arithmetic/operators
+
+        case QVM_OP_NEGI:
+            EMIT("\x41\xF7\x1E");                               // neg dword [r14]
+            break;
+
+        case QVM_OP_BCOM:
+            EMIT("\x41\xF7\x16");                               // not dword [r14]
+            break;
+
+        case QVM_OP_ADD:
+        case QVM_OP_SUB:
+        case QVM_OP_BAND:
+        case QVM_OP_BOR:
+        case QVM_OP_BXOR:
+            EMIT("\x41\x8B\x06");                               // mov eax, [r14]
+            EMIT("\x49\x83\xC6\x04");                           // add r14, 4
+            jit_emit_check_pop(b, &stubs);
+            if (op->op == QVM_OP_ADD)
+                EMIT("\x41\x01\x06");                           // add [r14], eax
+            else if (op->op == QVM_OP_SUB)
+                EMIT("\x41\x29\x06");                           // sub [r14], eax
+            else if (op->op == QVM_OP_BAND)
+                EMIT("\x41\x21\x06");                           // and [r14], eax
+            else if (op->op == QVM_OP_BOR)
+                EMIT("\x41\x09\x06");                           // or [r14], eax
+            else
+                EMIT("\x41\x31\x06");                           // xor [r14], eax
+            break;
+
+        case QVM_OP_MULI:
+        case QVM_OP_MULU:
+            // low 32 bits are the same for signed and unsigned
+            EMIT("\x41\x8B\x46\x04");                           // mov eax, [r14+4]
+            EMIT("\x41\x0F\xAF\x06");                           // imul eax, [r14]
+            EMIT("\x49\x83\xC6\x04");                           // add r14, 4
+            jit_emit_check_pop(b, &stubs);
+            EMIT("\x41\x89\x06");                               // mov [r14], eax
+            break;
+
+        case QVM_OP_DIVI:
+        case QVM_OP_DIVU:
+        case QVM_OP_MODI:
+        case QVM_OP_MODU: {
+            int ismod = (op->op == QVM_OP_MODI || op->op == QVM_OP_MODU);
+            EMIT("\x41\x8B\x0E");                               // mov ecx, [r14]
+            EMIT("\x49\x83\xC6\x04");                           // add r14, 4
+            jit_emit_check_pop(b, &stubs);
+            EMIT("\x85\xC9");                                   // test ecx, ecx
+            EMIT("\x75\x05");                                   // jnz +5
+            jit_emit_call(b, stubs.err[QVM_JIT_ERR_DIV0]);
+            EMIT("\x41\x8B\x06");                               // mov eax, [r14]
+            if (op->op == QVM_OP_DIVI || op->op == QVM_OP_MODI) {
+                // INT_MIN / -1 traps on x86, so handle -1 separately (x / -1 = -x, x % -1 = 0)
+                EMIT("\x83\xF9\xFF");                           // cmp ecx, -1
+                EMIT("\x75\x04");                               // jne +4
+                if (ismod) {
+                    EMIT("\x31\xC0");                           // xor eax, eax
+                    EMIT("\xEB\x05");                           // jmp +5
+                }
+                else {
+                    EMIT("\xF7\xD8");                           // neg eax
+                    EMIT("\xEB\x03");                           // jmp +3
+                }
+                EMIT("\x99");                                   // cdq
+                EMIT("\xF7\xF9");                               // idiv ecx
+            }
+            else {
+                EMIT("\x31\xD2");                               // xor edx, edx
+                EMIT("\xF7\xF1");                               // div ecx
+            }
+            if (ismod)
+                EMIT("\x89\xD0");                               // mov eax, edx
+            EMIT("\x41\x89\x06");                               // mov [r14], eax
+            break;
+        }
+
+        case QVM_OP_LSH:
+        case QVM_OP_RSHI:
+        case QVM_OP_RSHU:
+            EMIT("\x41\x8B\x0E");                               // mov ecx, [r14]
+            EMIT("\x49\x83\xC6\x04");                           // add r14, 4
+            jit_emit_check_pop(b, &stubs);
+            if (op->op == QVM_OP_LSH)
+                EMIT("\x41\xD3\x26");                           // shl dword [r14], cl
+            else if (op->op == QVM_OP_RSHI)
+                EMIT("\x41\xD3\x3E");                           // sar dword [r14], cl
+            else
+                EMIT("\x41\xD3\x2E");                           // shr dword [r14], cl
+            break;
+
+        case QVM_OP_NEGF:
+            EMIT("\x41\x81\x36\x00\x00\x00\x80");               // xor dword [r14], 0x80000000
+            break;
+
+        case QVM_OP_ADDF:
+        case QVM_OP_SUBF:
+        case QVM_OP_DIVF:
+        case QVM_OP_MULF:
+            EMIT("\xF3\x41\x0F\x10\x46\x04");                   // movss xmm0, [r14+4]
+            if (op->op == QVM_OP_ADDF)
+                EMIT("\xF3\x41\x0F\x58\x06");                   // addss xmm0, [r14]
+            else if (op->op == QVM_OP_SUBF)
+                EMIT("\xF3\x41\x0F\x5C\x06");                   // subss xmm0, [r14]
+            else if (op->op == QVM_OP_DIVF)
+                EMIT("\xF3\x41\x0F\x5E\x06");                   // divss xmm0, [r14]
+            else
+                EMIT("\xF3\x41\x0F\x59\x06");                   // mulss xmm0, [r14]
+            EMIT("\x49\x83\xC6\x04");                           // add r14, 4
+            jit_emit_check_pop(b, &stubs);
+            EMIT("\xF3\x41\x0F\x11\x06");                       // movss [r14], xmm0
+            break;
+
+        // format conversion
+
+        case QVM_OP_CVIF:
+            EMIT("\xF3\x41\x0F\x2A\x06");                       // cvtsi2ss xmm0, dword [r14]
+            EMIT("\xF3\x41\x0F\x11\x06");                       // movss [r14], xmm0
+            break;
+
+        case QVM_OP_CVFI:
+            EMIT("\xF3\x41\x0F\x2C\x06");                       // cvttss2si eax, dword [r14]
+            EMIT("\x41\x89\x06");                               // mov [r14], eax
+            break;
+
+        case QVM_OP_UNDEF:
+        default:
+            jit_emit_call(b, stubs.err[QVM_JIT_ERR_UNDEF]);
+            break;
+        }
+
+        if (b->pos > b->size) {
+            log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_jit_compile(): Native code buffer overflow at instruction %zu\n", i);
+            goto fail;
+        }
+    }
+
+    // point branches at their targets
+    for (size_t i = 0; i < numfixups; i++) {
+        uint8_t* rel = b->buf + fixups[i].pos;
+        int32_t disp = (int32_t)((uint8_t*)jit->instrtable[fixups[i].target] - (rel + 4));
+        memcpy(rel, &disp, sizeof(disp));
+    }
+    jit->codeused = b->pos;
+
+    // make code executable (and no longer writable)
+    if (mprotect(jit->code, jit->codesize, PROT_READ | PROT_EXEC) != 0) {
+        log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_jit_compile(): Unable to make native code executable\n");
+        goto fail;
+    }
+
+    free(fixups);
+    vm->jit = jit;
+
+    log_c(QMM_LOG_DEBUG, QMM_LOGGING_TAG, "qvm_jit_compile(): Compiled %zu instructions into %zu bytes of native code\n", vm->instructioncount, jit->codeused);
+    return 1;
+
+fail:
+    free(fixups);
+    if (jit) {
+        if (jit->code)
+            munmap(jit->code, jit->codesize);
+        free(jit->instrtable);
+        free(jit);
+    }
+    return 0;
+}
+
+
+void qvm_jit_free(qvm* vm) {
+    if (!vm || !vm->jit)
+        return;
+
+    struct qvm_jit* jit = vm->jit;
+    if (jit->code)
+        munmap(jit->code, jit->codesize);
+    free(jit->instrtable);
+    free(jit);
+    vm->jit = NULL;
+}
+
+
+size_t qvm_jit_codesize(const qvm* vm) {
+    if (!vm || !vm->jit)
+        return 0;
+    return vm->jit->codeused;
+}
+
+
+int qvm_jit_exec(qvm* vm, size_t instruction, int** programstack, int** opstack, int* opstacklow, int* opstackhigh, size_t* errinstr) {
+    struct qvm_jit* jit = vm->jit;
+
+    // save opstack bounds of any outer execution (if this is a re-entrant call from a syscall)
+    int* outeropstacklow = jit->opstacklow;
+    int* outeropstackhigh = jit->opstackhigh;
+    jit->opstacklow = opstacklow;
+    jit->opstackhigh = opstackhigh;
+
+    // save native stack pointer and call depth of any outer execution, since a guard region fault skips the entry
+    // stub's cleanup
+    void* outersavedrsp = jit->savedrsp;
+    int outercalldepth = jit->calldepth;
+
+    int err;
+    qvm_guard guard;
+    int guarded = (vm->allocator->flags & QVM_ALLOC_GUARDED) != 0;
+    if (guarded && sigsetjmp(guard.env, 0)) {
+        jit->savedrsp = outersavedrsp;
+        jit->calldepth = outercalldepth;
+        // the stacks at the fault are lost, so report the entry program stack and an empty opstack
+        jit->outprogramstack = *programstack;
+        jit->outopstack = opstackhigh;
+        // faultpc is not a return address like other error sites, so point just past it
+        jit->errsite = guard.faultpc ? (uint8_t*)guard.faultpc + 1 : NULL;
+        err = QVM_JIT_ERR_FAULT;
+    }
+    else {
+        if (guarded)
+            qvm_guard_push(&guard, vm);
+        err = jit->entry(jit, *programstack, *opstack, jit->instrtable[instruction]);
+        if (guarded)
+            qvm_guard_pop(&guard);
+    }
+
+    jit->opstacklow = outeropstacklow;
+    jit->opstackhigh = outeropstackhigh;
+    *programstack = jit->outprogramstack;
+    *opstack = jit->outopstack;
+
+    if (err == QVM_JIT_ERR_NONE)
+        return 1;
+
+    size_t at = jit_find_instruction(jit, jit->errsite, instruction);
+    *errinstr = at;
+
+    switch (err) {
+    case QVM_JIT_ERR_UNDEF:
+        log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %zu: invalid instruction or jump target\n", instruction, at);
+        break;
+    case QVM_JIT_ERR_OPSTACK:
+        log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %zu: opstack overflow! Opstack size is currently %td, max is %d.\n", instruction, at, (uint8_t*)opstackhigh - (uint8_t*)*opstack, QVM_OPSTACK_SIZE);
+        break;
+    case QVM_JIT_ERR_PROGRAMSTACK:
+        log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %zu: program stack overflow! Program stack size is currently %td, max is %zu.\n", instruction, at, (uint8_t*)vm->stackhigh - (uint8_t*)*programstack, vm->stacksize);
+        break;
+    case QVM_JIT_ERR_LEAVE:
+        log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %zu: QVM_OP_LEAVE param (%d) does not match QVM_OP_ENTER param (%d)\n", instruction, at, vm->codesegment[at].param, (*programstack)[1]);
+        break;
+    case QVM_JIT_ERR_DIV0:
+        log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %zu: %s division by 0!\n", instruction, at, qvm_opcodename[vm->codesegment[at].op]);
+        break;
+    case QVM_JIT_ERR_CALLDEPTH:
+        log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %zu: too many nested function calls (max is %d)\n", instruction, at, QVM_JIT_MAX_CALL_DEPTH);
+        break;
+    case QVM_JIT_ERR_FAULT:
+        log_c(QMM_LOG_FATAL, QMM_LOGGING_TAG, "qvm_exec(%zu): Runtime error at %zu: data segment access out of bounds (offset %td)\n", instruction, at, (uint8_t*)guard.faultaddr - vm->datasegment);
+        break;
+    case QVM_JIT_ERR_NESTED:
+    default:
+        // already reported by the nested execution
+        break;
+    }
+
+    return 0;
+}
+
+#else // !QVM_JIT_SUPPORTED
+
+int qvm_jit_compile(qvm* vm) {
+    (void)vm;
+    log_c(QMM_LOG_WARNING, QMM_LOGGING_TAG, "qvm_jit_compile(): JIT is not supported on this platform\n");
+    return 0;
+}
+
+
+void qvm_jit_free(qvm* vm) {
+    (void)vm;
+}
+
+
+size_t qvm_jit_codesize(const qvm* vm) {
+    (void)vm;
+    return 0;
+}
+
+
+int qvm_jit_exec(qvm* vm, size_t instruction, int** programstack, int** opstack, int* opstacklow, int* opstackhigh, size_t* errinstr) {
+    (void)vm; (void)programstack; (void)opstack; (void)opstacklow; (void)opstackhigh;
+    *errinstr = instruction;
+    return 0;
+}
+
+#endif // QVM_JIT_SUPPORTED
@@ -0,0 +1,64 @@
+/*
+QMM2 - Q3 MultiMod 2
+Copyright 2025-2026
+https://github.com/thecybermind/qmm2/
+3-clause BSD license: https://opensource.org/license/bsd-3-clause
+
+Created By:
+    Kevin Masterson < k.m.masterson@gmail.com >
+
+*/
+
+#include "version.h"
+#include <chrono>
+#include <map>
+#include "qmmapi.h"
+#include "stats.hpp"
+
+// Routing statistics are being collected
+bool g_stats_active = false;
+
+// Collected routing statistics totals
+StatsTable g_stats;
+
+
+// Find (or add) the entry for a message in a table. Messages in range are a direct index, so this stays cheap on the
+// routing path
+static StatsEntry& s_stats_entry(StatsTable& table, bool is_syscall, intptr_t cmd) {
+    if (cmd < 0 || cmd > QMM_STATS_MAX_CMD)
+        return table.othercmds[is_syscall][cmd];
+    std::vector<StatsEntry>& cmds = table.cmds[is_syscall];
+    if ((size_t)cmd >= cmds.size())
+        cmds.resize((size_t)cmd + 1);
+    return cmds[(size_t)cmd];
+}
+
+
+uint64_t stats_time() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+void stats_add(StatsTable& table, bool is_syscall, intptr_t cmd, StatsPhase phase, uint64_t time, plugin_res result) {
+    StatsCounter& counter = s_stats_entry(table, is_syscall, cmd).phases[phase];
+    counter.calls++;
+    counter.time += time;
+    if (time > counter.maxtime)
+        counter.maxtime = time;
+    if (result == QMM_OVERRIDE)
+        counter.overrides++;
+    else if (result == QMM_SUPERCEDE)
+        counter.supercedes++;
+}
+
+
+void stats_add_call(bool is_syscall, intptr_t cmd, uint64_t time) {
+    StatsEntry& entry = s_stats_entry(g_stats, is_syscall, cmd);
+    if (time > entry.maxtime)
+        entry.maxtime = time;
+}
+
+
+void stats_clear(StatsTable& table) {
+    table = StatsTable();
+}
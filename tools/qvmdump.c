@@ -0,0 +1,310 @@
+/*
+QMM2 - Q3 MultiMod 2
+Copyright 2025-2026
+https://github.com/thecybermind/qmm2/
+3-clause BSD license: https://opensource.org/license/bsd-3-clause
+
+Created By:
+    Kevin Masterson < k.m.masterson@gmail.com >
+
+*/
+
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdint.h>     // intptr_t and uint8_t
+#include <stdarg.h>     // va_list
+#include <stdio.h>
+#include <stdlib.h>     // malloc and free
+#include <string.h>     // memcpy and strcmp
+#include <time.h>       // time_t, localtime, and strftime
+#include "qvm.h"
+
+// Offline crash dump decoder. Reads a .qvmd file written by qvm_dump() and prints the annotated view: opstacks,
+// current instruction, flight recorder, program stack frames, and a hex/ASCII view of the data segment.
+
+// A loaded crash dump, with pointers to each section in the file
+typedef struct {
+    uint8_t* file;                  // File contents
+    size_t filesize;                // Size of file
+    qvm_dump_header header;         // Header
+    const int* opstack;             // Opstack values, top first
+    const uint8_t* outer;           // Outer execution opstacks (count and values for each)
+    const qvm_trace_entry* trace;   // Flight recorder entries, oldest first
+    const qvm_op* code;             // Code segment
+    const uint8_t* data;            // Data segment
+} dump_file;
+
+static const char* dump_tracename[] = { "call", "return", "jump", "syscall" };
+
+// log_c is provided by the QMM logging system in the full build
+void log_c(int severity, const char* tag, const char* fmt, ...) {
+    // only show warnings and errors (QMM_LOG_WARNING and up)
+    if (severity < 4)
+        return;
+    va_list ap;
+    va_start(ap, fmt);
+    fprintf(stderr, "[%s] ", tag);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+}
+
+
+// Point 'out' at the next 'size' bytes of the file. Returns 0 if the file is too short
+static int dump_section(dump_file* dump, size_t* pos, size_t size, const void** out) {
+    if (size > dump->filesize - *pos)
+        return 0;
+    *out = dump->file + *pos;
+    *pos += size;
+    return 1;
+}
+
+
+// Read a crash dump file and find its sections
+static int dump_load(dump_file* dump, const char* path) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        fprintf(stderr, "Unable to open \"%s\"\n", path);
+        return 0;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    dump->file = size > 0 ? (uint8_t*)malloc((size_t)size) : NULL;
+    dump->filesize = dump->file && fread(dump->file, 1, (size_t)size, fp) == (size_t)size ? (size_t)size : 0;
+    fclose(fp);
+
+    if (dump->filesize < sizeof(qvm_dump_header)) {
+        fprintf(stderr, "Unable to read \"%s\"\n", path);
+        return 0;
+    }
+    memcpy(&dump->header, dump->file, sizeof(qvm_dump_header));
+    qvm_dump_header* h = &dump->header;
+    if (h->magic != QVM_DUMP_MAGIC || h->version != QVM_DUMP_VERSION || h->headersize != sizeof(qvm_dump_header)) {
+        fprintf(stderr, "\"%s\" is not a version %d QVM crash dump\n", path, QVM_DUMP_VERSION);
+        return 0;
+    }
+
+    size_t pos = h->headersize;
+    const void* section;
+    if (!dump_section(dump, &pos, h->opstackcount * sizeof(int), &section))
+        goto truncated;
+    dump->opstack = (const int*)section;
+
+    dump->outer = dump->file + pos;
+    for (uint32_t i = 0; i < h->outercount; i++) {
+        uint32_t count;
+        if (!dump_section(dump, &pos, sizeof(count), &section))
+            goto truncated;
+        memcpy(&count, section, sizeof(count));
+        if (!dump_section(dump, &pos, count * sizeof(int), &section))
+            goto truncated;
+    }
+
+    if (!dump_section(dump, &pos, h->tracecount * sizeof(qvm_trace_entry), &section))
+        goto truncated;
+    dump->trace = (const qvm_trace_entry*)section;
+    if (!dump_section(dump, &pos, h->codeseglen, &section))
+        goto truncated;
+    dump->code = (const qvm_op*)section;
+    if (!dump_section(dump, &pos, h->dataseglen, &section))
+        goto truncated;
+    dump->data = (const uint8_t*)section;
+
+    if (h->instructioncount > h->codeseglen / sizeof(qvm_op) || h->stackptr > h->stackhigh || h->stackhigh > h->dataseglen) {
+        fprintf(stderr, "\"%s\" has an invalid header\n", path);
+        return 0;
+    }
+    return 1;
+
+truncated:
+    fprintf(stderr, "\"%s\" is truncated\n", path);
+    return 0;
+}
+
+
+// Print an instruction index with its opcode and the function it is in
+static void dump_instruction(const dump_file* dump, int instruction) {
+    if (instruction < 0 || (uint32_t)instruction >= dump->header.instructioncount) {
+        printf("%d (out of range)", instruction);
+        return;
+    }
+
+    const qvm_op* op = &dump->code[instruction];
+    const char* opname = op->op >= 0 && op->op < QVM_OP_NUM_OPS ? qvm_opcodename[op->op] : "unknown";
+
+    // the function starts at the nearest QVM_OP_ENTER at or before the instruction
+    int func = instruction;
+    while (func > 0 && dump->code[func].op != QVM_OP_ENTER)
+        func--;
+
+    printf("%d (%08x) %s %d, in function %d", instruction, instruction, opname, op->param, func);
+}
+
+
+// Print a row of opstack values in hex and decimal
+static void dump_opstack(const char* name, const int* values, uint32_t count) {
+    printf("%s (hex): ", name);
+    for (uint32_t i = 0; i < count; i++)
+        printf("%08x ", values[i]);
+    printf("\n%s (dec): ", name);
+    for (uint32_t i = 0; i < count; i++)
+        printf("%d ", values[i]);
+    printf("\n\n");
+}
+
+
+static void dump_print(const dump_file* dump, int showdata) {
+    const qvm_dump_header* h = &dump->header;
+
+    char stamp[32] = "unknown";
+    time_t t = (time_t)h->time;
+    struct tm* tm = localtime(&t);
+    if (tm)
+        strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", tm);
+    printf("QVM crash dump from %s\nQVM magic: %08x, %u instructions, %u bytes of data\n\n", stamp, h->vmmagic, h->instructioncount, h->dataseglen);
+
+    printf("VM state:\n-----\n");
+    dump_opstack("Opstack", dump->opstack, h->opstackcount);
+
+    // op stacks of outer executions that are waiting on a syscall which started a re-entrant execution
+    const uint8_t* p = dump->outer;
+    for (uint32_t i = 0; i < h->outercount; i++) {
+        uint32_t count;
+        memcpy(&count, p, sizeof(count));
+        char name[64];
+        snprintf(name, sizeof(name), "Outer execution %u opstack", i + 1);
+        dump_opstack(name, (const int*)(p + sizeof(count)), count);
+        p += sizeof(count) + count * sizeof(int);
+    }
+
+    // IP (unknown after a guard region fault)
+    printf("Instruction pointer: ");
+    if (h->instruction >= 0)
+        dump_instruction(dump, h->instruction);
+    else
+        printf("unknown");
+    printf("\n\n");
+
+    // flight recorder
+    if (h->tracecount) {
+        printf("Flight recorder (last %u of %llu events, oldest first):\n-----\n", h->tracecount, (unsigned long long)h->tracetotal);
+        for (uint32_t i = 0; i < h->tracecount; i++) {
+            const qvm_trace_entry* e = &dump->trace[i];
+            const char* type = e->type >= 0 && e->type <= QVM_TRACE_SYSCALL ? dump_tracename[e->type] : "unknown";
+            printf("%-8s ", type);
+            if (e->type == QVM_TRACE_SYSCALL) {
+                printf("%d (", e->cmd);
+                for (int a = 0; a < QVM_TRACE_ARGS; a++)
+                    printf(a ? ", %d" : "%d", e->args[a]);
+                printf(") from ");
+                if (e->instruction < 0) {
+                    printf("native code\n");
+                    continue;
+                }
+            }
+            dump_instruction(dump, e->instruction);
+            printf("\n");
+        }
+        printf("\n");
+    }
+
+    // program stack, one frame at a time from the innermost
+    printf("Stack:\n-----\n");
+    uint32_t offset = h->stackptr;
+    while (offset + 2 * sizeof(int) <= h->stackhigh) {
+        int frame[2];
+        memcpy(frame, dump->data + offset, sizeof(frame));
+        printf("0x%08x (%d) (RII", frame[0], frame[0]);
+        if (frame[0] > 0 && (uint32_t)frame[0] < h->instructioncount) {
+            printf(": ");
+            dump_instruction(dump, frame[0]);
+        }
+        printf(")\n0x%08x (%d) (Framesize)\n", frame[1], frame[1]);
+        // a damaged frame size would walk off the stack or never end
+        if (frame[1] < (int)(2 * sizeof(int)) || frame[1] % sizeof(int) || (uint32_t)frame[1] > h->stackhigh - offset) {
+            printf("(invalid frame size)\n-----\n");
+            break;
+        }
+        for (uint32_t i = offset + 2 * sizeof(int); i < offset + (uint32_t)frame[1]; i += sizeof(int)) {
+            int value;
+            memcpy(&value, dump->data + i, sizeof(value));
+            printf("0x%08x (%d)\n", value, value);
+        }
+        offset += (uint32_t)frame[1];
+        printf("-----\n");
+    }
+    printf("\n");
+
+    if (!showdata)
+        return;
+
+    // data segment
+    printf("Data segment:\n-----\n");
+    for (uint32_t row = 0; row < h->dataseglen; row += 32) {
+        const uint8_t* d = dump->data + row;
+        uint32_t len = h->dataseglen - row < 32 ? h->dataseglen - row : 32;
+
+        // print offset
+        printf("%04X ", row);
+
+        // print hex values, with a gap halfway through the row and empty spaces if the data ends early
+        for (uint32_t b = 0; b < 32; b++) {
+            if (b == 16)
+                printf("   ");
+            if (b >= len)
+                printf("   ");
+            else
+                printf(" %02X", d[b]);
+        }
+
+        printf("    ");
+
+        // print characters
+        for (uint32_t b = 0; b < 32; b++) {
+            if (b == 16)
+                printf(" ");
+            if (b >= len)
+                printf(" ");
+            else
+                printf("%c", (d[b] < 32 || d[b] >= 127) ? '.' : (char)d[b]);
+        }
+
+        printf("\n");
+    }
+}
+
+
+static void dump_usage(const char* argv0) {
+    printf("usage: %s [-n] dumpfile\n", argv0);
+    printf("  -n          don't print the data segment\n");
+}
+
+
+int main(int argc, char** argv) {
+    const char* path = NULL;
+    int showdata = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n")) {
+            showdata = 0;
+        }
+        else if (argv[i][0] == '-' || path) {
+            dump_usage(argv[0]);
+            return !strcmp(argv[i], "-h") ? 0 : 1;
+        }
+        else {
+            path = argv[i];
+        }
+    }
+    if (!path) {
+        dump_usage(argv[0]);
+        return 1;
+    }
+
+    dump_file dump;
+    memset(&dump, 0, sizeof(dump));
+    int ok = dump_load(&dump, path);
+    if (ok)
+        dump_print(&dump, showdata);
+    free(dump.file);
+    return ok ? 0 : 1;
+}